@@ -0,0 +1,203 @@
+// 堆分配基准：替换全局 operator new/delete 计数，以恒定客流运行 Building，
+// 报告预热之后每模拟小时的分配次数和字节数，确认稳定运行时乘客的到达、分配、上下梯和超时不再分配内存。
+// 请求预先生成；关闭数据记录（记录器按设计保存全部历史）和随机故障。
+// 复用的缓冲区都按载客量预先留足，预热后应为 0；不为 0 时说明某个缓冲区在客流新高时仍在扩容
+//
+// 用法: elevator_allocation_benchmark [--hours 小时] [--warmup 小时] [--dt 秒] [--rate 人/小时/层]
+//                                     [--strategy nearest|balanced|energy|batch] [--seed N]
+// 不给 --strategy 时依次测四种策略
+#include "building.h"
+#include "config.h"
+#include "logger.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    std::atomic<long long> allocationCount{0};
+    std::atomic<long long> allocatedBytes{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+    struct Options {
+        double hours = 4.0;
+        double warmup = 1.0;
+        double deltaTime = 0.1;
+        double rate = 20.0;  // 每层每小时到达人数
+        std::vector<Dispatcher::Strategy> strategies;
+        unsigned int seed = 42;
+    };
+
+    struct Request {
+        long long step;
+        int fromFloor;
+        int toFloor;
+    };
+
+    bool parseStrategy(const char* name, Dispatcher::Strategy& strategy) {
+        if (std::strcmp(name, "nearest") == 0) strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        else if (std::strcmp(name, "balanced") == 0) strategy = Dispatcher::Strategy::LOAD_BALANCED;
+        else if (std::strcmp(name, "energy") == 0) strategy = Dispatcher::Strategy::ENERGY_SAVING;
+        else if (std::strcmp(name, "batch") == 0) strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        else return false;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--hours") == 0) options.hours = std::atof(value);
+            else if (std::strcmp(arg, "--warmup") == 0) options.warmup = std::atof(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--rate") == 0) options.rate = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--strategy") == 0) {
+                Dispatcher::Strategy strategy;
+                if (!parseStrategy(value, strategy)) {
+                    std::cerr << "未知策略: " << value << std::endl;
+                    return false;
+                }
+                options.strategies.push_back(strategy);
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.hours > 0 && options.warmup >= 0 && options.deltaTime > 0 && options.rate >= 0;
+    }
+
+    // 上行（从1楼出发）、下行（到1楼）和层间各占 4:4:2
+    std::vector<Request> generateRequests(const Options& options, int floors, long long steps) {
+        std::mt19937 random(options.seed);
+        std::poisson_distribution<int> arrivals(options.rate * floors / 3600.0 * options.deltaTime);
+        std::uniform_real_distribution<double> kind(0.0, 1.0);
+        std::uniform_int_distribution<int> upper(2, floors);
+        std::uniform_int_distribution<int> any(1, floors);
+
+        std::vector<Request> requests;
+        for (long long step = 0; step < steps; ++step) {
+            for (int n = arrivals(random); n > 0; --n) {
+                double k = kind(random);
+                Request request{step, 1, 1};
+                if (k < 0.4) {
+                    request.toFloor = upper(random);
+                } else if (k < 0.8) {
+                    request.fromFloor = upper(random);
+                } else {
+                    request.fromFloor = any(random);
+                    do {
+                        request.toFloor = any(random);
+                    } while (request.toFloor == request.fromFloor);
+                }
+                requests.push_back(request);
+            }
+        }
+        return requests;
+    }
+
+    void benchmark(const Options& options, Dispatcher::Strategy strategy, const std::vector<Request>& requests,
+                   long long warmupSteps, long long steps) {
+        Building building;
+        building.setRecordingEnabled(false);
+        building.getMaintenanceManager().setEnabled(false);
+        building.setDispatchStrategy(strategy);
+
+        long long stepsPerHour = static_cast<long long>(3600 / options.deltaTime);
+        std::vector<long long> hourlyCounts;
+        hourlyCounts.reserve(steps / stepsPerHour + 1);  // 基准自身的记录不计入预热后的分配
+        long long measuredCount = 0, measuredBytes = 0;
+        long long hourStart = allocationCount.load();
+        size_t next = 0;
+        for (long long step = 0; step < steps; ++step) {
+            if (step == warmupSteps) {
+                measuredCount = allocationCount.load();
+                measuredBytes = allocatedBytes.load();
+            }
+            for (; next < requests.size() && requests[next].step == step; ++next) {
+                building.addRequest(requests[next].fromFloor, requests[next].toFloor, 1);
+            }
+            building.update(options.deltaTime);
+            if ((step + 1) % stepsPerHour == 0) {
+                long long now = allocationCount.load();
+                hourlyCounts.push_back(now - hourStart);
+                hourStart = now;
+            }
+        }
+        double measuredHours = (steps - warmupSteps) * options.deltaTime / 3600.0;
+        measuredCount = allocationCount.load() - measuredCount;
+        measuredBytes = allocatedBytes.load() - measuredBytes;
+
+        const auto& metrics = building.getMetrics();
+        const auto& pool = building.getPassengerPool();
+        std::cout << Dispatcher::getStrategyName(strategy) << ": 请求 " << metrics.getRequestedPassengers()
+                  << "  送达 " << metrics.getDeliveredPassengers() << "  超时 " << metrics.getTimedOutPassengers()
+                  << std::endl;
+        std::cout << "  每小时分配次数:";
+        for (long long count : hourlyCounts) {
+            std::cout << " " << count;
+        }
+        std::cout << std::endl;
+        std::cout << "  预热后: " << std::setprecision(1) << measuredCount / measuredHours << " 次/模拟小时  "
+                  << measuredBytes / measuredHours << " 字节/模拟小时" << std::endl;
+        std::cout << "  乘客池: 容量 " << pool.getCapacity() << "  扩容 " << pool.getGrowthCount()
+                  << " 次  在场 " << pool.getLiveCount() << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_allocation_benchmark [--hours 小时] [--warmup 小时] [--dt 秒] "
+                     "[--rate 人/小时/层] [--strategy nearest|balanced|energy|batch] [--seed N]" << std::endl;
+        return 1;
+    }
+    Logger::setThreadEnabled(false);
+    if (options.strategies.empty()) {
+        options.strategies = {Dispatcher::Strategy::NEAREST_FIRST, Dispatcher::Strategy::LOAD_BALANCED,
+                              Dispatcher::Strategy::ENERGY_SAVING, Dispatcher::Strategy::BATCH_OPTIMAL};
+    }
+
+    long long warmupSteps = static_cast<long long>(options.warmup * 3600 / options.deltaTime);
+    long long steps = warmupSteps + static_cast<long long>(options.hours * 3600 / options.deltaTime);
+    std::vector<Request> requests = generateRequests(options, ElevatorConfig::FLOOR_COUNT, steps);
+
+    std::cout << std::fixed;
+    std::cout << "=== 堆分配基准 ===" << std::endl;
+    std::cout << "预热 " << std::setprecision(1) << options.warmup << " 小时  测量 " << options.hours
+              << " 小时  步长 " << std::setprecision(2) << options.deltaTime << " s  " << requests.size()
+              << " 个请求" << std::endl;
+    for (Dispatcher::Strategy strategy : options.strategies) {
+        benchmark(options, strategy, requests, warmupSteps, steps);
+    }
+    return 0;
+}
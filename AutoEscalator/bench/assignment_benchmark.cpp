@@ -0,0 +1,133 @@
+// 批量指派耗时基准：在大楼规模下（默认64部电梯、200个候梯乘客）测量一个调度周期
+// 建代价矩阵并求解的耗时，以及下一周期重新优化全部已分配乘客的耗时，确认能在一个步长内完成
+//
+// 用法: elevator_assignment_benchmark [--cars N] [--calls N] [--floors N] [--rounds N] [--seed N]
+#include "batch_dispatcher.h"
+#include "config.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Options {
+        int cars = 64;
+        int calls = 200;
+        int floors = 60;
+        int rounds = 20;
+        unsigned int seed = 42;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--cars") == 0) options.cars = std::atoi(value);
+            else if (std::strcmp(arg, "--calls") == 0) options.calls = std::atoi(value);
+            else if (std::strcmp(arg, "--floors") == 0) options.floors = std::atoi(value);
+            else if (std::strcmp(arg, "--rounds") == 0) options.rounds = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.cars > 0 && options.calls > 0 && options.floors > 1 && options.rounds > 0;
+    }
+
+    int randomFloor(std::mt19937& random, int floors) {
+        return std::uniform_int_distribution<int>(1, floors)(random);
+    }
+
+    // 各电梯载上几名乘客后运行一段随机时间，分散在不同楼层和运行方向上；
+    // 乘客都放在 pool 中，与候梯队列共用
+    std::vector<Elevator> scatterElevators(const Options& options, std::mt19937& random, PassengerPool& pool) {
+        std::vector<Elevator> elevators(options.cars, Elevator(ElevatorConfig::MAX_CAPACITY));
+        for (auto& elevator : elevators) {
+            elevator.setPassengerPool(pool);
+            int riders = std::uniform_int_distribution<int>(0, 4)(random);
+            for (int i = 0; i < riders; ++i) {
+                int target = randomFloor(random, options.floors);
+                elevator.addPassenger(Passenger(1, target == 1 ? 2 : target));
+            }
+            double runTime = std::uniform_real_distribution<double>(0.0, 60.0)(random);
+            for (double t = 0; t < runTime; t += 0.5) {
+                elevator.update(0.5);
+            }
+        }
+        return elevators;
+    }
+
+    double percentile(std::vector<double> samples, double p) {
+        std::sort(samples.begin(), samples.end());
+        return samples[static_cast<size_t>(p / 100.0 * (samples.size() - 1))];
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_assignment_benchmark [--cars N] [--calls N] [--floors N] "
+                     "[--rounds N] [--seed N]" << std::endl;
+        return 1;
+    }
+    ElevatorConfig::FLOOR_COUNT = options.floors;
+    
+    std::mt19937 random(options.seed);
+    std::vector<double> firstCycle, reoptimize;
+    long long assigned = 0, reassigned = 0;
+    BatchDispatcher dispatcher;
+    DispatchWeights weights;
+    std::vector<BatchDispatcher::Assignment> newlyAssigned;
+    
+    for (int round = 0; round < options.rounds; ++round) {
+        PassengerPool pool;
+        std::vector<Elevator> elevators = scatterElevators(options, random, pool);
+        std::vector<PassengerPool::List> waiting(options.floors + 1);
+        for (int i = 0; i < options.calls; ++i) {
+            int from = randomFloor(random, options.floors);
+            int to = randomFloor(random, options.floors - 1);
+            pool.pushBack(waiting[from], pool.acquire(Passenger(from, to >= from ? to + 1 : to)));
+        }
+        
+        // 第一个周期指派全部新乘客，第二个周期电梯各走一步后重新优化全部已有分配
+        auto begin = std::chrono::steady_clock::now();
+        dispatcher.dispatch(elevators, pool, waiting, weights, newlyAssigned);
+        auto end = std::chrono::steady_clock::now();
+        firstCycle.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+        assigned += newlyAssigned.size();
+        
+        for (auto& elevator : elevators) {
+            elevator.update(0.5);
+        }
+        long long before = dispatcher.getStatistics().reassignments;
+        begin = std::chrono::steady_clock::now();
+        dispatcher.dispatch(elevators, pool, waiting, weights, newlyAssigned);
+        end = std::chrono::steady_clock::now();
+        reoptimize.push_back(std::chrono::duration<double, std::milli>(end - begin).count());
+        reassigned += dispatcher.getStatistics().reassignments - before;
+    }
+    
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 批量指派基准 ===" << std::endl;
+    std::cout << "电梯: " << options.cars << "  候梯乘客: " << options.calls
+              << "  楼层: " << options.floors << "  轮数: " << options.rounds << std::endl;
+    std::cout << "平均分到电梯: " << static_cast<double>(assigned) / options.rounds
+              << " 人  重新优化平均改派: " << static_cast<double>(reassigned) / options.rounds
+              << " 人" << std::endl;
+    std::cout << "新乘客周期: 中位 " << percentile(firstCycle, 50) << " ms  最长 "
+              << percentile(firstCycle, 100) << " ms" << std::endl;
+    std::cout << "重新优化周期: 中位 " << percentile(reoptimize, 50) << " ms  最长 "
+              << percentile(reoptimize, 100) << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,186 @@
+// 多天日历模拟基准：按日历连续运行若干天（默认一年），工作日、周末和节假日用各自的客流曲线，
+// 维护状态跨天延续并在夜间维护，报告耗时、按天类型的汇总指标和常驻内存（第7天与结束时对比，
+// 确认内存不随天数增长）。--csv 把每天一行的指标写入文件
+//
+// 用法: elevator_calendar_benchmark [--days N] [--dt 秒] [--seed N]
+//                                   [--strategy nearest|balanced|energy|batch] [--faults 0|1] [--fault-scale 倍数]
+//                                   [--calendar 文件] [--weekday 文件] [--weekend 文件] [--holiday 文件]
+//                                   [--csv 文件] [--record 文件]
+// 不给 --calendar 时从星期一开始、没有节假日；客流曲线文件格式同 --profile
+#include "multi_day_simulation.h"
+#include "config.h"
+#include "logger.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    struct Options {
+        int days = 365;
+        double deltaTime = 0.5;
+        unsigned int seed = 42;
+        Dispatcher::Strategy strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        bool faults = false;
+        double faultScale = 1.0;  // 故障率倍数，放大后便于观察降级运行
+        std::string calendar;
+        std::string profiles[Calendar::DAY_TYPE_COUNT];  // 按天类型，空表示默认曲线
+        std::string csv;
+        std::string record;
+    };
+
+    bool parseStrategy(const char* name, Dispatcher::Strategy& strategy) {
+        if (std::strcmp(name, "nearest") == 0) strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        else if (std::strcmp(name, "balanced") == 0) strategy = Dispatcher::Strategy::LOAD_BALANCED;
+        else if (std::strcmp(name, "energy") == 0) strategy = Dispatcher::Strategy::ENERGY_SAVING;
+        else if (std::strcmp(name, "batch") == 0) strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        else return false;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--days") == 0) options.days = std::atoi(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--faults") == 0) options.faults = std::atoi(value) != 0;
+            else if (std::strcmp(arg, "--fault-scale") == 0) options.faultScale = std::atof(value);
+            else if (std::strcmp(arg, "--calendar") == 0) options.calendar = value;
+            else if (std::strcmp(arg, "--weekday") == 0) options.profiles[0] = value;
+            else if (std::strcmp(arg, "--weekend") == 0) options.profiles[1] = value;
+            else if (std::strcmp(arg, "--holiday") == 0) options.profiles[2] = value;
+            else if (std::strcmp(arg, "--csv") == 0) options.csv = value;
+            else if (std::strcmp(arg, "--record") == 0) options.record = value;
+            else if (std::strcmp(arg, "--strategy") == 0) {
+                if (!parseStrategy(value, options.strategy)) {
+                    std::cerr << "未知调度策略: " << value << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.days > 0 && options.deltaTime > 0;
+    }
+
+    // 当前常驻内存（KiB），读不到 /proc 时为0
+    long readResidentKiB() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0) {
+                std::istringstream fields(line.substr(6));
+                long kib = 0;
+                fields >> kib;
+                return kib;
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_calendar_benchmark [--days N] [--dt 秒] [--seed N] "
+                     "[--strategy nearest|balanced|energy|batch] [--faults 0|1] [--fault-scale 倍数] [--calendar 文件] "
+                     "[--weekday 文件] [--weekend 文件] [--holiday 文件] [--csv 文件] [--record 文件]"
+                  << std::endl;
+        return 1;
+    }
+    Logger::setThreadEnabled(false);
+    Utils::seedRandom(options.seed);
+
+    SimulationEngine engine;
+    engine.getBuilding().setRecordingEnabled(false);
+    engine.getBuilding().setDispatchStrategy(options.strategy);
+    engine.getBuilding().getMaintenanceManager().setEnabled(options.faults);
+    engine.getBuilding().getMaintenanceManager().setFaultRateScale(options.faultScale);
+
+    MultiDaySimulation simulation(engine);
+    if (!options.calendar.empty()) {
+        Calendar calendar;
+        if (!calendar.loadFromFile(options.calendar)) {
+            std::cerr << "无法加载日历: " << calendar.getLastError() << std::endl;
+            return 1;
+        }
+        simulation.setCalendar(calendar);
+    }
+    for (int i = 0; i < Calendar::DAY_TYPE_COUNT; ++i) {
+        if (options.profiles[i].empty()) continue;
+        DemandProfile profile(ElevatorConfig::FLOOR_COUNT);
+        if (!profile.loadFromFile(options.profiles[i])) {
+            std::cerr << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+            return 1;
+        }
+        simulation.setProfile(static_cast<Calendar::DayType>(i), profile);
+    }
+    MultiDaySimulation::Settings settings;
+    settings.days = options.days;
+    settings.deltaTime = options.deltaTime;
+    simulation.setSettings(settings);
+
+    std::ofstream csv;
+    if (!options.csv.empty()) {
+        csv.open(options.csv, std::ios::trunc);
+        if (!csv.is_open()) {
+            std::cerr << "无法创建文件: " << options.csv << std::endl;
+            return 1;
+        }
+        DailyKpi::writeCsvHeader(csv);
+    }
+    if (!options.record.empty() && !engine.startRecording(options.record)) {
+        std::cerr << "无法创建输入日志: " << options.record << std::endl;
+        return 1;
+    }
+
+    long weekResident = 0;
+    auto begin = std::chrono::steady_clock::now();
+    simulation.run([&](const DailyKpi& kpi) {
+        if (csv.is_open()) {
+            kpi.writeCsvRow(csv);
+        }
+        if (kpi.day == 6) {
+            weekResident = readResidentKiB();
+        }
+    });
+    engine.stopRecording();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    long endResident = readResidentKiB();
+
+    long long steps = simulation.getTotalSteps();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 多天日历模拟基准 ===" << std::endl;
+    std::cout << "调度策略: " << Dispatcher::getStrategyName(options.strategy) << "  故障与维护: "
+              << (options.faults ? "开" : "关");
+    if (options.faults) {
+        std::cout << "  故障率倍数: " << options.faultScale;
+    }
+    std::cout << std::endl;
+    std::cout << "模拟天数: " << options.days << "  第1天: "
+              << Calendar::getWeekdayName(simulation.getCalendar().getFirstWeekday())
+              << "  步长: " << options.deltaTime << "s  种子: " << options.seed << std::endl;
+    std::cout << "总步数: " << steps << std::endl;
+    std::cout << "耗时: " << seconds << " s  每天 " << seconds / options.days << " s" << std::endl;
+    std::cout << "每步耗时: " << (steps > 0 ? seconds * 1e6 / steps : 0.0) << " us" << std::endl;
+    std::cout << "加速比: " << std::setprecision(0)
+              << (seconds > 0 ? engine.getDayLength() * options.days / seconds : 0.0) << "x" << std::endl;
+    std::cout << "常驻内存: 第7天 " << std::setprecision(1) << weekResident / 1024.0 << " MiB  结束 "
+              << endResident / 1024.0 << " MiB" << std::endl;
+    std::cout << simulation.getRollup().getReport();
+    return 0;
+}
@@ -0,0 +1,205 @@
+// 调度代价内核基准：在随机状态的电梯组上对大量请求求代价最小的电梯，比较
+// 原先逐部电梯经访问器的计算、CarBank 上的标量内核和 AVX2 内核的单次决策耗时，
+// 并核对三者选出的电梯完全相同（另测部分电梯停止服务时标量与 AVX2 一致）
+//
+// 用法: elevator_cost_kernel_benchmark [--cars N] [--floors N] [--requests N] [--seed N]
+// 不给 --cars 时依次测 8、32、64 部
+#include "cost_kernels.h"
+#include "dispatch_weights.h"
+#include "config.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        int cars = 0;
+        int floors = 60;
+        int requests = 200000;
+        unsigned int seed = 42;
+    };
+
+    enum class Strategy { NEAREST, BALANCED, ENERGY };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--cars") == 0) options.cars = std::atoi(value);
+            else if (std::strcmp(arg, "--floors") == 0) options.floors = std::atoi(value);
+            else if (std::strcmp(arg, "--requests") == 0) options.requests = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.cars >= 0 && options.floors >= 2 && options.requests > 0;
+    }
+
+    // 给每部电梯分配随机的乘客并运行一段随机时间，得到分散的楼层、方向和载客
+    std::vector<Elevator> createElevators(int count, int floors, std::mt19937& random) {
+        std::uniform_int_distribution<int> floor(1, floors);
+        std::uniform_int_distribution<int> passengers(0, 12);
+        std::uniform_int_distribution<int> steps(0, 400);
+        std::vector<Elevator> elevators(count, Elevator(12, floors));
+        for (auto& elevator : elevators) {
+            for (int n = passengers(random); n > 0; --n) {
+                int from = floor(random), to = floor(random);
+                if (from != to) elevator.addPassenger(Passenger(from, to));
+            }
+            for (int n = steps(random); n > 0; --n) {
+                elevator.update(0.5);
+            }
+        }
+        return elevators;
+    }
+
+    // 原先 Dispatcher 中逐部电梯经访问器的计算，作为对照
+    int accessorCost(const std::vector<Elevator>& elevators, int floor, Strategy strategy,
+                     const DispatchWeights& weights) {
+        int best = -1;
+        double bestCost = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < elevators.size(); ++i) {
+            const auto& elevator = elevators[i];
+            if (elevator.getCommittedLoad() >= elevator.getCapacity()) {
+                continue;
+            }
+            double distance = std::abs(elevator.getCurrentFloor() - floor);
+            double cost = distance;
+            if (strategy == Strategy::BALANCED) {
+                cost = (double)elevator.getCommittedLoad() / elevator.getCapacity() +
+                       distance * weights.loadDistanceWeight;
+            } else if (strategy == Strategy::ENERGY && elevator.getState() == ElevatorState::IDLE) {
+                cost *= weights.idleStartFactor;
+            }
+            if (cost < bestCost) {
+                bestCost = cost;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+
+    int kernelCost(const CarBank& cars, int floor, Strategy strategy, const DispatchWeights& weights) {
+        switch (strategy) {
+            case Strategy::NEAREST: return CostKernels::nearest(cars, floor);
+            case Strategy::BALANCED: return CostKernels::loadBalanced(cars, floor, weights.loadDistanceWeight);
+            case Strategy::ENERGY: return CostKernels::energySaving(cars, floor, weights.idleStartFactor);
+        }
+        return -1;
+    }
+
+    template <typename Function>
+    double measure(const std::vector<int>& requests, std::vector<int>& choices, Function function) {
+        choices.resize(requests.size());
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < requests.size(); ++i) {
+            choices[i] = function(requests[i]);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds * 1e9 / requests.size();
+    }
+
+    bool benchmark(const Options& options, int carCount) {
+        std::mt19937 random(options.seed + carCount);
+        std::vector<Elevator> elevators = createElevators(carCount, options.floors, random);
+        std::uniform_int_distribution<int> floor(1, options.floors);
+        std::vector<int> requests(options.requests);
+        for (int& request : requests) {
+            request = floor(random);
+        }
+
+        DispatchWeights weights;
+        CarBank cars;
+        cars.load(elevators);
+        CarBank masked = cars;
+        for (size_t i = 0; i < masked.size(); i += 5) {
+            masked.setInService(i, false);
+        }
+
+        std::cout << carCount << " 部电梯 × " << options.floors << " 层  " << requests.size()
+                  << " 次决策（ns/次）" << std::endl;
+        const char* names[] = {"最近优先", "负载均衡", "节能模式"};
+        bool allMatch = true;
+        for (Strategy strategy : {Strategy::NEAREST, Strategy::BALANCED, Strategy::ENERGY}) {
+            std::vector<int> accessor, scalar, avx2, maskedScalar, maskedAvx2;
+            double accessorNs = measure(requests, accessor, [&](int request) {
+                return accessorCost(elevators, request, strategy, weights);
+            });
+            CostKernels::setIsa(CostKernels::Isa::SCALAR);
+            double scalarNs = measure(requests, scalar, [&](int request) {
+                return kernelCost(cars, request, strategy, weights);
+            });
+            measure(requests, maskedScalar, [&](int request) {
+                return kernelCost(masked, request, strategy, weights);
+            });
+
+            bool hasAvx2 = CostKernels::setIsa(CostKernels::Isa::AVX2);
+            double avx2Ns = 0.0;
+            if (hasAvx2) {
+                avx2Ns = measure(requests, avx2, [&](int request) {
+                    return kernelCost(cars, request, strategy, weights);
+                });
+                measure(requests, maskedAvx2, [&](int request) {
+                    return kernelCost(masked, request, strategy, weights);
+                });
+            }
+
+            bool matches = accessor == scalar && (!hasAvx2 || (scalar == avx2 && maskedScalar == maskedAvx2));
+            allMatch = allMatch && matches;
+            std::cout << "  " << names[static_cast<int>(strategy)] << ": 访问器 " << std::setprecision(1)
+                      << accessorNs << "  标量SoA " << scalarNs;
+            if (hasAvx2) {
+                std::cout << "  AVX2 " << avx2Ns << "（相对访问器 " << std::setprecision(2)
+                          << accessorNs / avx2Ns << " 倍）";
+            } else {
+                std::cout << "  AVX2 不可用";
+            }
+            std::cout << "  选择一致: " << (matches ? "是" : "否") << std::endl;
+        }
+        CostKernels::setIsa(CostKernels::isSupported(CostKernels::Isa::AVX2) ? CostKernels::Isa::AVX2
+                                                                              : CostKernels::Isa::SCALAR);
+        return allMatch;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_cost_kernel_benchmark [--cars N] [--floors N] [--requests N] [--seed N]"
+                  << std::endl;
+        return 1;
+    }
+    Logger::setThreadEnabled(false);
+
+    std::vector<int> carCounts;
+    if (options.cars > 0) {
+        carCounts.push_back(options.cars);
+    } else {
+        carCounts = {8, 32, 64};
+    }
+
+    std::cout << std::fixed;
+    std::cout << "=== 调度代价内核基准 ===" << std::endl;
+    std::cout << "当前指令集: " << CostKernels::getIsaName(CostKernels::getIsa()) << std::endl;
+    bool allMatch = true;
+    for (int carCount : carCounts) {
+        allMatch = benchmark(options, carCount) && allMatch;
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+// 降级运行基准：同一客流下分别停用0、1、2……部电梯，报告各调度策略的等待时间，
+// 得到服务水平随停运电梯数下降的曲线。停用从 --down-at 秒起生效（默认一开始就停用），
+// 设在高峰中途时，已分配给停用电梯、尚未上梯的乘客会被改派；轿厢内的乘客在下一层下梯后
+// 重新候梯（计入"滞留"），等待时间按两段累计计入统计，可以观察改派的代价。
+// 故障与维护模拟关闭，停用的电梯用人工停用，结果只取决于停运数量
+//
+// 用法: elevator_degradation_benchmark [--days N] [--dt 秒] [--seed N] [--max-down N]
+//                                      [--down-at 秒] [--strategy all|nearest|balanced|energy|rollout|batch]
+//                                      [--profile office|文件]
+#include "simulation_engine.h"
+#include "config.h"
+#include "kpi_rollup.h"
+#include "logger.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        int days = 1;
+        double deltaTime = 0.5;
+        unsigned int seed = 42;
+        int maxDown = 2;
+        double downAt = 0.0;
+        std::vector<Dispatcher::Strategy> strategies = {
+            Dispatcher::Strategy::NEAREST_FIRST, Dispatcher::Strategy::LOAD_BALANCED,
+            Dispatcher::Strategy::ENERGY_SAVING, Dispatcher::Strategy::BATCH_OPTIMAL
+        };
+        std::string profile = "office";
+    };
+
+    struct Result {
+        long long requested = 0;
+        long long boarded = 0;
+        long long timedOut = 0;
+        long long stranded = 0;
+        double totalWait = 0.0;
+        double maxWait = 0.0;
+        WaitHistogram waits;
+    };
+
+    bool parseStrategy(const char* name, Dispatcher::Strategy& strategy) {
+        if (std::strcmp(name, "nearest") == 0) strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        else if (std::strcmp(name, "balanced") == 0) strategy = Dispatcher::Strategy::LOAD_BALANCED;
+        else if (std::strcmp(name, "energy") == 0) strategy = Dispatcher::Strategy::ENERGY_SAVING;
+        else if (std::strcmp(name, "rollout") == 0) strategy = Dispatcher::Strategy::ROLLOUT;
+        else if (std::strcmp(name, "batch") == 0) strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        else return false;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--days") == 0) options.days = std::atoi(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--max-down") == 0) options.maxDown = std::atoi(value);
+            else if (std::strcmp(arg, "--down-at") == 0) options.downAt = std::atof(value);
+            else if (std::strcmp(arg, "--profile") == 0) options.profile = value;
+            else if (std::strcmp(arg, "--strategy") == 0) {
+                Dispatcher::Strategy strategy;
+                if (std::strcmp(value, "all") != 0) {
+                    if (!parseStrategy(value, strategy)) {
+                        std::cerr << "未知调度策略: " << value << std::endl;
+                        return false;
+                    }
+                    options.strategies = {strategy};
+                }
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.days > 0 && options.deltaTime > 0 && options.maxDown >= 0 && options.downAt >= 0;
+    }
+
+    // 从头运行 days 天，编号最大的 down 部电梯在第一天 downAt 秒起停用到结束
+    Result run(const Options& options, const DemandProfile& profile, Dispatcher::Strategy strategy, int down) {
+        Utils::seedRandom(options.seed);  // 各轮客流相同
+        SimulationEngine engine;
+        engine.getBuilding().setRecordingEnabled(false);
+        engine.getBuilding().setDispatchStrategy(strategy);
+        engine.getBuilding().getMaintenanceManager().setEnabled(false);
+        RolloutDispatcher::Settings rollout = engine.getBuilding().getRolloutDispatcher().getSettings();
+        rollout.budgetMs = 0;  // 结果不受机器快慢影响
+        engine.getBuilding().getRolloutDispatcher().setSettings(rollout);
+        engine.setDemandProfile(profile);
+
+        Result result;
+        int elevatorCount = static_cast<int>(engine.getBuilding().getElevators().size());
+        for (int day = 0; day < options.days; ++day) {
+            double remaining = engine.getDayLength();
+            if (day == 0) {
+                engine.start();
+                double before = std::min(options.downAt, remaining);
+                engine.advance(before, options.deltaTime);
+                remaining -= before;
+                for (int i = 0; i < down && i < elevatorCount; ++i) {
+                    engine.setElevatorLockedOut(elevatorCount - 1 - i, true);
+                }
+            } else {
+                engine.startNextDay();
+            }
+            engine.advance(remaining, options.deltaTime);
+
+            const auto& metrics = engine.getMetrics();
+            result.requested += metrics.getRequestedPassengers();
+            result.boarded += metrics.getBoardedPassengers();
+            result.timedOut += metrics.getTimedOutPassengers();
+            result.stranded += metrics.getStrandedPassengers();
+            result.totalWait += metrics.getAverageWaitTime() * metrics.getBoardedPassengers();
+            result.maxWait = std::max(result.maxWait, metrics.getMaxWaitTime());
+            for (double wait : metrics.getWaitSamples()) {
+                result.waits.add(wait);
+            }
+        }
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_degradation_benchmark [--days N] [--dt 秒] [--seed N] [--max-down N] "
+                     "[--down-at 秒] [--strategy all|nearest|balanced|energy|rollout|batch] "
+                     "[--profile office|文件]" << std::endl;
+        return 1;
+    }
+    Logger::setThreadEnabled(false);
+
+    DemandProfile profile = DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT);
+    if (options.profile != "office" && !profile.loadFromFile(options.profile)) {
+        std::cerr << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+        return 1;
+    }
+    int maxDown = std::min(options.maxDown, ElevatorConfig::ELEVATOR_COUNT - 1);  // 至少留一部
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=== 降级运行基准 ===" << std::endl;
+    std::cout << "客流: " << options.profile << "  模拟天数: " << options.days << "  步长: "
+              << options.deltaTime << "s  种子: " << options.seed << std::endl;
+    std::cout << "电梯数: " << ElevatorConfig::ELEVATOR_COUNT << "  停用时刻: " << options.downAt << "s" << std::endl;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (Dispatcher::Strategy strategy : options.strategies) {
+        std::cout << "\n调度策略: " << Dispatcher::getStrategyName(strategy) << std::endl;
+        std::cout << "停用  在用      请求      超时      滞留   平均等待   P95等待   最长等待   P95倍数" << std::endl;
+        double baseline = 0.0;
+        for (int down = 0; down <= maxDown; ++down) {
+            Result result = run(options, profile, strategy, down);
+            double p95 = result.waits.getPercentile(95);
+            if (down == 0) {
+                baseline = p95;
+            }
+            std::cout << std::setw(4) << down
+                      << std::setw(6) << ElevatorConfig::ELEVATOR_COUNT - down
+                      << std::setw(10) << result.requested
+                      << std::setw(10) << result.timedOut
+                      << std::setw(10) << result.stranded
+                      << std::setw(11) << (result.boarded > 0 ? result.totalWait / result.boarded : 0.0)
+                      << std::setw(10) << p95
+                      << std::setw(11) << result.maxWait
+                      << std::setw(10) << std::setprecision(2) << (baseline > 0 ? p95 / baseline : 0.0)
+                      << std::setprecision(1) << std::endl;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "\n耗时: " << std::setprecision(3) << seconds << " s" << std::endl;
+    return 0;
+}
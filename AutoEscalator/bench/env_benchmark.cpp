@@ -0,0 +1,162 @@
+// 强化学习环境基准：用随机动作驱动单个 DispatchEnv 和 N 个环境的 DispatchVectorEnv，
+// 报告每秒推进的环境步数（每步为 decisionInterval 的模拟时长），并核对并行环境与
+// 单个环境在相同种子、相同动作下的观测和奖励逐位一致
+//
+// 用法: elevator_env_benchmark [--envs N] [--threads N] [--steps N] [--seed N]
+//                              [--interval 秒] [--dt 秒]
+#include "dispatch_env.h"
+#include "logger.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Options {
+        int envs = 16;
+        int threads = 0;  // 0 表示按硬件线程数
+        int steps = 2000;
+        unsigned int seed = 42;
+        DispatchEnv::Config config;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--envs") == 0) options.envs = std::atoi(value);
+            else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--steps") == 0) options.steps = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--interval") == 0) options.config.decisionInterval = std::atof(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.config.timeStep = std::atof(value);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.envs > 0 && options.threads >= 0 && options.steps > 0 &&
+               options.config.decisionInterval > 0 && options.config.timeStep > 0;
+    }
+    
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+    
+    // 每层随机选一部电梯，约三分之一的层本步不分配
+    void randomActions(std::mt19937& random, int elevatorCount, std::vector<int>& actions) {
+        std::uniform_int_distribution<int> pick(-elevatorCount / 2, elevatorCount - 1);
+        for (auto& action : actions) {
+            action = pick(random);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_env_benchmark [--envs N] [--threads N] [--steps N] [--seed N] "
+                     "[--interval 秒] [--dt 秒]" << std::endl;
+        return 1;
+    }
+    
+    Logger::setThreadEnabled(false);
+    Utils::seedRandom(options.seed);
+    
+    auto begin = std::chrono::steady_clock::now();
+    DispatchVectorEnv vectorEnv(options.envs, options.config, options.threads);
+    double setupSeconds = secondsSince(begin);
+    
+    int observationSize = vectorEnv.getObservationSize();
+    int actionCount = vectorEnv.getActionCount();
+    int elevatorCount = static_cast<int>(ElevatorConfig::ELEVATOR_COUNT);
+    
+    // 单个环境：与并行环境中的第 0 个使用相同的起始状态、种子和动作
+    Utils::seedRandom(options.seed);
+    DispatchEnv single(options.config);
+    std::vector<float> singleObservation(observationSize);
+    std::vector<int> singleActions(actionCount);
+    std::mt19937 singleRandom(options.seed);
+    single.reset(options.seed, singleObservation.data());
+    
+    double singleReward = 0.0;
+    int singleEpisodes = 0;
+    unsigned int singleSeed = options.seed;
+    std::vector<std::vector<float>> singleTrace;
+    std::vector<float> singleRewards;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.steps; ++i) {
+        randomActions(singleRandom, elevatorCount, singleActions);
+        DispatchEnv::StepResult result = single.step(singleActions.data(), singleObservation.data());
+        singleReward += result.reward;
+        singleRewards.push_back(result.reward);
+        if (result.done) {
+            ++singleEpisodes;
+            singleSeed += static_cast<unsigned int>(options.envs);
+            single.reset(singleSeed, singleObservation.data());
+        }
+        singleTrace.push_back(singleObservation);
+    }
+    double singleSeconds = secondsSince(begin);
+    
+    // 并行环境：第 0 个环境复用单环境的动作序列，其余环境各自随机
+    std::vector<float> observations(static_cast<size_t>(options.envs) * observationSize);
+    std::vector<int> actions(static_cast<size_t>(options.envs) * actionCount);
+    std::vector<float> rewards(options.envs);
+    std::vector<uint8_t> dones(options.envs);
+    std::vector<int> envActions(actionCount);
+    std::mt19937 firstRandom(options.seed);
+    std::mt19937 otherRandom(options.seed + 1);
+    vectorEnv.reset(options.seed, observations.data());
+    
+    double totalReward = 0.0;
+    int episodes = 0;
+    bool matches = true;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.steps; ++i) {
+        for (int env = 0; env < options.envs; ++env) {
+            randomActions(env == 0 ? firstRandom : otherRandom, elevatorCount, envActions);
+            std::copy(envActions.begin(), envActions.end(), actions.begin() + env * actionCount);
+        }
+        vectorEnv.step(actions.data(), observations.data(), rewards.data(), dones.data());
+        for (int env = 0; env < options.envs; ++env) {
+            totalReward += rewards[env];
+            episodes += dones[env];
+        }
+        matches = matches && rewards[0] == singleRewards[i] &&
+                  std::equal(singleTrace[i].begin(), singleTrace[i].end(), observations.begin());
+    }
+    double vectorSeconds = secondsSince(begin);
+    
+    double simulatedPerStep = options.config.decisionInterval;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 调度环境基准 ===" << std::endl;
+    std::cout << "观测长度: " << observationSize << "  动作数: " << actionCount
+              << "  每步模拟 " << simulatedPerStep << " s（步长 " << options.config.timeStep << " s）"
+              << std::endl;
+    std::cout << "起始状态: " << setupSeconds * 1e3 << " ms" << std::endl;
+    std::cout << "单个环境: " << options.steps << " 步  " << singleSeconds << " s  "
+              << std::setprecision(0) << options.steps / singleSeconds << " 步/s"
+              << std::setprecision(3) << "  完成回合 " << singleEpisodes
+              << "  平均每步奖励 " << singleReward / options.steps << std::endl;
+    
+    double vectorRate = static_cast<double>(options.steps) * options.envs / vectorSeconds;
+    std::cout << "并行环境: " << options.envs << " 个 × " << options.steps << " 步  "
+              << vectorSeconds << " s  " << std::setprecision(0) << vectorRate << " 步/s"
+              << std::setprecision(2) << "（单环境的 " << vectorRate * singleSeconds / options.steps
+              << " 倍）" << std::setprecision(3) << "  完成回合 " << episodes
+              << "  平均每步奖励 " << totalReward / (static_cast<double>(options.steps) * options.envs)
+              << std::endl;
+    std::cout << "第0个环境与单个环境一致: " << (matches ? "是" : "否") << std::endl;
+    return matches ? 0 : 1;
+}
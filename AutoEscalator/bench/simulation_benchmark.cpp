@@ -0,0 +1,270 @@
+// 无界面模拟基准：以固定步长跑完若干天，输出吞吐量和服务指标
+//
+// 用法: elevator_benchmark [--days N] [--dt 秒] [--seed N]
+//                          [--strategy nearest|balanced|energy|rollout|batch] [--peak-requests N]
+//                          [--faults 0|1] [--profile office|文件] [--runlog 文件]
+//                          [--record 文件] [--replay 文件]
+//                          [--rollout-horizon 秒] [--rollout-budget 毫秒] [--rollout-threads N]
+//                          [--weights 文件] [--parking lobby|predictive]
+//
+// --record 把全部输入写入输入日志，--replay 按日志重放（忽略其余模拟参数）；
+// 两者输出的结果校验值相同，可用来确认不同构建的模拟结果逐位一致。
+// 前瞻推演的结果受决策时间预算影响，需要复现时用 --rollout-budget 0；
+// 推演用的预期客流不在输入日志里，重放时要给出同样的 --profile。
+// 需求模型跨天学习，多天运行时从第二天起按预测停靠（--parking lobby 关闭），
+// 另外单独报告最后一天的平均等待；停靠方式同样不在输入日志里
+#include "simulation_engine.h"
+#include "config.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+    struct Options {
+        int days = 1;
+        double deltaTime = 0.1;
+        unsigned int seed = 42;
+        Dispatcher::Strategy strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        int peakRequests = ElevatorConfig::DEFAULT_REQUEST_COUNT;
+        bool faults = false;  // 随机故障会让电梯长期停运，默认只测调度和运行
+        std::string profile;  // 客流需求曲线，空表示默认的上下班高峰
+        std::string runLog;   // 二进制运行日志，空表示不写
+        std::string record;   // 输入日志
+        std::string replay;
+        RolloutDispatcher::Settings rollout;  // 前瞻推演策略的参数
+        std::string weights;  // 调度权重文件，空表示默认权重
+        bool predictiveParking = true;
+    };
+    
+    // 对每轮模拟的结果做 FNV-1a 校验，浮点数按位参与
+    class ResultDigest {
+    private:
+        uint64_t hash = 1469598103934665603ULL;
+        
+        void mix(const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+        }
+        
+    public:
+        void add(long long value) { mix(&value, sizeof(value)); }
+        void add(double value) { mix(&value, sizeof(value)); }
+        uint64_t get() const { return hash; }
+    };
+
+    bool parseStrategy(const std::string& name, Dispatcher::Strategy& strategy) {
+        if (name == "nearest") strategy = Dispatcher::Strategy::NEAREST_FIRST;
+        else if (name == "balanced") strategy = Dispatcher::Strategy::LOAD_BALANCED;
+        else if (name == "energy") strategy = Dispatcher::Strategy::ENERGY_SAVING;
+        else if (name == "rollout") strategy = Dispatcher::Strategy::ROLLOUT;
+        else if (name == "batch") strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        else return false;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--days") == 0) options.days = std::atoi(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--peak-requests") == 0) options.peakRequests = std::atoi(value);
+            else if (std::strcmp(arg, "--faults") == 0) options.faults = std::atoi(value) != 0;
+            else if (std::strcmp(arg, "--profile") == 0) options.profile = value;
+            else if (std::strcmp(arg, "--runlog") == 0) options.runLog = value;
+            else if (std::strcmp(arg, "--record") == 0) options.record = value;
+            else if (std::strcmp(arg, "--replay") == 0) options.replay = value;
+            else if (std::strcmp(arg, "--rollout-horizon") == 0) options.rollout.horizon = std::atof(value);
+            else if (std::strcmp(arg, "--rollout-budget") == 0) options.rollout.budgetMs = std::atof(value);
+            else if (std::strcmp(arg, "--rollout-threads") == 0) options.rollout.threadCount = std::atoi(value);
+            else if (std::strcmp(arg, "--weights") == 0) options.weights = value;
+            else if (std::strcmp(arg, "--parking") == 0) {
+                if (std::strcmp(value, "lobby") == 0) options.predictiveParking = false;
+                else if (std::strcmp(value, "predictive") == 0) options.predictiveParking = true;
+                else {
+                    std::cerr << "未知停靠方式: " << value << std::endl;
+                    return false;
+                }
+            }
+            else if (std::strcmp(arg, "--strategy") == 0) {
+                if (!parseStrategy(value, options.strategy)) {
+                    std::cerr << "未知调度策略: " << value << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.days > 0 && options.deltaTime > 0 && options.peakRequests > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_benchmark [--days N] [--dt 秒] [--seed N] "
+                     "[--strategy nearest|balanced|energy|rollout|batch] [--peak-requests N] [--faults 0|1] "
+                     "[--profile office|文件] [--runlog 文件] [--record 文件] [--replay 文件] "
+                     "[--rollout-horizon 秒] [--rollout-budget 毫秒] [--rollout-threads N] "
+                     "[--weights 文件] [--parking lobby|predictive]" << std::endl;
+        return 1;
+    }
+
+    Utils::seedRandom(options.seed);
+    ElevatorConfig::DEFAULT_REQUEST_COUNT = options.peakRequests;
+
+    SimulationEngine engine;
+    engine.getBuilding().setRecordingEnabled(false);  // 基准只关心模拟本身
+    engine.getBuilding().setDispatchStrategy(options.strategy);
+    engine.getBuilding().getRolloutDispatcher().setSettings(options.rollout);
+    if (!options.weights.empty()) {
+        DispatchWeights weights;
+        std::string error;
+        if (!weights.loadFromFile(options.weights, &error)) {
+            std::cerr << "无法加载调度权重: " << error << std::endl;
+            return 1;
+        }
+        engine.setDispatchWeights(weights);
+    }
+    engine.getBuilding().getMaintenanceManager().setEnabled(options.faults);
+    ParkingPolicy::Settings parking = engine.getBuilding().getParkingPolicy().getSettings();
+    parking.enabled = options.predictiveParking;
+    engine.getBuilding().getParkingPolicy().setSettings(parking);
+    
+    if (!options.profile.empty()) {
+        DemandProfile profile = DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT);
+        if (options.profile != "office" && !profile.loadFromFile(options.profile)) {
+            std::cerr << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+            return 1;
+        }
+        engine.setDemandProfile(profile);
+    }
+    
+    if (!options.runLog.empty() && !engine.getBuilding().startRunLog(options.runLog)) {
+        std::cerr << "无法创建运行日志: " << options.runLog << std::endl;
+        return 1;
+    }
+
+    if (!options.record.empty() && !engine.startRecording(options.record)) {
+        std::cerr << "无法创建输入日志: " << options.record << std::endl;
+        return 1;
+    }
+    if (!options.replay.empty() && !engine.openReplay(options.replay)) {
+        std::cerr << "无法重放输入日志: " << engine.getReplayError() << std::endl;
+        return 1;
+    }
+
+    long long totalSteps = 0;
+    int runs = 0;
+    int requested = 0, boarded = 0, delivered = 0, timedOut = 0;
+    double waitSum = 0.0, maxWait = 0.0, lastDayWait = 0.0;
+    ResultDigest digest;
+    
+    auto collect = [&]() {
+        const auto& metrics = engine.getMetrics();
+        ++runs;
+        requested += metrics.getRequestedPassengers();
+        boarded += metrics.getBoardedPassengers();
+        delivered += metrics.getDeliveredPassengers();
+        timedOut += metrics.getTimedOutPassengers();
+        waitSum += metrics.getAverageWaitTime() * metrics.getBoardedPassengers();
+        maxWait = std::max(maxWait, metrics.getMaxWaitTime());
+        lastDayWait = metrics.getAverageWaitTime();
+        
+        digest.add(static_cast<long long>(metrics.getRequestedPassengers()));
+        digest.add(static_cast<long long>(metrics.getBoardedPassengers()));
+        digest.add(static_cast<long long>(metrics.getDeliveredPassengers()));
+        digest.add(static_cast<long long>(metrics.getTimedOutPassengers()));
+        digest.add(metrics.getAverageWaitTime());
+        digest.add(metrics.getMaxWaitTime());
+        digest.add(engine.getBuilding().getEnergyManager().getTotalConsumption());
+        for (const auto& elevator : engine.getBuilding().getElevators()) {
+            digest.add(static_cast<long long>(elevator.getCurrentFloor()));
+            digest.add(static_cast<long long>(elevator.getDeliveredCount()));
+        }
+    };
+
+    auto begin = std::chrono::steady_clock::now();
+    if (!options.replay.empty()) {
+        while (engine.replayRun()) {
+            collect();
+        }
+        totalSteps = engine.getJournalSteps();
+        engine.closeReplay();
+    } else {
+        for (int day = 0; day < options.days; ++day) {
+            engine.start();
+            totalSteps += engine.advance(engine.getDayLength(), options.deltaTime);
+            collect();
+        }
+    }
+    engine.stopRecording();
+    engine.getBuilding().stopRunLog();  // 写出最后一块和索引，计入耗时
+    auto end = std::chrono::steady_clock::now();
+    
+    if (!engine.getReplayError().empty()) {
+        std::cerr << "重放中止: " << engine.getReplayError() << std::endl;
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    double simulated = engine.getDayLength() * runs;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 模拟基准 ===" << std::endl;
+    std::cout << "调度策略: " << Dispatcher::getStrategyName(engine.getBuilding().getDispatchStrategy()) << std::endl;
+    std::cout << "客流: " << (options.profile.empty() ? "上下班高峰" : options.profile) << std::endl;
+    std::cout << "模拟天数: " << runs << "  步长: " << options.deltaTime
+              << "s  种子: " << options.seed << std::endl;
+    std::cout << "总步数: " << totalSteps << std::endl;
+    std::cout << "耗时: " << seconds << " s" << std::endl;
+    std::cout << "每步耗时: " << (totalSteps > 0 ? seconds * 1e6 / totalSteps : 0.0) << " us" << std::endl;
+    std::cout << "加速比: " << std::setprecision(0) << (seconds > 0 ? simulated / seconds : 0.0)
+              << "x" << std::setprecision(3) << std::endl;
+    std::cout << "请求/上梯/送达/超时: " << requested << " / " << boarded << " / "
+              << delivered << " / " << timedOut << std::endl;
+    std::cout << "平均等待: " << (boarded > 0 ? waitSum / boarded : 0.0)
+              << " s  最长等待: " << maxWait << " s" << std::endl;
+    if (runs > 1) {
+        std::cout << "最后一天平均等待: " << lastDayWait << " s" << std::endl;
+    }
+    std::cout << "结果校验: " << std::hex << std::setw(16) << std::setfill('0') << digest.get()
+              << std::dec << std::setfill(' ') << std::endl;
+    if (engine.getBuilding().getDispatchStrategy() == Dispatcher::Strategy::ROLLOUT) {
+        const auto& rollout = engine.getBuilding().getRolloutDispatcher().getStatistics();
+        std::cout << "推演决策: " << rollout.decisions << "  推演次数: " << rollout.rollouts
+                  << "  超时改用估算: " << rollout.fallbacks << std::endl;
+        std::cout << "决策耗时: 平均 "
+                  << (rollout.decisions > 0 ? rollout.totalDecisionMs / rollout.decisions : 0.0)
+                  << " ms  最长 " << rollout.maxDecisionMs << " ms" << std::endl;
+    }
+    if (engine.getBuilding().getDispatchStrategy() == Dispatcher::Strategy::BATCH_OPTIMAL) {
+        const auto& batch = engine.getBuilding().getBatchDispatcher().getStatistics();
+        std::cout << "调度周期: " << batch.cycles << "  改派: " << batch.reassignments
+                  << "  单周期最多乘客: " << batch.maxCalls << std::endl;
+        std::cout << "求解耗时: 平均 " << (batch.cycles > 0 ? batch.totalSolveMs / batch.cycles : 0.0)
+                  << " ms  最长 " << batch.maxSolveMs << " ms" << std::endl;
+    }
+    if (!options.runLog.empty()) {
+        std::ifstream log(options.runLog, std::ios::binary | std::ios::ate);
+        std::cout << "运行日志: " << options.runLog << "  " << std::setprecision(1)
+                  << static_cast<double>(log.tellg()) / 1024.0 << " KiB" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+// 楼型特化基准：同一组预先生成的请求分别交给编译期特化的 BuildingT 和运行时大小的
+// DynamicBuilding（即按楼型构造的完整 Building），比较每步耗时，并核对两者的服务指标逐位一致
+//
+// 用法: elevator_topology_benchmark [--floors N --cars N [--capacity N]] [--hours 小时]
+//                                   [--dt 秒] [--rate 人/小时/层] [--repeat N] [--seed N]
+// 不给楼型时依次测 14×4 和 40×8
+#include "building_registry.h"
+#include "config.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        BuildingTopology topology{0, 0, 12};
+        double hours = 2.0;
+        double deltaTime = 0.1;
+        double rate = 20.0;  // 每层每小时到达人数
+        int repeat = 3;
+        unsigned int seed = 42;
+    };
+
+    struct Request {
+        long long step;
+        int fromFloor;
+        int toFloor;
+    };
+
+    struct Result {
+        double stepMicros = 0.0;  // 多次重复中最快一次的每步耗时
+        SimulationMetrics metrics;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--floors") == 0) options.topology.floors = std::atoi(value);
+            else if (std::strcmp(arg, "--cars") == 0) options.topology.elevators = std::atoi(value);
+            else if (std::strcmp(arg, "--capacity") == 0) options.topology.capacity = std::atoi(value);
+            else if (std::strcmp(arg, "--hours") == 0) options.hours = std::atof(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--rate") == 0) options.rate = std::atof(value);
+            else if (std::strcmp(arg, "--repeat") == 0) options.repeat = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        bool noTopology = options.topology.floors == 0 && options.topology.elevators == 0;
+        bool validTopology = options.topology.floors >= 2 && options.topology.elevators >= 1;
+        return (noTopology || validTopology) && options.topology.capacity >= 1 &&
+               options.hours > 0 && options.deltaTime > 0 && options.rate >= 0 && options.repeat > 0;
+    }
+
+    // 上行（从1楼出发）、下行（到1楼）和层间各占 4:4:2
+    std::vector<Request> generateRequests(const Options& options, int floors, long long steps) {
+        std::mt19937 random(options.seed);
+        std::poisson_distribution<int> arrivals(options.rate * floors / 3600.0 * options.deltaTime);
+        std::uniform_real_distribution<double> kind(0.0, 1.0);
+        std::uniform_int_distribution<int> upper(2, floors);
+        std::uniform_int_distribution<int> any(1, floors);
+
+        std::vector<Request> requests;
+        for (long long step = 0; step < steps; ++step) {
+            for (int n = arrivals(random); n > 0; --n) {
+                double k = kind(random);
+                Request request{step, 1, 1};
+                if (k < 0.4) {
+                    request.toFloor = upper(random);
+                } else if (k < 0.8) {
+                    request.fromFloor = upper(random);
+                } else {
+                    request.fromFloor = any(random);
+                    do {
+                        request.toFloor = any(random);
+                    } while (request.toFloor == request.fromFloor);
+                }
+                requests.push_back(request);
+            }
+        }
+        return requests;
+    }
+
+    template <typename Model, typename Create>
+    Result run(const Options& options, const std::vector<Request>& requests, long long steps, Create create) {
+        Result result;
+        result.stepMicros = 1e30;
+        for (int r = 0; r < options.repeat; ++r) {
+            std::unique_ptr<Model> model = create();
+            size_t next = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (long long step = 0; step < steps; ++step) {
+                for (; next < requests.size() && requests[next].step == step; ++next) {
+                    model->addRequest(requests[next].fromFloor, requests[next].toFloor, 1);
+                }
+                model->update(options.deltaTime);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            result.stepMicros = std::min(result.stepMicros, seconds * 1e6 / steps);
+            result.metrics = model->getMetrics();
+        }
+        return result;
+    }
+
+    bool sameMetrics(const SimulationMetrics& a, const SimulationMetrics& b) {
+        return a.getRequestedPassengers() == b.getRequestedPassengers() &&
+               a.getBoardedPassengers() == b.getBoardedPassengers() &&
+               a.getDeliveredPassengers() == b.getDeliveredPassengers() &&
+               a.getTimedOutPassengers() == b.getTimedOutPassengers() &&
+               a.getTotalWaitTime() == b.getTotalWaitTime() &&
+               a.getMaxWaitTime() == b.getMaxWaitTime();
+    }
+
+    void printResult(const std::string& name, const Result& result) {
+        const auto& metrics = result.metrics;
+        std::cout << "  " << name << ": " << std::setprecision(3) << result.stepMicros << " us/步  "
+                  << "上梯/送达/超时 " << metrics.getBoardedPassengers() << "/"
+                  << metrics.getDeliveredPassengers() << "/" << metrics.getTimedOutPassengers()
+                  << "  平均等待 " << metrics.getAverageWaitTime() << " s" << std::endl;
+    }
+
+    bool benchmark(const Options& options, const BuildingTopology& topology) {
+        long long steps = static_cast<long long>(options.hours * 3600 / options.deltaTime);
+        std::vector<Request> requests = generateRequests(options, topology.floors, steps);
+
+        std::cout << "楼型 " << topology.floors << " 层 × " << topology.elevators << " 部 × "
+                  << topology.capacity << " 人  " << steps << " 步  " << requests.size() << " 个请求"
+                  << (BuildingRegistry::isSpecialized(topology) ? "" : "（无特化，两者均为 Building）")
+                  << std::endl;
+
+        Result specialized = run<BuildingModel>(options, requests, steps,
+                                                [&]() { return BuildingRegistry::create(topology); });
+        Result dynamic = run<BuildingModel>(options, requests, steps,
+                                            [&]() { return BuildingRegistry::createDynamic(topology); });
+        printResult("特化", specialized);
+        printResult("Building", dynamic);
+        bool matches = sameMetrics(specialized.metrics, dynamic.metrics);
+
+        std::cout << "  特化相对 Building: " << std::setprecision(2)
+                  << dynamic.stepMicros / specialized.stepMicros << " 倍  结果一致: "
+                  << (matches ? "是" : "否") << std::endl;
+        return matches;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_topology_benchmark [--floors N --cars N [--capacity N]] [--hours 小时] "
+                     "[--dt 秒] [--rate 人/小时/层] [--repeat N] [--seed N]" << std::endl;
+        return 1;
+    }
+    Logger::setThreadEnabled(false);
+
+    std::vector<BuildingTopology> topologies;
+    if (options.topology.floors > 0) {
+        topologies.push_back(options.topology);
+    } else {
+        topologies.push_back({14, 4, 12});
+        topologies.push_back({40, 8, 12});
+    }
+
+    std::cout << std::fixed;
+    std::cout << "=== 楼型特化基准 ===" << std::endl;
+    bool allMatch = true;
+    for (const auto& topology : topologies) {
+        allMatch = benchmark(options, topology) && allMatch;
+    }
+    return allMatch ? 0 : 1;
+}
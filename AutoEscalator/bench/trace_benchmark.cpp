@@ -0,0 +1,163 @@
+// 请求轨迹读取基准：生成一个大的合成轨迹文件，分别测量纯解析吞吐量和
+// 随模拟时间流式送入引擎的开销，并报告常驻内存，验证内存不随轨迹大小增长；
+// 只有轨迹中的请求进入模拟，送入人数应与轨迹人数一致
+//
+// 用法: elevator_trace_benchmark [--requests N] [--file 路径] [--keep 0|1] [--seed N]
+#include "simulation_engine.h"
+#include "trace_reader.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+    struct Options {
+        long long requests = 1000000;
+        std::string file = "trace_benchmark.trace";
+        bool keep = false;
+        unsigned int seed = 42;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--requests") == 0) options.requests = std::atoll(value);
+            else if (std::strcmp(arg, "--file") == 0) options.file = value;
+            else if (std::strcmp(arg, "--keep") == 0) options.keep = std::atoi(value) != 0;
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.requests > 0;
+    }
+
+    // 当前常驻内存（KB），无法获取时返回 -1
+    long readResidentKb() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmRSS:") == 0) {
+                return std::atol(line.c_str() + 6);
+            }
+        }
+        return -1;
+    }
+
+    // 请求均匀分布在一天之中，时刻单调递增
+    bool writeTrace(const Options& options, double dayLength) {
+        std::FILE* out = std::fopen(options.file.c_str(), "wb");
+        if (!out) return false;
+
+        std::fprintf(out, "# 合成请求轨迹: <到达时刻(毫秒)> <出发层> <目的层> <人数>\n");
+        long long dayMs = static_cast<long long>(dayLength * 1000);
+        for (long long i = 0; i < options.requests; ++i) {
+            long long timeMs = i * dayMs / options.requests;
+            int fromFloor = Utils::generateRandomNumber(1, ElevatorConfig::FLOOR_COUNT);
+            int toFloor = Utils::generateRandomNumber(1, ElevatorConfig::FLOOR_COUNT - 1);
+            if (toFloor >= fromFloor) ++toFloor;
+            std::fprintf(out, "%lld %d %d %d\n", timeMs, fromFloor, toFloor,
+                         Utils::generateRandomNumber(1, 3));
+        }
+        return std::fclose(out) == 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_trace_benchmark [--requests N] [--file 路径] [--keep 0|1] [--seed N]"
+                  << std::endl;
+        return 1;
+    }
+
+    Utils::seedRandom(options.seed);
+    SimulationEngine engine;
+    engine.getBuilding().setRecordingEnabled(false);
+    engine.getBuilding().getMaintenanceManager().setEnabled(false);
+
+    if (!writeTrace(options, engine.getDayLength())) {
+        std::cerr << "无法写入轨迹文件: " << options.file << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 请求轨迹基准 ===" << std::endl;
+    std::cout << "轨迹: " << options.file << "  请求: " << options.requests << std::endl;
+
+    // 纯解析
+    long baseResident = readResidentKb();
+    long peakResident = baseResident;
+    TraceReader reader;
+    if (!reader.open(options.file)) {
+        std::cerr << reader.getLastError() << std::endl;
+        return 1;
+    }
+    TraceReader::Record record;
+    long long checksum = 0;
+    long long tracePassengers = 0;
+    auto begin = std::chrono::steady_clock::now();
+    while (reader.next(record)) {
+        checksum += record.fromFloor + record.toFloor + record.passengerCount;
+        tracePassengers += record.passengerCount;
+        if ((reader.getRecordCount() & 0xFFFFF) == 0) {
+            peakResident = std::max(peakResident, readResidentKb());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double parseSeconds = std::chrono::duration<double>(end - begin).count();
+
+    std::cout << "--- 解析 ---" << std::endl;
+    std::cout << "记录/跳过: " << reader.getRecordCount() << " / " << reader.getSkippedLines()
+              << "  校验和: " << checksum << std::endl;
+    std::cout << "耗时: " << parseSeconds << " s  吞吐: "
+              << std::setprecision(1) << reader.getRecordCount() / parseSeconds / 1e6
+              << " M行/s" << std::setprecision(3) << std::endl;
+    std::cout << "常驻内存: 开始 " << baseResident << " KB  峰值 " << peakResident << " KB" << std::endl;
+    reader.close();
+
+    // 随模拟时间送入引擎
+    if (!engine.openTrace(options.file)) {
+        std::cerr << "无法打开轨迹文件: " << options.file << std::endl;
+        return 1;
+    }
+    engine.start();
+    long long steps = 0;
+    begin = std::chrono::steady_clock::now();
+    while (engine.isSimulationRunning()) {
+        steps += engine.advance(3600.0, 0.1);
+        peakResident = std::max(peakResident, readResidentKb());
+    }
+    end = std::chrono::steady_clock::now();
+    double runSeconds = std::chrono::duration<double>(end - begin).count();
+
+    const auto& metrics = engine.getMetrics();
+    std::cout << "--- 模拟 ---" << std::endl;
+    std::cout << "步数: " << steps << "  耗时: " << runSeconds << " s  每步耗时: "
+              << runSeconds * 1e6 / steps << " us" << std::endl;
+    std::cout << "送入请求(人): " << metrics.getRequestedPassengers() << "  轨迹人数: " << tracePassengers
+              << "  一致: " << (metrics.getRequestedPassengers() == tracePassengers ? "是" : "否")
+              << std::endl;
+    std::cout << "上梯/送达/超时: " << metrics.getBoardedPassengers() << " / "
+              << metrics.getDeliveredPassengers() << " / " << metrics.getTimedOutPassengers() << std::endl;
+    std::cout << "常驻内存峰值: " << peakResident << " KB" << std::endl;
+
+    engine.closeTrace();
+    if (!options.keep) {
+        std::remove(options.file.c_str());
+    }
+    return 0;
+}
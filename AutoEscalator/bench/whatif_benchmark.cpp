@@ -0,0 +1,218 @@
+// 分支推演基准：模拟到分支时刻（默认 08:55），保存检查点并分出若干变体
+// （三种调度策略 × 是否在分支时刻追加一批散会客流），各变体在独立线程上跑完当天。
+// 与每个变体都从零点重新模拟相比，报告节省的时间，并核对分支与原引擎的结果一致
+//
+// 用法: elevator_whatif_benchmark [--dt 秒] [--seed N] [--branch HH:MM]
+//                                 [--profile office|文件] [--threads N] [--burst 人数]
+#include "simulation_engine.h"
+#include "config.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Options {
+        double deltaTime = 0.1;
+        unsigned int seed = 42;
+        double branchTime = 8 * 3600 + 55 * 60;  // 按24小时制的一天
+        std::string profile = "office";
+        int threads = 0;  // 0 表示按硬件线程数
+        int burst = 40;   // 追加的散会客流人数
+    };
+    
+    struct Variant {
+        Dispatcher::Strategy strategy;
+        bool burst;
+        std::unique_ptr<SimulationEngine> engine;
+        double seconds = 0.0;
+    };
+
+    bool parseTime(const char* text, double& seconds) {
+        int hours = 0, minutes = 0;
+        if (std::sscanf(text, "%d:%d", &hours, &minutes) != 2 ||
+            hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+            return false;
+        }
+        seconds = hours * 3600.0 + minutes * 60.0;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--profile") == 0) options.profile = value;
+            else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--burst") == 0) options.burst = std::atoi(value);
+            else if (std::strcmp(arg, "--branch") == 0) {
+                if (!parseTime(value, options.branchTime)) {
+                    std::cerr << "分支时刻格式应为 HH:MM: " << value << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.deltaTime > 0 && options.threads >= 0 && options.burst >= 0;
+    }
+    
+    double secondsSince(std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+    
+    // 散会：高层会议室的人一起下到1楼
+    void addMeetingBurst(SimulationEngine& engine, int passengers) {
+        int meetingFloor = ElevatorConfig::FLOOR_COUNT - 2;
+        while (passengers > 0) {
+            int group = std::min(passengers, 4);
+            engine.addRequest(meetingFloor, 1, group);
+            passengers -= group;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_whatif_benchmark [--dt 秒] [--seed N] [--branch HH:MM] "
+                     "[--profile office|文件] [--threads N] [--burst 人数]" << std::endl;
+        return 1;
+    }
+    
+    Utils::seedRandom(options.seed);
+    SimulationEngine engine;
+    engine.getBuilding().setRecordingEnabled(false);
+    engine.getBuilding().getMaintenanceManager().setEnabled(false);
+    
+    DemandProfile profile = DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT);
+    if (options.profile != "office" && !profile.loadFromFile(options.profile)) {
+        std::cerr << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+        return 1;
+    }
+    engine.setDemandProfile(profile);
+    
+    // 上午的公共部分只模拟一次
+    double branchAt = options.branchTime / (24.0 * 3600) * engine.getDayLength();
+    auto begin = std::chrono::steady_clock::now();
+    engine.start();
+    long long prefixSteps = engine.advance(branchAt, options.deltaTime);
+    double prefixSeconds = secondsSince(begin);
+    
+    // 检查点往返：保存、恢复到新引擎、再保存，两次字节应完全相同
+    begin = std::chrono::steady_clock::now();
+    std::vector<uint8_t> checkpoint = engine.saveCheckpoint();
+    double saveSeconds = secondsSince(begin);
+    
+    SimulationEngine restored;
+    begin = std::chrono::steady_clock::now();
+    bool restoredOk = restored.restoreCheckpoint(checkpoint);
+    double restoreSeconds = secondsSince(begin);
+    bool roundTrip = restoredOk && restored.saveCheckpoint() == checkpoint;
+    
+    // 分出变体
+    const Dispatcher::Strategy strategies[] = {
+        Dispatcher::Strategy::NEAREST_FIRST,
+        Dispatcher::Strategy::LOAD_BALANCED,
+        Dispatcher::Strategy::ENERGY_SAVING
+    };
+    std::vector<Variant> variants;
+    begin = std::chrono::steady_clock::now();
+    for (bool burst : {false, true}) {
+        for (auto strategy : strategies) {
+            Variant variant;
+            variant.strategy = strategy;
+            variant.burst = burst;
+            variant.engine = engine.fork();
+            variant.engine->setDispatchStrategy(strategy);
+            if (burst) {
+                addMeetingBurst(*variant.engine, options.burst);
+            }
+            variants.push_back(std::move(variant));
+        }
+    }
+    double forkSeconds = secondsSince(begin);
+    
+    // 各变体并行跑完当天
+    int threadCount = options.threads > 0 ? options.threads
+                                          : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(variants.size())));
+    std::atomic<size_t> nextVariant(0);
+    auto worker = [&]() {
+        for (size_t i = nextVariant++; i < variants.size(); i = nextVariant++) {
+            auto start = std::chrono::steady_clock::now();
+            variants[i].engine->advance(variants[i].engine->getDayLength(), options.deltaTime);
+            variants[i].seconds = secondsSince(start);
+        }
+    };
+    begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    double parallelSeconds = secondsSince(begin);
+    
+    // 原引擎继续跑完，应与同策略、无追加客流的分支逐位一致
+    engine.advance(engine.getDayLength(), options.deltaTime);
+    const auto& baseline = engine.getMetrics();
+    const auto& sameBranch = variants[0].engine->getMetrics();
+    bool forkMatches = baseline.getBoardedPassengers() == sameBranch.getBoardedPassengers() &&
+                       baseline.getAverageWaitTime() == sameBranch.getAverageWaitTime() &&
+                       baseline.getMaxWaitTime() == sameBranch.getMaxWaitTime() &&
+                       engine.getBuilding().getEnergyManager().getTotalConsumption() ==
+                           variants[0].engine->getBuilding().getEnergyManager().getTotalConsumption();
+    
+    double serialRerun = 0.0;
+    for (const auto& variant : variants) {
+        serialRerun += prefixSeconds + variant.seconds;
+    }
+    double branched = prefixSeconds + saveSeconds + forkSeconds + parallelSeconds;
+    
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 分支推演基准 ===" << std::endl;
+    std::cout << "分支时刻: 模拟时间 " << branchAt << " s（" << prefixSteps << " 步）  线程: "
+              << threadCount << std::endl;
+    std::cout << "上午模拟: " << prefixSeconds << " s" << std::endl;
+    std::cout << "检查点: " << checkpoint.size() << " 字节  保存 " << saveSeconds * 1e3
+              << " ms  恢复 " << restoreSeconds * 1e3 << " ms  往返一致: "
+              << (roundTrip ? "是" : "否") << std::endl;
+    std::cout << "分出 " << variants.size() << " 个变体: " << forkSeconds * 1e3 << " ms" << std::endl;
+    std::cout << "分支与原引擎一致: " << (forkMatches ? "是" : "否") << std::endl;
+    std::cout << std::endl;
+    for (const auto& variant : variants) {
+        const auto& metrics = variant.engine->getMetrics();
+        std::cout << Dispatcher::getStrategyName(variant.strategy)
+                  << (variant.burst ? " + 散会" + std::to_string(options.burst) + "人" : "")
+                  << ": 上梯 " << metrics.getBoardedPassengers()
+                  << "  超时 " << metrics.getTimedOutPassengers() << std::setprecision(1)
+                  << "  平均等待 " << metrics.getAverageWaitTime() << " s"
+                  << "  P95 " << metrics.getWaitTimePercentile(95) << " s"
+                  << std::setprecision(3) << "  耗时 " << variant.seconds << " s" << std::endl;
+    }
+    std::cout << std::endl;
+    std::cout << "逐个从零点重新模拟: " << serialRerun << " s" << std::endl;
+    std::cout << "检查点分支并行推演: " << branched << " s" << std::endl;
+    std::cout << "加速: " << std::setprecision(1) << (branched > 0 ? serialRerun / branched : 0.0)
+              << "x" << std::endl;
+    return roundTrip && forkMatches ? 0 : 1;
+}
@@ -89,11 +89,10 @@ void AnimationController::drawElevators(const std::vector<Elevator>& elevators)
 }
 
 void AnimationController::drawPassengers(const Building& building) {
-    const auto& waitingPassengers = building.getWaitingPassengers();
     for (int floor = 1; floor <= 14; ++floor) {
-        if (!waitingPassengers[floor].empty()) {
+        int count = building.getWaitingCountAtFloor(floor);
+        if (count > 0) {
             int y = SCREEN_HEIGHT - 2 - (floor - 1) * 2;
-            int count = waitingPassengers[floor].size();
             
             // 最多显示5个等待乘客图标
             for (int i = 0; i < std::min(count, 5); ++i) {
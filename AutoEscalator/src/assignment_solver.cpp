@@ -0,0 +1,79 @@
+#include "assignment_solver.h"
+#include <limits>
+
+const std::vector<int>& AssignmentSolver::solve(const std::vector<double>& cost,
+                                                size_t rows, size_t columns) {
+    const double INF = std::numeric_limits<double>::infinity();
+    reserve(rows, columns);
+    rowPotential.assign(rows + 1, 0.0);
+    columnPotential.assign(columns + 1, 0.0);
+    columnOwner.assign(columns + 1, 0);
+    previousColumn.assign(columns + 1, 0);
+    
+    // 逐行加入，每次沿缩减代价为0的边找一条增广路；第0列是虚拟起点
+    for (size_t row = 1; row <= rows; ++row) {
+        columnOwner[0] = static_cast<int>(row);
+        size_t column = 0;
+        minSlack.assign(columns + 1, INF);
+        visited.assign(columns + 1, 0);
+        
+        do {
+            visited[column] = 1;
+            size_t owner = columnOwner[column];
+            const double* costRow = &cost[(owner - 1) * columns];
+            double delta = INF;
+            size_t nextColumn = 0;
+            for (size_t j = 1; j <= columns; ++j) {
+                if (visited[j]) continue;
+                double slack = costRow[j - 1] - rowPotential[owner] - columnPotential[j];
+                if (slack < minSlack[j]) {
+                    minSlack[j] = slack;
+                    previousColumn[j] = static_cast<int>(column);
+                }
+                if (minSlack[j] < delta) {
+                    delta = minSlack[j];
+                    nextColumn = j;
+                }
+            }
+            for (size_t j = 0; j <= columns; ++j) {
+                if (visited[j]) {
+                    rowPotential[columnOwner[j]] += delta;
+                    columnPotential[j] -= delta;
+                } else {
+                    minSlack[j] -= delta;
+                }
+            }
+            column = nextColumn;
+        } while (columnOwner[column] != 0);
+        
+        // 沿增广路翻转匹配
+        do {
+            size_t previous = previousColumn[column];
+            columnOwner[column] = columnOwner[previous];
+            column = previous;
+        } while (column != 0);
+    }
+    
+    assignment.assign(rows, -1);
+    for (size_t j = 1; j <= columns; ++j) {
+        if (columnOwner[j] != 0) {
+            assignment[columnOwner[j] - 1] = static_cast<int>(j - 1);
+        }
+    }
+    return assignment;
+}
+
+void AssignmentSolver::reserve(size_t rows, size_t columns) {
+    if (rowPotential.capacity() > rows && columnOwner.capacity() > columns) {
+        return;
+    }
+    size_t reservedRows = 2 * rows + 1;
+    size_t reservedColumns = 2 * columns + 1;
+    rowPotential.reserve(reservedRows);
+    assignment.reserve(reservedRows);
+    columnPotential.reserve(reservedColumns);
+    minSlack.reserve(reservedColumns);
+    columnOwner.reserve(reservedColumns);
+    previousColumn.reserve(reservedColumns);
+    visited.reserve(reservedColumns);
+}
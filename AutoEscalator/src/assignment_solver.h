@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// 最小代价指派：匈牙利算法（带行列势的最短增广路实现），rows 行时间复杂度 O(rows² × columns)。
+// 各缓冲区在多次求解之间复用
+class AssignmentSolver {
+private:
+    std::vector<double> rowPotential;
+    std::vector<double> columnPotential;
+    std::vector<double> minSlack;
+    std::vector<int> columnOwner;   // 列当前匹配的行（1起编号，0表示未匹配）
+    std::vector<int> previousColumn;
+    std::vector<char> visited;
+    std::vector<int> assignment;
+    
+public:
+    // 为至少 rows×columns 的问题预留缓冲区；求解时规模超过已预留的容量会按两倍预留
+    void reserve(size_t rows, size_t columns);
+    
+    // cost 按行存放 rows×columns 的代价矩阵，要求 rows <= columns。
+    // 返回每行分到的列，使总代价最小
+    const std::vector<int>& solve(const std::vector<double>& cost, size_t rows, size_t columns);
+};
@@ -0,0 +1,143 @@
+#include "batch_dispatcher.h"
+#include "config.h"
+#include "cost_kernels.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    const double UNASSIGNED_COST = 1e6;      // 空位不够时留在队列中的代价
+}
+
+BatchDispatcher::BatchDispatcher() : stats{0, 0, 0.0, 0.0, 0} {}
+
+size_t BatchDispatcher::fleetCapacity(const std::vector<Elevator>& elevators) {
+    size_t total = 0;
+    for (const auto& elevator : elevators) {
+        total += elevator.getCapacity();
+    }
+    return total;
+}
+
+double BatchDispatcher::callCost(double arrivalTime, const Elevator& elevator, const Passenger& passenger,
+                                 int slot, const DispatchWeights& weights) {
+    double result = arrivalTime + slot * weights.batchLoadPenalty;
+    
+    if (elevator.getCurrentLoad() > 0) {
+        bool goingUp = passenger.getTargetFloor() > passenger.getSourceFloor();
+        if ((elevator.getState() == ElevatorState::MOVING_UP && !goingUp) ||
+            (elevator.getState() == ElevatorState::MOVING_DOWN && goingUp)) {
+            result += weights.batchDirectionPenalty;
+        }
+    }
+    return result;
+}
+
+void BatchDispatcher::dispatch(std::vector<Elevator>& elevators,
+                               PassengerPool& pool,
+                               std::vector<PassengerPool::List>& waitingPassengers,
+                               const DispatchWeights& weights,
+                               std::vector<Assignment>& newlyAssigned) {
+    auto begin = std::chrono::steady_clock::now();
+    newlyAssigned.clear();
+    calls.clear();
+    
+    // 收回已分配未上梯的乘客，与等待队列一起重新指派
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        released.clear();
+        elevators[i].takeAssignedPassengers(released);
+        for (PassengerPool::Handle passenger : released) {
+            calls.push_back({passenger, static_cast<int>(i)});
+        }
+    }
+    size_t firstQueued = calls.size();
+    for (auto& queue : waitingPassengers) {
+        while (!queue.empty()) {
+            calls.push_back({pool.popFront(queue), -1});
+        }
+    }
+    if (calls.empty()) {
+        return;
+    }
+    
+    // 每部电梯按剩余容量展开为若干空位，空位代价随序号递增；停用的电梯没有空位，
+    // 上面收回的原分配给它的乘客就此改派给其他电梯
+    slotElevator.clear();
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        if (!elevators[i].isInService()) continue;
+        int free = elevators[i].getCapacity() - elevators[i].getCurrentLoad();
+        int slots = std::min<int>(free, calls.size());
+        slotElevator.insert(slotElevator.end(), std::max(slots, 0), static_cast<int>(i));
+    }
+    size_t rows = calls.size();
+    size_t slotCount = slotElevator.size();
+    size_t columns = std::max(rows, slotCount);
+    
+    if (cost.capacity() < rows * columns) {
+        // 至少按全部电梯的载客量预留，平常的客流不再分配；更大的批次按两倍预留
+        size_t reserved = std::max(2 * columns, fleetCapacity(elevators));
+        cost.reserve(reserved * reserved);
+        calls.reserve(reserved);
+        released.reserve(reserved);
+        slotElevator.reserve(reserved);
+        solver.reserve(reserved, reserved);
+    }
+    
+    cars.load(elevators);
+    arrivalTimes.resize(cars.paddedSize());
+    cost.resize(rows * columns);
+    for (size_t row = 0; row < rows; ++row) {
+        const Call& call = calls[row];
+        const Passenger& passenger = pool.get(call.passenger);
+        double* costRow = &cost[row * columns];
+        CostKernels::arrivalTimes(cars, passenger.getSourceFloor(), arrivalTimes.data());
+        int slot = 0;
+        for (size_t column = 0; column < slotCount; ++column) {
+            int elevator = slotElevator[column];
+            slot = (column > 0 && slotElevator[column - 1] == elevator) ? slot + 1 : 0;
+            costRow[column] = callCost(arrivalTimes[elevator], elevators[elevator], passenger,
+                                       slot, weights);
+            if (call.previousElevator >= 0 && call.previousElevator != elevator) {
+                // 改派罚时，避免在代价相近的电梯间来回切换
+                costRow[column] += weights.batchReassignPenalty;
+            }
+        }
+        // 已分配的乘客优先保住空位
+        double unassigned = call.previousElevator >= 0 ? 2 * UNASSIGNED_COST : UNASSIGNED_COST;
+        std::fill(costRow + slotCount, costRow + columns, unassigned);
+    }
+    
+    const std::vector<int>& assignment = solver.solve(cost, rows, columns);
+    
+    for (size_t row = 0; row < rows; ++row) {
+        const Call& call = calls[row];
+        const Passenger& passenger = pool.get(call.passenger);
+        size_t column = assignment[row];
+        if (column >= slotCount) {
+            pool.pushBack(waitingPassengers[passenger.getSourceFloor()], call.passenger);
+            continue;
+        }
+        
+        int elevator = slotElevator[column];
+        elevators[elevator].addPassenger(call.passenger);
+        if (row >= firstQueued) {
+            newlyAssigned.push_back({passenger, elevator});
+        } else if (call.previousElevator != elevator) {
+            ++stats.reassignments;
+        }
+    }
+    
+    double elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    ++stats.cycles;
+    stats.totalSolveMs += elapsed;
+    stats.maxSolveMs = std::max(stats.maxSolveMs, elapsed);
+    stats.maxCalls = std::max(stats.maxCalls, static_cast<int>(rows));
+}
+
+const BatchDispatcher::Statistics& BatchDispatcher::getStatistics() const {
+    return stats;
+}
+
+void BatchDispatcher::resetStatistics() {
+    stats = {0, 0, 0.0, 0.0, 0};
+}
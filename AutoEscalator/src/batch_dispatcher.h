@@ -0,0 +1,61 @@
+#pragma once
+#include "assignment_solver.h"
+#include "car_bank.h"
+#include "dispatch_weights.h"
+#include "elevator.h"
+#include "passenger.h"
+#include "passenger_pool.h"
+#include <vector>
+
+// 批量最优调度：一个调度周期内收集各层全部未分配的乘客，连同各电梯已分配、尚未上梯的乘客，
+// 按 乘客×电梯空位 的代价矩阵求总代价最小的指派。
+// 代价 = 电梯到达出发楼层的估算时间 + 同一电梯每多接一人的停靠时间 + 与电梯运行方向相反的罚时；
+// 已分配的乘客换到其他电梯时另加改派罚时，只在明显更优时才改派。各项罚时取自 DispatchWeights。
+class BatchDispatcher {
+public:
+    struct Assignment {
+        Passenger passenger;
+        int elevator;
+    };
+    
+    struct Statistics {
+        long long cycles;
+        long long reassignments;   // 已分配乘客改派到其他电梯的次数
+        double totalSolveMs;       // 建矩阵和求解的总耗时
+        double maxSolveMs;
+        int maxCalls;              // 单个周期参与指派的最多乘客数
+    };
+    
+private:
+    struct Call {
+        PassengerPool::Handle passenger;
+        int previousElevator;      // 原分配的电梯，-1表示来自等待队列
+    };
+    
+    AssignmentSolver solver;
+    std::vector<Call> calls;       // 以下缓冲区在周期之间复用
+    std::vector<PassengerPool::Handle> released;
+    std::vector<double> cost;
+    std::vector<int> slotElevator; // 每一列（电梯空位）所属的电梯
+    CarBank cars;                  // 收回已分配乘客后的电梯状态，按出发楼层一次算出各电梯的到达时间
+    std::vector<double> arrivalTimes;
+    Statistics stats;
+    
+    static double callCost(double arrivalTime, const Elevator& elevator, const Passenger& passenger,
+                           int slot, const DispatchWeights& weights);
+    static size_t fleetCapacity(const std::vector<Elevator>& elevators);
+    
+public:
+    BatchDispatcher();
+    
+    // 执行一个调度周期。等待队列中分到电梯的乘客写入 newlyAssigned，
+    // 没分到的按原顺序留在队列中。电梯和各层队列的乘客都在 pool 中，只移动句柄
+    void dispatch(std::vector<Elevator>& elevators,
+                  PassengerPool& pool,
+                  std::vector<PassengerPool::List>& waitingPassengers,
+                  const DispatchWeights& weights,
+                  std::vector<Assignment>& newlyAssigned);
+    
+    const Statistics& getStatistics() const;
+    void resetStatistics();
+};
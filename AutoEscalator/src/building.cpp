@@ -1,46 +1,117 @@
 #include "building.h"
+#include "logger.h"
 #include <algorithm>
+#include <cmath>
+#include <iostream>
 
-Building::Building() 
-    : dispatcher(Dispatcher::Strategy::NEAREST_FIRST),
-      energyManager(ELEVATOR_COUNT),
-      maintenanceManager(ELEVATOR_COUNT) {
-    // 初始化电梯
-    elevators.resize(ELEVATOR_COUNT, Elevator());
+Building::Building(int floorCount, int elevatorCount, int capacity)
+    : floorCount(floorCount),
+      dispatcher(Dispatcher::Strategy::NEAREST_FIRST),
+      expectedTrafficScale(1.0),
+      demandForecaster(floorCount),
+      nextParkingUpdate(0.0),
+      energyManager(elevatorCount),
+      maintenanceManager(elevatorCount),
+      runLogTimeOffset(0.0),
+      currentTime(0.0),
+      recordingEnabled(true) {
+    // 初始化电梯，乘客都放在楼宇的乘客池中
+    elevators.resize(elevatorCount, Elevator(capacity, floorCount));
+    for (auto& elevator : elevators) {
+        elevator.setPassengerPool(passengerPool);
+    }
     // 初始化每层楼的等待队列
-    waitingPassengers.resize(FLOOR_COUNT + 1); // +1因为从1楼开始计数
-    
-    // 开始记录数据
-    dataRecorder.startLogging("elevator_data.csv");
+    waitingPassengers.resize(floorCount + 1); // +1因为从1楼开始计数
+    boardingWaits.reserve(static_cast<size_t>(elevatorCount) * capacity);
+}
+
+Building::Building(const Building& other)
+    : floorCount(other.floorCount),
+      passengerPool(other.passengerPool),
+      elevators(other.elevators),
+      waitingPassengers(other.waitingPassengers),
+      dispatcher(other.dispatcher),
+      rolloutDispatcher(other.rolloutDispatcher.getSettings()),
+      expectedTraffic(other.expectedTraffic),
+      expectedTrafficScale(other.expectedTrafficScale),
+      demandForecaster(other.demandForecaster),
+      parkingPolicy(other.parkingPolicy.getSettings()),
+      nextParkingUpdate(other.nextParkingUpdate),
+      energyManager(other.energyManager),
+      maintenanceManager(other.maintenanceManager),
+      metrics(other.metrics),
+      runLogTimeOffset(0.0),
+      currentTime(other.currentTime),
+      recordingEnabled(other.recordingEnabled) {
+    // 句柄在复制的池中照样有效，电梯改用本楼宇的池
+    for (auto& elevator : elevators) {
+        elevator.setPassengerPool(passengerPool);
+    }
 }
 
 void Building::update(double deltaTime) {
+    currentTime += deltaTime;
+    
     performance.startMeasure("elevator_updates");
-    // 更新所有电梯
-    for (auto& elevator : elevators) {
+    // 更新所有电梯，并统计本步送达的乘客
+    int delivered = 0;
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        auto& elevator = elevators[i];
+        int before = elevator.getDeliveredCount();
+        size_t boardedBefore = boardingWaits.size();
         elevator.update(deltaTime);
+        int carDelivered = elevator.getDeliveredCount() - before;
+        delivered += carDelivered;
+        elevator.takeBoardingWaits(boardingWaits);
+        
+        if (runLog.isOpen()) {
+            RunLog::Event event;
+            event.timeMs = getRunLogTime();
+            event.elevator = static_cast<int>(i);
+            event.floor = elevator.getCurrentFloor();
+            if (carDelivered > 0) {
+                event.type = RunLog::EventType::DELIVERY;
+                event.passengers = carDelivered;
+                runLog.write(event);
+            }
+            event.type = RunLog::EventType::BOARDING;
+            for (size_t j = boardedBefore; j < boardingWaits.size(); ++j) {
+                event.waitMs = std::llround(boardingWaits[j] * 1000.0);
+                runLog.write(event);
+            }
+        }
     }
+    metrics.recordDeliveries(delivered);
+    for (double waitTime : boardingWaits) {
+        metrics.recordBoarding(waitTime);
+    }
+    boardingWaits.clear();
     performance.endMeasure("elevator_updates");
     
     performance.startMeasure("passenger_updates");
-    // 更新等待乘客并处理超时
-    for (int floor = 1; floor <= FLOOR_COUNT; ++floor) {
-        auto& queue = waitingPassengers[floor];
-        std::queue<Passenger> newQueue;
-        
-        while (!queue.empty()) {
-            Passenger passenger = queue.front();
-            queue.pop();
-            
-            passenger.updateWaitTime(deltaTime);
-            if (!passenger.hasTimeout()) {
-                newQueue.push(passenger);
-            } else {
-                Logger::log("乘客在" + std::to_string(floor) + "楼等待超时，已离开");
+    // 更新等待乘客并处理超时，超时的乘客就地从队列中摘下并归还槽位
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        passengerPool.removeIf(waitingPassengers[floor],
+            [deltaTime](Passenger& passenger) {
+                passenger.updateWaitTime(deltaTime);
+                return passenger.hasTimeout();
+            },
+            [this, floor](PassengerPool::Handle handle) {
+                metrics.recordTimeout();
+                if (runLog.isOpen()) {
+                    RunLog::Event event;
+                    event.timeMs = getRunLogTime();
+                    event.type = RunLog::EventType::TIMEOUT;
+                    event.floor = floor;
+                    event.waitMs = std::llround(passengerPool.get(handle).getWaitTime() * 1000.0);
+                    runLog.write(event);
+                }
+                passengerPool.release(handle);
+                if (Logger::isEnabled()) {
+                    Logger::log("乘客在" + std::to_string(floor) + "楼等待超时，已离开");
+                }
             }
-        }
-        
-        waitingPassengers[floor] = newQueue;
+        );
     }
     performance.endMeasure("passenger_updates");
     
@@ -49,29 +120,60 @@ void Building::update(double deltaTime) {
     assignPassengersToElevators();
     performance.endMeasure("passenger_assignment");
     
+    demandForecaster.advance(currentTime);
+    updateParking();
+    
     // 更新能源统计
     energyManager.updateEnergy(elevators, deltaTime);
+    logCarStates();
     
     // 更新维护状态
     maintenanceManager.update(elevators, currentTime);
     
     // 记录电梯状态
-    dataRecorder.recordState(elevators, currentTime);
+    if (recordingEnabled) {
+        dataRecorder.recordState(elevators, currentTime);
+    }
 }
 
-void Building::addRequest(int fromFloor, int toFloor, int passengerCount) {
-    if (fromFloor < 1 || fromFloor > FLOOR_COUNT || 
-        toFloor < 1 || toFloor > FLOOR_COUNT || 
-        fromFloor == toFloor) {
-        return;
+bool Building::addRequest(int fromFloor, int toFloor, int passengerCount) {
+    if (fromFloor < 1 || fromFloor > floorCount || 
+        toFloor < 1 || toFloor > floorCount || 
+        fromFloor == toFloor || passengerCount <= 0) {
+        return false;
     }
     
     for (int i = 0; i < passengerCount; ++i) {
-        waitingPassengers[fromFloor].push(Passenger(fromFloor, toFloor));
+        passengerPool.pushBack(waitingPassengers[fromFloor], passengerPool.acquire(Passenger(fromFloor, toFloor)));
     }
+    metrics.recordRequest(passengerCount);
+    demandForecaster.recordArrival(currentTime, fromFloor, toFloor, passengerCount);
+    
+    if (runLog.isOpen()) {
+        RunLog::Event event;
+        event.timeMs = getRunLogTime();
+        event.type = RunLog::EventType::REQUEST;
+        event.floor = fromFloor;
+        event.target = toFloor;
+        event.passengers = passengerCount;
+        runLog.write(event);
+    }
+    return true;
 }
 
 void Building::reset() {
+    maintenanceManager.reset();
+    resetDay();
+}
+
+void Building::startNextDay() {
+    // 先记下前一天的时长：resetDay 会把时钟归零，并让所有电梯恢复运行
+    double elapsed = currentTime;
+    resetDay();
+    maintenanceManager.startNextDay(elevators, elapsed);
+}
+
+void Building::resetDay() {
     // 重置所有电梯
     for (auto& elevator : elevators) {
         elevator.reset();
@@ -79,43 +181,162 @@ void Building::reset() {
     
     // 清空等待队列
     for (auto& queue : waitingPassengers) {
-        while (!queue.empty()) {
-            queue.pop();
-        }
+        passengerPool.releaseAll(queue);
     }
     
-    // 清除记录数据
+    // 清除记录数据和统计
     dataRecorder.clear();
+    energyManager.reset();
+    metrics.reset();
+    demandForecaster.finishDay(currentTime);
+    nextParkingUpdate = 0.0;
+    runLogTimeOffset += currentTime;
+    currentTime = 0.0;
+    logCarStates();
+}
+
+void Building::startDataLogging(const std::string& filename) {
+    dataRecorder.startLogging(filename);
+}
+
+void Building::setRecordingEnabled(bool enabled) {
+    recordingEnabled = enabled;
+}
+
+bool Building::startRunLog(const std::string& filename) {
+    RunLog::Config config;
+    config.floorCount = floorCount;
+    config.elevatorCount = static_cast<int>(elevators.size());
+    config.capacity = elevators.empty() ? 0 : elevators.front().getCapacity();
+    config.strategy = static_cast<int>(dispatcher.getStrategy());
+    config.floorTravelTime = ElevatorConfig::FLOOR_TRAVEL_TIME;
+    config.maxIdleTime = ElevatorConfig::MAX_IDLE_TIME;
+    config.maxWaitTime = ElevatorConfig::MAX_WAIT_TIME;
+    
+    if (!runLog.open(filename, config)) {
+        Logger::log("无法创建运行日志: " + filename);
+        return false;
+    }
+    logCarStates();
+    return true;
+}
+
+void Building::stopRunLog() {
+    runLog.close();
+}
+
+bool Building::isRunLogging() const {
+    return runLog.isOpen();
+}
+
+long long Building::getRunLogTime() const {
+    return std::llround((runLogTimeOffset + currentTime) * 1000.0);
+}
+
+void Building::logCarStates() {
+    if (!runLog.isOpen()) return;
+    
+    RunLog::Event event;
+    event.timeMs = getRunLogTime();
+    event.type = RunLog::EventType::CAR_STATE;
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const auto& elevator = elevators[i];
+        event.elevator = static_cast<int>(i);
+        event.floor = elevator.getCurrentFloor();
+        event.passengers = elevator.getCurrentLoad();
+        event.state = static_cast<int>(elevator.getState());
+        event.energyWh = std::llround(energyManager.getElevatorConsumption(i) * 1000.0);
+        runLog.write(event);  // 没有状态变化时写入方会跳过
+    }
 }
 
 const std::vector<Elevator>& Building::getElevators() const {
     return elevators;
 }
 
-const std::vector<std::queue<Passenger>>& Building::getWaitingPassengers() const {
-    return waitingPassengers;
+int Building::getFloorCount() const {
+    return floorCount;
+}
+
+void Building::fillSnapshot(EngineSnapshot& snapshot) const {
+    snapshot.cars.resize(elevators.size());
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const Elevator& elevator = elevators[i];
+        snapshot.cars[i] = {elevator.getCurrentFloor(), elevator.getState(), elevator.getCurrentLoad(),
+                            elevator.isInService()};
+    }
+    
+    // 已分配给电梯的乘客仍在出发楼层等待，与队列中的一起计入呼梯
+    snapshot.floors.assign(floorCount + 1, EngineSnapshot::Floor{false, false, 0});
+    auto addWaiting = [&snapshot](const Passenger& passenger) {
+        auto& floor = snapshot.floors[passenger.getSourceFloor()];
+        if (passenger.getTargetFloor() > passenger.getSourceFloor()) {
+            floor.upCall = true;
+        } else {
+            floor.downCall = true;
+        }
+        ++floor.waiting;
+    };
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        passengerPool.forEach(waitingPassengers[floor], addWaiting);
+    }
+    for (const auto& elevator : elevators) {
+        elevator.forEachAssignedPassenger(addWaiting);
+    }
+}
+
+PassengerQueue Building::getWaitingQueue(int floor) const {
+    if (floor < 1 || floor > floorCount) {
+        return PassengerQueue();
+    }
+    return PassengerQueue(passengerPool, waitingPassengers[floor]);
+}
+
+const PassengerPool& Building::getPassengerPool() const {
+    return passengerPool;
 }
 
 void Building::assignPassengersToElevators() {
-    for (int floor = 1; floor <= FLOOR_COUNT; ++floor) {
+    releaseStrandedPassengers();
+    if (dispatcher.getStrategy() == Dispatcher::Strategy::EXTERNAL) {
+        return;  // 由调用方通过 assignWaitingPassenger 分配
+    }
+    if (dispatcher.getStrategy() == Dispatcher::Strategy::BATCH_OPTIMAL) {
+        // 有新的候梯乘客时才开始一个调度周期，同时重新优化之前的分配
+        if (getTotalWaitingPassengers() == 0) return;
+        batchDispatcher.dispatch(elevators, passengerPool, waitingPassengers, dispatcher.getWeights(),
+                                 batchAssignments);
+        for (const auto& assignment : batchAssignments) {
+            dispatcher.recordAssignment(elevators, assignment.passenger, assignment.elevator);
+        }
+        return;
+    }
+    
+    bool prepared = false;
+    for (int floor = 1; floor <= floorCount; ++floor) {
         auto& queue = waitingPassengers[floor];
         if (queue.empty()) continue;
+        if (!prepared) {
+            dispatcher.prepareRound(elevators);
+            prepared = true;
+        }
         
         while (!queue.empty()) {
-            const auto& passenger = queue.front();
-            int elevatorIndex = dispatcher.assignElevator(elevators, passenger);
+            const auto& passenger = passengerPool.get(queue.head);
+            int elevatorIndex;
+            if (dispatcher.getStrategy() == Dispatcher::Strategy::ROLLOUT) {
+                elevatorIndex = rolloutDispatcher.assign(*this, floor);
+                dispatcher.recordAssignment(elevators, passenger, elevatorIndex);
+            } else {
+                elevatorIndex = dispatcher.assignPrepared(elevators, passenger);
+            }
             
             if (elevatorIndex >= 0) {
                 auto& elevator = elevators[elevatorIndex];
-                if (elevator.addPassenger(passenger)) {
-                    // 设置电梯运动方向
-                    if (elevator.getCurrentFloor() < floor) {
-                        elevator.setState(ElevatorState::MOVING_UP);
-                    } else if (elevator.getCurrentFloor() > floor) {
-                        elevator.setState(ElevatorState::MOVING_DOWN);
-                    }
-                    queue.pop();
-                } else {
+                // 电梯自行决定运行方向，前往出发楼层接载；乘客的句柄从队列移到电梯
+                PassengerPool::Handle handle = passengerPool.popFront(queue);
+                if (!elevator.addPassenger(handle)) {
+                    passengerPool.pushFront(queue, handle);
                     break;
                 }
             } else {
@@ -125,9 +346,83 @@ void Building::assignPassengersToElevators() {
     }
 }
 
+// 停用电梯上已分配未上梯的乘客退回各自楼层的队首，保留已等待的时间，按原先的先后顺序重新分配；
+// 停用电梯停靠后，轿厢内未到目的层的乘客在所在楼层下梯，排在该层队首重新候梯
+void Building::releaseStrandedPassengers() {
+    for (auto& elevator : elevators) {
+        if (elevator.isInService()) continue;
+        strandedPassengers.clear();
+        elevator.takeAssignedPassengers(strandedPassengers);
+        for (auto it = strandedPassengers.rbegin(); it != strandedPassengers.rend(); ++it) {
+            int floor = passengerPool.get(*it).getSourceFloor();
+            passengerPool.pushFront(waitingPassengers[floor], *it);
+        }
+        if (!strandedPassengers.empty() && Logger::isEnabled()) {
+            Logger::log(std::to_string(strandedPassengers.size()) + "位乘客所分配的电梯停用，已退回候梯队列");
+        }
+        
+        strandedPassengers.clear();
+        elevator.takeStrandedPassengers(strandedPassengers);
+        int floor = elevator.getCurrentFloor();
+        for (auto it = strandedPassengers.rbegin(); it != strandedPassengers.rend(); ++it) {
+            Passenger& passenger = passengerPool.get(*it);
+            metrics.recordStranded(passenger.getWaitTime(), passenger.takeBoardingRecord());
+            passenger.relocate(floor);
+            passengerPool.pushFront(waitingPassengers[floor], *it);
+        }
+        if (!strandedPassengers.empty() && Logger::isEnabled()) {
+            Logger::log(std::to_string(strandedPassengers.size()) + "位乘客在" + std::to_string(floor) +
+                        "楼离开停用的电梯，重新候梯");
+        }
+    }
+}
+
+// 按需求预测重新选择各电梯的待命楼层；关闭预测停靠时都回1楼
+void Building::updateParking() {
+    if (currentTime < nextParkingUpdate) return;
+    nextParkingUpdate = currentTime + PARKING_INTERVAL;
+    
+    if (parkingPolicy.getSettings().enabled) {
+        parkingPolicy.chooseFloors(elevators, demandForecaster, currentTime, floorCount, parkingFloors);
+        dispatcher.setFloorDemand(parkingPolicy.getFloorDemand());
+    } else {
+        parkingFloors.assign(elevators.size(), 1);
+        dispatcher.setFloorDemand({});
+    }
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        elevators[i].setHomeFloor(parkingFloors[i]);
+    }
+}
+
+bool Building::assignWaitingPassenger(int floor, int elevatorIndex) {
+    if (floor < 1 || floor > floorCount || waitingPassengers[floor].empty() ||
+        elevatorIndex < 0 || elevatorIndex >= static_cast<int>(elevators.size())) {
+        return false;
+    }
+    PassengerPool::Handle handle = passengerPool.popFront(waitingPassengers[floor]);
+    if (!elevators[elevatorIndex].addPassenger(handle)) {
+        passengerPool.pushFront(waitingPassengers[floor], handle);
+        return false;
+    }
+    return true;
+}
+
+double Building::getPendingWaitTime() const {
+    double total = 0.0;
+    for (const auto& queue : waitingPassengers) {
+        passengerPool.forEach(queue, [&total](const Passenger& passenger) {
+            total += passenger.getWaitTime();
+        });
+    }
+    for (const auto& elevator : elevators) {
+        total += elevator.getAssignedWaitTime();
+    }
+    return total;
+}
+
 void Building::displayWaitingPassengers() const {
     std::cout << "\n=== 等待乘客状态 ===" << std::endl;
-    for (int floor = 1; floor <= FLOOR_COUNT; ++floor) {
+    for (int floor = 1; floor <= floorCount; ++floor) {
         if (!waitingPassengers[floor].empty()) {
             std::cout << floor << "楼: " << waitingPassengers[floor].size() 
                      << "人等待" << std::endl;
@@ -144,7 +439,7 @@ int Building::getTotalWaitingPassengers() const {
 }
 
 int Building::getWaitingCountAtFloor(int floor) const {
-    if (floor < 1 || floor > FLOOR_COUNT) {
+    if (floor < 1 || floor > floorCount) {
         return 0;
     }
     return waitingPassengers[floor].size();
@@ -153,6 +448,8 @@ int Building::getWaitingCountAtFloor(int floor) const {
 void Building::setDispatchStrategy(Dispatcher::Strategy strategy) {
     dispatcher.setStrategy(strategy);
     dispatcher.resetStatistics();
+    rolloutDispatcher.resetStatistics();
+    batchDispatcher.resetStatistics();
 }
 
 Dispatcher::Strategy Building::getDispatchStrategy() const {
@@ -163,6 +460,63 @@ const Dispatcher::Statistics& Building::getDispatcherStatistics() const {
     return dispatcher.getStatistics();
 }
 
+void Building::setDispatchWeights(const DispatchWeights& weights) {
+    dispatcher.setWeights(weights);
+}
+
+const DispatchWeights& Building::getDispatchWeights() const {
+    return dispatcher.getWeights();
+}
+
+RolloutDispatcher& Building::getRolloutDispatcher() {
+    return rolloutDispatcher;
+}
+
+const RolloutDispatcher& Building::getRolloutDispatcher() const {
+    return rolloutDispatcher;
+}
+
+const BatchDispatcher& Building::getBatchDispatcher() const {
+    return batchDispatcher;
+}
+
+void Building::setExpectedTraffic(const DemandProfile& profile, double timeScale) {
+    expectedTraffic = std::make_shared<const DemandProfile>(profile);
+    expectedTrafficScale = timeScale;
+}
+
+void Building::clearExpectedTraffic() {
+    expectedTraffic.reset();
+}
+
+const DemandProfile* Building::getExpectedTraffic() const {
+    return expectedTraffic.get();
+}
+
+double Building::getExpectedTrafficScale() const {
+    return expectedTrafficScale;
+}
+
+void Building::setDayLength(double length) {
+    demandForecaster.setDayLength(length);
+}
+
+const DemandForecaster& Building::getDemandForecaster() const {
+    return demandForecaster;
+}
+
+DemandForecaster& Building::getDemandForecaster() {
+    return demandForecaster;
+}
+
+ParkingPolicy& Building::getParkingPolicy() {
+    return parkingPolicy;
+}
+
+const ParkingPolicy& Building::getParkingPolicy() const {
+    return parkingPolicy;
+}
+
 const EnergyManager& Building::getEnergyManager() const {
     return energyManager;
 }
@@ -171,6 +525,64 @@ const MaintenanceManager& Building::getMaintenanceManager() const {
     return maintenanceManager;
 }
 
+MaintenanceManager& Building::getMaintenanceManager() {
+    return maintenanceManager;
+}
+
 const DataRecorder& Building::getDataRecorder() const {
     return dataRecorder;
-} 
\ No newline at end of file
+}
+
+const SimulationMetrics& Building::getMetrics() const {
+    return metrics;
+}
+
+double Building::getCurrentTime() const {
+    return currentTime;
+}
+
+void Building::saveState(StateWriter& out) const {
+    out.writeUnsigned(elevators.size());
+    for (const auto& elevator : elevators) {
+        elevator.saveState(out);
+    }
+    
+    out.writeUnsigned(waitingPassengers.size());
+    for (const auto& queue : waitingPassengers) {
+        passengerPool.saveList(out, queue);
+    }
+    
+    dispatcher.saveState(out);
+    demandForecaster.saveState(out);
+    out.writeDouble(nextParkingUpdate);
+    energyManager.saveState(out);
+    maintenanceManager.saveState(out);
+    metrics.saveState(out);
+    out.writeDouble(currentTime);
+}
+
+void Building::loadState(StateReader& in) {
+    if (in.readCount() != elevators.size()) {
+        in.fail();
+        return;
+    }
+    for (auto& elevator : elevators) {
+        elevator.loadState(in);
+    }
+    
+    if (in.readCount() != waitingPassengers.size()) {
+        in.fail();
+        return;
+    }
+    for (auto& queue : waitingPassengers) {
+        passengerPool.loadList(in, queue);
+    }
+    
+    dispatcher.loadState(in);
+    demandForecaster.loadState(in);
+    nextParkingUpdate = in.readDouble();
+    energyManager.loadState(in);
+    maintenanceManager.loadState(in);
+    metrics.loadState(in);
+    currentTime = in.readDouble();
+}
@@ -1,48 +1,135 @@
 #pragma once
 #include <vector>
-#include <queue>
 #include "elevator.h"
 #include "passenger.h"
+#include "passenger_pool.h"
 #include "dispatcher.h"
 #include "performance.h"
 #include "energy_manager.h"
 #include "maintenance_manager.h"
 #include "data_recorder.h"
+#include "metrics.h"
+#include "run_log.h"
+#include "rollout_dispatcher.h"
+#include "batch_dispatcher.h"
+#include "demand_forecaster.h"
+#include "parking_policy.h"
+#include "engine_snapshot.h"
+#include <memory>
 
 class Building {
-private:
+public:
+    // 默认楼型
     static const int FLOOR_COUNT = 14;
     static const int ELEVATOR_COUNT = 4;
+    static const int CAPACITY = 12;
+    
+private:
+    static constexpr double PARKING_INTERVAL = 5.0;  // 重新选择待命楼层的间隔（秒）
     
+    int floorCount;
+    PassengerPool passengerPool;          // 候梯和电梯中的全部乘客，各层队列和各电梯的链表都在其中
     std::vector<Elevator> elevators;
-    std::vector<std::queue<Passenger>> waitingPassengers;
+    std::vector<PassengerPool::List> waitingPassengers;  // 每层按到达顺序的候梯队列
     Dispatcher dispatcher;
+    RolloutDispatcher rolloutDispatcher;  // 前瞻推演策略使用，复制时只复制设置
+    BatchDispatcher batchDispatcher;      // 批量最优策略使用
+    std::vector<BatchDispatcher::Assignment> batchAssignments;  // 复用缓冲
+    std::vector<PassengerPool::Handle> strandedPassengers;      // 复用缓冲
+    std::shared_ptr<const DemandProfile> expectedTraffic;  // 推演用的预期客流，各副本共享
+    double expectedTrafficScale;          // 模拟一天与24小时的比例
+    DemandForecaster demandForecaster;    // 从实际到达中学习的需求模型，reset 后保留
+    ParkingPolicy parkingPolicy;
+    std::vector<int> parkingFloors;       // 复用缓冲
+    double nextParkingUpdate;
     Performance performance;
     EnergyManager energyManager;
     MaintenanceManager maintenanceManager;
     DataRecorder dataRecorder;
+    SimulationMetrics metrics;
+    std::vector<double> boardingWaits;  // 本步上梯乘客的等待时间（复用缓冲）
+    RunLog::Writer runLog;
+    double runLogTimeOffset;            // 之前各轮模拟的时长，使日志时间跨 reset 单调递增
+    double currentTime;
+    bool recordingEnabled;
+    
+    void assignPassengersToElevators();
+    void releaseStrandedPassengers();
+    void updateParking();
+    long long getRunLogTime() const;
+    void logCarStates();
+    void resetDay();  // reset 和 startNextDay 共用的部分，不含维护状态
     
 public:
-    Building();
+    explicit Building(int floorCount = FLOOR_COUNT, int elevatorCount = ELEVATOR_COUNT, int capacity = CAPACITY);
+    // 复制模拟状态，用于分支推演：记录器历史、运行日志和性能计时不复制，从空白开始
+    Building(const Building& other);
+    Building& operator=(const Building&) = delete;
     
     void update(double deltaTime);
-    void addRequest(int fromFloor, int toFloor, int passengerCount);
+    bool addRequest(int fromFloor, int toFloor, int passengerCount);
     void reset();
+    // 开始下一天：与 reset 相同，但维护状态跨天保留（见 MaintenanceManager::startNextDay）
+    void startNextDay();
+    
+    // 运行数据记录（默认只保存在内存中，需要CSV日志时由前端开启）
+    void startDataLogging(const std::string& filename);
+    void setRecordingEnabled(bool enabled);
+    
+    // 二进制运行日志：配置、电梯状态变化和乘客全过程，可用 RunLog::Reader 回看
+    bool startRunLog(const std::string& filename);
+    void stopRunLog();
+    bool isRunLogging() const;
     
     // 获取状态
     const std::vector<Elevator>& getElevators() const;
-    const std::vector<std::queue<Passenger>>& getWaitingPassengers() const;
+    int getFloorCount() const;
+    PassengerQueue getWaitingQueue(int floor) const;  // floor 层的候梯乘客，按到达顺序
+    const PassengerPool& getPassengerPool() const;
     
     void displayWaitingPassengers() const;
     int getTotalWaitingPassengers() const;
     int getWaitingCountAtFloor(int floor) const;
+    // 填写快照中的电梯和各层候梯状态
+    void fillSnapshot(EngineSnapshot& snapshot) const;
     
     void setDispatchStrategy(Dispatcher::Strategy strategy);
     Dispatcher::Strategy getDispatchStrategy() const;
     const Dispatcher::Statistics& getDispatcherStatistics() const;
+    void setDispatchWeights(const DispatchWeights& weights);
+    const DispatchWeights& getDispatchWeights() const;
+    RolloutDispatcher& getRolloutDispatcher();
+    const RolloutDispatcher& getRolloutDispatcher() const;
+    const BatchDispatcher& getBatchDispatcher() const;
+    
+    // 前瞻推演按需求曲线抽取预期客流，没有设置时只推演已有请求
+    void setExpectedTraffic(const DemandProfile& profile, double timeScale);
+    void clearExpectedTraffic();
+    const DemandProfile* getExpectedTraffic() const;
+    double getExpectedTrafficScale() const;
+    
+    // 需求预测：每个到达都计入模型，跨天（跨 reset）累积；
+    // 预测停靠据此为空闲电梯选择待命楼层，负载均衡调度据此保留待命电梯
+    void setDayLength(double length);  // 模拟一天的时长，需求模型按它划分时段
+    const DemandForecaster& getDemandForecaster() const;
+    DemandForecaster& getDemandForecaster();
+    ParkingPolicy& getParkingPolicy();
+    const ParkingPolicy& getParkingPolicy() const;
+    
+    // 把 floor 层队首的乘客直接分给指定电梯，供推演副本固定待评估的分配和外部决定策略使用
+    bool assignWaitingPassenger(int floor, int elevatorIndex);
+    // 仍在等待（包括已分配未上梯）的乘客已等待的时间之和
+    double getPendingWaitTime() const;
     
     const EnergyManager& getEnergyManager() const;
     const MaintenanceManager& getMaintenanceManager() const;
+    MaintenanceManager& getMaintenanceManager();
     
     const DataRecorder& getDataRecorder() const;
+    const SimulationMetrics& getMetrics() const;
+    double getCurrentTime() const;
+    
+    // 检查点：电梯、等待乘客、调度、需求模型、能耗、维护和指标，不含记录器历史
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
 }; 
\ No newline at end of file
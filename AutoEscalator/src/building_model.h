@@ -0,0 +1,32 @@
+#pragma once
+#include "metrics.h"
+
+struct BuildingTopology {
+    int floors;
+    int elevators;
+    int capacity;
+};
+
+// 精简的楼宇模型：只含电梯运行、候梯队列、超时和最近优先分配，
+// 行为与 Building 在最近优先策略、关闭维护和预测停靠时一致（能耗、记录等外围功能不在其中）。
+// 用于大批量的楼型研究，由 BuildingRegistry 按楼型选择编译期特化的 BuildingT，
+// 没有特化的楼型使用包装按楼型构造的 Building 的 DynamicBuilding
+class BuildingModel {
+public:
+    static const int MAX_WAITING_PER_FLOOR = 256;  // 每层候梯人数上限，超出的请求被拒绝
+    
+    virtual ~BuildingModel() = default;
+    
+    virtual BuildingTopology getTopology() const = 0;
+    virtual bool isSpecialized() const = 0;
+    
+    // 请求无效或该层候梯已满时返回false
+    virtual bool addRequest(int fromFloor, int toFloor, int passengerCount) = 0;
+    virtual void update(double deltaTime) = 0;
+    virtual void reset() = 0;
+    
+    virtual int getCarFloor(int elevator) const = 0;
+    virtual int getCarLoad(int elevator) const = 0;
+    virtual int getWaitingCount(int floor) const = 0;
+    virtual const SimulationMetrics& getMetrics() const = 0;
+};
@@ -0,0 +1,56 @@
+#include "building_registry.h"
+#include "building_t.h"
+#include "dynamic_building.h"
+
+namespace {
+    struct Entry {
+        BuildingTopology topology;
+        std::unique_ptr<BuildingModel> (*create)();
+    };
+    
+    template <int Floors, int Cars, int Capacity>
+    std::unique_ptr<BuildingModel> createSpecialized() {
+        return std::make_unique<BuildingT<Floors, Cars, Capacity>>();
+    }
+    
+    // 新增楼型只需在此加一行
+    const Entry ENTRIES[] = {
+        {{14, 4, 12}, createSpecialized<14, 4, 12>},  // 默认楼型
+        {{20, 6, 12}, createSpecialized<20, 6, 12>},
+        {{30, 6, 16}, createSpecialized<30, 6, 16>},
+        {{40, 8, 12}, createSpecialized<40, 8, 12>},
+        {{60, 12, 20}, createSpecialized<60, 12, 20>},
+    };
+    
+    const Entry* findEntry(const BuildingTopology& topology) {
+        for (const auto& entry : ENTRIES) {
+            if (entry.topology.floors == topology.floors &&
+                entry.topology.elevators == topology.elevators &&
+                entry.topology.capacity == topology.capacity) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+}
+
+std::unique_ptr<BuildingModel> BuildingRegistry::create(const BuildingTopology& topology) {
+    const Entry* entry = findEntry(topology);
+    return entry ? entry->create() : createDynamic(topology);
+}
+
+std::unique_ptr<BuildingModel> BuildingRegistry::createDynamic(const BuildingTopology& topology) {
+    return std::make_unique<DynamicBuilding>(topology);
+}
+
+bool BuildingRegistry::isSpecialized(const BuildingTopology& topology) {
+    return findEntry(topology) != nullptr;
+}
+
+std::vector<BuildingTopology> BuildingRegistry::getSpecializedTopologies() {
+    std::vector<BuildingTopology> topologies;
+    for (const auto& entry : ENTRIES) {
+        topologies.push_back(entry.topology);
+    }
+    return topologies;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "building_model.h"
+#include <memory>
+#include <vector>
+
+// 常用楼型的编译期特化表。启动时按楼型创建模型，表中没有的楼型使用 DynamicBuilding
+class BuildingRegistry {
+public:
+    static std::unique_ptr<BuildingModel> create(const BuildingTopology& topology);
+    // 不查特化表，总是创建运行时大小的模型（用于对照）
+    static std::unique_ptr<BuildingModel> createDynamic(const BuildingTopology& topology);
+    static bool isSpecialized(const BuildingTopology& topology);
+    static std::vector<BuildingTopology> getSpecializedTopologies();
+};
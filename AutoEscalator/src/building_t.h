@@ -0,0 +1,305 @@
+#pragma once
+#include "building_model.h"
+#include "config.h"
+#include "elevator.h"
+#include <array>
+#include <bitset>
+#include <cstdlib>
+#include <utility>
+
+// 编译期确定楼层数、电梯数和载客量的楼宇模型，行为与 DynamicBuilding 逐位一致：
+// - 候梯队列为每层定长的环形缓冲，乘客只保存目的层和已等待时间
+// - 轿厢内乘客只按目的层计数，停靠层用 std::bitset<Floors> 表示，找方向只需移位判断
+// - 已分配待接的乘客放在定长数组里，保持分配顺序，上梯时按此顺序计入等待时间
+// - 逐部电梯的循环在编译期展开
+template <int Floors, int Cars, int Capacity>
+class BuildingT : public BuildingModel {
+    static_assert(Floors >= 2 && Cars >= 1 && Capacity >= 1, "楼型参数无效");
+
+private:
+    static constexpr double DOOR_DWELL_TIME = 2.0;  // 与 Elevator 相同
+
+    struct Waiting {
+        int targetFloor;
+        double waitTime;
+    };
+
+    struct FloorQueue {
+        std::array<Waiting, MAX_WAITING_PER_FLOOR> items;
+        int head = 0;
+        int size = 0;
+
+        Waiting& at(int i) { return items[(head + i) % MAX_WAITING_PER_FLOOR]; }
+        const Waiting& at(int i) const { return items[(head + i) % MAX_WAITING_PER_FLOOR]; }
+        void pop() {
+            head = (head + 1) % MAX_WAITING_PER_FLOOR;
+            --size;
+        }
+    };
+
+    struct Assigned {
+        int sourceFloor;
+        int targetFloor;
+        double waitTime;
+    };
+
+    struct Car {
+        int floor;
+        ElevatorState state;
+        ElevatorState lastDirection;
+        double idleTime;
+        double floorTravelTime;
+        bool returningHome;
+        int load;            // 轿厢内人数
+        int assignedCount;   // 已分配待接人数
+        int delivered;
+        std::bitset<Floors> dropStops;    // 轿厢内乘客的目的层（第 i 位为 i+1 层）
+        std::bitset<Floors> pickupStops;  // 待接乘客的出发层
+        std::array<int, Floors + 1> dropCount;
+        std::array<int, Floors + 1> pickupCount;
+        std::array<Assigned, Capacity> assigned;
+    };
+
+    std::array<Car, Cars> cars;
+    std::array<FloorQueue, Floors + 1> waiting;
+    SimulationMetrics metrics;
+
+    template <typename Function, size_t... Index>
+    static void forEachCar(Function&& function, std::index_sequence<Index...>) {
+        (function(std::integral_constant<size_t, Index>()), ...);
+    }
+
+    template <typename Function>
+    static void forEachCar(Function&& function) {
+        forEachCar(std::forward<Function>(function), std::make_index_sequence<Cars>());
+    }
+
+    static bool hasStopInDirection(const Car& car, ElevatorState direction) {
+        std::bitset<Floors> stops = car.dropStops | car.pickupStops;
+        if (direction == ElevatorState::MOVING_UP) {
+            return (stops >> car.floor).any();             // 高于当前层的位
+        }
+        return (stops << (Floors - car.floor + 1)).any();  // 低于当前层的位
+    }
+
+    static ElevatorState chooseDirection(const Car& car) {
+        if (car.lastDirection != ElevatorState::IDLE && hasStopInDirection(car, car.lastDirection)) {
+            return car.lastDirection;
+        }
+        if (hasStopInDirection(car, ElevatorState::MOVING_UP)) return ElevatorState::MOVING_UP;
+        if (hasStopInDirection(car, ElevatorState::MOVING_DOWN)) return ElevatorState::MOVING_DOWN;
+        return ElevatorState::IDLE;
+    }
+
+    // 在当前层下客并接载已分配的乘客，有人上下时返回true
+    bool serveCurrentFloor(Car& car) {
+        int floor = car.floor;
+        bool served = false;
+        if (car.dropStops.test(floor - 1)) {
+            car.load -= car.dropCount[floor];
+            car.delivered += car.dropCount[floor];
+            car.dropCount[floor] = 0;
+            car.dropStops.reset(floor - 1);
+            served = true;
+        }
+        if (car.pickupStops.test(floor - 1)) {
+            int kept = 0;
+            for (int i = 0; i < car.assignedCount; ++i) {
+                const Assigned& passenger = car.assigned[i];
+                if (passenger.sourceFloor == floor) {
+                    metrics.recordBoarding(passenger.waitTime);
+                    car.dropCount[passenger.targetFloor]++;
+                    car.dropStops.set(passenger.targetFloor - 1);
+                    car.load++;
+                } else {
+                    car.assigned[kept++] = passenger;
+                }
+            }
+            car.assignedCount = kept;
+            car.pickupCount[floor] = 0;
+            car.pickupStops.reset(floor - 1);
+            served = true;
+        }
+        return served;
+    }
+
+    // 与 Elevator::update 相同的状态机，待命楼层固定为1楼
+    void updateCar(Car& car, double deltaTime) {
+        for (int i = 0; i < car.assignedCount; ++i) {
+            car.assigned[i].waitTime += deltaTime;
+        }
+
+        switch (car.state) {
+            case ElevatorState::MOVING_UP:
+            case ElevatorState::MOVING_DOWN:
+                car.floorTravelTime += deltaTime;
+                if (car.floorTravelTime >= ElevatorConfig::FLOOR_TRAVEL_TIME) {
+                    car.floor += car.state == ElevatorState::MOVING_UP ? 1 : -1;
+                    car.floorTravelTime = 0.0;
+                    car.lastDirection = car.state;
+
+                    if (serveCurrentFloor(car)) {
+                        car.state = ElevatorState::STOPPED;
+                        car.idleTime = 0.0;
+                        car.returningHome = false;
+                    } else {
+                        ElevatorState next = chooseDirection(car);
+                        if (next != ElevatorState::IDLE) {
+                            car.state = next;
+                            car.returningHome = false;
+                        } else if (!car.returningHome || car.floor == 1) {
+                            car.state = ElevatorState::IDLE;
+                            car.idleTime = 0.0;
+                            car.returningHome = false;
+                        } else {
+                            car.state = ElevatorState::MOVING_DOWN;
+                        }
+                    }
+                }
+                break;
+
+            case ElevatorState::IDLE:
+                if (serveCurrentFloor(car)) {
+                    car.state = ElevatorState::STOPPED;
+                    car.idleTime = 0.0;
+                    break;
+                }
+                car.state = chooseDirection(car);
+                if (car.state != ElevatorState::IDLE) {
+                    car.idleTime = 0.0;
+                    break;
+                }
+                car.idleTime += deltaTime;
+                if (car.idleTime >= ElevatorConfig::MAX_IDLE_TIME && car.floor != 1) {
+                    car.state = ElevatorState::MOVING_DOWN;
+                    car.returningHome = true;
+                    car.idleTime = 0.0;
+                }
+                break;
+
+            case ElevatorState::STOPPED:
+                car.idleTime += deltaTime;
+                if (car.idleTime >= DOOR_DWELL_TIME) {
+                    serveCurrentFloor(car);
+                    car.state = chooseDirection(car);
+                    car.idleTime = 0.0;
+                }
+                break;
+        }
+    }
+
+    // 最近优先：距离相同时取编号小的电梯，满载的电梯跳过
+    int findNearestCar(int floor) const {
+        int best = -1;
+        int bestDistance = Floors + 1;
+        forEachCar([&](auto index) {
+            const Car& car = cars[index];
+            int distance = std::abs(car.floor - floor);
+            if (car.load + car.assignedCount < Capacity && distance < bestDistance) {
+                bestDistance = distance;
+                best = static_cast<int>(index);
+            }
+        });
+        return best;
+    }
+
+public:
+    BuildingT() {
+        reset();
+    }
+
+    BuildingTopology getTopology() const override {
+        return BuildingTopology{Floors, Cars, Capacity};
+    }
+
+    bool isSpecialized() const override {
+        return true;
+    }
+
+    bool addRequest(int fromFloor, int toFloor, int passengerCount) override {
+        if (fromFloor < 1 || fromFloor > Floors || toFloor < 1 || toFloor > Floors ||
+            fromFloor == toFloor || passengerCount <= 0 ||
+            waiting[fromFloor].size + passengerCount > MAX_WAITING_PER_FLOOR) {
+            return false;
+        }
+        FloorQueue& queue = waiting[fromFloor];
+        for (int i = 0; i < passengerCount; ++i) {
+            queue.at(queue.size++) = Waiting{toFloor, 0.0};
+        }
+        metrics.recordRequest(passengerCount);
+        return true;
+    }
+
+    void update(double deltaTime) override {
+        forEachCar([&](auto index) {
+            int before = cars[index].delivered;
+            updateCar(cars[index], deltaTime);
+            metrics.recordDeliveries(cars[index].delivered - before);
+        });
+
+        // 同层乘客按到达顺序排队，等待时间从队首起递减，超时的总在队首
+        for (int floor = 1; floor <= Floors; ++floor) {
+            FloorQueue& queue = waiting[floor];
+            for (int i = 0; i < queue.size; ++i) {
+                queue.at(i).waitTime += deltaTime;
+            }
+            while (queue.size > 0 && queue.at(0).waitTime >= ElevatorConfig::MAX_WAIT_TIME) {
+                queue.pop();
+                metrics.recordTimeout();
+            }
+        }
+
+        for (int floor = 1; floor <= Floors; ++floor) {
+            FloorQueue& queue = waiting[floor];
+            while (queue.size > 0) {
+                int index = findNearestCar(floor);
+                if (index < 0) break;
+                Car& car = cars[index];
+                const Waiting& passenger = queue.at(0);
+                car.assigned[car.assignedCount++] = Assigned{floor, passenger.targetFloor, passenger.waitTime};
+                car.pickupCount[floor]++;
+                car.pickupStops.set(floor - 1);
+                queue.pop();
+            }
+        }
+    }
+
+    void reset() override {
+        for (Car& car : cars) {
+            car.floor = 1;
+            car.state = ElevatorState::IDLE;
+            car.lastDirection = ElevatorState::IDLE;
+            car.idleTime = 0.0;
+            car.floorTravelTime = 0.0;
+            car.returningHome = false;
+            car.load = 0;
+            car.assignedCount = 0;
+            car.delivered = 0;
+            car.dropStops.reset();
+            car.pickupStops.reset();
+            car.dropCount.fill(0);
+            car.pickupCount.fill(0);
+        }
+        for (FloorQueue& queue : waiting) {
+            queue.head = 0;
+            queue.size = 0;
+        }
+        metrics.reset();
+    }
+
+    int getCarFloor(int elevator) const override {
+        return cars[elevator].floor;
+    }
+
+    int getCarLoad(int elevator) const override {
+        return cars[elevator].load;
+    }
+
+    int getWaitingCount(int floor) const override {
+        return (floor < 1 || floor > Floors) ? 0 : waiting[floor].size;
+    }
+
+    const SimulationMetrics& getMetrics() const override {
+        return metrics;
+    }
+};
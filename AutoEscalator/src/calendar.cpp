@@ -0,0 +1,115 @@
+#include "calendar.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+    std::string stripComment(const std::string& line) {
+        return line.substr(0, line.find('#'));
+    }
+
+    // 解析 <天> 或 <天>-<天>
+    bool parseRange(const std::string& text, int& first, int& last) {
+        char dash = 0;
+        std::istringstream input(text);
+        if (!(input >> first)) return false;
+        last = first;
+        if (input >> dash) {
+            if (dash != '-' || !(input >> last)) return false;
+        }
+        return input.eof() && first >= 1 && last >= first;
+    }
+}
+
+Calendar::Calendar() : firstWeekday(1) {}
+
+bool Calendar::fail(int lineNumber, const std::string& message) {
+    lastError = "第" + std::to_string(lineNumber) + "行: " + message;
+    return false;
+}
+
+bool Calendar::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        lastError = "无法打开文件: " + filename;
+        return false;
+    }
+
+    firstWeekday = 1;
+    holidays.clear();
+    workdays.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream input(stripComment(line));
+        std::string keyword;
+        if (!(input >> keyword)) continue;
+
+        if (keyword == "start") {
+            int weekday = 0;
+            if (!(input >> weekday) || weekday < 1 || weekday > 7) {
+                return fail(lineNumber, "start 后应为1-7（1为星期一）");
+            }
+            firstWeekday = weekday;
+        } else if (keyword == "holiday" || keyword == "workday") {
+            std::string range;
+            int first = 0, last = 0;
+            if (!(input >> range) || !parseRange(range, first, last)) {
+                return fail(lineNumber, keyword + " 后应为 <天> 或 <天>-<天>，天数从1起计");
+            }
+            for (int day = first; day <= last; ++day) {
+                if (keyword == "holiday") addHoliday(day - 1);
+                else addWorkday(day - 1);
+            }
+        } else {
+            return fail(lineNumber, "未知关键字: " + keyword);
+        }
+    }
+    return true;
+}
+
+const std::string& Calendar::getLastError() const {
+    return lastError;
+}
+
+void Calendar::setFirstWeekday(int weekday) {
+    if (weekday >= 1 && weekday <= 7) {
+        firstWeekday = weekday;
+    }
+}
+
+int Calendar::getFirstWeekday() const {
+    return firstWeekday;
+}
+
+void Calendar::addHoliday(int day) {
+    holidays.insert(day);
+}
+
+void Calendar::addWorkday(int day) {
+    workdays.insert(day);
+}
+
+int Calendar::getWeekday(int day) const {
+    return (firstWeekday - 1 + day % 7) % 7 + 1;
+}
+
+Calendar::DayType Calendar::getDayType(int day) const {
+    if (holidays.count(day)) return DayType::HOLIDAY;
+    if (workdays.count(day)) return DayType::WEEKDAY;
+    return getWeekday(day) >= 6 ? DayType::WEEKEND : DayType::WEEKDAY;
+}
+
+const char* Calendar::getDayTypeName(DayType type) {
+    switch (type) {
+        case DayType::WEEKDAY: return "工作日";
+        case DayType::WEEKEND: return "周末";
+        case DayType::HOLIDAY: return "节假日";
+    }
+    return "未知";
+}
+
+const char* Calendar::getWeekdayName(int weekday) {
+    static const char* NAMES[] = {"周一", "周二", "周三", "周四", "周五", "周六", "周日"};
+    return weekday >= 1 && weekday <= 7 ? NAMES[weekday - 1] : "未知";
+}
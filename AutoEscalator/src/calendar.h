@@ -0,0 +1,46 @@
+#pragma once
+#include <set>
+#include <string>
+
+// 模拟日历：把多天运行中的第几天映射为星期几和天类型（工作日、周末、节假日），
+// 多天模拟按天类型换用客流曲线并分别汇总指标。
+//
+// 文件格式（# 之后为注释），天数从1起计：
+//   start <1-7>             第1天是星期几（1为星期一），默认星期一
+//   holiday <天>[-<天>]     节假日，可写范围
+//   workday <天>            调休上班的周末，按工作日处理
+class Calendar {
+public:
+    enum class DayType {
+        WEEKDAY,
+        WEEKEND,
+        HOLIDAY
+    };
+    static constexpr int DAY_TYPE_COUNT = 3;
+
+private:
+    int firstWeekday;     // 第0天是星期几，1-7
+    std::set<int> holidays;
+    std::set<int> workdays;
+    std::string lastError;
+
+    bool fail(int lineNumber, const std::string& message);
+
+public:
+    Calendar();
+
+    bool loadFromFile(const std::string& filename);
+    const std::string& getLastError() const;
+
+    // 以下天数都从0起计
+    void setFirstWeekday(int weekday);
+    int getFirstWeekday() const;
+    void addHoliday(int day);
+    void addWorkday(int day);
+
+    int getWeekday(int day) const;  // 1-7，1为星期一
+    DayType getDayType(int day) const;
+
+    static const char* getDayTypeName(DayType type);
+    static const char* getWeekdayName(int weekday);
+};
@@ -0,0 +1,79 @@
+#include "car_bank.h"
+#include <algorithm>
+
+CarBank::CarBank() : carCount(0), floorCount(0) {}
+
+void CarBank::load(const std::vector<Elevator>& elevators) {
+    carCount = elevators.size();
+    floorCount = elevators.empty() ? 0 : elevators.front().getFloorCount();
+    size_t padded = (carCount + LANES - 1) / LANES * LANES;
+    floors.assign(padded, 0.0);
+    directions.assign(padded, 0.0);
+    loads.assign(padded, 0.0);
+    committed.assign(padded, 0.0);
+    capacities.assign(padded, 1.0);
+    idle.assign(padded, 0.0);
+    available.assign(padded, 0.0);
+    reserve.assign(padded, 0.0);
+    inService.assign(padded, false);
+    
+    for (size_t i = 0; i < carCount; ++i) {
+        const Elevator& elevator = elevators[i];
+        ElevatorState state = elevator.getState();
+        floors[i] = elevator.getCurrentFloor();
+        directions[i] = state == ElevatorState::MOVING_UP ? 1.0
+                      : state == ElevatorState::MOVING_DOWN ? -1.0 : 0.0;
+        loads[i] = elevator.getCurrentLoad();
+        committed[i] = elevator.getCommittedLoad();
+        capacities[i] = elevator.getCapacity();
+        idle[i] = state == ElevatorState::IDLE ? 1.0 : 0.0;
+        inService[i] = elevator.isInService();
+        updateAvailable(i);
+    }
+}
+
+void CarBank::setReserve(const std::vector<double>& floorDemand, double weight) {
+    for (size_t i = 0; i < carCount; ++i) {
+        size_t floor = static_cast<size_t>(floors[i]);
+        reserve[i] = (idle[i] != 0.0 && committed[i] == 0.0 && floor < floorDemand.size())
+            ? weight * std::min(1.0, floorDemand[floor]) : 0.0;
+    }
+}
+
+void CarBank::updateAvailable(size_t car) {
+    available[car] = (inService[car] && committed[car] < capacities[car]) ? 1.0 : 0.0;
+}
+
+void CarBank::setInService(size_t car, bool value) {
+    if (car >= carCount) return;
+    inService[car] = value;
+    updateAvailable(car);
+}
+
+void CarBank::commit(size_t car) {
+    if (car >= carCount) return;
+    committed[car] += 1.0;
+    reserve[car] = 0.0;  // 有了任务就不再是待命电梯
+    updateAvailable(car);
+}
+
+size_t CarBank::size() const {
+    return carCount;
+}
+
+size_t CarBank::paddedSize() const {
+    return floors.size();
+}
+
+int CarBank::getFloorCount() const {
+    return floorCount;
+}
+
+const double* CarBank::getFloors() const { return floors.data(); }
+const double* CarBank::getDirections() const { return directions.data(); }
+const double* CarBank::getLoads() const { return loads.data(); }
+const double* CarBank::getCommitted() const { return committed.data(); }
+const double* CarBank::getCapacities() const { return capacities.data(); }
+const double* CarBank::getIdle() const { return idle.data(); }
+const double* CarBank::getAvailable() const { return available.data(); }
+const double* CarBank::getReserve() const { return reserve.data(); }
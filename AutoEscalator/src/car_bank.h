@@ -0,0 +1,51 @@
+#pragma once
+#include "elevator.h"
+#include <cstddef>
+#include <vector>
+
+// 调度用的电梯热字段，按字段分别连续存放（SoA），供 CostKernels 一次计算全部电梯的代价。
+// 数组长度补齐到 LANES 的整数倍，补出的电梯不可用；楼层、人数等都存为 double，
+// 使向量内核与原先逐部电梯的标量计算逐位一致
+class CarBank {
+public:
+    static const size_t LANES = 4;  // AVX2 一次处理的 double 个数
+    
+private:
+    size_t carCount;
+    int floorCount;                   // 所在楼宇的楼层数，与 Elevator::estimateArrivalTime 的折返时间一致
+    std::vector<double> floors;
+    std::vector<double> directions;   // 上行1、下行-1、其他0
+    std::vector<double> loads;        // 轿厢内人数
+    std::vector<double> committed;    // 轿厢内人数 + 已分配待接人数
+    std::vector<double> capacities;
+    std::vector<double> idle;         // 空闲为1
+    std::vector<double> available;    // 未满载且在服务中为1，否则为0
+    std::vector<double> reserve;      // 负载均衡的待命保留代价（见 Dispatcher）
+    std::vector<bool> inService;
+    
+    void updateAvailable(size_t car);
+    
+public:
+    CarBank();
+    
+    // 从电梯对象装入全部热字段（含是否在服务中）和楼宇的楼层数，保留代价为0
+    void load(const std::vector<Elevator>& elevators);
+    // 负载均衡的待命保留代价：空闲无任务的电梯按所在楼层的预计需求计，离开本层时加上
+    void setReserve(const std::vector<double>& floorDemand, double weight);
+    void setInService(size_t car, bool value);
+    // 本轮分配中给 car 计入一位乘客
+    void commit(size_t car);
+    
+    size_t size() const;          // 实际电梯数
+    size_t paddedSize() const;    // 补齐后的长度
+    int getFloorCount() const;
+    
+    const double* getFloors() const;
+    const double* getDirections() const;
+    const double* getLoads() const;
+    const double* getCommitted() const;
+    const double* getCapacities() const;
+    const double* getIdle() const;
+    const double* getAvailable() const;
+    const double* getReserve() const;
+};
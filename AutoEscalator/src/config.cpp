@@ -11,6 +11,36 @@ double ElevatorConfig::MAX_IDLE_TIME = 10.0;
 double ElevatorConfig::MAX_WAIT_TIME = 120.0;
 int ElevatorConfig::DEFAULT_REQUEST_COUNT = 5;
 
+const char* const ElevatorConfig::KEYS[] = {
+    "FLOOR_COUNT", "ELEVATOR_COUNT", "MAX_CAPACITY", "FLOOR_TRAVEL_TIME",
+    "MAX_IDLE_TIME", "MAX_WAIT_TIME", "DEFAULT_REQUEST_COUNT"
+};
+const int ElevatorConfig::KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+
+bool ElevatorConfig::getValue(const std::string& key, double& value) {
+    if (key == "FLOOR_COUNT") value = FLOOR_COUNT;
+    else if (key == "ELEVATOR_COUNT") value = ELEVATOR_COUNT;
+    else if (key == "MAX_CAPACITY") value = MAX_CAPACITY;
+    else if (key == "FLOOR_TRAVEL_TIME") value = FLOOR_TRAVEL_TIME;
+    else if (key == "MAX_IDLE_TIME") value = MAX_IDLE_TIME;
+    else if (key == "MAX_WAIT_TIME") value = MAX_WAIT_TIME;
+    else if (key == "DEFAULT_REQUEST_COUNT") value = DEFAULT_REQUEST_COUNT;
+    else return false;
+    return true;
+}
+
+bool ElevatorConfig::setValue(const std::string& key, double value) {
+    if (key == "FLOOR_COUNT") FLOOR_COUNT = static_cast<int>(value);
+    else if (key == "ELEVATOR_COUNT") ELEVATOR_COUNT = static_cast<int>(value);
+    else if (key == "MAX_CAPACITY") MAX_CAPACITY = static_cast<int>(value);
+    else if (key == "FLOOR_TRAVEL_TIME") FLOOR_TRAVEL_TIME = value;
+    else if (key == "MAX_IDLE_TIME") MAX_IDLE_TIME = value;
+    else if (key == "MAX_WAIT_TIME") MAX_WAIT_TIME = value;
+    else if (key == "DEFAULT_REQUEST_COUNT") DEFAULT_REQUEST_COUNT = static_cast<int>(value);
+    else return false;
+    return true;
+}
+
 void ElevatorConfig::loadDefaultConfig() {
     FLOOR_COUNT = 14;
     ELEVATOR_COUNT = 4;
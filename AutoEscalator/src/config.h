@@ -13,4 +13,10 @@ struct ElevatorConfig {
     static void loadDefaultConfig();
     static void saveConfig(const std::string& filename = "elevator.conf");
     static bool loadConfig(const std::string& filename = "elevator.conf");
+    
+    // 按配置文件中的键名读写配置项，整数项按取整处理；未知键名返回false
+    static const char* const KEYS[];
+    static const int KEY_COUNT;
+    static bool getValue(const std::string& key, double& value);
+    static bool setValue(const std::string& key, double value);
 }; 
\ No newline at end of file
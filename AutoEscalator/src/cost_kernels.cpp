@@ -0,0 +1,268 @@
+#include "cost_kernels.h"
+#include "config.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define COST_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    const double INF = std::numeric_limits<double>::infinity();
+    
+    double movingAwayPenalty(const CarBank& cars) {
+        return cars.getFloorCount() * ElevatorConfig::FLOOR_TRAVEL_TIME / 2;
+    }
+    
+    // ---- 标量实现 ----
+    
+    int nearestScalar(const CarBank& cars, double floor) {
+        const double* floors = cars.getFloors();
+        const double* available = cars.getAvailable();
+        int best = -1;
+        double bestCost = INF;
+        for (size_t i = 0; i < cars.size(); ++i) {
+            double cost = std::fabs(floors[i] - floor);
+            if (available[i] != 0.0 && cost < bestCost) {
+                bestCost = cost;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+    
+    int loadBalancedScalar(const CarBank& cars, double floor, double distanceWeight) {
+        const double* floors = cars.getFloors();
+        const double* committed = cars.getCommitted();
+        const double* capacities = cars.getCapacities();
+        const double* reserve = cars.getReserve();
+        const double* available = cars.getAvailable();
+        int best = -1;
+        double bestCost = INF;
+        for (size_t i = 0; i < cars.size(); ++i) {
+            double cost = committed[i] / capacities[i] + std::fabs(floors[i] - floor) * distanceWeight;
+            cost += floors[i] != floor ? reserve[i] : 0.0;
+            if (available[i] != 0.0 && cost < bestCost) {
+                bestCost = cost;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+    
+    int energySavingScalar(const CarBank& cars, double floor, double idleStartFactor) {
+        const double* floors = cars.getFloors();
+        const double* idle = cars.getIdle();
+        const double* available = cars.getAvailable();
+        int best = -1;
+        double bestCost = INF;
+        for (size_t i = 0; i < cars.size(); ++i) {
+            double cost = std::fabs(floors[i] - floor) * (idle[i] != 0.0 ? idleStartFactor : 1.0);
+            if (available[i] != 0.0 && cost < bestCost) {
+                bestCost = cost;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+    
+    void arrivalTimesScalar(const CarBank& cars, double floor, double* out) {
+        const double* floors = cars.getFloors();
+        const double* directions = cars.getDirections();
+        const double* committed = cars.getCommitted();
+        double penalty = movingAwayPenalty(cars);
+        for (size_t i = 0; i < cars.paddedSize(); ++i) {
+            double offset = floor - floors[i];
+            double time = std::fabs(offset) * ElevatorConfig::FLOOR_TRAVEL_TIME +
+                          committed[i] * Elevator::DOOR_DWELL_TIME;
+            if (directions[i] * offset < 0) {
+                time += penalty;
+            }
+            out[i] = time;
+        }
+    }
+    
+#ifdef COST_KERNELS_AVX2
+    // ---- AVX2 实现：每次4部电梯。先算出全部代价并求最小值，再找第一个等于最小值的电梯，
+    // 两遍扫描都没有逐元素的分支，也避免了逐通道记录下标的长依赖链 ----
+    
+    const size_t STACK_CARS = 256;
+    
+    // 大于 STACK_CARS 部电梯时使用的线程内缓冲
+    double* costBuffer(double* stackBuffer, size_t size) {
+        if (size <= STACK_CARS) return stackBuffer;
+        thread_local std::vector<double> buffer;
+        buffer.resize(size);
+        return buffer.data();
+    }
+    
+    __attribute__((target("avx2"))) inline __m256d absolute(__m256d value) {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+    }
+    
+    // 屏蔽不可用的电梯（代价置为无穷大），写入 costs 并更新最小值
+    __attribute__((target("avx2"))) inline __m256d storeMasked(__m256d cost, const double* available,
+                                                               double* costs, __m256d minimum) {
+        __m256d usable = _mm256_cmp_pd(_mm256_loadu_pd(available), _mm256_setzero_pd(), _CMP_NEQ_OQ);
+        cost = _mm256_blendv_pd(_mm256_set1_pd(INF), cost, usable);
+        _mm256_storeu_pd(costs, cost);
+        return _mm256_min_pd(minimum, cost);
+    }
+    
+    __attribute__((target("avx2"))) inline int findMinimum(const double* costs, size_t size, __m256d minimum) {
+        alignas(32) double lanes[CarBank::LANES];
+        _mm256_store_pd(lanes, minimum);
+        double best = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+        if (best == INF) return -1;
+        
+        __m256d target = _mm256_set1_pd(best);
+        for (size_t i = 0; i < size; i += CarBank::LANES) {
+            int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(costs + i), target, _CMP_EQ_OQ));
+            if (mask != 0) {
+                return static_cast<int>(i) + __builtin_ctz(mask);
+            }
+        }
+        return -1;
+    }
+    
+    __attribute__((target("avx2"))) int nearestAvx2(const CarBank& cars, double floor) {
+        const double* floors = cars.getFloors();
+        const double* available = cars.getAvailable();
+        __m256d request = _mm256_set1_pd(floor);
+        double stackCosts[STACK_CARS];
+        double* costs = costBuffer(stackCosts, cars.paddedSize());
+        __m256d minimum = _mm256_set1_pd(INF);
+        for (size_t i = 0; i < cars.paddedSize(); i += CarBank::LANES) {
+            __m256d cost = absolute(_mm256_sub_pd(_mm256_loadu_pd(floors + i), request));
+            minimum = storeMasked(cost, available + i, costs + i, minimum);
+        }
+        return findMinimum(costs, cars.paddedSize(), minimum);
+    }
+    
+    __attribute__((target("avx2"))) int loadBalancedAvx2(const CarBank& cars, double floor, double distanceWeight) {
+        const double* floors = cars.getFloors();
+        const double* committed = cars.getCommitted();
+        const double* capacities = cars.getCapacities();
+        const double* reserve = cars.getReserve();
+        const double* available = cars.getAvailable();
+        __m256d request = _mm256_set1_pd(floor);
+        __m256d weight = _mm256_set1_pd(distanceWeight);
+        double stackCosts[STACK_CARS];
+        double* costs = costBuffer(stackCosts, cars.paddedSize());
+        __m256d minimum = _mm256_set1_pd(INF);
+        for (size_t i = 0; i < cars.paddedSize(); i += CarBank::LANES) {
+            __m256d carFloor = _mm256_loadu_pd(floors + i);
+            __m256d ratio = _mm256_div_pd(_mm256_loadu_pd(committed + i), _mm256_loadu_pd(capacities + i));
+            __m256d distance = absolute(_mm256_sub_pd(carFloor, request));
+            __m256d cost = _mm256_add_pd(ratio, _mm256_mul_pd(distance, weight));
+            __m256d leaving = _mm256_cmp_pd(carFloor, request, _CMP_NEQ_OQ);
+            cost = _mm256_add_pd(cost, _mm256_and_pd(leaving, _mm256_loadu_pd(reserve + i)));
+            minimum = storeMasked(cost, available + i, costs + i, minimum);
+        }
+        return findMinimum(costs, cars.paddedSize(), minimum);
+    }
+    
+    __attribute__((target("avx2"))) int energySavingAvx2(const CarBank& cars, double floor, double idleStartFactor) {
+        const double* floors = cars.getFloors();
+        const double* idle = cars.getIdle();
+        const double* available = cars.getAvailable();
+        __m256d request = _mm256_set1_pd(floor);
+        __m256d factor = _mm256_set1_pd(idleStartFactor);
+        __m256d one = _mm256_set1_pd(1.0);
+        double stackCosts[STACK_CARS];
+        double* costs = costBuffer(stackCosts, cars.paddedSize());
+        __m256d minimum = _mm256_set1_pd(INF);
+        for (size_t i = 0; i < cars.paddedSize(); i += CarBank::LANES) {
+            __m256d distance = absolute(_mm256_sub_pd(_mm256_loadu_pd(floors + i), request));
+            __m256d isIdle = _mm256_cmp_pd(_mm256_loadu_pd(idle + i), _mm256_setzero_pd(), _CMP_NEQ_OQ);
+            __m256d cost = _mm256_mul_pd(distance, _mm256_blendv_pd(one, factor, isIdle));
+            minimum = storeMasked(cost, available + i, costs + i, minimum);
+        }
+        return findMinimum(costs, cars.paddedSize(), minimum);
+    }
+    
+    __attribute__((target("avx2"))) void arrivalTimesAvx2(const CarBank& cars, double floor, double* out) {
+        const double* floors = cars.getFloors();
+        const double* directions = cars.getDirections();
+        const double* committed = cars.getCommitted();
+        __m256d request = _mm256_set1_pd(floor);
+        __m256d travel = _mm256_set1_pd(ElevatorConfig::FLOOR_TRAVEL_TIME);
+        __m256d dwell = _mm256_set1_pd(Elevator::DOOR_DWELL_TIME);
+        __m256d penalty = _mm256_set1_pd(movingAwayPenalty(cars));
+        for (size_t i = 0; i < cars.paddedSize(); i += CarBank::LANES) {
+            __m256d offset = _mm256_sub_pd(request, _mm256_loadu_pd(floors + i));
+            __m256d time = _mm256_add_pd(_mm256_mul_pd(absolute(offset), travel),
+                                         _mm256_mul_pd(_mm256_loadu_pd(committed + i), dwell));
+            __m256d away = _mm256_cmp_pd(_mm256_mul_pd(_mm256_loadu_pd(directions + i), offset),
+                                         _mm256_setzero_pd(), _CMP_LT_OQ);
+            time = _mm256_add_pd(time, _mm256_and_pd(away, penalty));
+            _mm256_storeu_pd(out + i, time);
+        }
+    }
+#endif
+    
+    CostKernels::Isa detectIsa() {
+#ifdef COST_KERNELS_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            return CostKernels::Isa::AVX2;
+        }
+#endif
+        return CostKernels::Isa::SCALAR;
+    }
+    
+    CostKernels::Isa activeIsa = detectIsa();
+}
+
+namespace CostKernels {
+    Isa getIsa() {
+        return activeIsa;
+    }
+    
+    bool isSupported(Isa isa) {
+        return isa == Isa::SCALAR || detectIsa() == Isa::AVX2;
+    }
+    
+    bool setIsa(Isa isa) {
+        if (!isSupported(isa)) return false;
+        activeIsa = isa;
+        return true;
+    }
+    
+    const char* getIsaName(Isa isa) {
+        return isa == Isa::AVX2 ? "AVX2" : "标量";
+    }
+    
+    int nearest(const CarBank& cars, int floor) {
+#ifdef COST_KERNELS_AVX2
+        if (activeIsa == Isa::AVX2) return nearestAvx2(cars, floor);
+#endif
+        return nearestScalar(cars, floor);
+    }
+    
+    int loadBalanced(const CarBank& cars, int floor, double distanceWeight) {
+#ifdef COST_KERNELS_AVX2
+        if (activeIsa == Isa::AVX2) return loadBalancedAvx2(cars, floor, distanceWeight);
+#endif
+        return loadBalancedScalar(cars, floor, distanceWeight);
+    }
+    
+    int energySaving(const CarBank& cars, int floor, double idleStartFactor) {
+#ifdef COST_KERNELS_AVX2
+        if (activeIsa == Isa::AVX2) return energySavingAvx2(cars, floor, idleStartFactor);
+#endif
+        return energySavingScalar(cars, floor, idleStartFactor);
+    }
+    
+    void arrivalTimes(const CarBank& cars, int floor, double* out) {
+#ifdef COST_KERNELS_AVX2
+        if (activeIsa == Isa::AVX2) {
+            arrivalTimesAvx2(cars, floor, out);
+            return;
+        }
+#endif
+        arrivalTimesScalar(cars, floor, out);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "car_bank.h"
+
+// 一次计算 CarBank 中全部电梯对某个楼层请求的代价，返回代价最小的可用电梯（代价相同取编号小的），
+// 没有可用电梯时返回-1。满载或停止服务的电梯被屏蔽。
+// 有 AVX2 时按4部电梯一组计算，否则用标量实现；两者与原先逐部电梯的计算结果逐位一致
+namespace CostKernels {
+    enum class Isa {
+        SCALAR,
+        AVX2
+    };
+    
+    // 启动时按CPU检测；setIsa 用于对照测试，不支持的指令集返回false。
+    // 只应在没有其他线程调度时切换
+    Isa getIsa();
+    bool setIsa(Isa isa);
+    bool isSupported(Isa isa);
+    const char* getIsaName(Isa isa);
+    
+    // 最近优先：楼层距离
+    int nearest(const CarBank& cars, int floor);
+    // 负载均衡：承诺载客率 + 距离 × distanceWeight + 离开本层时的待命保留代价
+    int loadBalanced(const CarBank& cars, int floor, double distanceWeight);
+    // 节能模式：距离，空闲电梯乘以 idleStartFactor
+    int energySaving(const CarBank& cars, int floor, double idleStartFactor);
+    
+    // 各电梯到达 floor 的估算时间，与 Elevator::estimateArrivalTime 相同；
+    // out 至少 paddedSize() 个，不屏蔽不可用的电梯
+    void arrivalTimes(const CarBank& cars, int floor, double* out);
+}
@@ -0,0 +1,157 @@
+#include "demand_forecaster.h"
+#include <algorithm>
+#include <cmath>
+
+DemandForecaster::DemandForecaster(int floorCount, double dayLength, double smoothing)
+    : floorCount(floorCount), dayLength(dayLength), smoothing(smoothing),
+      rates(static_cast<size_t>(SLOTS_PER_DAY) * (floorCount + 1) * 2, 0.0),
+      counts(static_cast<size_t>(floorCount + 1) * 2, 0.0),
+      observedDays(SLOTS_PER_DAY, 0),
+      currentSlot(-1) {}
+
+size_t DemandForecaster::index(int slot, int floor, int direction) const {
+    return (static_cast<size_t>(slot) * (floorCount + 1) + floor) * 2 + direction;
+}
+
+double DemandForecaster::getSlotLength() const {
+    return dayLength / SLOTS_PER_DAY;
+}
+
+long long DemandForecaster::getSlotIndex(double time) const {
+    return static_cast<long long>(std::floor(time / getSlotLength()));
+}
+
+void DemandForecaster::setDayLength(double length) {
+    if (length > 0) {
+        dayLength = length;
+    }
+}
+
+double DemandForecaster::getDayLength() const {
+    return dayLength;
+}
+
+void DemandForecaster::setSmoothing(double value) {
+    smoothing = std::min(1.0, std::max(0.0, value));
+}
+
+double DemandForecaster::getSmoothing() const {
+    return smoothing;
+}
+
+// 把 slot 时段的计数并入平滑估计，第一次观测直接作为估计
+void DemandForecaster::foldSlot(long long slot) {
+    int daySlot = static_cast<int>(slot % SLOTS_PER_DAY);
+    double weight = observedDays[daySlot] == 0 ? 1.0 : smoothing;
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        for (int direction = UP; direction <= DOWN; ++direction) {
+            double& rate = rates[index(daySlot, floor, direction)];
+            rate += weight * (counts[floor * 2 + direction] - rate);
+        }
+    }
+    observedDays[daySlot]++;
+    std::fill(counts.begin(), counts.end(), 0.0);
+}
+
+void DemandForecaster::advance(double time) {
+    long long slot = getSlotIndex(time);
+    if (currentSlot < 0) {
+        currentSlot = slot;
+        return;
+    }
+    // 中间没有到达的时段按0人并入
+    for (; currentSlot < slot; ++currentSlot) {
+        foldSlot(currentSlot);
+    }
+}
+
+void DemandForecaster::recordArrival(double time, int fromFloor, int toFloor, int passengerCount) {
+    if (fromFloor < 1 || fromFloor > floorCount || fromFloor == toFloor) return;
+    advance(time);
+    counts[fromFloor * 2 + (toFloor > fromFloor ? UP : DOWN)] += passengerCount;
+}
+
+void DemandForecaster::finishDay(double time) {
+    if (currentSlot >= 0) {
+        advance(time);
+        // 步长累加的误差可能让一天停在末尾之前一点点
+        if (time >= dayLength * (1.0 - 1e-9)) {
+            for (; currentSlot < SLOTS_PER_DAY; ++currentSlot) {
+                foldSlot(currentSlot);
+            }
+        }
+    }
+    std::fill(counts.begin(), counts.end(), 0.0);
+    currentSlot = -1;
+}
+
+void DemandForecaster::clear() {
+    std::fill(rates.begin(), rates.end(), 0.0);
+    std::fill(observedDays.begin(), observedDays.end(), 0);
+    std::fill(counts.begin(), counts.end(), 0.0);
+    currentSlot = -1;
+}
+
+bool DemandForecaster::hasHistory() const {
+    return std::any_of(observedDays.begin(), observedDays.end(), [](int days) { return days > 0; });
+}
+
+int DemandForecaster::getObservedDays(double time) const {
+    long long slot = getSlotIndex(time) % SLOTS_PER_DAY;
+    return observedDays[static_cast<size_t>(slot < 0 ? slot + SLOTS_PER_DAY : slot)];
+}
+
+double DemandForecaster::forecastArrivals(int floor, Direction direction, double from, double duration) const {
+    if (floor < 1 || floor > floorCount || duration <= 0) return 0.0;
+    
+    double slotLength = getSlotLength();
+    double total = 0.0;
+    double time = from;
+    double end = from + duration;
+    while (time < end) {
+        long long slot = getSlotIndex(time);
+        double slotEnd = std::min(end, (slot + 1) * slotLength);
+        int daySlot = static_cast<int>(((slot % SLOTS_PER_DAY) + SLOTS_PER_DAY) % SLOTS_PER_DAY);
+        double arrivals = 0.0;
+        if (direction != DOWN) arrivals += rates[index(daySlot, floor, UP)];
+        if (direction != UP) arrivals += rates[index(daySlot, floor, DOWN)];
+        total += arrivals * (slotEnd - time) / slotLength;
+        time = slotEnd;
+    }
+    return total;
+}
+
+void DemandForecaster::saveState(StateWriter& out) const {
+    out.writeDouble(dayLength);
+    out.writeDouble(smoothing);
+    out.writeUnsigned(rates.size());
+    for (double rate : rates) {
+        out.writeDouble(rate);
+    }
+    for (double count : counts) {
+        out.writeDouble(count);
+    }
+    for (int days : observedDays) {
+        out.writeInt(days);
+    }
+    out.writeInt(currentSlot);
+}
+
+void DemandForecaster::loadState(StateReader& in) {
+    dayLength = in.readDouble();
+    smoothing = in.readDouble();
+    if (in.readCount() != rates.size()) {
+        in.fail();
+        return;
+    }
+    for (double& rate : rates) {
+        rate = in.readDouble();
+    }
+    for (double& count : counts) {
+        count = in.readDouble();
+    }
+    for (int& days : observedDays) {
+        days = static_cast<int>(in.readInt());
+    }
+    currentSlot = in.readInt();
+}
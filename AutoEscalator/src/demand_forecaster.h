@@ -0,0 +1,54 @@
+#pragma once
+#include "state_io.h"
+#include <vector>
+
+// 在线客流需求模型：把一天按24小时制分成若干时段，统计每个时段各层上行、下行的到达人数，
+// 时段结束时用指数平滑并入跨天的估计。每次到达只做一次计数，开销与楼层数无关。
+// 一天跑完时最后一个时段照常并入；未跑完的时段（中途 reset）不计入，以免把半个时段当作整段的需求。
+class DemandForecaster {
+public:
+    static const int SLOTS_PER_DAY = 96;  // 每时段相当于24小时制的15分钟
+    
+    enum Direction { UP = 0, DOWN = 1, ANY = 2 };
+    
+private:
+    int floorCount;
+    double dayLength;             // 模拟一天的时长（秒）
+    double smoothing;             // 新一天的观测所占的比重
+    std::vector<double> rates;    // 各时段各层各方向的平滑到达人数
+    std::vector<double> counts;   // 当前时段的到达人数
+    std::vector<int> observedDays;  // 各时段已并入的天数
+    long long currentSlot;        // 正在累计的时段（从模拟开始计的序号），-1表示尚未开始
+    
+    size_t index(int slot, int floor, int direction) const;
+    double getSlotLength() const;
+    long long getSlotIndex(double time) const;
+    void foldSlot(long long slot);
+    
+public:
+    explicit DemandForecaster(int floorCount, double dayLength = 24.0 * 3600, double smoothing = 0.3);
+    
+    void setDayLength(double length);
+    double getDayLength() const;
+    void setSmoothing(double value);
+    double getSmoothing() const;
+    
+    // 记录一批到达；time 为模拟时间
+    void recordArrival(double time, int fromFloor, int toFloor, int passengerCount);
+    // 时间推进到 time，并入其间结束的时段
+    void advance(double time);
+    // 一天（一轮模拟）在 time 时刻结束：并入到 time 为止已结束的时段，time 到达一天末尾时
+    // 连同最后一个时段一起并入；丢弃未完成时段的计数，下一轮从0时刻重新开始
+    void finishDay(double time);
+    // 清除所有学到的估计
+    void clear();
+    
+    // 是否已有至少一个完整时段的观测
+    bool hasHistory() const;
+    int getObservedDays(double time) const;
+    // 预计 [from, from + duration) 内在 floor 层按 direction 方向到达的人数，可跨时段和跨天
+    double forecastArrivals(int floor, Direction direction, double from, double duration) const;
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+};
@@ -0,0 +1,280 @@
+#include "demand_profile.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    const double DAY_SECONDS = 24.0 * 3600;
+    
+    // 解析 HH:MM、HH:MM:SS 或秒数
+    bool parseTime(const std::string& text, double& seconds) {
+        std::istringstream input(text);
+        double parts[3] = {0.0, 0.0, 0.0};
+        int count = 0;
+        char separator = ':';
+        while (count < 3 && separator == ':' && input >> parts[count]) {
+            ++count;
+            if (!(input >> separator)) break;
+        }
+        if (count == 0 || !input.eof()) return false;
+        
+        seconds = count == 1 ? parts[0] : parts[0] * 3600 + parts[1] * 60 + parts[2];
+        return seconds >= 0 && seconds <= DAY_SECONDS;
+    }
+    
+    std::string stripComment(const std::string& line) {
+        return line.substr(0, line.find('#'));
+    }
+}
+
+DemandProfile::DemandProfile(int floors) : floorCount(std::max(2, floors)) {
+    addMix("up", 0.85, 0.05, 0.10);
+    addMix("lunch", 0.40, 0.40, 0.20);
+    addMix("down", 0.05, 0.85, 0.10);
+    addMix("inter", 0.10, 0.10, 0.80);
+}
+
+DemandProfile DemandProfile::createOfficeDay(int floorCount) {
+    DemandProfile profile(floorCount);
+    profile.addSlot(7 * 3600, 7.5 * 3600, 120, "up");
+    profile.addSlot(7.5 * 3600, 9.5 * 3600, 600, "up");
+    profile.addSlot(9.5 * 3600, 11.5 * 3600, 90, "inter");
+    profile.addSlot(11.5 * 3600, 13.5 * 3600, 360, "lunch");
+    profile.addSlot(13.5 * 3600, 17 * 3600, 90, "inter");
+    profile.addSlot(17 * 3600, 19 * 3600, 540, "down");
+    profile.addSlot(19 * 3600, 21 * 3600, 60, "down");
+    return profile;
+}
+
+DemandProfile DemandProfile::createWeekendDay(int floorCount) {
+    DemandProfile profile(floorCount);
+    profile.addSlot(8 * 3600, 10 * 3600, 40, "up");
+    profile.addSlot(10 * 3600, 16 * 3600, 30, "inter");
+    profile.addSlot(16 * 3600, 19 * 3600, 40, "down");
+    return profile;
+}
+
+int DemandProfile::findMatrix(const std::string& name) const {
+    for (size_t i = 0; i < matrices.size(); ++i) {
+        if (matrices[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool DemandProfile::addMatrix(const std::string& name, const std::vector<double>& weights) {
+    Matrix matrix{name, {}};
+    matrix.cumulative.reserve(weights.size());
+    double total = 0.0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        int from = static_cast<int>(i) / floorCount;
+        int to = static_cast<int>(i) % floorCount;
+        if (weights[i] < 0) return false;
+        if (from != to) total += weights[i];  // 同层出行没有意义，忽略其权重
+        matrix.cumulative.push_back(total);
+    }
+    if (total <= 0) return false;
+    
+    int existing = findMatrix(name);
+    if (existing >= 0) {
+        matrices[existing] = std::move(matrix);
+    } else {
+        matrices.push_back(std::move(matrix));
+    }
+    return true;
+}
+
+bool DemandProfile::addMix(const std::string& name, double incoming, double outgoing, double interfloor) {
+    int n = floorCount;
+    std::vector<double> weights(static_cast<size_t>(n) * n, 0.0);
+    int upperFloors = n - 1;
+    for (int floor = 1; floor < n; ++floor) {
+        weights[floor] += incoming / upperFloors;              // 1楼 → 其他楼层
+        weights[static_cast<size_t>(floor) * n] += outgoing / upperFloors;  // 其他楼层 → 1楼
+    }
+    if (n > 2) {
+        double pairWeight = interfloor / (static_cast<double>(upperFloors) * (upperFloors - 1));
+        for (int from = 1; from < n; ++from) {
+            for (int to = 1; to < n; ++to) {
+                if (from != to) weights[static_cast<size_t>(from) * n + to] = pairWeight;
+            }
+        }
+    }
+    return addMatrix(name, weights);
+}
+
+bool DemandProfile::fail(int lineNumber, const std::string& message) {
+    lastError = "第" + std::to_string(lineNumber) + "行: " + message;
+    return false;
+}
+
+// 解析到副本上，全部成功才替换当前曲线，出错时原曲线保持不变
+bool DemandProfile::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        lastError = "无法打开文件: " + filename;
+        return false;
+    }
+    
+    DemandProfile loaded(*this);
+    loaded.clearSlots();
+    if (!loaded.parse(file)) {
+        lastError = loaded.lastError;
+        return false;
+    }
+    loaded.lastError.clear();
+    *this = std::move(loaded);
+    return true;
+}
+
+bool DemandProfile::parse(std::istream& file) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream input(stripComment(line));
+        std::string keyword;
+        if (!(input >> keyword)) continue;
+        
+        if (keyword == "mix") {
+            std::string name;
+            double incoming, outgoing, interfloor;
+            if (!(input >> name >> incoming >> outgoing >> interfloor) ||
+                !addMix(name, incoming, outgoing, interfloor)) {
+                return fail(lineNumber, "无效的客流组合");
+            }
+        } else if (keyword == "od") {
+            std::string name;
+            if (!(input >> name)) return fail(lineNumber, "缺少矩阵名称");
+            
+            std::vector<double> weights;
+            weights.reserve(static_cast<size_t>(floorCount) * floorCount);
+            while (static_cast<int>(weights.size()) < floorCount * floorCount && std::getline(file, line)) {
+                ++lineNumber;
+                std::istringstream row(stripComment(line));
+                double weight;
+                while (row >> weight) weights.push_back(weight);
+            }
+            if (static_cast<int>(weights.size()) != floorCount * floorCount || !addMatrix(name, weights)) {
+                return fail(lineNumber, "OD矩阵需要 " + std::to_string(floorCount) + "x" +
+                                        std::to_string(floorCount) + " 个非负权重");
+            }
+        } else if (keyword == "slot") {
+            std::string start, end, matrix;
+            double passengersPerHour;
+            double startTime, endTime;
+            if (!(input >> start >> end >> passengersPerHour >> matrix) ||
+                !parseTime(start, startTime) || !parseTime(end, endTime)) {
+                return fail(lineNumber, "时段格式应为 slot <开始> <结束> <人/小时> <矩阵>");
+            }
+            if (!addSlot(startTime, endTime, passengersPerHour, matrix)) {
+                return fail(lineNumber, "时段无效、与其他时段重叠或矩阵未定义: " + matrix);
+            }
+        } else {
+            return fail(lineNumber, "未知关键字: " + keyword);
+        }
+    }
+    return true;
+}
+
+const std::string& DemandProfile::getLastError() const {
+    return lastError;
+}
+
+bool DemandProfile::addSlot(double startTime, double endTime, double passengersPerHour,
+                            const std::string& matrix) {
+    int matrixIndex = findMatrix(matrix);
+    if (matrixIndex < 0 || startTime < 0 || endTime > DAY_SECONDS ||
+        startTime >= endTime || passengersPerHour < 0) {
+        return false;
+    }
+    
+    Slot slot{startTime, endTime, passengersPerHour / 3600.0, matrixIndex};
+    auto it = std::lower_bound(timeSlots.begin(), timeSlots.end(), slot,
+                               [](const Slot& a, const Slot& b) { return a.startTime < b.startTime; });
+    if (it != timeSlots.end() && it->startTime < endTime) return false;
+    if (it != timeSlots.begin() && std::prev(it)->endTime > startTime) return false;
+    
+    timeSlots.insert(it, slot);
+    return true;
+}
+
+void DemandProfile::clearSlots() {
+    timeSlots.clear();
+}
+
+void DemandProfile::scaleArrivalRates(double factor) {
+    for (auto& slot : timeSlots) {
+        slot.arrivalRate *= std::max(0.0, factor);
+    }
+}
+
+int DemandProfile::getFloorCount() const {
+    return floorCount;
+}
+
+const std::vector<DemandProfile::Slot>& DemandProfile::getSlots() const {
+    return timeSlots;
+}
+
+double DemandProfile::getExpectedDailyArrivals() const {
+    double total = 0.0;
+    for (const auto& slot : timeSlots) {
+        total += slot.arrivalRate * (slot.endTime - slot.startTime);
+    }
+    return total;
+}
+
+void DemandProfile::sampleTrip(const Slot& slot, std::mt19937& engine, int& fromFloor, int& toFloor) const {
+    const auto& cumulative = matrices[slot.matrix].cumulative;
+    std::uniform_real_distribution<double> pick(0.0, cumulative.back());
+    auto it = std::upper_bound(cumulative.begin(), cumulative.end(), pick(engine));
+    int index = static_cast<int>(std::min(it - cumulative.begin(),
+                                          static_cast<std::ptrdiff_t>(cumulative.size() - 1)));
+    fromFloor = index / floorCount + 1;
+    toFloor = index % floorCount + 1;
+}
+
+void DemandProfile::saveState(StateWriter& out) const {
+    out.writeInt(floorCount);
+    out.writeUnsigned(matrices.size());
+    for (const auto& matrix : matrices) {
+        out.writeString(matrix.name);
+        out.writeUnsigned(matrix.cumulative.size());
+        for (double weight : matrix.cumulative) {
+            out.writeDouble(weight);
+        }
+    }
+    out.writeUnsigned(timeSlots.size());
+    for (const auto& slot : timeSlots) {
+        out.writeDouble(slot.startTime);
+        out.writeDouble(slot.endTime);
+        out.writeDouble(slot.arrivalRate);
+        out.writeInt(slot.matrix);
+    }
+}
+
+void DemandProfile::loadState(StateReader& in) {
+    floorCount = static_cast<int>(in.readInt());
+    matrices.assign(in.readCount(), Matrix());
+    for (auto& matrix : matrices) {
+        matrix.name = in.readString();
+        matrix.cumulative.assign(in.readCount(), 0.0);
+        for (double& weight : matrix.cumulative) {
+            weight = in.readDouble();
+        }
+        if (matrix.cumulative.size() != static_cast<size_t>(floorCount) * floorCount) {
+            in.fail();
+        }
+    }
+    timeSlots.assign(in.readCount(), Slot());
+    for (auto& slot : timeSlots) {
+        slot.startTime = in.readDouble();
+        slot.endTime = in.readDouble();
+        slot.arrivalRate = in.readDouble();
+        slot.matrix = static_cast<int>(in.readInt());
+        if (slot.matrix < 0 || slot.matrix >= static_cast<int>(matrices.size())) {
+            in.fail();
+        }
+    }
+    lastError.clear();
+}
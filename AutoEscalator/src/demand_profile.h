@@ -0,0 +1,69 @@
+#pragma once
+#include "state_io.h"
+#include <istream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 一天的客流需求曲线：若干时段，每个时段给出到达率和一个起止楼层(OD)矩阵。
+// 时刻按24小时制的一天给出（秒），实际模拟一天更短时由客流生成器按比例缩放。
+//
+// 文件格式（# 之后为注释）：
+//   mix <名称> <进楼> <出楼> <层间>        按比例组合三类客流生成OD矩阵
+//   od <名称>                              自定义OD矩阵，随后 FLOOR_COUNT 行，
+//                                          每行 FLOOR_COUNT 个非负权重（行为出发层）
+//   slot <开始> <结束> <人/小时> <名称>     时段，时刻写作 HH:MM 或秒数
+// 内置 up（上行高峰）、lunch（午餐）、down（下行高峰）、inter（层间）四种组合。
+class DemandProfile {
+public:
+    struct Slot {
+        double startTime;    // 一天中的秒数
+        double endTime;
+        double arrivalRate;  // 人/秒
+        int matrix;          // OD矩阵下标
+    };
+    
+private:
+    struct Matrix {
+        std::string name;
+        std::vector<double> cumulative;  // 按 出发层*楼层数+到达层 展开的累计权重
+    };
+    
+    int floorCount;
+    std::vector<Matrix> matrices;
+    std::vector<Slot> timeSlots;  // 按开始时间排序且互不重叠
+    std::string lastError;
+    
+    int findMatrix(const std::string& name) const;
+    bool addMatrix(const std::string& name, const std::vector<double>& weights);
+    bool addMix(const std::string& name, double incoming, double outgoing, double interfloor);
+    bool fail(int lineNumber, const std::string& message);
+    bool parse(std::istream& file);
+    
+public:
+    explicit DemandProfile(int floorCount);
+    
+    // 典型办公楼的一天：上行高峰、午餐、下行高峰和白天的层间客流
+    static DemandProfile createOfficeDay(int floorCount);
+    // 办公楼的周末：没有上下班高峰，白天少量进出楼和层间客流
+    static DemandProfile createWeekendDay(int floorCount);
+    
+    bool loadFromFile(const std::string& filename);
+    const std::string& getLastError() const;
+    
+    bool addSlot(double startTime, double endTime, double passengersPerHour, const std::string& matrix);
+    void clearSlots();
+    // 各时段到达率乘以同一系数，用于由一条曲线派生客流更少（或更多）的天
+    void scaleArrivalRates(double factor);
+    
+    int getFloorCount() const;
+    const std::vector<Slot>& getSlots() const;
+    // 全天期望到达人数
+    double getExpectedDailyArrivals() const;
+    
+    // 按时段的OD矩阵抽取一次出行的起止楼层（1起编号）
+    void sampleTrip(const Slot& slot, std::mt19937& engine, int& fromFloor, int& toFloor) const;
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+};
@@ -0,0 +1,192 @@
+#include "dispatch_env.h"
+#include "logger.h"
+#include <algorithm>
+#include <cmath>
+
+std::shared_ptr<const SimulationEngine> DispatchEnv::createStartState(const Config& config,
+                                                                      const DemandProfile& profile) {
+    auto engine = std::make_shared<SimulationEngine>();
+    engine->getBuilding().setRecordingEnabled(false);
+    engine->getBuilding().getMaintenanceManager().setEnabled(false);
+    engine->setDemandProfile(profile);
+    engine->start();
+    engine->advance(config.startTime / (24.0 * 3600) * engine->getDayLength(), config.timeStep);
+    engine->setDispatchStrategy(Dispatcher::Strategy::EXTERNAL);
+    return engine;
+}
+
+DispatchEnv::DispatchEnv(const Config& config)
+    : DispatchEnv(config, createStartState(config,
+                                           DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT))) {}
+
+DispatchEnv::DispatchEnv(const Config& config, std::shared_ptr<const SimulationEngine> startState)
+    : config(config), startState(std::move(startState)), episodeStart(0.0), accumulatedWait(0.0) {
+    const Building& building = this->startState->getBuilding();
+    floorCount = building.getFloorCount();
+    elevatorCount = static_cast<int>(building.getElevators().size());
+}
+
+int DispatchEnv::getObservationSize() const {
+    return elevatorCount * 4 + floorCount * 4 + 1;
+}
+
+int DispatchEnv::getActionCount() const {
+    return floorCount;
+}
+
+void DispatchEnv::reset(unsigned int seed, float* observation) {
+    engine = startState->fork();
+    engine->seedRandom(seed);
+    episodeStart = engine->getCurrentTime();
+    accumulatedWait = getAccumulatedWait();
+    writeObservation(observation);
+}
+
+DispatchEnv::StepResult DispatchEnv::step(const int* actions, float* observation) {
+    Building& building = engine->getBuilding();
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        int elevator = actions[floor - 1];
+        if (elevator < 0 || elevator >= elevatorCount) continue;
+        while (building.assignWaitingPassenger(floor, elevator)) {
+        }
+    }
+    
+    int steps = std::max(1, static_cast<int>(std::lround(config.decisionInterval / config.timeStep)));
+    for (int i = 0; i < steps && engine->isSimulationRunning(); ++i) {
+        engine->step(config.timeStep);
+    }
+    
+    double wait = getAccumulatedWait();
+    StepResult result;
+    result.reward = static_cast<float>(accumulatedWait - wait);
+    accumulatedWait = wait;
+    result.done = !engine->isSimulationRunning() ||
+                  (config.episodeLength > 0 &&
+                   engine->getCurrentTime() - episodeStart >= config.episodeLength - 1e-9);
+    writeObservation(observation);
+    return result;
+}
+
+// 已上梯乘客的等待时间 + 仍在等待的乘客已等的时间 + 超时离开的乘客按最长等待时间计
+double DispatchEnv::getAccumulatedWait() const {
+    const Building& building = engine->getBuilding();
+    const auto& metrics = building.getMetrics();
+    return metrics.getTotalWaitTime() + building.getPendingWaitTime() +
+           metrics.getTimedOutPassengers() * ElevatorConfig::MAX_WAIT_TIME;
+}
+
+void DispatchEnv::writeObservation(float* observation) const {
+    const Building& building = engine->getBuilding();
+    float* out = observation;
+    
+    for (const auto& elevator : building.getElevators()) {
+        float capacity = static_cast<float>(std::max(1, elevator.getCapacity()));
+        *out++ = static_cast<float>(elevator.getCurrentFloor() - 1) / std::max(1, floorCount - 1);
+        *out++ = elevator.getCurrentLoad() / capacity;
+        *out++ = elevator.getCommittedLoad() / capacity;
+        switch (elevator.getState()) {
+            case ElevatorState::MOVING_UP: *out++ = 1.0f; break;
+            case ElevatorState::MOVING_DOWN: *out++ = -1.0f; break;
+            default: *out++ = 0.0f; break;
+        }
+    }
+    
+    float capacity = building.getElevators().empty()
+        ? 1.0f : static_cast<float>(std::max(1, building.getElevators().front().getCapacity()));
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        PassengerQueue queue = building.getWaitingQueue(floor);
+        float up = 0.0f, down = 0.0f, oldest = 0.0f;
+        if (!queue.empty()) {
+            oldest = static_cast<float>(queue.front().getWaitTime() / ElevatorConfig::MAX_WAIT_TIME);
+            for (const Passenger& passenger : queue) {
+                if (passenger.getTargetFloor() > floor) up = 1.0f;
+                else down = 1.0f;
+            }
+        }
+        *out++ = up;
+        *out++ = down;
+        *out++ = oldest;
+        *out++ = queue.size() / capacity;
+    }
+    
+    *out++ = static_cast<float>(engine->getCurrentTime() / engine->getDayLength());
+}
+
+const SimulationEngine& DispatchEnv::getEngine() const {
+    return *engine;
+}
+
+DispatchVectorEnv::DispatchVectorEnv(int envCount, const DispatchEnv::Config& config, size_t threadCount)
+    : pool(threadCount) {
+    // 起始状态只模拟一次，各环境共享
+    auto startState = DispatchEnv::createStartState(
+        config, DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT));
+    for (int i = 0; i < envCount; ++i) {
+        envs.push_back(std::make_unique<DispatchEnv>(config, startState));
+    }
+    nextSeeds.assign(envCount, 0);
+}
+
+int DispatchVectorEnv::getEnvCount() const {
+    return static_cast<int>(envs.size());
+}
+
+int DispatchVectorEnv::getObservationSize() const {
+    return envs.empty() ? 0 : envs.front()->getObservationSize();
+}
+
+int DispatchVectorEnv::getActionCount() const {
+    return envs.empty() ? 0 : envs.front()->getActionCount();
+}
+
+// 按线程数把环境分成连续的块，最后一块在调用线程上执行
+template <typename Function>
+void DispatchVectorEnv::forEachChunk(Function function) {
+    size_t chunks = std::min(pool.getThreadCount(), envs.size());
+    size_t chunkSize = (envs.size() + chunks - 1) / std::max<size_t>(chunks, 1);
+    pending.clear();
+    for (size_t begin = 0; begin < envs.size(); begin += chunkSize) {
+        size_t end = std::min(begin + chunkSize, envs.size());
+        if (end == envs.size()) {
+            function(begin, end);
+        } else {
+            pending.push_back(pool.submit([function, begin, end]() {
+                Logger::setThreadEnabled(false);
+                function(begin, end);
+            }));
+        }
+    }
+    for (auto& future : pending) {
+        future.get();
+    }
+}
+
+void DispatchVectorEnv::reset(unsigned int seed, float* observations) {
+    int observationSize = getObservationSize();
+    for (size_t i = 0; i < envs.size(); ++i) {
+        nextSeeds[i] = seed + static_cast<unsigned int>(i);
+    }
+    forEachChunk([this, observations, observationSize](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            envs[i]->reset(nextSeeds[i], observations + i * observationSize);
+            nextSeeds[i] += static_cast<unsigned int>(envs.size());
+        }
+    });
+}
+
+void DispatchVectorEnv::step(const int* actions, float* observations, float* rewards, uint8_t* dones) {
+    int observationSize = getObservationSize();
+    int actionCount = getActionCount();
+    forEachChunk([=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float* observation = observations + i * observationSize;
+            DispatchEnv::StepResult result = envs[i]->step(actions + i * actionCount, observation);
+            rewards[i] = result.reward;
+            dones[i] = result.done ? 1 : 0;
+            if (result.done) {
+                envs[i]->reset(nextSeeds[i], observation);
+                nextSeeds[i] += static_cast<unsigned int>(envs.size());
+            }
+        }
+    });
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "simulation_engine.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 训练调度策略用的强化学习环境（Gym 风格）：策略每隔固定的模拟时长给出一次动作，
+// 决定各层尚未分配的候梯乘客由哪部电梯接载，楼宇本身不再自动分配。
+//
+// 动作：每层一个整数（共 getActionCount() 个），取值为电梯下标，负数或无效下标表示本次不分配
+// 观测：定长浮点数组（共 getObservationSize() 个）
+//   每部电梯 4 项：所在楼层（归一到0-1）、轿厢载客率、承诺载客率（含待接）、运行方向（上1、下-1、否则0）
+//   每层 4 项：有上行呼梯、有下行呼梯（0/1）、最早候梯乘客已等待时间/最长等待时间、未分配人数/电梯容量
+//   最后 1 项：一天中的时刻（0-1）
+// 奖励：本次动作期间所有乘客新增的等待时间之和取负（超时离开的乘客按最长等待时间计）
+//
+// 每个回合从同一个起始状态分出（默认按办公楼客流用最近优先模拟到 07:30），
+// reset 的种子决定之后的客流。
+class DispatchEnv {
+public:
+    struct Config {
+        double startTime = 7.5 * 3600;   // 回合开始时刻（24小时制的一天中的秒数）
+        double episodeLength = 3600.0;   // 回合时长（模拟秒），0表示到一天结束
+        double decisionInterval = 1.0;   // 每个动作作用的模拟时长（秒）
+        double timeStep = 0.5;           // 模拟步长（秒）
+    };
+    
+    struct StepResult {
+        float reward;
+        bool done;
+    };
+    
+private:
+    Config config;
+    std::shared_ptr<const SimulationEngine> startState;
+    std::unique_ptr<SimulationEngine> engine;
+    int floorCount;
+    int elevatorCount;
+    double episodeStart;
+    double accumulatedWait;  // 上次动作后全部乘客累计的等待时间
+    
+    double getAccumulatedWait() const;
+    void writeObservation(float* observation) const;
+    
+public:
+    // 按 config 用给定客流曲线模拟到回合开始时刻，作为各回合共同的起点；可供多个环境共享
+    static std::shared_ptr<const SimulationEngine> createStartState(const Config& config,
+                                                                    const DemandProfile& profile);
+    
+    explicit DispatchEnv(const Config& config);
+    DispatchEnv(const Config& config, std::shared_ptr<const SimulationEngine> startState);
+    
+    int getObservationSize() const;
+    int getActionCount() const;
+    
+    // 开始新回合，写入初始观测
+    void reset(unsigned int seed, float* observation);
+    // 执行动作并推进 decisionInterval，写入新的观测
+    StepResult step(const int* actions, float* observation);
+    
+    const SimulationEngine& getEngine() const;
+};
+
+// 并行环境：N 个相互独立的楼宇同步推进，在线程池上分块执行。
+// 观测写入调用方提供的连续缓冲区（N × getObservationSize()，按环境依次排列），
+// 回合结束的环境自动开始下一回合，返回的观测即新回合的初始观测
+class DispatchVectorEnv {
+private:
+    std::vector<std::unique_ptr<DispatchEnv>> envs;
+    std::vector<unsigned int> nextSeeds;
+    ThreadPool pool;
+    std::vector<std::future<void>> pending;
+    
+    template <typename Function>
+    void forEachChunk(Function function);
+    
+public:
+    DispatchVectorEnv(int envCount, const DispatchEnv::Config& config, size_t threadCount = 0);
+    
+    int getEnvCount() const;
+    int getObservationSize() const;
+    int getActionCount() const;
+    
+    // 第 i 个环境使用种子 seed + i，之后每个回合加上环境数
+    void reset(unsigned int seed, float* observations);
+    // actions 为 N × getActionCount()，rewards 和 dones 各 N 个
+    void step(const int* actions, float* observations, float* rewards, uint8_t* dones);
+};
@@ -0,0 +1,103 @@
+#include "dispatch_weights.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+const char* const DispatchWeights::KEYS[] = {
+    "LOAD_DISTANCE_WEIGHT", "IDLE_START_FACTOR", "BATCH_LOAD_PENALTY",
+    "BATCH_DIRECTION_PENALTY", "BATCH_REASSIGN_PENALTY", "FORECAST_RESERVE_WEIGHT"
+};
+const int DispatchWeights::KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+const double DispatchWeights::LOWER_BOUNDS[] = {0.0, 1.0, 0.0, 0.0, 0.0, 0.0};
+const double DispatchWeights::UPPER_BOUNDS[] = {1.0, 5.0, 10.0, 60.0, 30.0, 1.0};
+
+bool DispatchWeights::getValue(const std::string& key, double& value) const {
+    if (key == "LOAD_DISTANCE_WEIGHT") value = loadDistanceWeight;
+    else if (key == "IDLE_START_FACTOR") value = idleStartFactor;
+    else if (key == "BATCH_LOAD_PENALTY") value = batchLoadPenalty;
+    else if (key == "BATCH_DIRECTION_PENALTY") value = batchDirectionPenalty;
+    else if (key == "BATCH_REASSIGN_PENALTY") value = batchReassignPenalty;
+    else if (key == "FORECAST_RESERVE_WEIGHT") value = forecastReserveWeight;
+    else return false;
+    return true;
+}
+
+bool DispatchWeights::setValue(const std::string& key, double value) {
+    if (key == "LOAD_DISTANCE_WEIGHT") loadDistanceWeight = value;
+    else if (key == "IDLE_START_FACTOR") idleStartFactor = value;
+    else if (key == "BATCH_LOAD_PENALTY") batchLoadPenalty = value;
+    else if (key == "BATCH_DIRECTION_PENALTY") batchDirectionPenalty = value;
+    else if (key == "BATCH_REASSIGN_PENALTY") batchReassignPenalty = value;
+    else if (key == "FORECAST_RESERVE_WEIGHT") forecastReserveWeight = value;
+    else return false;
+    return true;
+}
+
+std::vector<double> DispatchWeights::toVector() const {
+    std::vector<double> values(KEY_COUNT);
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        getValue(KEYS[i], values[i]);
+    }
+    return values;
+}
+
+DispatchWeights DispatchWeights::fromVector(const std::vector<double>& values) {
+    DispatchWeights weights;
+    for (int i = 0; i < KEY_COUNT && i < static_cast<int>(values.size()); ++i) {
+        weights.setValue(KEYS[i], values[i]);
+    }
+    return weights;
+}
+
+bool DispatchWeights::saveToFile(const std::string& filename, const std::string& comment) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    if (!comment.empty()) {
+        file << "# " << comment << "\n";
+    }
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        double value = 0.0;
+        getValue(KEYS[i], value);
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        file << KEYS[i] << "=" << buffer << "\n";
+    }
+    return file.good();
+}
+
+bool DispatchWeights::loadFromFile(const std::string& filename, std::string* error) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        if (error) *error = "无法打开文件: " + filename;
+        return false;
+    }
+    
+    // 读到副本上，整个文件都有效才替换当前权重
+    DispatchWeights loaded = *this;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+        size_t pos = line.find('=');
+        if (pos == std::string::npos) continue;
+        
+        std::string key = line.substr(0, pos);
+        std::string text = line.substr(pos + 1);
+        char* end = nullptr;
+        double value = std::strtod(text.c_str(), &end);
+        if (end == text.c_str()) {
+            if (error) *error = "第" + std::to_string(lineNumber) + "行: 无效的数值: " + text;
+            return false;
+        }
+        if (!loaded.setValue(key, value)) {
+            if (error) *error = "第" + std::to_string(lineNumber) + "行: 未知的权重: " + key;
+            return false;
+        }
+    }
+    *this = loaded;
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// 调度策略中的评分权重，默认值为原先手工设定的数值。
+// 可按键名逐项读写，也可作为参数向量整体读写，供离线调优工具搜索。
+//
+// 文件格式与配置文件相同，每行 键=值，# 开头的行为注释
+struct DispatchWeights {
+    double loadDistanceWeight = 0.1;     // 负载均衡：每相距一层折算的负载比例
+    double idleStartFactor = 2.0;        // 节能模式：从空闲状态启动的能耗倍数
+    double batchLoadPenalty = 2.0;       // 批量最优：同一电梯每多接一人增加的停靠时间（秒）
+    double batchDirectionPenalty = 10.0; // 批量最优：载客电梯需要反向接载时的罚时（秒）
+    double batchReassignPenalty = 5.0;   // 批量最优：已分配乘客改派到其他电梯的罚时（秒）
+    double forecastReserveWeight = 0.2;  // 负载均衡：调走停在预测有客楼层的空闲电梯时折算的负载比例
+    
+    static const char* const KEYS[];
+    static const int KEY_COUNT;
+    static const double LOWER_BOUNDS[];  // 调优时各项的取值范围
+    static const double UPPER_BOUNDS[];
+    
+    bool getValue(const std::string& key, double& value) const;
+    bool setValue(const std::string& key, double value);
+    
+    // 参数向量按 KEYS 的顺序排列
+    std::vector<double> toVector() const;
+    static DispatchWeights fromVector(const std::vector<double>& values);
+    
+    bool saveToFile(const std::string& filename, const std::string& comment = "") const;
+    // 只覆盖文件中出现的键；文件无法打开、有未知的键或无法解析的值时返回false，
+    // 权重保持不变，原因写入 error（可为空）
+    bool loadFromFile(const std::string& filename, std::string* error = nullptr);
+};
@@ -1,6 +1,8 @@
 #include "dispatcher.h"
+#include "cost_kernels.h"
 #include <algorithm>
 #include <limits>
+#include <cstdlib>
 
 Dispatcher::Dispatcher(Strategy strategy) 
     : currentStrategy(strategy), stats{0, 0, 0.0, 0.0} {}
@@ -13,6 +15,22 @@ Dispatcher::Strategy Dispatcher::getStrategy() const {
     return currentStrategy;
 }
 
+void Dispatcher::setWeights(const DispatchWeights& newWeights) {
+    weights = newWeights;
+}
+
+const DispatchWeights& Dispatcher::getWeights() const {
+    return weights;
+}
+
+void Dispatcher::setFloorDemand(const std::vector<double>& demand) {
+    floorDemand = demand;
+}
+
+const std::vector<double>& Dispatcher::getFloorDemand() const {
+    return floorDemand;
+}
+
 void Dispatcher::resetStatistics() {
     stats = {0, 0, 0.0, 0.0};
 }
@@ -23,23 +41,51 @@ const Dispatcher::Statistics& Dispatcher::getStatistics() const {
 
 int Dispatcher::assignElevator(const std::vector<Elevator>& elevators, 
                              const Passenger& passenger) {
-    stats.totalAssignments++;
+    prepareRound(elevators);
+    return assignPrepared(elevators, passenger);
+}
+
+void Dispatcher::prepareRound(const std::vector<Elevator>& elevators) {
+    cars.load(elevators);
+    if (currentStrategy == Strategy::LOAD_BALANCED) {
+        // 停在预计有客楼层待命的空闲电梯，调走后那里的乘客要等别的电梯
+        cars.setReserve(floorDemand, weights.forecastReserveWeight);
+    }
+}
+
+int Dispatcher::assignPrepared(const std::vector<Elevator>& elevators, const Passenger& passenger) {
     int assignedElevator = -1;
+    int floor = passenger.getSourceFloor();
     
     switch (currentStrategy) {
         case Strategy::NEAREST_FIRST:
-            assignedElevator = assignNearestElevator(elevators, passenger);
+        case Strategy::ROLLOUT:
+        case Strategy::BATCH_OPTIMAL:
+        case Strategy::EXTERNAL:
+            assignedElevator = CostKernels::nearest(cars, floor);
             break;
             
         case Strategy::LOAD_BALANCED:
-            assignedElevator = assignLoadBalancedElevator(elevators, passenger);
+            // 承诺载客率加上按距离折算的负载
+            assignedElevator = CostKernels::loadBalanced(cars, floor, weights.loadDistanceWeight);
             break;
             
         case Strategy::ENERGY_SAVING:
-            assignedElevator = assignEnergySavingElevator(elevators, passenger);
+            // 按移动距离估算能耗，从空闲状态启动需要更多能耗
+            assignedElevator = CostKernels::energySaving(cars, floor, weights.idleStartFactor);
             break;
     }
     
+    if (assignedElevator >= 0) {
+        cars.commit(assignedElevator);
+    }
+    recordAssignment(elevators, passenger, assignedElevator);
+    return assignedElevator;
+}
+
+void Dispatcher::recordAssignment(const std::vector<Elevator>& elevators,
+                                  const Passenger& passenger, int assignedElevator) {
+    stats.totalAssignments++;
     if (assignedElevator >= 0) {
         stats.successfulAssignments++;
         stats.averageWaitTime = (stats.averageWaitTime * (stats.successfulAssignments - 1) + 
@@ -50,86 +96,48 @@ int Dispatcher::assignElevator(const std::vector<Elevator>& elevators,
         stats.averageDistance = (stats.averageDistance * (stats.successfulAssignments - 1) + 
                                distance) / stats.successfulAssignments;
     }
-    
-    return assignedElevator;
 }
 
-int Dispatcher::assignNearestElevator(const std::vector<Elevator>& elevators, 
-                                    const Passenger& passenger) {
-    int bestElevator = -1;
-    int minDistance = std::numeric_limits<int>::max();
-    
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (elevator.getCurrentLoad() >= elevator.getCapacity()) {
-            continue;
-        }
-        
-        int distance = std::abs(elevator.getCurrentFloor() - passenger.getSourceFloor());
-        if (distance < minDistance) {
-            minDistance = distance;
-            bestElevator = i;
-        }
+std::string Dispatcher::getStrategyName(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::NEAREST_FIRST: return "最近优先";
+        case Strategy::LOAD_BALANCED: return "负载均衡";
+        case Strategy::ENERGY_SAVING: return "节能模式";
+        case Strategy::ROLLOUT: return "前瞻推演";
+        case Strategy::BATCH_OPTIMAL: return "批量最优";
+        case Strategy::EXTERNAL: return "外部决定";
+        default: return "未知策略";
     }
-    
-    return bestElevator;
 }
 
-int Dispatcher::assignLoadBalancedElevator(const std::vector<Elevator>& elevators, 
-                                         const Passenger& passenger) {
-    int bestElevator = -1;
-    double minLoad = std::numeric_limits<double>::max();
-    
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (elevator.getCurrentLoad() >= elevator.getCapacity()) {
-            continue;
-        }
-        
-        // 计算负载因子（考虑当前载客量和距离）
-        double loadFactor = (double)elevator.getCurrentLoad() / elevator.getCapacity() +
-                          std::abs(elevator.getCurrentFloor() - passenger.getSourceFloor()) * 0.1;
-                          
-        if (loadFactor < minLoad) {
-            minLoad = loadFactor;
-            bestElevator = i;
-        }
+void Dispatcher::saveState(StateWriter& out) const {
+    out.writeInt(static_cast<int>(currentStrategy));
+    out.writeInt(stats.totalAssignments);
+    out.writeInt(stats.successfulAssignments);
+    out.writeDouble(stats.averageWaitTime);
+    out.writeDouble(stats.averageDistance);
+    for (double value : weights.toVector()) {
+        out.writeDouble(value);
     }
-    
-    return bestElevator;
-}
-
-int Dispatcher::assignEnergySavingElevator(const std::vector<Elevator>& elevators, 
-                                         const Passenger& passenger) {
-    int bestElevator = -1;
-    int minEnergyCost = std::numeric_limits<int>::max();
-    
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (elevator.getCurrentLoad() >= elevator.getCapacity()) {
-            continue;
-        }
-        
-        // 计算能耗（考虑移动距离和当前状态）
-        int energyCost = std::abs(elevator.getCurrentFloor() - passenger.getSourceFloor());
-        if (elevator.getState() == ElevatorState::IDLE) {
-            energyCost *= 2; // 从空闲状态启动需要更多能耗
-        }
-        
-        if (energyCost < minEnergyCost) {
-            minEnergyCost = energyCost;
-            bestElevator = i;
-        }
+    out.writeUnsigned(floorDemand.size());
+    for (double demand : floorDemand) {
+        out.writeDouble(demand);
     }
-    
-    return bestElevator;
 }
 
-std::string Dispatcher::getStrategyName(Strategy strategy) {
-    switch (strategy) {
-        case Strategy::NEAREST_FIRST: return "最近优先";
-        case Strategy::LOAD_BALANCED: return "负载均衡";
-        case Strategy::ENERGY_SAVING: return "节能模式";
-        default: return "未知策略";
+void Dispatcher::loadState(StateReader& in) {
+    currentStrategy = static_cast<Strategy>(in.readInt());
+    stats.totalAssignments = static_cast<int>(in.readInt());
+    stats.successfulAssignments = static_cast<int>(in.readInt());
+    stats.averageWaitTime = in.readDouble();
+    stats.averageDistance = in.readDouble();
+    std::vector<double> values(DispatchWeights::KEY_COUNT);
+    for (double& value : values) {
+        value = in.readDouble();
+    }
+    weights = DispatchWeights::fromVector(values);
+    floorDemand.assign(in.readCount(), 0.0);
+    for (double& demand : floorDemand) {
+        demand = in.readDouble();
     }
-} 
\ No newline at end of file
+}
@@ -1,19 +1,23 @@
 #pragma once
+#include "car_bank.h"
+#include "dispatch_weights.h"
 #include "elevator.h"
 #include "passenger.h"
 #include <vector>
+#include <string>
 
 class Dispatcher {
 public:
     enum class Strategy {
         NEAREST_FIRST,    // 最近电梯优先
         LOAD_BALANCED,    // 负载均衡
-        ENERGY_SAVING     // 节能模式
+        ENERGY_SAVING,    // 节能模式
+        ROLLOUT,          // 前瞻推演，由楼宇调用 RolloutDispatcher
+        BATCH_OPTIMAL,    // 批量最优指派，由楼宇调用 BatchDispatcher
+                          // （这两种策略下直接调用 assignElevator 时按最近优先处理）
+        EXTERNAL          // 外部决定：楼宇不自动分配，由调用方（如 DispatchEnv）分配候梯乘客
     };
     
-private:
-    Strategy currentStrategy;
-    
     struct Statistics {
         int totalAssignments;
         int successfulAssignments;
@@ -21,7 +25,12 @@ private:
         double averageDistance;
     };
     
+private:
+    Strategy currentStrategy;
     Statistics stats;
+    DispatchWeights weights;
+    std::vector<double> floorDemand;  // 各层预计到达人数，由楼宇按需求模型更新
+    CarBank cars;                     // 本轮分配用的电梯热字段，由 prepareRound 装入
     
 public:
     Dispatcher(Strategy strategy = Strategy::NEAREST_FIRST);
@@ -29,13 +38,31 @@ public:
     void setStrategy(Strategy strategy);
     Strategy getStrategy() const;
     
+    void setWeights(const DispatchWeights& newWeights);
+    const DispatchWeights& getWeights() const;
+    
+    // 需求预测：负载均衡策略尽量不调走停在预计有客楼层的空闲电梯，空表示没有预测
+    void setFloorDemand(const std::vector<double>& demand);
+    const std::vector<double>& getFloorDemand() const;
+    
     // 为乘客分配最合适的电梯
     int assignElevator(const std::vector<Elevator>& elevators, 
                       const Passenger& passenger);
+    // 一轮连续分配：prepareRound 把电梯状态装入 CarBank，之后 assignPrepared 只运行代价内核，
+    // 并在 CarBank 中给选中的电梯计入一人。调用方必须随即把乘客加入该电梯，
+    // 且本轮中不能经其他途径改变电梯
+    void prepareRound(const std::vector<Elevator>& elevators);
+    int assignPrepared(const std::vector<Elevator>& elevators, const Passenger& passenger);
+    // 计入一次分配结果（由其他调度器选出电梯时使用），elevatorIndex 为-1表示分配失败
+    void recordAssignment(const std::vector<Elevator>& elevators,
+                          const Passenger& passenger, int elevatorIndex);
                       
     // 获取策略名称
     static std::string getStrategyName(Strategy strategy);
     
     void resetStatistics();
     const Statistics& getStatistics() const;
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
 }; 
\ No newline at end of file
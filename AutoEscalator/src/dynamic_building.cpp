@@ -0,0 +1,51 @@
+#include "dynamic_building.h"
+
+DynamicBuilding::DynamicBuilding(const BuildingTopology& topology)
+    : topology(topology),
+      building(topology.floors, topology.elevators, topology.capacity) {
+    building.setRecordingEnabled(false);
+    building.getMaintenanceManager().setEnabled(false);
+    ParkingPolicy::Settings parking = building.getParkingPolicy().getSettings();
+    parking.enabled = false;
+    building.getParkingPolicy().setSettings(parking);
+}
+
+BuildingTopology DynamicBuilding::getTopology() const {
+    return topology;
+}
+
+bool DynamicBuilding::isSpecialized() const {
+    return false;
+}
+
+bool DynamicBuilding::addRequest(int fromFloor, int toFloor, int passengerCount) {
+    if (fromFloor >= 1 && fromFloor <= topology.floors &&
+        building.getWaitingCountAtFloor(fromFloor) + passengerCount > MAX_WAITING_PER_FLOOR) {
+        return false;
+    }
+    return building.addRequest(fromFloor, toFloor, passengerCount);
+}
+
+void DynamicBuilding::update(double deltaTime) {
+    building.update(deltaTime);
+}
+
+void DynamicBuilding::reset() {
+    building.reset();
+}
+
+int DynamicBuilding::getCarFloor(int elevator) const {
+    return building.getElevators()[elevator].getCurrentFloor();
+}
+
+int DynamicBuilding::getCarLoad(int elevator) const {
+    return building.getElevators()[elevator].getCurrentLoad();
+}
+
+int DynamicBuilding::getWaitingCount(int floor) const {
+    return building.getWaitingCountAtFloor(floor);
+}
+
+const SimulationMetrics& DynamicBuilding::getMetrics() const {
+    return building.getMetrics();
+}
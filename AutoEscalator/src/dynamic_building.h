@@ -0,0 +1,28 @@
+#pragma once
+#include "building.h"
+#include "building_model.h"
+
+// 运行时大小的楼宇模型：直接包装按楼型构造的 Building（最近优先，关闭维护、记录和预测停靠），
+// 只加上每层候梯人数上限。任意楼型都可用，BuildingRegistry 中没有特化的楼型时使用它
+class DynamicBuilding : public BuildingModel {
+private:
+    BuildingTopology topology;
+    Building building;
+    
+public:
+    explicit DynamicBuilding(const BuildingTopology& topology);
+    DynamicBuilding(const DynamicBuilding&) = delete;
+    DynamicBuilding& operator=(const DynamicBuilding&) = delete;
+    
+    BuildingTopology getTopology() const override;
+    bool isSpecialized() const override;
+    
+    bool addRequest(int fromFloor, int toFloor, int passengerCount) override;
+    void update(double deltaTime) override;
+    void reset() override;
+    
+    int getCarFloor(int elevator) const override;
+    int getCarLoad(int elevator) const override;
+    int getWaitingCount(int floor) const override;
+    const SimulationMetrics& getMetrics() const override;
+};
@@ -1,41 +1,117 @@
 #include "elevator.h"
+#include "config.h"
+#include "logger.h"
+#include <cstdlib>
 
-Elevator::Elevator(int cap) 
-    : currentFloor(1), capacity(cap), state(ElevatorState::IDLE), idleTime(0) {}
+Elevator::Elevator(int cap, int floors)
+    : currentFloor(1), capacity(cap), floorCount(floors), pool(&ownPool), state(ElevatorState::IDLE),
+      lastDirection(ElevatorState::IDLE), idleTime(0), homeFloor(1), returningHome(false), floorTravelTime(0.0),
+      deliveredCount(0), inService(true) {
+    // 一步内上梯的人数不超过载客量
+    recentBoardingWaits.reserve(capacity);
+}
+
+Elevator::Elevator(const Elevator& other)
+    : currentFloor(other.currentFloor), capacity(other.capacity), floorCount(other.floorCount),
+      ownPool(other.ownPool),
+      pool(other.pool == &other.ownPool ? &ownPool : other.pool),
+      passengers(other.passengers), assignedPassengers(other.assignedPassengers),
+      state(other.state), lastDirection(other.lastDirection), idleTime(other.idleTime),
+      homeFloor(other.homeFloor), returningHome(other.returningHome),
+      floorTravelTime(other.floorTravelTime), deliveredCount(other.deliveredCount),
+      inService(other.inService), recentBoardingWaits(other.recentBoardingWaits) {
+    recentBoardingWaits.reserve(capacity);
+}
+
+Elevator& Elevator::operator=(const Elevator& other) {
+    if (this == &other) {
+        return *this;
+    }
+    currentFloor = other.currentFloor;
+    capacity = other.capacity;
+    floorCount = other.floorCount;
+    ownPool = other.ownPool;
+    pool = other.pool == &other.ownPool ? &ownPool : other.pool;
+    passengers = other.passengers;
+    assignedPassengers = other.assignedPassengers;
+    state = other.state;
+    lastDirection = other.lastDirection;
+    idleTime = other.idleTime;
+    homeFloor = other.homeFloor;
+    returningHome = other.returningHome;
+    floorTravelTime = other.floorTravelTime;
+    deliveredCount = other.deliveredCount;
+    inService = other.inService;
+    recentBoardingWaits = other.recentBoardingWaits;
+    return *this;
+}
+
+void Elevator::setPassengerPool(PassengerPool& shared) {
+    pool = &shared;
+    ownPool.clear();
+}
+
+const PassengerPool& Elevator::getPassengerPool() const {
+    return *pool;
+}
 
 bool Elevator::addPassenger(const Passenger& passenger) {
-    if (passengers.size() >= capacity) {
+    if (!inService || getCommittedLoad() >= capacity) {
         return false;
     }
-    passengers.push_back(passenger);
+    pool->pushBack(assignedPassengers, pool->acquire(passenger));
+    return true;
+}
+
+bool Elevator::addPassenger(PassengerPool::Handle passenger) {
+    if (!inService || getCommittedLoad() >= capacity) {
+        return false;
+    }
+    pool->pushBack(assignedPassengers, passenger);
     return true;
 }
 
 void Elevator::removePassenger(int targetFloor) {
-    passengers.erase(
-        std::remove_if(passengers.begin(), passengers.end(),
-            [targetFloor](const Passenger& p) {
-                return p.getTargetFloor() == targetFloor;
-            }
-        ),
-        passengers.end()
+    pool->removeIf(passengers,
+        [targetFloor](const Passenger& p) {
+            return p.getTargetFloor() == targetFloor;
+        },
+        [this](PassengerPool::Handle handle) {
+            pool->release(handle);
+            ++deliveredCount;
+        }
     );
 }
 
+void Elevator::takeAssignedPassengers(std::vector<PassengerPool::Handle>& out) {
+    while (!assignedPassengers.empty()) {
+        out.push_back(pool->popFront(assignedPassengers));
+    }
+}
+
+void Elevator::takeStrandedPassengers(std::vector<PassengerPool::Handle>& out) {
+    if (inService || state == ElevatorState::MOVING_UP || state == ElevatorState::MOVING_DOWN) {
+        return;
+    }
+    while (!passengers.empty()) {
+        out.push_back(pool->popFront(passengers));
+    }
+}
+
 void Elevator::move() {
     int oldFloor = currentFloor;
     
     switch (state) {
         case ElevatorState::MOVING_UP:
             currentFloor++;
-            Logger::log("电梯从" + std::to_string(oldFloor) + "楼上行到" + 
-                       std::to_string(currentFloor) + "楼");
+            if (Logger::isEnabled()) Logger::log("电梯从" + std::to_string(oldFloor) + "楼上行到" +
+                                                 std::to_string(currentFloor) + "楼");
             break;
             
         case ElevatorState::MOVING_DOWN:
             currentFloor--;
-            Logger::log("电梯从" + std::to_string(oldFloor) + "楼下行到" + 
-                       std::to_string(currentFloor) + "楼");
+            if (Logger::isEnabled()) Logger::log("电梯从" + std::to_string(oldFloor) + "楼下行到" +
+                                                 std::to_string(currentFloor) + "楼");
             break;
             
         default:
@@ -43,57 +119,141 @@ void Elevator::move() {
     }
 }
 
+// 在当前楼层下客并接载已分配的乘客，有人上下时返回true
+bool Elevator::serveCurrentFloor() {
+    size_t before = passengers.size();
+    removePassenger(currentFloor);
+    bool served = passengers.size() != before;
+    
+    // 已分配的乘客按分配顺序上梯，句柄直接挂到轿厢链表
+    pool->removeIf(assignedPassengers,
+        [this](const Passenger& p) {
+            return p.getSourceFloor() == currentFloor;
+        },
+        [this, &served](PassengerPool::Handle handle) {
+            Passenger& passenger = pool->get(handle);
+            recentBoardingWaits.push_back(passenger.getWaitTime());
+            passenger.markBoarded();  // 本步结束前由 Building 计入指标
+            pool->pushBack(passengers, handle);
+            served = true;
+        }
+    );
+    return served;
+}
+
+bool Elevator::hasStopInDirection(ElevatorState direction) const {
+    auto ahead = [this, direction](int floor) {
+        return direction == ElevatorState::MOVING_UP ? floor > currentFloor : floor < currentFloor;
+    };
+    for (auto h = passengers.head; h != PassengerPool::NONE; h = pool->next(h)) {
+        if (ahead(pool->get(h).getTargetFloor())) return true;
+    }
+    for (auto h = assignedPassengers.head; h != PassengerPool::NONE; h = pool->next(h)) {
+        if (ahead(pool->get(h).getSourceFloor())) return true;
+    }
+    return false;
+}
+
+// 沿原方向还有停靠点就继续，否则掉头；没有任何停靠点时空闲
+ElevatorState Elevator::chooseDirection() const {
+    if (lastDirection != ElevatorState::IDLE && hasStopInDirection(lastDirection)) {
+        return lastDirection;
+    }
+    if (hasStopInDirection(ElevatorState::MOVING_UP)) return ElevatorState::MOVING_UP;
+    if (hasStopInDirection(ElevatorState::MOVING_DOWN)) return ElevatorState::MOVING_DOWN;
+    return ElevatorState::IDLE;
+}
+
 void Elevator::update(double deltaTime) {
+    pool->forEach(assignedPassengers, [deltaTime](Passenger& passenger) {
+        passenger.updateWaitTime(deltaTime);
+    });
+    if (!inService) {
+        updateOutOfService(deltaTime);
+        return;
+    }
+    
     // 更新电梯状态
     switch (state) {
         case ElevatorState::MOVING_UP:
         case ElevatorState::MOVING_DOWN:
             floorTravelTime += deltaTime;
-            if (floorTravelTime >= FLOOR_TRAVEL_TIME) {
+            if (floorTravelTime >= ElevatorConfig::FLOOR_TRAVEL_TIME) {
                 move();
                 floorTravelTime = 0.0;
+                lastDirection = state;
                 
-                // 检查是否有乘客到达目标楼层
-                bool hasPassengersToRemove = false;
-                for (const auto& passenger : passengers) {
-                    if (passenger.getTargetFloor() == currentFloor) {
-                        hasPassengersToRemove = true;
-                        break;
-                    }
-                }
-                
-                if (hasPassengersToRemove) {
+                // 有乘客在本层上下时停靠，否则按需继续或转为空闲
+                if (serveCurrentFloor()) {
                     state = ElevatorState::STOPPED;
-                    removePassenger(currentFloor);
+                    idleTime = 0.0;
+                    returningHome = false;
+                } else {
+                    ElevatorState next = chooseDirection();
+                    if (next != ElevatorState::IDLE) {
+                        state = next;
+                        returningHome = false;
+                    } else if (!returningHome || currentFloor == homeFloor) {
+                        state = ElevatorState::IDLE;
+                        idleTime = 0.0;
+                        returningHome = false;
+                    } else {
+                        // 仍在返回待命楼层途中，待命楼层可能已经改变
+                        state = homeFloor > currentFloor ? ElevatorState::MOVING_UP
+                                                         : ElevatorState::MOVING_DOWN;
+                    }
                 }
             }
             break;
             
         case ElevatorState::IDLE:
+            if (serveCurrentFloor()) {
+                state = ElevatorState::STOPPED;
+                idleTime = 0.0;
+                break;
+            }
+            state = chooseDirection();
+            if (state != ElevatorState::IDLE) {
+                idleTime = 0.0;
+                break;
+            }
             idleTime += deltaTime;
-            if (idleTime >= MAX_IDLE_TIME && currentFloor != 1) {
-                state = ElevatorState::MOVING_DOWN;
+            if (idleTime >= ElevatorConfig::MAX_IDLE_TIME && currentFloor != homeFloor) {
+                // 空闲超时返回待命楼层
+                state = homeFloor > currentFloor ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN;
+                returningHome = true;
                 idleTime = 0.0;
             }
             break;
             
         case ElevatorState::STOPPED:
             idleTime += deltaTime;
-            if (idleTime >= 2.0) {  // 停靠2秒后继续运行
-                if (!passengers.empty()) {
-                    // 继续朝原来的方向运行
-                    state = (passengers.front().getTargetFloor() > currentFloor) 
-                        ? ElevatorState::MOVING_UP 
-                        : ElevatorState::MOVING_DOWN;
-                } else {
-                    state = ElevatorState::IDLE;
-                }
+            if (idleTime >= DOOR_DWELL_TIME) {  // 停靠2秒后继续运行
+                serveCurrentFloor();
+                state = chooseDirection();
                 idleTime = 0.0;
             }
             break;
     }
 }
 
+// 停用：层间运行的电梯驶到下一层后停靠，到达目的层的乘客下梯
+void Elevator::updateOutOfService(double deltaTime) {
+    if (state == ElevatorState::MOVING_UP || state == ElevatorState::MOVING_DOWN) {
+        floorTravelTime += deltaTime;
+        if (floorTravelTime < ElevatorConfig::FLOOR_TRAVEL_TIME) {
+            return;
+        }
+        move();
+        floorTravelTime = 0.0;
+        lastDirection = state;
+        state = ElevatorState::STOPPED;
+        idleTime = 0.0;
+        returningHome = false;
+    }
+    removePassenger(currentFloor);
+}
+
 int Elevator::getCurrentFloor() const {
     return currentFloor;
 }
@@ -102,15 +262,72 @@ int Elevator::getCurrentLoad() const {
     return passengers.size();
 }
 
+int Elevator::getCommittedLoad() const {
+    return passengers.size() + assignedPassengers.size();
+}
+
+int Elevator::getCapacity() const {
+    return capacity;
+}
+
+int Elevator::getFloorCount() const {
+    return floorCount;
+}
+
+int Elevator::getDeliveredCount() const {
+    return deliveredCount;
+}
+
+void Elevator::setHomeFloor(int floor) {
+    homeFloor = floor;
+}
+
+int Elevator::getHomeFloor() const {
+    return homeFloor;
+}
+
 ElevatorState Elevator::getState() const {
     return state;
 }
 
+double Elevator::getAssignedWaitTime() const {
+    double total = 0.0;
+    pool->forEach(assignedPassengers, [&total](const Passenger& passenger) {
+        total += passenger.getWaitTime();
+    });
+    return total;
+}
+
+double Elevator::estimateArrivalTime(int floor) const {
+    int offset = floor - currentFloor;
+    double time = std::abs(offset) * ElevatorConfig::FLOOR_TRAVEL_TIME +
+                  getCommittedLoad() * DOOR_DWELL_TIME;
+    bool movingAway = (state == ElevatorState::MOVING_UP && offset < 0) ||
+                      (state == ElevatorState::MOVING_DOWN && offset > 0);
+    if (movingAway) {
+        time += floorCount * ElevatorConfig::FLOOR_TRAVEL_TIME / 2;
+    }
+    return time;
+}
+
+void Elevator::takeBoardingWaits(std::vector<double>& out) {
+    out.insert(out.end(), recentBoardingWaits.begin(), recentBoardingWaits.end());
+    recentBoardingWaits.clear();
+}
+
 void Elevator::reset() {
     currentFloor = 1;
-    passengers.clear();
+    pool->releaseAll(passengers);
+    pool->releaseAll(assignedPassengers);
+    recentBoardingWaits.clear();
     state = ElevatorState::IDLE;
+    lastDirection = ElevatorState::IDLE;
     idleTime = 0;
+    homeFloor = 1;
+    returningHome = false;
+    floorTravelTime = 0.0;
+    deliveredCount = 0;
+    inService = true;
 }
 
 void Elevator::setState(ElevatorState newState) {
@@ -118,4 +335,50 @@ void Elevator::setState(ElevatorState newState) {
     if (state != ElevatorState::IDLE) {
         idleTime = 0;
     }
-} 
\ No newline at end of file
+}
+
+void Elevator::setInService(bool value) {
+    inService = value;
+}
+
+bool Elevator::isInService() const {
+    return inService;
+}
+
+void Elevator::saveState(StateWriter& out) const {
+    out.writeInt(currentFloor);
+    out.writeInt(capacity);
+    pool->saveList(out, passengers);
+    pool->saveList(out, assignedPassengers);
+    out.writeInt(static_cast<int>(state));
+    out.writeInt(static_cast<int>(lastDirection));
+    out.writeDouble(idleTime);
+    out.writeInt(homeFloor);
+    out.writeBool(returningHome);
+    out.writeDouble(floorTravelTime);
+    out.writeInt(deliveredCount);
+    out.writeBool(inService);
+    out.writeUnsigned(recentBoardingWaits.size());
+    for (double wait : recentBoardingWaits) {
+        out.writeDouble(wait);
+    }
+}
+
+void Elevator::loadState(StateReader& in) {
+    currentFloor = static_cast<int>(in.readInt());
+    capacity = static_cast<int>(in.readInt());
+    pool->loadList(in, passengers);
+    pool->loadList(in, assignedPassengers);
+    state = static_cast<ElevatorState>(in.readInt());
+    lastDirection = static_cast<ElevatorState>(in.readInt());
+    idleTime = in.readDouble();
+    homeFloor = static_cast<int>(in.readInt());
+    returningHome = in.readBool();
+    floorTravelTime = in.readDouble();
+    deliveredCount = static_cast<int>(in.readInt());
+    inService = in.readBool();
+    recentBoardingWaits.assign(in.readCount(), 0.0);
+    for (double& wait : recentBoardingWaits) {
+        wait = in.readDouble();
+    }
+}
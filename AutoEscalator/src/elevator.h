@@ -1,7 +1,8 @@
 #pragma once
 #include <vector>
-#include <queue>
+#include "config.h"
 #include "passenger.h"
+#include "passenger_pool.h"
 
 enum class ElevatorState {
     IDLE,
@@ -14,32 +15,85 @@ class Elevator {
 private:
     int currentFloor;
     int capacity;
-    std::vector<Passenger> passengers;
+    int floorCount;                            // 所在楼宇的楼层数，估算反向运行的折返时间
+    PassengerPool ownPool;                     // 单独使用时的乘客池
+    PassengerPool* pool;                       // 乘客所在的池，楼宇中各电梯与候梯队列共用一个
+    PassengerPool::List passengers;            // 已在轿厢内的乘客
+    PassengerPool::List assignedPassengers;    // 已分配、仍在出发楼层等待接载的乘客
     ElevatorState state;
-    int idleTime;
-    static constexpr double FLOOR_TRAVEL_TIME = 5.0;  // 电梯运行每层楼需要5秒
-    static constexpr double MAX_IDLE_TIME = 10.0;     // 最大空闲等待时间
+    ElevatorState lastDirection;               // 最近一次运行方向，停靠后优先沿此方向继续
+    double idleTime;
+    int homeFloor;                             // 空闲时待命的楼层，默认1楼
+    bool returningHome;                        // 空闲超时后正在返回待命楼层
     double floorTravelTime;                           // 当前层间运行时间计数器
-    static constexpr double MAX_PASSENGER_WAIT_TIME = 120.0; // 乘客最大等待时间(T)为120秒
-    double currentWaitTime;  // 当前等待时间计数器
+    int deliveredCount;      // 累计送达乘客数
+    bool inService;          // 故障维修或维护时停用
+    std::vector<double> recentBoardingWaits;  // 上次取出后新上梯乘客的等待时间
+    
+    void move();
+    bool serveCurrentFloor();
+    void updateOutOfService(double deltaTime);
+    bool hasStopInDirection(ElevatorState direction) const;
+    ElevatorState chooseDirection() const;
     
 public:
-    Elevator(int capacity = 12);
+    static constexpr double DOOR_DWELL_TIME = 2.0;  // 停靠开关门时间
+    
+    Elevator(int capacity = 12, int floorCount = ElevatorConfig::FLOOR_COUNT);
+    // 使用自身乘客池的电梯复制后仍用自己的池；使用共用池的电梯复制后指向同一个池，
+    // 由持有池的一方（如复制后的楼宇）调用 setPassengerPool 改指向自己的副本
+    Elevator(const Elevator& other);
+    Elevator& operator=(const Elevator& other);
+    
+    // 改用共用的乘客池，已有乘客的句柄须在新池中有效（刚复制的池或尚无乘客时）
+    void setPassengerPool(PassengerPool& shared);
+    const PassengerPool& getPassengerPool() const;
     
     // 基本操作
-    bool addPassenger(const Passenger& passenger);
+    bool addPassenger(const Passenger& passenger);  // 分配乘客，电梯前往其出发楼层接载
+    // 把池中已有的乘客分给电梯，满载或停用时返回false，句柄仍归调用方
+    bool addPassenger(PassengerPool::Handle passenger);
     void removePassenger(int targetFloor);
-    void move();
+    // 收回已分配、尚未上梯的乘客的句柄，供批量调度重新分配
+    void takeAssignedPassengers(std::vector<PassengerPool::Handle>& out);
+    // 停用且已停在楼层时，收回轿厢内未到目的层的乘客的句柄，由调用方放回该层候梯；
+    // 仍在层间运行或在服务中时不收回
+    void takeStrandedPassengers(std::vector<PassengerPool::Handle>& out);
     void update(double deltaTime);
+    // 设置待命楼层，空闲超时后前往；正在返回途中时改为前往新的楼层
+    void setHomeFloor(int floor);
     
     // 获取状态
     int getCurrentFloor() const;
-    int getCurrentLoad() const;
+    int getCurrentLoad() const;       // 轿厢内人数
+    int getCommittedLoad() const;     // 轿厢内人数 + 已分配待接人数
+    int getCapacity() const;
+    int getFloorCount() const;
+    int getDeliveredCount() const;
+    int getHomeFloor() const;
     ElevatorState getState() const;
+    double getAssignedWaitTime() const;  // 已分配、尚未上梯乘客的等待时间之和
+    template <typename Function>
+    void forEachAssignedPassenger(Function function) const {
+        pool->forEach(assignedPassengers, function);
+    }
+    // 估算到达 floor 层的时间：行程时间加上已承诺乘客的停靠时间，反向运行时另加折返时间（半栋楼的行程）
+    double estimateArrivalTime(int floor) const;
+    
+    // 取出自上次调用以来上梯乘客的等待时间
+    void takeBoardingWaits(std::vector<double>& out);
     
     // 重置
     void reset();
     
     // 在Elevator类的public部分添加
     void setState(ElevatorState newState);
-}; 
\ No newline at end of file
+    // 停用的电梯在层间运行时先驶到下一层，然后停靠不动，到达目的层的乘客在此下梯，
+    // 其余乘客由楼宇收回改派；调度不向它分配新乘客。由 MaintenanceManager 在故障、维护和人工停用时切换
+    void setInService(bool value);
+    bool isInService() const;
+    
+    // 检查点
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+};
@@ -14,7 +14,12 @@ void EnergyManager::updateEnergy(const std::vector<Elevator>& elevators, double
         // 计算时间段内的能耗
         double hourFraction = deltaTime / 3600.0; // 转换为小时
         
-        switch (elevator.getState()) {
+        // 停用的电梯驶到下一层后停靠不动，只计待机功耗
+        ElevatorState state = elevator.getState();
+        if (!elevator.isInService() && state == ElevatorState::STOPPED) {
+            state = ElevatorState::IDLE;
+        }
+        switch (state) {
             case ElevatorState::IDLE:
                 metrics.idleConsumption += IDLE_POWER * hourFraction;
                 break;
@@ -25,7 +30,8 @@ void EnergyManager::updateEnergy(const std::vector<Elevator>& elevators, double
                 break;
                 
             case ElevatorState::STOPPED:
-                metrics.doorOperations += 1;
+                // 按停靠时长折算开关门次数，停满一次 DOOR_DWELL_TIME 记一次，与步长无关
+                metrics.doorOperations += deltaTime / Elevator::DOOR_DWELL_TIME;
                 break;
         }
         
@@ -100,10 +106,37 @@ void EnergyManager::reset() {
     }
 }
 
+double EnergyManager::getElevatorConsumption(size_t index) const {
+    return index < elevatorMetrics.size() ? elevatorMetrics[index].totalConsumption : 0.0;
+}
+
 double EnergyManager::getTotalConsumption() const {
     double total = 0;
     for (const auto& metrics : elevatorMetrics) {
         total += metrics.totalConsumption;
     }
     return total;
-} 
\ No newline at end of file
+}
+
+void EnergyManager::saveState(StateWriter& out) const {
+    out.writeUnsigned(elevatorMetrics.size());
+    for (const auto& metrics : elevatorMetrics) {
+        out.writeDouble(metrics.totalConsumption);
+        out.writeDouble(metrics.idleConsumption);
+        out.writeDouble(metrics.movingConsumption);
+        out.writeDouble(metrics.doorOperations);
+    }
+}
+
+void EnergyManager::loadState(StateReader& in) {
+    if (in.readCount() != elevatorMetrics.size()) {
+        in.fail();
+        return;
+    }
+    for (auto& metrics : elevatorMetrics) {
+        metrics.totalConsumption = in.readDouble();
+        metrics.idleConsumption = in.readDouble();
+        metrics.movingConsumption = in.readDouble();
+        metrics.doorOperations = in.readDouble();
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "elevator.h"
+#include "state_io.h"
 #include <vector>
 #include <map>
 
@@ -39,4 +40,9 @@ public:
     
     // 获取总能耗
     double getTotalConsumption() const;
+    double getElevatorConsumption(size_t index) const;
+    
+    // 检查点；电梯数量不一致时读取失败
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
 }; 
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include "elevator.h"
+#include <vector>
+
+// 供图形前端绘制的模拟状态快照，由 SimulationEngine::takeSnapshot 填写。
+// 前端每次推进后取一次，与上一次比较后只刷新变化的部分；各数组在多次填写之间复用
+struct EngineSnapshot {
+    struct Car {
+        int floor;
+        ElevatorState state;
+        int load;            // 轿厢内人数
+        bool inService;
+    };
+    
+    struct Floor {
+        bool upCall;         // 有去往上方的候梯乘客（包括已分配、尚未上梯的）
+        bool downCall;
+        int waiting;         // 候梯人数
+    };
+    
+    double time = 0.0;
+    std::vector<Car> cars;
+    std::vector<Floor> floors;  // 下标为楼层，0 不用
+    int requested = 0;
+    int delivered = 0;
+};
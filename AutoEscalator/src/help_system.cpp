@@ -17,26 +17,32 @@ void HelpSystem::initializeTopics() {
     topics["elevator"] = {
         "电梯操作",
         "每部电梯最多可载12人，运行速度为5秒/层。\n"
-        "电梯空闲时最多等待10秒，然后返回1楼。",
+        "电梯空闲时最多等待10秒，然后返回待命楼层。\n"
+        "待命楼层默认为1楼；系统从每天的实际客流中学习各时段各层的需求，\n"
+        "有了历史之后按预测把空闲电梯分散停到接下来需求最多的楼层。",
         {"电梯", "运行", "载客"}
     };
     
     topics["dispatch"] = {
         "调度策略",
-        "系统支持三种调度策略：\n"
+        "系统支持五种调度策略：\n"
         "1. 最近优先：选择最近的电梯响应请求\n"
         "2. 负载均衡：平衡各电梯的负载\n"
-        "3. 节能模式：优化能源消耗",
+        "3. 节能模式：优化能源消耗\n"
+        "4. 前瞻推演：为每部电梯推演接下来一段时间的运行，选总等待最少的电梯\n"
+        "5. 批量最优：把所有候梯乘客一起按总代价最小分配，并重新优化已有分配",
         {"调度", "策略", "分配"}
     };
     
     topics["maintenance"] = {
         "维护管理",
         "系统提供完整的维护管理功能：\n"
-        "1. 定期维护提醒\n"
-        "2. 故障检测和报告\n"
+        "1. 定期维护提醒：按出发次数、开关门次数和时间间隔，到期的电梯空闲后停用维护\n"
+        "2. 故障检测和报告：各类故障按平均无故障时间排定，与模拟步长无关\n"
         "3. 维护记录管理\n"
-        "4. 故障修复跟踪",
+        "4. 故障修复跟踪：故障电梯停用到维修完成，停用期间不接受调度，\n"
+        "   已分配给它、尚未上梯的乘客自动改派其他电梯\n"
+        "5. 人工停用：维护菜单中可停用或恢复指定电梯（封梯、改造）",
         {"维护", "故障", "修理", "检修"}
     };
     
@@ -70,6 +76,24 @@ void HelpSystem::initializeTopics() {
         {"命令", "操作", "使用", "控制"}
     };
     
+    topics["calendar"] = {
+        "多天日历模拟",
+        "按日历连续模拟多天（主菜单 Y），工作日、周末和节假日使用各自的客流曲线。\n"
+        "电梯的运行次数、距上次维护的时间和未修复的故障跨天保留，\n"
+        "每天结束后对到期或故障的电梯做夜间维护。每天输出一行指标，最后按天类型汇总。\n"
+        "日历文件：start <1-7> 指定第1天是星期几，holiday <天>[-<天>] 指定节假日，\n"
+        "workday <天> 指定调休上班的周末，天数从1起计。",
+        {"日历", "多天", "一年", "周末", "节假日"}
+    };
+    
+    topics["topology"] = {
+        "楼型研究",
+        "按输入的楼层数、电梯数和容量快速估算服务水平（主菜单 S），不影响当前模拟。\n"
+        "常用楼型使用编译期特化的模型，其他楼型使用按楼型构造的 Building，两者结果一致。\n"
+        "模型只含最近优先调度，不模拟能耗、维护和预测停靠。",
+        {"楼型", "楼层数", "电梯数", "特化"}
+    };
+    
     topics["config"] = {
         "系统配置",
         "可配置的系统参数：\n"
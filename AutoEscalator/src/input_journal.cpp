@@ -0,0 +1,168 @@
+#include "input_journal.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+    const InputJournal::Kind ALL_KINDS[] = {
+        InputJournal::Kind::CONFIG, InputJournal::Kind::STRATEGY, InputJournal::Kind::MAINTENANCE,
+        InputJournal::Kind::DAY_LENGTH, InputJournal::Kind::START, InputJournal::Kind::RESET,
+        InputJournal::Kind::REQUEST, InputJournal::Kind::SERVICE, InputJournal::Kind::REPAIR,
+        InputJournal::Kind::END, InputJournal::Kind::DELTA_TIME, InputJournal::Kind::ARRIVAL,
+        InputJournal::Kind::FAULT, InputJournal::Kind::WEIGHT, InputJournal::Kind::NEXT_DAY,
+        InputJournal::Kind::LOCKOUT
+    };
+    
+    int getArgumentCount(InputJournal::Kind kind) {
+        switch (kind) {
+            case InputJournal::Kind::REQUEST:
+            case InputJournal::Kind::ARRIVAL:
+                return 3;
+            case InputJournal::Kind::FAULT:
+            case InputJournal::Kind::LOCKOUT:
+                return 2;
+            case InputJournal::Kind::STRATEGY:
+            case InputJournal::Kind::MAINTENANCE:
+            case InputJournal::Kind::SERVICE:
+            case InputJournal::Kind::REPAIR:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+    
+    bool hasValue(InputJournal::Kind kind) {
+        return kind == InputJournal::Kind::CONFIG || kind == InputJournal::Kind::WEIGHT ||
+               kind == InputJournal::Kind::DAY_LENGTH || kind == InputJournal::Kind::DELTA_TIME;
+    }
+    
+    bool hasKey(InputJournal::Kind kind) {
+        return kind == InputJournal::Kind::CONFIG || kind == InputJournal::Kind::WEIGHT;
+    }
+    
+    // 17位有效数字保证 double 写出后能原样读回
+    std::string formatValue(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+}
+
+bool InputJournal::open(const std::string& filename) {
+    close();
+    file.open(filename, std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << "# 电梯模拟输入日志 v1\n";
+    file << "# <步号> <时刻(毫秒)> <类型> <参数...>\n";
+    return file.good();
+}
+
+void InputJournal::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool InputJournal::isOpen() const {
+    return file.is_open();
+}
+
+void InputJournal::write(const Entry& entry) {
+    if (!file.is_open()) return;
+    
+    file << entry.step << ' ' << entry.timeMs << ' ' << getKindName(entry.kind);
+    if (hasKey(entry.kind)) {
+        file << ' ' << entry.key;
+    }
+    for (int i = 0; i < getArgumentCount(entry.kind); ++i) {
+        file << ' ' << entry.args[i];
+    }
+    if (hasValue(entry.kind)) {
+        file << ' ' << formatValue(entry.value);
+    }
+    file << '\n';
+}
+
+bool InputJournal::load(const std::string& filename, std::vector<Entry>& entries, std::string& error) {
+    std::ifstream input(filename);
+    if (!input.is_open()) {
+        error = "无法打开文件: " + filename;
+        return false;
+    }
+    
+    entries.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        
+        std::istringstream fields(line);
+        Entry entry;
+        std::string kindName;
+        if (!(fields >> entry.step)) continue;  // 空行
+        
+        bool valid = static_cast<bool>(fields >> entry.timeMs >> kindName);
+        bool known = false;
+        for (Kind kind : ALL_KINDS) {
+            if (kindName == getKindName(kind)) {
+                entry.kind = kind;
+                known = true;
+                break;
+            }
+        }
+        valid = valid && known;
+        if (valid && hasKey(entry.kind)) {
+            valid = static_cast<bool>(fields >> entry.key);
+        }
+        for (int i = 0; valid && i < getArgumentCount(entry.kind); ++i) {
+            valid = static_cast<bool>(fields >> entry.args[i]);
+        }
+        if (valid && hasValue(entry.kind)) {
+            // strtod 按 C locale 解析，与写出时的格式一致
+            std::string text;
+            char* end = nullptr;
+            valid = static_cast<bool>(fields >> text);
+            if (valid) {
+                entry.value = std::strtod(text.c_str(), &end);
+                valid = end != text.c_str() && *end == '\0';
+            }
+        }
+        if (valid && !entries.empty() && entry.step < entries.back().step) {
+            valid = false;  // 步号必须单调不减
+        }
+        if (!valid) {
+            error = "第" + std::to_string(lineNumber) + "行格式错误: " + line;
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+const char* InputJournal::getKindName(Kind kind) {
+    switch (kind) {
+        case Kind::CONFIG: return "config";
+        case Kind::STRATEGY: return "strategy";
+        case Kind::MAINTENANCE: return "maintenance";
+        case Kind::DAY_LENGTH: return "daylength";
+        case Kind::START: return "start";
+        case Kind::RESET: return "reset";
+        case Kind::REQUEST: return "request";
+        case Kind::SERVICE: return "service";
+        case Kind::REPAIR: return "repair";
+        case Kind::END: return "end";
+        case Kind::DELTA_TIME: return "dt";
+        case Kind::ARRIVAL: return "arrival";
+        case Kind::FAULT: return "fault";
+        case Kind::WEIGHT: return "weight";
+        case Kind::NEXT_DAY: return "nextday";
+        case Kind::LOCKOUT: return "lockout";
+    }
+    return "unknown";
+}
+
+bool InputJournal::isStepInput(Kind kind) {
+    return kind == Kind::DELTA_TIME || kind == Kind::ARRIVAL || kind == Kind::FAULT;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 模拟输入日志：按发生顺序记录一次运行的全部外部输入，重放时逐条送回，
+// 不再依赖随机数和键盘输入，同一份日志在不同构建上得到逐位相同的结果。
+//
+// 文件为文本，每行一条记录，# 之后为注释：
+//   <步号> <时刻(毫秒)> <类型> <参数...>
+// 步号是开始记录以来执行过的时间步数，重放按步号对齐，时刻只供阅读。
+// 类型分两类：
+//   步间输入（两步之间由前端发出）
+//     config <键> <值>    配置项，键名同配置文件
+//     weight <键> <值>    调度权重，键名同权重文件
+//     strategy <n>        调度策略
+//     maintenance <0|1>   维护模拟开关
+//     daylength <秒>      模拟一天的时长
+//     start / reset       开始或重置模拟
+//     nextday             开始下一天（维护状态跨天保留）
+//     request <起> <止> <人数>  手动或文件请求
+//     service <电梯>      执行维护
+//     repair <电梯>       维修故障
+//     lockout <电梯> <0|1>  人工停用或解除
+//     end                 记录结束
+//   步内输入（该步更新楼宇之前生效）
+//     dt <秒>             步长，与上一步不同时才记录
+//     arrival <起> <止> <人数>  客流生成或轨迹送入的请求
+//     fault <电梯> <类型>  随机故障
+class InputJournal {
+public:
+    enum class Kind {
+        CONFIG,
+        STRATEGY,
+        MAINTENANCE,
+        DAY_LENGTH,
+        START,
+        RESET,
+        REQUEST,
+        SERVICE,
+        REPAIR,
+        END,
+        DELTA_TIME,
+        ARRIVAL,
+        FAULT,
+        WEIGHT,
+        NEXT_DAY,
+        LOCKOUT
+    };
+    
+    struct Entry {
+        long long step = 0;
+        long long timeMs = 0;
+        Kind kind = Kind::END;
+        std::string key;       // config / weight 的键名
+        double value = 0.0;    // config / weight / daylength / dt 的值
+        int args[3] = {0, 0, 0};
+    };
+    
+private:
+    std::ofstream file;
+    
+public:
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+    void write(const Entry& entry);
+    
+    // 读取整个日志；格式错误时返回false并给出出错的行
+    static bool load(const std::string& filename, std::vector<Entry>& entries, std::string& error);
+    
+    static const char* getKindName(Kind kind);
+    static bool isStepInput(Kind kind);
+};
@@ -0,0 +1,128 @@
+#include "kpi_rollup.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+void DailyKpi::writeCsvHeader(std::ostream& out) {
+    out << "day,weekday,day_type,requested,boarded,delivered,timed_out,"
+           "avg_wait,p95_wait,max_wait,energy_kwh,faults,services\n";
+}
+
+void DailyKpi::writeCsvRow(std::ostream& out) const {
+    out << (day + 1) << ',' << weekday << ',' << static_cast<int>(dayType) << ','
+        << requested << ',' << boarded << ',' << delivered << ',' << timedOut << ','
+        << averageWait << ',' << p95Wait << ',' << maxWait << ',' << energy << ','
+        << faults << ',' << services << '\n';
+}
+
+WaitHistogram::WaitHistogram() : bins(BIN_COUNT, 0), count(0) {}
+
+void WaitHistogram::add(double waitTime) {
+    int bin = static_cast<int>(std::max(0.0, waitTime) / BIN_WIDTH);
+    ++bins[std::min(bin, BIN_COUNT - 1)];
+    ++count;
+}
+
+void WaitHistogram::merge(const WaitHistogram& other) {
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        bins[i] += other.bins[i];
+    }
+    count += other.count;
+}
+
+void WaitHistogram::clear() {
+    std::fill(bins.begin(), bins.end(), 0);
+    count = 0;
+}
+
+long long WaitHistogram::getCount() const {
+    return count;
+}
+
+double WaitHistogram::getPercentile(double p) const {
+    if (count == 0) return 0.0;
+
+    double target = std::clamp(p, 0.0, 100.0) / 100.0 * count;
+    long long below = 0;
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        if (bins[i] > 0 && below + bins[i] >= target) {
+            double fraction = (target - below) / bins[i];
+            return (i + fraction) * BIN_WIDTH;
+        }
+        below += bins[i];
+    }
+    return BIN_COUNT * BIN_WIDTH;
+}
+
+double KpiRollup::Totals::getAverageWait() const {
+    return boarded > 0 ? totalWait / boarded : 0.0;
+}
+
+double KpiRollup::Totals::getEnergyPerDay() const {
+    return days > 0 ? energy / days : 0.0;
+}
+
+void KpiRollup::addTo(Totals& totals, const DailyKpi& kpi, const std::vector<double>& waitSamples) {
+    ++totals.days;
+    totals.requested += kpi.requested;
+    totals.boarded += kpi.boarded;
+    totals.delivered += kpi.delivered;
+    totals.timedOut += kpi.timedOut;
+    totals.totalWait += kpi.averageWait * kpi.boarded;
+    totals.maxWait = std::max(totals.maxWait, kpi.maxWait);
+    totals.energy += kpi.energy;
+    totals.faults += kpi.faults;
+    totals.services += kpi.services;
+    for (double wait : waitSamples) {
+        totals.waits.add(wait);
+    }
+}
+
+void KpiRollup::add(const DailyKpi& kpi, const std::vector<double>& waitSamples) {
+    addTo(byType[static_cast<int>(kpi.dayType)], kpi, waitSamples);
+    addTo(overall, kpi, waitSamples);
+}
+
+void KpiRollup::reset() {
+    for (auto& totals : byType) {
+        totals = Totals();
+    }
+    overall = Totals();
+}
+
+const KpiRollup::Totals& KpiRollup::getTotals() const {
+    return overall;
+}
+
+const KpiRollup::Totals& KpiRollup::getTotals(Calendar::DayType type) const {
+    return byType[static_cast<int>(type)];
+}
+
+std::string KpiRollup::getReport() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    auto line = [&](const char* name, const Totals& totals) {
+        ss << std::left << std::setw(8) << name << std::right
+           << std::setw(6) << totals.days
+           << std::setw(12) << totals.requested
+           << std::setw(10) << totals.timedOut
+           << std::setw(10) << totals.getAverageWait()
+           << std::setw(10) << totals.waits.getPercentile(95)
+           << std::setw(10) << totals.maxWait
+           << std::setw(12) << totals.getEnergyPerDay()
+           << std::setw(8) << totals.faults
+           << std::setw(8) << totals.services << std::endl;
+    };
+
+    ss << "\n=== 多天运行汇总 ===" << std::endl;
+    ss << "类型      天数        请求      超时   平均等待   P95等待   最长等待   日均能耗kWh    故障    维护"
+       << std::endl;
+    for (int i = 0; i < Calendar::DAY_TYPE_COUNT; ++i) {
+        auto type = static_cast<Calendar::DayType>(i);
+        if (byType[i].days > 0) {
+            line(Calendar::getDayTypeName(type), byType[i]);
+        }
+    }
+    line("全部", overall);
+    return ss.str();
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "calendar.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 一天的服务、能耗和维护指标
+struct DailyKpi {
+    int day = 0;        // 第几天，0起
+    int weekday = 1;    // 1-7，1为星期一
+    Calendar::DayType dayType = Calendar::DayType::WEEKDAY;
+    int requested = 0;
+    int boarded = 0;
+    int delivered = 0;
+    int timedOut = 0;
+    double averageWait = 0.0;
+    double p95Wait = 0.0;
+    double maxWait = 0.0;
+    double energy = 0.0;  // kWh
+    int faults = 0;
+    int services = 0;     // 维护次数，含夜间维护
+
+    // 每天一行的CSV，天数从1起计，天类型写作 0工作日、1周末、2节假日
+    static void writeCsvHeader(std::ostream& out);
+    void writeCsvRow(std::ostream& out) const;
+};
+
+// 等待时间直方图：每格0.1秒，超出范围的计入最后一格。
+// 内存与样本数无关，用于跨天汇总的百分位数（格内按均匀分布插值）
+class WaitHistogram {
+private:
+    static constexpr double BIN_WIDTH = 0.1;
+    static constexpr int BIN_COUNT = 6000;  // 覆盖10分钟
+
+    std::vector<long long> bins;
+    long long count;
+
+public:
+    WaitHistogram();
+
+    void add(double waitTime);
+    void merge(const WaitHistogram& other);
+    void clear();
+    long long getCount() const;
+    double getPercentile(double p) const;  // p取值0-100
+};
+
+// 多天运行的流式汇总：按天类型和全程累计计数、能耗和等待时间直方图，
+// 不保存逐日数据，一年和一周占用的内存相同
+class KpiRollup {
+public:
+    struct Totals {
+        int days = 0;
+        long long requested = 0;
+        long long boarded = 0;
+        long long delivered = 0;
+        long long timedOut = 0;
+        double totalWait = 0.0;
+        double maxWait = 0.0;
+        double energy = 0.0;
+        long long faults = 0;
+        long long services = 0;
+        WaitHistogram waits;
+
+        double getAverageWait() const;
+        double getEnergyPerDay() const;
+    };
+
+private:
+    Totals byType[Calendar::DAY_TYPE_COUNT];
+    Totals overall;
+
+    static void addTo(Totals& totals, const DailyKpi& kpi, const std::vector<double>& waitSamples);
+
+public:
+    // waitSamples 为当天每位上梯乘客的等待时间
+    void add(const DailyKpi& kpi, const std::vector<double>& waitSamples);
+    void reset();
+
+    const Totals& getTotals() const;
+    const Totals& getTotals(Calendar::DayType type) const;
+    std::string getReport() const;
+};
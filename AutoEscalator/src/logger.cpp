@@ -2,22 +2,41 @@
 #include <iomanip>
 
 std::ofstream Logger::logFile;
+std::mutex Logger::mutex;
+
+namespace {
+    thread_local bool threadEnabled = true;
+}
 
 void Logger::init(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(mutex);
     logFile.open(filename, std::ios::app);
 }
 
 void Logger::log(const std::string& message) {
+    if (!threadEnabled) return;
+    std::lock_guard<std::mutex> lock(mutex);
     if (!logFile.is_open()) return;
     
     auto now = std::time(nullptr);
-    auto* tm = std::localtime(&now);
+    std::tm tm = *std::localtime(&now);
     
-    logFile << std::put_time(tm, "[%Y-%m-%d %H:%M:%S] ")
+    logFile << std::put_time(&tm, "[%Y-%m-%d %H:%M:%S] ")
             << message << std::endl;
 }
 
+bool Logger::isEnabled() {
+    if (!threadEnabled) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    return logFile.is_open();
+}
+
+void Logger::setThreadEnabled(bool enabled) {
+    threadEnabled = enabled;
+}
+
 void Logger::close() {
+    std::lock_guard<std::mutex> lock(mutex);
     if (logFile.is_open()) {
         logFile.close();
     }
@@ -2,13 +2,19 @@
 #include <string>
 #include <fstream>
 #include <ctime>
+#include <mutex>
 
 class Logger {
 private:
     static std::ofstream logFile;
+    static std::mutex mutex;  // 分支推演时多个引擎可能在不同线程上同时写日志
     
 public:
     static void init(const std::string& filename = "elevator.log");
     static void log(const std::string& message);
+    // 当前线程的日志会写入文件时返回true，热路径上据此跳过拼接消息
+    static bool isEnabled();
+    // 关闭当前线程的日志，推演线程用它避免把假设的运行写进日志
+    static void setThreadEnabled(bool enabled);
     static void close();
 }; 
\ No newline at end of file
@@ -26,6 +26,10 @@ int main() {
         std::cout << "10. 显示能源报告" << std::endl;
         std::cout << "11. 维护管理" << std::endl;
         std::cout << "12. 数据分析" << std::endl;
+        std::cout << "T. 加载带时间的请求轨迹" << std::endl;
+        std::cout << "R. 重放输入日志" << std::endl;
+        std::cout << "Y. 多天日历模拟" << std::endl;
+        std::cout << "S. 楼型研究" << std::endl;
         std::cout << "H. 帮助" << std::endl;
         
         char choice;
@@ -88,6 +92,34 @@ int main() {
                 simulator.showDataAnalysisMenu();
                 break;
                 
+            case 'T':
+            case 't': {
+                std::string filename;
+                std::cout << "请输入轨迹文件名: ";
+                std::cin >> filename;
+                simulator.loadTrace(filename);
+                break;
+            }
+            
+            case 'R':
+            case 'r': {
+                std::string filename;
+                std::cout << "请输入输入日志文件名: ";
+                std::cin >> filename;
+                simulator.replayJournal(filename);
+                break;
+            }
+            
+            case 'Y':
+            case 'y':
+                simulator.runCalendar();
+                break;
+                
+            case 'S':
+            case 's':
+                simulator.runTopologyStudy();
+                break;
+                
             case 'H':
             case 'h': {
                 std::string topic;
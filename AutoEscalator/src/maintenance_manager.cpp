@@ -1,89 +1,173 @@
 #include "maintenance_manager.h"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <limits>
 #include <random>
+#include "utils.h"
 
-MaintenanceManager::MaintenanceManager(size_t elevatorCount) {
+MaintenanceManager::MaintenanceManager(size_t elevatorCount)
+    : enabled(true), randomFaultsEnabled(true), faultRateScale(1.0), random(Utils::randomEngine()()) {
     elevatorStatus.resize(elevatorCount);
+    for (size_t i = 0; i < elevatorCount; ++i) {
+        scheduleNextFault(static_cast<int>(i), 0.0);
+    }
 }
 
 void MaintenanceManager::update(std::vector<Elevator>& elevators, double currentTime) {
     for (size_t i = 0; i < elevators.size(); ++i) {
         auto& status = elevatorStatus[i];
         auto& elevator = elevators[i];
+        int id = static_cast<int>(i);
         
-        // 更新操作计数
-        if (elevator.getState() != ElevatorState::IDLE) {
-            status.operationCount++;
+        // 注入的故障不论维护开关和电梯是否停用都生效
+        if (status.faultPending) {
+            applyFault(id, elevator, currentTime);
+        }
+        if (status.lockedOut) {
+            elevator.setInService(false);
+            continue;
         }
         
-        // 检查是否需要维护
-        if (status.operationCount >= OPERATIONS_BEFORE_MAINTENANCE ||
-            (currentTime - status.lastMaintenanceTime) >= MAINTENANCE_INTERVAL) {
-            status.needsMaintenance = true;
-            maintenanceQueue.push(i);
+        // 停用中：维修或维护到时后恢复服务，并从此刻重新排定故障
+        if (!elevator.isInService()) {
+            if (currentTime < status.serviceEndTime) continue;
+            if (status.hasFault) {
+                status.hasFault = false;
+                maintenanceHistory.emplace_back(id, "维修", currentTime,
+                    "修复" + getFaultTypeString(status.currentFault) + "故障");
+            }
+            if (status.underMaintenance) {
+                completeMaintenance(id, currentTime);
+            }
+            elevator.setInService(true);
+            status.lastState = elevator.getState();
+            scheduleNextFault(id, currentTime);
+            continue;
         }
+        if (!enabled) continue;
         
-        // 模拟随机故障
-        if (!status.hasFault && !status.needsMaintenance) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_real_distribution<> dis(0, 1);
-            
-            if (dis(gen) < FAULT_PROBABILITY) {
-                simulateFault(i);
+        // 按状态变化计数：从空闲或停靠转为运行算一次出发，转为停靠算一次开关门
+        ElevatorState state = elevator.getState();
+        if (state != status.lastState) {
+            bool moving = state == ElevatorState::MOVING_UP || state == ElevatorState::MOVING_DOWN;
+            bool wasStanding = status.lastState == ElevatorState::IDLE ||
+                               status.lastState == ElevatorState::STOPPED;
+            if (state == ElevatorState::STOPPED) {
+                ++status.doorCycleCount;
+            } else if (moving && wasStanding) {
+                ++status.tripCount;
             }
+            status.lastState = state;
         }
         
-        // 如果有故障或需要维护，停止电梯
-        if (status.hasFault || status.needsMaintenance) {
-            elevator.setState(ElevatorState::STOPPED);
+        // 排定的故障到时发生
+        if (randomFaultsEnabled && !status.hasFault && currentTime >= status.nextFaultTime) {
+            simulateFault(id, status.nextFaultType);
+            applyFault(id, elevator, currentTime);
+            continue;
+        }
+        
+        // 检查是否需要维护，每部电梯只入队一次
+        if (!status.needsMaintenance &&
+            (status.tripCount >= TRIPS_BEFORE_MAINTENANCE ||
+             status.doorCycleCount >= DOOR_CYCLES_BEFORE_MAINTENANCE ||
+             (currentTime - status.lastMaintenanceTime) >= MAINTENANCE_INTERVAL)) {
+            status.needsMaintenance = true;
+            maintenanceQueue.push_back(id);
+        }
+        
+        // 待维护的电梯等到空闲且没有乘客时停用维护
+        if (status.needsMaintenance && state == ElevatorState::IDLE && elevator.getCommittedLoad() == 0) {
+            status.underMaintenance = true;
+            status.serviceEndTime = currentTime + MAINTENANCE_DURATION;
+            elevator.setInService(false);
+            removeFromQueue(id);
         }
     }
 }
 
-void MaintenanceManager::simulateFault(int elevatorId) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 4);
-    
+// 故障使电梯停用到维修完成；维修或维护中又发生的故障把完成时刻顺延一次维修时长
+void MaintenanceManager::applyFault(int elevatorId, Elevator& elevator, double currentTime) {
     auto& status = elevatorStatus[elevatorId];
-    status.hasFault = true;
-    status.currentFault = static_cast<FaultType>(dis(gen));
+    status.faultPending = false;
+    maintenanceHistory.emplace_back(elevatorId, "故障", currentTime, getFaultTypeString(status.currentFault));
+    status.serviceEndTime = std::max(status.serviceEndTime, currentTime) +
+        REPAIR_MINUTES[static_cast<int>(status.currentFault)] * 60.0;
+    elevator.setInService(false);
+}
+
+// 各类故障独立的指数分布合起来仍是指数分布，总故障率为各类之和，发生时按各类占比抽取类型
+void MaintenanceManager::scheduleNextFault(int elevatorId, double currentTime) {
+    double rates[FAULT_TYPE_COUNT];
+    double totalRate = 0.0;
+    for (int type = 0; type < FAULT_TYPE_COUNT; ++type) {
+        rates[type] = faultRateScale / (FAULT_MTBF_HOURS[type] * 3600.0);
+        totalRate += rates[type];
+    }
     
-    std::string faultDesc;
-    switch (status.currentFault) {
-        case FaultType::DOOR_MALFUNCTION:
-            faultDesc = "门故障";
-            break;
-        case FaultType::SENSOR_ERROR:
-            faultDesc = "传感器错误";
-            break;
-        case FaultType::OVERLOAD:
-            faultDesc = "超载";
-            break;
-        case FaultType::POWER_FAILURE:
-            faultDesc = "电源故障";
-            break;
-        case FaultType::COMMUNICATION_ERROR:
-            faultDesc = "通信错误";
-            break;
+    auto& status = elevatorStatus[elevatorId];
+    if (totalRate <= 0.0) {
+        status.nextFaultTime = std::numeric_limits<double>::infinity();
+        return;
+    }
+    std::exponential_distribution<double> interval(totalRate);
+    std::discrete_distribution<int> type(rates, rates + FAULT_TYPE_COUNT);
+    status.nextFaultTime = currentTime + interval(random);
+    status.nextFaultType = static_cast<FaultType>(type(random));
+}
+
+void MaintenanceManager::simulateFault(int elevatorId) {
+    std::uniform_int_distribution<> dis(0, FAULT_TYPE_COUNT - 1);
+    simulateFault(elevatorId, static_cast<FaultType>(dis(random)));
+}
+
+void MaintenanceManager::simulateFault(int elevatorId, FaultType type) {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return;
     }
     
-    maintenanceHistory.emplace_back(elevatorId, "故障", 0.0, faultDesc);
+    auto& status = elevatorStatus[elevatorId];
+    status.hasFault = true;
+    status.faultPending = true;
+    status.currentFault = type;
+    recentFaults.emplace_back(elevatorId, type);
+}
+
+void MaintenanceManager::takeRecentFaults(std::vector<std::pair<int, FaultType>>& out) {
+    out.insert(out.end(), recentFaults.begin(), recentFaults.end());
+    recentFaults.clear();
 }
 
 void MaintenanceManager::performMaintenance(int elevatorId, double currentTime) {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return;
+    }
+    auto& status = elevatorStatus[elevatorId];
+    status.hasFault = false;
+    status.faultPending = false;
+    status.serviceEndTime = currentTime;
+    completeMaintenance(elevatorId, currentTime);
+}
+
+void MaintenanceManager::completeMaintenance(int elevatorId, double currentTime) {
     auto& status = elevatorStatus[elevatorId];
     status.lastMaintenanceTime = currentTime;
-    status.operationCount = 0;
+    status.tripCount = 0;
+    status.doorCycleCount = 0;
     status.needsMaintenance = false;
-    status.hasFault = false;
+    status.underMaintenance = false;
+    removeFromQueue(elevatorId);
     
-    maintenanceHistory.emplace_back(elevatorId, "定期维护", currentTime, 
+    maintenanceHistory.emplace_back(elevatorId, "定期维护", currentTime,
                                   "完成例行维护检查");
 }
 
+void MaintenanceManager::removeFromQueue(int elevatorId) {
+    maintenanceQueue.erase(std::remove(maintenanceQueue.begin(), maintenanceQueue.end(), elevatorId),
+                           maintenanceQueue.end());
+}
+
 std::string MaintenanceManager::getMaintenanceReport() const {
     std::stringstream ss;
     ss << "\n=== 维护状态报告 ===" << std::endl;
@@ -91,15 +175,19 @@ std::string MaintenanceManager::getMaintenanceReport() const {
     for (size_t i = 0; i < elevatorStatus.size(); ++i) {
         const auto& status = elevatorStatus[i];
         ss << "电梯 " << (i + 1) << ":" << std::endl;
-        ss << "  运行次数: " << status.operationCount << std::endl;
-        ss << "  上次维护时间: " << std::fixed << std::setprecision(1) 
+        ss << "  出发次数: " << status.tripCount << "  开关门次数: " << status.doorCycleCount << std::endl;
+        ss << "  上次维护时间: " << std::fixed << std::setprecision(1)
            << status.lastMaintenanceTime << "s" << std::endl;
         
-        if (status.hasFault) {
-            ss << "  当前状态: 故障" << std::endl;
+        if (status.lockedOut) {
+            ss << "  当前状态: 人工停用" << std::endl;
+        } else if (status.hasFault) {
+            ss << "  当前状态: 故障停用" << std::endl;
             ss << "  故障类型: " << getFaultTypeString(status.currentFault) << std::endl;
+        } else if (status.underMaintenance) {
+            ss << "  当前状态: 维护中，预计 " << status.serviceEndTime << "s 完成" << std::endl;
         } else if (status.needsMaintenance) {
-            ss << "  当前状态: 需要维护" << std::endl;
+            ss << "  当前状态: 需要维护（空闲后停用）" << std::endl;
         } else {
             ss << "  当前状态: 正常" << std::endl;
         }
@@ -121,13 +209,146 @@ std::string MaintenanceManager::getFaultTypeString(FaultType type) const {
 }
 
 void MaintenanceManager::reset() {
+    for (size_t i = 0; i < elevatorStatus.size(); ++i) {
+        elevatorStatus[i] = ElevatorStatus();
+        scheduleNextFault(static_cast<int>(i), 0.0);
+    }
+    maintenanceHistory.clear();
+    recentFaults.clear();
+    maintenanceQueue.clear();
+}
+
+void MaintenanceManager::startNextDay(std::vector<Elevator>& elevators, double elapsed) {
+    for (size_t i = 0; i < elevatorStatus.size(); ++i) {
+        auto& status = elevatorStatus[i];
+        status.lastMaintenanceTime -= elapsed;
+        status.nextFaultTime -= elapsed;
+        status.serviceEndTime -= elapsed;
+        status.lastState = ElevatorState::IDLE;
+        if ((status.hasFault || status.underMaintenance || status.lockedOut) && i < elevators.size()) {
+            elevators[i].setInService(false);
+        }
+    }
+    if (maintenanceHistory.size() > MAX_HISTORY) {
+        maintenanceHistory.erase(maintenanceHistory.begin(),
+                                 maintenanceHistory.end() - MAX_HISTORY);
+    }
+    recentFaults.clear();
+}
+
+void MaintenanceManager::setEnabled(bool value) {
+    enabled = value;
+}
+
+bool MaintenanceManager::isEnabled() const {
+    return enabled;
+}
+
+void MaintenanceManager::setRandomFaultsEnabled(bool value) {
+    randomFaultsEnabled = value;
+}
+
+void MaintenanceManager::setFaultRateScale(double scale) {
+    faultRateScale = std::max(0.0, scale);
+}
+
+double MaintenanceManager::getFaultRateScale() const {
+    return faultRateScale;
+}
+
+void MaintenanceManager::seedRandom(unsigned int seed) {
+    random.seed(seed);
+}
+
+void MaintenanceManager::saveState(StateWriter& out) const {
+    out.writeUnsigned(elevatorStatus.size());
+    for (const auto& status : elevatorStatus) {
+        out.writeDouble(status.lastMaintenanceTime);
+        out.writeInt(status.tripCount);
+        out.writeInt(status.doorCycleCount);
+        out.writeInt(static_cast<int>(status.lastState));
+        out.writeBool(status.needsMaintenance);
+        out.writeBool(status.underMaintenance);
+        out.writeBool(status.hasFault);
+        out.writeBool(status.faultPending);
+        out.writeInt(static_cast<int>(status.currentFault));
+        out.writeDouble(status.nextFaultTime);
+        out.writeInt(static_cast<int>(status.nextFaultType));
+        out.writeDouble(status.serviceEndTime);
+        out.writeBool(status.lockedOut);
+    }
+    
+    out.writeUnsigned(maintenanceHistory.size());
+    for (const auto& record : maintenanceHistory) {
+        out.writeInt(record.elevatorId);
+        out.writeString(record.type);
+        out.writeDouble(record.timestamp);
+        out.writeString(record.description);
+    }
+    
+    out.writeUnsigned(maintenanceQueue.size());
+    for (int id : maintenanceQueue) {
+        out.writeInt(id);
+    }
+    
+    out.writeUnsigned(recentFaults.size());
+    for (const auto& fault : recentFaults) {
+        out.writeInt(fault.first);
+        out.writeInt(static_cast<int>(fault.second));
+    }
+    out.writeBool(enabled);
+    out.writeBool(randomFaultsEnabled);
+    out.writeDouble(faultRateScale);
+    out.writeRandom(random);
+}
+
+void MaintenanceManager::loadState(StateReader& in) {
+    if (in.readCount() != elevatorStatus.size()) {
+        in.fail();
+        return;
+    }
     for (auto& status : elevatorStatus) {
-        status = ElevatorStatus();
+        status.lastMaintenanceTime = in.readDouble();
+        status.tripCount = static_cast<int>(in.readInt());
+        status.doorCycleCount = static_cast<int>(in.readInt());
+        status.lastState = static_cast<ElevatorState>(in.readInt());
+        status.needsMaintenance = in.readBool();
+        status.underMaintenance = in.readBool();
+        status.hasFault = in.readBool();
+        status.faultPending = in.readBool();
+        status.currentFault = static_cast<FaultType>(in.readInt());
+        status.nextFaultTime = in.readDouble();
+        status.nextFaultType = static_cast<FaultType>(in.readInt());
+        status.serviceEndTime = in.readDouble();
+        status.lockedOut = in.readBool();
     }
+    
     maintenanceHistory.clear();
-    while (!maintenanceQueue.empty()) {
-        maintenanceQueue.pop();
+    size_t historySize = in.readCount();
+    for (size_t i = 0; i < historySize && in.isOk(); ++i) {
+        int id = static_cast<int>(in.readInt());
+        std::string type = in.readString();
+        double timestamp = in.readDouble();
+        std::string description = in.readString();
+        maintenanceHistory.emplace_back(id, type, timestamp, description);
     }
+    
+    maintenanceQueue.clear();
+    size_t queueSize = in.readCount();
+    for (size_t i = 0; i < queueSize; ++i) {
+        maintenanceQueue.push_back(static_cast<int>(in.readInt()));
+    }
+    
+    recentFaults.clear();
+    size_t faultCount = in.readCount();
+    for (size_t i = 0; i < faultCount; ++i) {
+        int id = static_cast<int>(in.readInt());
+        recentFaults.emplace_back(id, static_cast<FaultType>(in.readInt()));
+    }
+    enabled = in.readBool();
+    randomFaultsEnabled = in.readBool();
+    faultRateScale = in.readDouble();
+    in.readRandom(random);
 }
 
 bool MaintenanceManager::needsMaintenance(int elevatorId) const {
@@ -137,7 +358,35 @@ bool MaintenanceManager::needsMaintenance(int elevatorId) const {
     return elevatorStatus[elevatorId].needsMaintenance;
 }
 
-const std::vector<MaintenanceManager::MaintenanceRecord>& 
+bool MaintenanceManager::hasFault(int elevatorId) const {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return false;
+    }
+    return elevatorStatus[elevatorId].hasFault;
+}
+
+bool MaintenanceManager::isUnderMaintenance(int elevatorId) const {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return false;
+    }
+    return elevatorStatus[elevatorId].underMaintenance;
+}
+
+void MaintenanceManager::setLockedOut(int elevatorId, bool value) {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return;
+    }
+    elevatorStatus[elevatorId].lockedOut = value;
+}
+
+bool MaintenanceManager::isLockedOut(int elevatorId) const {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevatorStatus.size())) {
+        return false;
+    }
+    return elevatorStatus[elevatorId].lockedOut;
+}
+
+const std::vector<MaintenanceManager::MaintenanceRecord>&
 MaintenanceManager::getMaintenanceHistory() const {
     return maintenanceHistory;
 }
@@ -150,7 +399,11 @@ void MaintenanceManager::repairFault(int elevatorId, double currentTime) {
     auto& status = elevatorStatus[elevatorId];
     if (status.hasFault) {
         status.hasFault = false;
+        status.faultPending = false;
+        if (!status.underMaintenance) {
+            status.serviceEndTime = currentTime;
+        }
         maintenanceHistory.emplace_back(elevatorId, "维修", currentTime,
             "修复" + getFaultTypeString(status.currentFault) + "故障");
     }
-} 
\ No newline at end of file
+}
@@ -1,10 +1,16 @@
 #pragma once
 #include "elevator.h"
+#include "state_io.h"
+#include <random>
 #include <vector>
 #include <string>
-#include <queue>
-#include <chrono>
+#include <deque>
 
+// 维护与故障：以事件时刻而不是逐步抽签建模，结果与步长无关。
+// 每部电梯按各类故障的平均无故障时间（指数分布）排定下一次故障的时刻和类型，到时停用，
+// 经过该类故障的维修时长后自动修复并重新排定。出发次数、开关门次数或距上次维护的时间
+// 达到上限时电梯进入待维护，等它空闲且没有乘客时停用做例行维护，完成后恢复。
+// 停用的电梯不运行（见 Elevator::setInService），调度不再分配给它
 class MaintenanceManager {
 public:
     struct MaintenanceRecord {
@@ -24,38 +30,69 @@ public:
         POWER_FAILURE,
         COMMUNICATION_ERROR
     };
+    static constexpr int FAULT_TYPE_COUNT = 5;
     
 private:
     struct ElevatorStatus {
         double lastMaintenanceTime;
-        int operationCount;
+        int tripCount;            // 上次维护以来的出发次数
+        int doorCycleCount;       // 上次维护以来的停靠开关门次数
+        ElevatorState lastState;  // 上一步的运行状态，用来识别出发和停靠
         bool needsMaintenance;
+        bool underMaintenance;
         bool hasFault;
+        bool faultPending;        // 已发生、下一次 update 时生效的故障
         FaultType currentFault;
+        double nextFaultTime;     // 排定的下一次故障时刻
+        FaultType nextFaultType;
+        double serviceEndTime;    // 停用中时，维修或维护完成的时刻
+        bool lockedOut;           // 人工停用，解除前不恢复服务
         
-        ElevatorStatus() : lastMaintenanceTime(0), operationCount(0),
-                          needsMaintenance(false), hasFault(false) {}
+        ElevatorStatus() : lastMaintenanceTime(0), tripCount(0), doorCycleCount(0),
+                          lastState(ElevatorState::IDLE), needsMaintenance(false),
+                          underMaintenance(false), hasFault(false), faultPending(false),
+                          currentFault(FaultType::DOOR_MALFUNCTION), nextFaultTime(0),
+                          nextFaultType(FaultType::DOOR_MALFUNCTION), serviceEndTime(0),
+                          lockedOut(false) {}
     };
     
     std::vector<ElevatorStatus> elevatorStatus;
     std::vector<MaintenanceRecord> maintenanceHistory;
-    std::queue<int> maintenanceQueue;
+    std::deque<int> maintenanceQueue;  // 待维护的电梯，按到期先后，每部至多一次
+    bool enabled;  // 关闭后不再计数、不产生排定的故障、不开始维护；注入的故障、人工停用和进行中的维修维护照常
+    bool randomFaultsEnabled;  // 重放输入日志时关闭，故障由日志注入
+    double faultRateScale;     // 故障率倍数，研究降级运行时调高
+    std::vector<std::pair<int, FaultType>> recentFaults;  // 上次取出后发生的故障
+    std::mt19937 random;       // 各楼宇独立的随机数，复制楼宇时随之复制
     
     // 维护参数
-    static constexpr int OPERATIONS_BEFORE_MAINTENANCE = 1000;  // 需要维护的操作次数
-    static constexpr double MAINTENANCE_INTERVAL = 24 * 3600;   // 维护间隔（秒）
-    static constexpr double FAULT_PROBABILITY = 0.001;         // 故障概率
+    static constexpr int TRIPS_BEFORE_MAINTENANCE = 20000;       // 需要维护的出发次数
+    static constexpr int DOOR_CYCLES_BEFORE_MAINTENANCE = 40000; // 需要维护的开关门次数
+    static constexpr double MAINTENANCE_INTERVAL = 30 * 24 * 3600;  // 维护间隔（秒）
+    static constexpr double MAINTENANCE_DURATION = 3600;         // 例行维护停用时长（秒）
+    static constexpr size_t MAX_HISTORY = 1000;                 // 跨天保留的维护记录条数
+    // 各类故障的平均无故障时间（小时）和维修时长（分钟），按 FaultType 顺序。
+    // 维修时长固定，重放日志时只需注入故障本身
+    static constexpr double FAULT_MTBF_HOURS[FAULT_TYPE_COUNT] = {400, 1200, 800, 4000, 2000};
+    static constexpr double REPAIR_MINUTES[FAULT_TYPE_COUNT] = {30, 45, 10, 120, 20};
+    
+    void scheduleNextFault(int elevatorId, double currentTime);
+    void applyFault(int elevatorId, Elevator& elevator, double currentTime);
+    void completeMaintenance(int elevatorId, double currentTime);
+    void removeFromQueue(int elevatorId);
     
 public:
     explicit MaintenanceManager(size_t elevatorCount);
     
-    // 更新电梯状态
+    // 更新电梯状态：计数出发和停靠，到时产生故障，停用到期或维修、维护完成的电梯
     void update(std::vector<Elevator>& elevators, double currentTime);
     
     // 检查是否需要维护
     bool needsMaintenance(int elevatorId) const;
+    bool hasFault(int elevatorId) const;
+    bool isUnderMaintenance(int elevatorId) const;
     
-    // 执行维护
+    // 立即完成维护（含修复故障），电梯在下一次 update 时恢复服务
     void performMaintenance(int elevatorId, double currentTime);
     
     // 获取维护历史
@@ -64,12 +101,42 @@ public:
     // 获取维护状态报告
     std::string getMaintenanceReport() const;
     
-    // 模拟故障
+    // 模拟故障（随机类型或指定类型），电梯在下一次 update 时停用；
+    // 已在维修或维护中的，完成时刻顺延该故障的维修时长
     void simulateFault(int elevatorId);
+    void simulateFault(int elevatorId, FaultType type);
+    
+    // 取出自上次调用以来发生的故障（电梯编号, 故障类型）
+    void takeRecentFaults(std::vector<std::pair<int, FaultType>>& out);
     
-    // 修复故障
+    // 立即修复故障，电梯在下一次 update 时恢复服务
     void repairFault(int elevatorId, double currentTime);
     
-    // 重置
+    // 人工停用或解除（封梯、改造等），在下一次 update 时生效，不受维护开关影响；
+    // 解除时如果仍在维修或维护，等其完成后再恢复服务。reset 后全部解除，跨天保留
+    void setLockedOut(int elevatorId, bool value);
+    bool isLockedOut(int elevatorId) const;
+    
+    // 重置，并从0时刻起重新排定各电梯的故障
     void reset();
+    
+    // 进入下一天（电梯已重置）：计数、未修复的故障、维护状态和排定的故障保留，
+    // 各时刻减去前一天的时长（仍相对当天零点，之前几天的为负），停用中的电梯重新停用；
+    // 维护记录只保留最近 MAX_HISTORY 条
+    void startNextDay(std::vector<Elevator>& elevators, double elapsed);
+    
+    void setEnabled(bool value);
+    bool isEnabled() const;
+    void setRandomFaultsEnabled(bool value);
+    // 故障率倍数，从下一次排定起生效
+    void setFaultRateScale(double scale);
+    double getFaultRateScale() const;
+    void seedRandom(unsigned int seed);
+    
+    // 检查点；电梯数量不一致时读取失败
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+    
+private:
+    std::string getFaultTypeString(FaultType type) const;
 }; 
\ No newline at end of file
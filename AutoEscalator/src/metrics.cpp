@@ -0,0 +1,123 @@
+#include "metrics.h"
+#include <algorithm>
+#include <iterator>
+
+SimulationMetrics::SimulationMetrics() {
+    waitSamples.reserve(RESERVED_SAMPLES);
+    reset();
+}
+
+void SimulationMetrics::recordRequest(int passengerCount) {
+    requestedPassengers += passengerCount;
+}
+
+void SimulationMetrics::recordBoarding(double waitTime) {
+    boardedPassengers++;
+    totalWaitTime += waitTime;
+    maxWaitTime = std::max(maxWaitTime, waitTime);
+    waitSamples.push_back(waitTime);
+}
+
+void SimulationMetrics::recordDeliveries(int passengerCount) {
+    deliveredPassengers += passengerCount;
+}
+
+void SimulationMetrics::recordTimeout() {
+    timedOutPassengers++;
+}
+
+void SimulationMetrics::recordStranded(double waitTime, bool boardingRecorded) {
+    strandedPassengers++;
+    if (!boardingRecorded) return;
+    // 当天的样本中数值相同的可以互换，撤销任意一个结果都一样
+    auto sample = std::find(waitSamples.rbegin(), waitSamples.rend(), waitTime);
+    if (sample != waitSamples.rend()) {
+        waitSamples.erase(std::next(sample).base());
+        boardedPassengers--;
+        totalWaitTime -= waitTime;
+    }
+}
+
+void SimulationMetrics::reset() {
+    requestedPassengers = 0;
+    boardedPassengers = 0;
+    deliveredPassengers = 0;
+    timedOutPassengers = 0;
+    strandedPassengers = 0;
+    totalWaitTime = 0.0;
+    maxWaitTime = 0.0;
+    waitSamples.clear();
+}
+
+int SimulationMetrics::getRequestedPassengers() const {
+    return requestedPassengers;
+}
+
+int SimulationMetrics::getBoardedPassengers() const {
+    return boardedPassengers;
+}
+
+int SimulationMetrics::getDeliveredPassengers() const {
+    return deliveredPassengers;
+}
+
+int SimulationMetrics::getTimedOutPassengers() const {
+    return timedOutPassengers;
+}
+
+int SimulationMetrics::getStrandedPassengers() const {
+    return strandedPassengers;
+}
+
+double SimulationMetrics::getAverageWaitTime() const {
+    return boardedPassengers > 0 ? totalWaitTime / boardedPassengers : 0.0;
+}
+
+double SimulationMetrics::getTotalWaitTime() const {
+    return totalWaitTime;
+}
+
+double SimulationMetrics::getMaxWaitTime() const {
+    return maxWaitTime;
+}
+
+double SimulationMetrics::getWaitTimePercentile(double p) const {
+    if (waitSamples.empty()) return 0.0;
+    
+    std::vector<double> sorted(waitSamples);
+    size_t index = static_cast<size_t>(std::clamp(p, 0.0, 100.0) / 100.0 * (sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+const std::vector<double>& SimulationMetrics::getWaitSamples() const {
+    return waitSamples;
+}
+
+void SimulationMetrics::saveState(StateWriter& out) const {
+    out.writeInt(requestedPassengers);
+    out.writeInt(boardedPassengers);
+    out.writeInt(deliveredPassengers);
+    out.writeInt(timedOutPassengers);
+    out.writeInt(strandedPassengers);
+    out.writeDouble(totalWaitTime);
+    out.writeDouble(maxWaitTime);
+    out.writeUnsigned(waitSamples.size());
+    for (double sample : waitSamples) {
+        out.writeDouble(sample);
+    }
+}
+
+void SimulationMetrics::loadState(StateReader& in) {
+    requestedPassengers = static_cast<int>(in.readInt());
+    boardedPassengers = static_cast<int>(in.readInt());
+    deliveredPassengers = static_cast<int>(in.readInt());
+    timedOutPassengers = static_cast<int>(in.readInt());
+    strandedPassengers = static_cast<int>(in.readInt());
+    totalWaitTime = in.readDouble();
+    maxWaitTime = in.readDouble();
+    waitSamples.assign(in.readCount(), 0.0);
+    for (double& sample : waitSamples) {
+        sample = in.readDouble();
+    }
+}
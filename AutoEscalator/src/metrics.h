@@ -0,0 +1,47 @@
+#pragma once
+#include "state_io.h"
+#include <vector>
+
+// 乘客服务指标：请求、上梯、送达、超时及等待时间分布
+class SimulationMetrics {
+private:
+    // 上梯样本预留的容量：每天清空但保留容量，一般一天都不用扩容
+    static const size_t RESERVED_SAMPLES = 8192;
+    
+    int requestedPassengers;
+    int boardedPassengers;
+    int deliveredPassengers;
+    int timedOutPassengers;
+    int strandedPassengers;
+    double totalWaitTime;
+    double maxWaitTime;
+    std::vector<double> waitSamples;  // 当天每位上梯乘客的等待时间
+    
+public:
+    SimulationMetrics();
+    
+    void recordRequest(int passengerCount);
+    void recordBoarding(double waitTime);
+    void recordDeliveries(int passengerCount);
+    void recordTimeout();
+    // 乘客被停用的电梯放在途中楼层：计入滞留人数；boardingRecorded 为真时撤销其上梯记录
+    // （重新上梯时按累计等待时间再记一次）。标记随乘客保存，不靠按数值查找样本来判断
+    void recordStranded(double waitTime, bool boardingRecorded);
+    void reset();
+    
+    int getRequestedPassengers() const;
+    int getBoardedPassengers() const;
+    int getDeliveredPassengers() const;
+    int getTimedOutPassengers() const;
+    int getStrandedPassengers() const;
+    double getAverageWaitTime() const;
+    double getTotalWaitTime() const;
+    double getMaxWaitTime() const;
+    
+    // 等待时间百分位数，p取值0-100
+    double getWaitTimePercentile(double p) const;
+    const std::vector<double>& getWaitSamples() const;
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+};
@@ -47,10 +47,10 @@ void Monitor::displayAlerts() const {
 }
 
 void Monitor::checkWaitingTimes(double currentTime) {
-    const auto& waitingPassengers = building.getWaitingPassengers();
     for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
-        if (!waitingPassengers[floor].empty()) {
-            const auto& passenger = waitingPassengers[floor].front();
+        PassengerQueue queue = building.getWaitingQueue(floor);
+        if (!queue.empty()) {
+            const auto& passenger = queue.front();
             if (passenger.getWaitTime() >= MAX_WAIT_TIME_WARNING) {
                 addAlert(Alert::Level::WARNING,
                         std::to_string(floor) + "楼的乘客等待时间过长",
@@ -77,12 +77,12 @@ void Monitor::checkElevatorLoads() {
 }
 
 void Monitor::checkQueueLengths() {
-    const auto& waitingPassengers = building.getWaitingPassengers();
     for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
-        if (waitingPassengers[floor].size() >= MAX_QUEUE_LENGTH) {
+        int count = building.getWaitingCountAtFloor(floor);
+        if (count >= MAX_QUEUE_LENGTH) {
             addAlert(Alert::Level::WARNING,
                     std::to_string(floor) + "楼等待人数过多(" + 
-                    std::to_string(waitingPassengers[floor].size()) + "人)",
+                    std::to_string(count) + "人)",
                     0.0);
         }
     }
@@ -101,7 +101,7 @@ void MonitorDisplay::drawStatistics(const Building& building) {
     screen[START_Y + 1].replace(START_X, energyInfo.length(), energyInfo);
 }
 
-void MonitorDisplay::drawAlerts(const std::vector<Monitor::Alert>& alerts) {
+void MonitorDisplay::drawAlerts(const std::vector<MaintenanceManager::MaintenanceRecord>& records) {
     const int START_X = 5;
     const int START_Y = 15;
     const int MAX_ALERTS = 5;
@@ -109,11 +109,11 @@ void MonitorDisplay::drawAlerts(const std::vector<Monitor::Alert>& alerts) {
     screen[START_Y].replace(START_X, 7, "警告：");
     
     int alertCount = 0;
-    for (auto it = alerts.rbegin(); 
-         it != alerts.rend() && alertCount < MAX_ALERTS; 
+    for (auto it = records.rbegin(); 
+         it != records.rend() && alertCount < MAX_ALERTS; 
          ++it, ++alertCount) {
         std::string alertText = "[" + std::to_string(alertCount + 1) + "] " + 
-                               it->message;
+                               it->type + ": " + it->description;
         screen[START_Y + 1 + alertCount].replace(START_X, alertText.length(), alertText);
     }
 }
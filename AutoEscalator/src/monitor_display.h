@@ -12,7 +12,7 @@ private:
     void drawFrame();
     void drawElevators(const std::vector<Elevator>& elevators);
     void drawStatistics(const Building& building);
-    void drawAlerts(const std::vector<Monitor::Alert>& alerts);
+    void drawAlerts(const std::vector<MaintenanceManager::MaintenanceRecord>& records);
     void drawLegend();
     
 public:
@@ -0,0 +1,107 @@
+#include "multi_day_simulation.h"
+#include "config.h"
+
+MultiDaySimulation::MultiDaySimulation(SimulationEngine& engine)
+    : engine(engine), totalSteps(0) {
+    DemandProfile holiday = DemandProfile::createWeekendDay(ElevatorConfig::FLOOR_COUNT);
+    holiday.scaleArrivalRates(0.5);
+    profiles.push_back(DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT));
+    profiles.push_back(DemandProfile::createWeekendDay(ElevatorConfig::FLOOR_COUNT));
+    profiles.push_back(holiday);
+}
+
+void MultiDaySimulation::setCalendar(const Calendar& value) {
+    calendar = value;
+}
+
+const Calendar& MultiDaySimulation::getCalendar() const {
+    return calendar;
+}
+
+bool MultiDaySimulation::setProfile(Calendar::DayType type, const DemandProfile& profile) {
+    if (profile.getFloorCount() != ElevatorConfig::FLOOR_COUNT) {
+        return false;
+    }
+    profiles[static_cast<int>(type)] = profile;
+    return true;
+}
+
+const DemandProfile& MultiDaySimulation::getProfile(Calendar::DayType type) const {
+    return profiles[static_cast<int>(type)];
+}
+
+void MultiDaySimulation::setSettings(const Settings& value) {
+    settings = value;
+}
+
+const MultiDaySimulation::Settings& MultiDaySimulation::getSettings() const {
+    return settings;
+}
+
+void MultiDaySimulation::run(const DayCallback& onDay) {
+    rollup.reset();
+    totalSteps = 0;
+    for (int day = 0; day < settings.days; ++day) {
+        DailyKpi kpi = runDay(day);
+        if (onDay) {
+            onDay(kpi);
+        }
+    }
+}
+
+DailyKpi MultiDaySimulation::runDay(int day) {
+    DailyKpi kpi;
+    kpi.day = day;
+    kpi.weekday = calendar.getWeekday(day);
+    kpi.dayType = calendar.getDayType(day);
+
+    engine.setDemandProfile(profiles[static_cast<int>(kpi.dayType)]);
+    if (day == 0) {
+        engine.start();
+    } else {
+        engine.startNextDay();
+    }
+    const auto& history = engine.getBuilding().getMaintenanceManager().getMaintenanceHistory();
+    size_t historyStart = history.size();
+
+    totalSteps += engine.advance(engine.getDayLength(), settings.deltaTime);
+    if (settings.overnightService) {
+        serviceOvernight();
+    }
+
+    const auto& metrics = engine.getMetrics();
+    kpi.requested = metrics.getRequestedPassengers();
+    kpi.boarded = metrics.getBoardedPassengers();
+    kpi.delivered = metrics.getDeliveredPassengers();
+    kpi.timedOut = metrics.getTimedOutPassengers();
+    kpi.averageWait = metrics.getAverageWaitTime();
+    kpi.p95Wait = metrics.getWaitTimePercentile(95);
+    kpi.maxWait = metrics.getMaxWaitTime();
+    kpi.energy = engine.getBuilding().getEnergyManager().getTotalConsumption();
+    for (size_t i = historyStart; i < history.size(); ++i) {
+        if (history[i].type == "故障") ++kpi.faults;
+        else if (history[i].type == "定期维护") ++kpi.services;
+    }
+
+    rollup.add(kpi, metrics.getWaitSamples());
+    return kpi;
+}
+
+// 夜间停运时段维护：到期的做例行维护，故障的维护时一并修复
+void MultiDaySimulation::serviceOvernight() {
+    const auto& maintenance = engine.getBuilding().getMaintenanceManager();
+    int count = static_cast<int>(engine.getBuilding().getElevators().size());
+    for (int i = 0; i < count; ++i) {
+        if (maintenance.needsMaintenance(i) || maintenance.hasFault(i)) {
+            engine.performMaintenance(i);
+        }
+    }
+}
+
+const KpiRollup& MultiDaySimulation::getRollup() const {
+    return rollup;
+}
+
+long long MultiDaySimulation::getTotalSteps() const {
+    return totalSteps;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "calendar.h"
+#include "kpi_rollup.h"
+#include "simulation_engine.h"
+#include <functional>
+#include <vector>
+
+// 多天连续模拟：按日历逐天驱动引擎，每天按天类型换用客流曲线。第一天 start，
+// 之后每天 startNextDay，维护状态跨天延续，维护间隔和运行次数按真实的天数累计；
+// 开启夜间维护时，每天结束后对到期或故障的电梯做一次维护（经由引擎，记入输入日志）。
+// 每天结束时整理出一行日指标，交给回调并计入流式汇总，当天的明细随引擎进入下一天而释放，
+// 内存不随天数增长
+class MultiDaySimulation {
+public:
+    struct Settings {
+        int days = 7;
+        double deltaTime = 0.1;
+        bool overnightService = true;
+    };
+
+    using DayCallback = std::function<void(const DailyKpi&)>;
+
+private:
+    SimulationEngine& engine;
+    Calendar calendar;
+    std::vector<DemandProfile> profiles;  // 按天类型
+    Settings settings;
+    KpiRollup rollup;
+    long long totalSteps;
+
+    void serviceOvernight();
+
+public:
+    // 默认曲线：工作日为典型办公日，周末为 createWeekendDay，节假日为周末的一半
+    explicit MultiDaySimulation(SimulationEngine& engine);
+
+    void setCalendar(const Calendar& value);
+    const Calendar& getCalendar() const;
+    // 楼层数与当前配置不一致时返回false
+    bool setProfile(Calendar::DayType type, const DemandProfile& profile);
+    const DemandProfile& getProfile(Calendar::DayType type) const;
+    void setSettings(const Settings& value);
+    const Settings& getSettings() const;
+
+    // 从第0天起连续运行 settings.days 天，每天结束时调用 onDay
+    void run(const DayCallback& onDay = nullptr);
+    // 运行第 day 天（0起）；day 为0时重新开始，否则接着前一天
+    DailyKpi runDay(int day);
+
+    const KpiRollup& getRollup() const;
+    long long getTotalSteps() const;
+};
@@ -0,0 +1,95 @@
+#include "parking_policy.h"
+#include <algorithm>
+#include <cstdlib>
+
+ParkingPolicy::ParkingPolicy() {}
+
+ParkingPolicy::ParkingPolicy(const Settings& settings) : settings(settings) {}
+
+void ParkingPolicy::setSettings(const Settings& newSettings) {
+    settings = newSettings;
+}
+
+const ParkingPolicy::Settings& ParkingPolicy::getSettings() const {
+    return settings;
+}
+
+const std::vector<double>& ParkingPolicy::getFloorDemand() const {
+    return floorDemand;
+}
+
+void ParkingPolicy::chooseFloors(const std::vector<Elevator>& elevators, const DemandForecaster& forecaster,
+                                 double time, int floorCount, std::vector<int>& homeFloors) {
+    homeFloors.assign(elevators.size(), 1);
+    floorDemand.assign(floorCount + 1, 0.0);
+    if (!forecaster.hasHistory()) return;
+    
+    double horizon = settings.horizon / (24.0 * 3600) * forecaster.getDayLength();
+    double total = 0.0;
+    for (int floor = 1; floor <= floorCount; ++floor) {
+        floorDemand[floor] = forecaster.forecastArrivals(floor, DemandForecaster::ANY, time, horizon);
+        total += floorDemand[floor];
+    }
+    if (total < settings.minimumDemand) return;
+    
+    // 覆盖程度：本层为1，按距离线性递减，超出范围为0
+    int radius = std::max(1, settings.coverRadius);
+    auto cover = [radius](int distance) {
+        return distance >= radius ? 0.0 : 1.0 - static_cast<double>(distance) / radius;
+    };
+    
+    remaining = floorDemand;
+    targets.clear();
+    for (size_t car = 0; car < elevators.size(); ++car) {
+        int bestFloor = 1;
+        double bestGain = -1.0;
+        for (int floor = 1; floor <= floorCount; ++floor) {
+            double gain = 0.0;
+            for (int other = std::max(1, floor - radius + 1);
+                 other <= std::min(floorCount, floor + radius - 1); ++other) {
+                gain += remaining[other] * cover(std::abs(other - floor));
+            }
+            if (gain > bestGain) {
+                bestGain = gain;
+                bestFloor = floor;
+            }
+        }
+        targets.push_back(bestFloor);
+        for (int other = std::max(1, bestFloor - radius + 1);
+             other <= std::min(floorCount, bestFloor + radius - 1); ++other) {
+            remaining[other] *= 1.0 - 0.5 * cover(std::abs(other - bestFloor));
+        }
+    }
+    
+    // 已停在某个停靠层的空闲电梯不动，避免电梯之间来回交换位置
+    std::sort(targets.begin(), targets.end());
+    targetUsed.assign(targets.size(), false);
+    order.clear();
+    for (size_t car = 0; car < elevators.size(); ++car) {
+        const auto& elevator = elevators[car];
+        bool settled = false;
+        if (elevator.getState() == ElevatorState::IDLE && elevator.getCommittedLoad() == 0) {
+            for (size_t i = 0; i < targets.size(); ++i) {
+                if (!targetUsed[i] && targets[i] == elevator.getCurrentFloor()) {
+                    targetUsed[i] = true;
+                    homeFloors[car] = targets[i];
+                    settled = true;
+                    break;
+                }
+            }
+        }
+        if (!settled) {
+            order.push_back(static_cast<int>(car));
+        }
+    }
+    
+    // 其余电梯：一维上按顺序配对即为总距离最短的分配
+    std::stable_sort(order.begin(), order.end(), [&elevators](int a, int b) {
+        return elevators[a].getCurrentFloor() < elevators[b].getCurrentFloor();
+    });
+    size_t next = 0;
+    for (int car : order) {
+        while (targetUsed[next]) ++next;
+        homeFloors[car] = targets[next++];
+    }
+}
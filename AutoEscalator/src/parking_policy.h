@@ -0,0 +1,41 @@
+#pragma once
+#include "demand_forecaster.h"
+#include "elevator.h"
+#include <vector>
+
+// 预测停靠：按需求模型预计接下来一段时间各层的到达人数，为每部电梯选一个停靠层，
+// 电梯空闲超时后前往该层待命，而不是一律回到1楼。
+// 选层时逐部电梯挑选覆盖剩余需求最多的楼层（相邻楼层按距离折减），
+// 选中后附近楼层的需求按覆盖程度减半，需求大的楼层可以停多部电梯；
+// 已在某个停靠层待命的电梯留在原地，其余电梯按楼层顺序配对，使空驶距离最短。
+// 没有历史或预计需求太少时全部回到1楼，与原来的行为相同。
+class ParkingPolicy {
+public:
+    struct Settings {
+        bool enabled = true;
+        double horizon = 15 * 60.0;    // 预测的时长（24小时制的秒数）
+        int coverRadius = 3;           // 一部电梯能兼顾的楼层范围
+        double minimumDemand = 0.5;    // 预计到达人数低于此值时回到1楼
+    };
+    
+private:
+    Settings settings;
+    std::vector<double> floorDemand;  // 各层预计到达人数
+    std::vector<double> remaining;    // 选层时尚未覆盖的需求（复用缓冲）
+    std::vector<int> targets;
+    std::vector<int> order;
+    std::vector<bool> targetUsed;
+    
+public:
+    ParkingPolicy();
+    explicit ParkingPolicy(const Settings& settings);
+    
+    void setSettings(const Settings& newSettings);
+    const Settings& getSettings() const;
+    
+    // 为每部电梯选出停靠层，写入 homeFloors（下标与 elevators 对应）
+    void chooseFloors(const std::vector<Elevator>& elevators, const DemandForecaster& forecaster,
+                      double time, int floorCount, std::vector<int>& homeFloors);
+    // 最近一次 chooseFloors 时各层的预计到达人数（下标为楼层，0号不用）
+    const std::vector<double>& getFloorDemand() const;
+};
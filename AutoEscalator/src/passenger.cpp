@@ -1,7 +1,8 @@
 #include "passenger.h"
 
 Passenger::Passenger(int from, int to) 
-    : sourceFloor(from), targetFloor(to), waitTime(0.0), isTimeout(false) {}
+    : sourceFloor(from), targetFloor(to), waitTime(0.0), timeoutOffset(0.0), isTimeout(false),
+      boardingRecorded(false) {}
 
 int Passenger::getSourceFloor() const {
     return sourceFloor;
@@ -17,11 +18,45 @@ double Passenger::getWaitTime() const {
 
 void Passenger::updateWaitTime(double deltaTime) {
     waitTime += deltaTime;
-    if (waitTime >= ElevatorConfig::MAX_WAIT_TIME) {
+    if (waitTime - timeoutOffset >= ElevatorConfig::MAX_WAIT_TIME) {
         isTimeout = true;
     }
 }
 
 bool Passenger::hasTimeout() const {
     return isTimeout;
-} 
\ No newline at end of file
+}
+
+void Passenger::relocate(int floor) {
+    sourceFloor = floor;
+    timeoutOffset = waitTime;
+    isTimeout = false;
+}
+
+void Passenger::markBoarded() {
+    boardingRecorded = true;
+}
+
+bool Passenger::takeBoardingRecord() {
+    bool recorded = boardingRecorded;
+    boardingRecorded = false;
+    return recorded;
+}
+
+void Passenger::saveState(StateWriter& out) const {
+    out.writeInt(sourceFloor);
+    out.writeInt(targetFloor);
+    out.writeDouble(waitTime);
+    out.writeDouble(timeoutOffset);
+    out.writeBool(isTimeout);
+    out.writeBool(boardingRecorded);
+}
+
+void Passenger::loadState(StateReader& in) {
+    sourceFloor = static_cast<int>(in.readInt());
+    targetFloor = static_cast<int>(in.readInt());
+    waitTime = in.readDouble();
+    timeoutOffset = in.readDouble();
+    isTimeout = in.readBool();
+    boardingRecorded = in.readBool();
+}
@@ -1,12 +1,15 @@
 #pragma once
 #include "config.h"
+#include "state_io.h"
 
 class Passenger {
 private:
     int sourceFloor;
     int targetFloor;
     double waitTime;
+    double timeoutOffset;  // 超时从这一等待时间起算，被停用电梯放下的乘客重新计
     bool isTimeout;
+    bool boardingRecorded; // 上梯已计入当天指标，被停用电梯放下时据此撤销
     
 public:
     Passenger(int from, int to);
@@ -16,4 +19,12 @@ public:
     double getWaitTime() const;
     void updateWaitTime(double deltaTime);
     bool hasTimeout() const;
+    // 被停用的电梯放在 floor 层：从该层重新候梯，已等待的时间保留，超时重新计
+    void relocate(int floor);
+    void markBoarded();
+    // 返回上梯是否已计入指标，并清除该标记
+    bool takeBoardingRecord();
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
 }; 
\ No newline at end of file
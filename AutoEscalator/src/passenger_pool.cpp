@@ -0,0 +1,105 @@
+#include "passenger_pool.h"
+
+PassengerPool::PassengerPool() : freeHead(NONE), liveCount(0), growthCount(0) {}
+
+PassengerPool::Handle PassengerPool::acquire(const Passenger& passenger) {
+    ++liveCount;
+    if (freeHead != NONE) {
+        Handle handle = freeHead;
+        freeHead = entries[handle].next;
+        entries[handle] = Slot{passenger, NONE};
+        return handle;
+    }
+    if (entries.size() == entries.capacity()) {
+        ++growthCount;
+    }
+    entries.push_back(Slot{passenger, NONE});
+    return static_cast<Handle>(entries.size() - 1);
+}
+
+void PassengerPool::release(Handle handle) {
+    entries[handle].next = freeHead;
+    freeHead = handle;
+    --liveCount;
+}
+
+void PassengerPool::reserve(size_t count) {
+    if (count > entries.capacity()) {
+        entries.reserve(count);
+        ++growthCount;
+    }
+}
+
+void PassengerPool::clear() {
+    entries.clear();
+    freeHead = NONE;
+    liveCount = 0;
+}
+
+void PassengerPool::pushBack(List& list, Handle handle) {
+    entries[handle].next = NONE;
+    if (list.tail == NONE) {
+        list.head = handle;
+    } else {
+        entries[list.tail].next = handle;
+    }
+    list.tail = handle;
+    ++list.count;
+}
+
+void PassengerPool::pushFront(List& list, Handle handle) {
+    entries[handle].next = list.head;
+    list.head = handle;
+    if (list.tail == NONE) {
+        list.tail = handle;
+    }
+    ++list.count;
+}
+
+PassengerPool::Handle PassengerPool::popFront(List& list) {
+    Handle handle = list.head;
+    if (handle == NONE) {
+        return NONE;
+    }
+    list.head = entries[handle].next;
+    if (list.head == NONE) {
+        list.tail = NONE;
+    }
+    --list.count;
+    return handle;
+}
+
+void PassengerPool::releaseAll(List& list) {
+    while (!list.empty()) {
+        release(popFront(list));
+    }
+}
+
+size_t PassengerPool::getLiveCount() const {
+    return liveCount;
+}
+
+size_t PassengerPool::getCapacity() const {
+    return entries.capacity();
+}
+
+size_t PassengerPool::getGrowthCount() const {
+    return growthCount;
+}
+
+void PassengerPool::saveList(StateWriter& out, const List& list) const {
+    out.writeUnsigned(list.size());
+    forEach(list, [&](const Passenger& passenger) {
+        passenger.saveState(out);
+    });
+}
+
+void PassengerPool::loadList(StateReader& in, List& list) {
+    releaseAll(list);
+    size_t count = in.readCount();
+    for (size_t i = 0; i < count && in.isOk(); ++i) {
+        Passenger passenger(1, 1);
+        passenger.loadState(in);
+        pushBack(list, acquire(passenger));
+    }
+}
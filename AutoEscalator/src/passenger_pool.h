@@ -0,0 +1,137 @@
+#pragma once
+#include "passenger.h"
+#include "state_io.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 乘客对象池：乘客记录放在一块连续的槽位数组中，用32位句柄引用。
+// 候梯队列和轿厢内/已分配的乘客都是串在槽位上的侵入式单向链表，乘客在队列和电梯之间
+// 移动只改链接，不复制也不分配；送达或超时后槽位回到空闲链表，供下一个到达的乘客复用。
+// 槽位数组只在同时在场的乘客数超过历史最高时扩容，稳定运行后不再分配内存。
+// 句柄是下标而不是指针，复制整个池（分支推演复制楼宇）后原有的链表在副本中照样有效
+class PassengerPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle NONE = UINT32_MAX;
+
+    // 链表头：首尾句柄和人数，链接保存在槽位中
+    struct List {
+        Handle head = NONE;
+        Handle tail = NONE;
+        uint32_t count = 0;
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+    };
+
+private:
+    struct Slot {
+        Passenger passenger;
+        Handle next;  // 所在链表的下一个；空闲时为空闲链表的下一个
+    };
+
+    std::vector<Slot> entries;  // 不叫 slots：Qt 前端也包含本头文件，而 Qt 把 slots 定义为宏
+    Handle freeHead;
+    size_t liveCount;
+    size_t growthCount;  // 槽位数组重新分配的次数
+
+public:
+    PassengerPool();
+
+    // 取一个空闲槽位放入乘客，没有空闲槽位时扩容
+    Handle acquire(const Passenger& passenger);
+    // 归还槽位，句柄此后不得再用；调用方须先把它从所在链表中取下
+    void release(Handle handle);
+    // 预留槽位，使同时在场不超过 count 人时不再分配
+    void reserve(size_t count);
+    // 归还全部槽位，所有链表随之失效
+    void clear();
+
+    Passenger& get(Handle handle) { return entries[handle].passenger; }
+    const Passenger& get(Handle handle) const { return entries[handle].passenger; }
+    Handle next(Handle handle) const { return entries[handle].next; }
+
+    void pushBack(List& list, Handle handle);
+    void pushFront(List& list, Handle handle);
+    Handle popFront(List& list);
+    // 把整条链表的乘客都归还
+    void releaseAll(List& list);
+
+    // 按顺序遍历链表，对满足 predicate 的乘客先取下再交给 onRemoved（由它归还或挂到别的链表），
+    // 其余的保持原顺序
+    template <typename Predicate, typename OnRemoved>
+    void removeIf(List& list, Predicate predicate, OnRemoved onRemoved) {
+        Handle previous = NONE;
+        Handle current = list.head;
+        while (current != NONE) {
+            Handle following = entries[current].next;
+            if (predicate(entries[current].passenger)) {
+                if (previous == NONE) list.head = following;
+                else entries[previous].next = following;
+                if (list.tail == current) list.tail = previous;
+                --list.count;
+                onRemoved(current);
+            } else {
+                previous = current;
+            }
+            current = following;
+        }
+    }
+
+    template <typename Function>
+    void forEach(List& list, Function function) {
+        for (Handle h = list.head; h != NONE; h = entries[h].next) {
+            function(entries[h].passenger);
+        }
+    }
+
+    template <typename Function>
+    void forEach(const List& list, Function function) const {
+        for (Handle h = list.head; h != NONE; h = entries[h].next) {
+            function(entries[h].passenger);
+        }
+    }
+
+    size_t getLiveCount() const;    // 在场乘客数
+    size_t getCapacity() const;     // 不再分配即可容纳的人数
+    size_t getGrowthCount() const;
+
+    // 检查点：链表按顺序写出乘客，读入时重新取槽位，格式与逐个保存乘客相同
+    void saveList(StateWriter& out, const List& list) const;
+    void loadList(StateReader& in, List& list);
+};
+
+// 某条链表的只读视图，按排队顺序遍历，供界面、监控和观测使用
+class PassengerQueue {
+private:
+    const PassengerPool* pool;
+    PassengerPool::List list;
+
+public:
+    class Iterator {
+    private:
+        const PassengerPool* pool;
+        PassengerPool::Handle handle;
+
+    public:
+        Iterator(const PassengerPool* pool, PassengerPool::Handle handle) : pool(pool), handle(handle) {}
+        const Passenger& operator*() const { return pool->get(handle); }
+        const Passenger* operator->() const { return &pool->get(handle); }
+        Iterator& operator++() {
+            handle = pool->next(handle);
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return handle != other.handle; }
+        bool operator==(const Iterator& other) const { return handle == other.handle; }
+    };
+
+    PassengerQueue() : pool(nullptr) {}
+    PassengerQueue(const PassengerPool& pool, const PassengerPool::List& list) : pool(&pool), list(list) {}
+
+    bool empty() const { return list.empty(); }
+    size_t size() const { return list.size(); }
+    const Passenger& front() const { return pool->get(list.head); }
+    Iterator begin() const { return Iterator(pool, list.head); }
+    Iterator end() const { return Iterator(pool, PassengerPool::NONE); }
+};
@@ -2,17 +2,17 @@
 #include <sstream>
 #include <iomanip>
 
-void Performance::startMeasure(const std::string& operation) {
-    startTimes[operation] = Clock::now();
+void Performance::startMeasure(std::string_view operation) {
+    entry(startTimes, operation) = Clock::now();
 }
 
-void Performance::endMeasure(const std::string& operation) {
+void Performance::endMeasure(std::string_view operation) {
     auto endTime = Clock::now();
-    auto startTime = startTimes[operation];
+    auto startTime = entry(startTimes, operation);
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
         endTime - startTime).count() / 1000000.0; // 转换为秒
     
-    auto& metric = metrics[operation];
+    auto& metric = entry(metrics, operation);
     metric.totalTime += duration;
     metric.callCount++;
     metric.maxTime = std::max(metric.maxTime, duration);
@@ -1,6 +1,7 @@
 #pragma once
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
 
@@ -15,17 +16,27 @@ private:
         Metric() : totalTime(0), callCount(0), maxTime(0), minTime(999999) {}
     };
     
-    std::map<std::string, Metric> metrics;
+    // 按 string_view 查找，每步的测量不为操作名构造字符串，只在第一次出现时插入
+    std::map<std::string, Metric, std::less<>> metrics;
     using Clock = std::chrono::high_resolution_clock;
     using TimePoint = Clock::time_point;
-    std::map<std::string, TimePoint> startTimes;
+    std::map<std::string, TimePoint, std::less<>> startTimes;
+    
+    template <typename Value>
+    static Value& entry(std::map<std::string, Value, std::less<>>& map, std::string_view key) {
+        auto it = map.find(key);
+        if (it == map.end()) {
+            it = map.emplace(std::string(key), Value()).first;
+        }
+        return it->second;
+    }
     
 public:
     // 开始测量某个操作的时间
-    void startMeasure(const std::string& operation);
+    void startMeasure(std::string_view operation);
     
     // 结束测量并记录结果
-    void endMeasure(const std::string& operation);
+    void endMeasure(std::string_view operation);
     
     // 获取性能报告
     std::string getReport() const;
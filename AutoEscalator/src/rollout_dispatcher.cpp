@@ -0,0 +1,181 @@
+#include "rollout_dispatcher.h"
+#include "building.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <random>
+
+RolloutDispatcher::RolloutDispatcher() : RolloutDispatcher(Settings()) {}
+
+RolloutDispatcher::RolloutDispatcher(const Settings& settings)
+    : settings(settings), stats{0, 0, 0, 0.0, 0.0}, decisionCount(0) {}
+
+int RolloutDispatcher::assign(const Building& building, int floor) {
+    const auto& elevators = building.getElevators();
+    const Passenger& passenger = building.getWaitingQueue(floor).front();
+    
+    std::vector<int> candidates;
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        if (elevators[i].isInService() && elevators[i].getCommittedLoad() < elevators[i].getCapacity()) {
+            candidates.push_back(static_cast<int>(i));
+        }
+    }
+    if (candidates.size() < 2) {
+        return candidates.empty() ? -1 : candidates.front();
+    }
+    
+    auto begin = std::chrono::steady_clock::now();
+    auto deadline = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(settings.budgetMs));
+    ++stats.decisions;
+    
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(settings.threadCount);
+    }
+    
+    // 副本在调用线程上复制，超时返回后调用方即可继续修改楼宇
+    auto arrivals = std::make_shared<const std::vector<Arrival>>(sampleArrivals(building));
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    std::vector<std::future<double>> costs;
+    costs.reserve(candidates.size());
+    for (int elevatorIndex : candidates) {
+        auto clone = std::make_shared<Building>(building);
+        Settings rolloutSettings = settings;
+        costs.push_back(pool->submit([clone, floor, elevatorIndex, arrivals, rolloutSettings, cancelled]() {
+            return rollout(*clone, floor, elevatorIndex, *arrivals, rolloutSettings, *cancelled);
+        }));
+    }
+    stats.rollouts += candidates.size();
+    
+    int bestElevator = -1;
+    double minCost = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (settings.budgetMs > 0 &&
+            costs[i].wait_until(deadline) != std::future_status::ready) {
+            // 未完成的推演在下一次检查时退出，结果丢弃
+            cancelled->store(true);
+            bestElevator = -1;
+            break;
+        }
+        double cost = costs[i].get();
+        if (cost < minCost) {
+            minCost = cost;
+            bestElevator = candidates[i];
+        }
+    }
+    if (bestElevator < 0) {
+        ++stats.fallbacks;
+        bestElevator = estimateElevator(elevators, passenger);
+    }
+    
+    double elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    stats.totalDecisionMs += elapsed;
+    stats.maxDecisionMs = std::max(stats.maxDecisionMs, elapsed);
+    return bestElevator;
+}
+
+// 按需求曲线在推演时长内抽取到达；没有曲线时只推演已有的请求
+std::vector<RolloutDispatcher::Arrival> RolloutDispatcher::sampleArrivals(const Building& building) {
+    std::vector<Arrival> arrivals;
+    const DemandProfile* profile = building.getExpectedTraffic();
+    ++decisionCount;
+    if (!profile) {
+        return arrivals;
+    }
+    
+    std::mt19937 random(decisionCount);
+    double scale = building.getExpectedTrafficScale();
+    double begin = building.getCurrentTime() / scale;  // 曲线上的时刻
+    double end = (building.getCurrentTime() + settings.horizon) / scale;
+    for (const auto& slot : profile->getSlots()) {
+        double from = std::max(begin, slot.startTime);
+        double to = std::min(end, slot.endTime);
+        if (from >= to || slot.arrivalRate <= 0) continue;
+        
+        std::exponential_distribution<double> interval(slot.arrivalRate);
+        for (double t = from + interval(random); t < to; t += interval(random)) {
+            Arrival arrival;
+            arrival.time = t * scale - building.getCurrentTime();
+            profile->sampleTrip(slot, random, arrival.fromFloor, arrival.toFloor);
+            arrivals.push_back(arrival);
+        }
+    }
+    return arrivals;
+}
+
+// 推演代价：期间上梯乘客的等待时间、超时乘客按最长等待计，加上推演结束时仍在等待的乘客已等的时间
+double RolloutDispatcher::rollout(Building& clone, int floor, int elevatorIndex,
+                                  const std::vector<Arrival>& arrivals, const Settings& settings,
+                                  const std::atomic<bool>& cancelled) {
+    Logger::setThreadEnabled(false);  // 推演中的运行不是真实发生的
+    clone.setRecordingEnabled(false);
+    clone.getMaintenanceManager().setEnabled(false);
+    clone.setDispatchStrategy(Dispatcher::Strategy::NEAREST_FIRST);
+    if (!clone.assignWaitingPassenger(floor, elevatorIndex)) {
+        return std::numeric_limits<double>::max();
+    }
+    
+    const auto& metrics = clone.getMetrics();
+    double waitBefore = metrics.getTotalWaitTime();
+    int timeoutsBefore = metrics.getTimedOutPassengers();
+    
+    size_t next = 0;
+    int steps = static_cast<int>(std::ceil(settings.horizon / settings.timeStep));
+    for (int step = 0; step < steps; ++step) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return std::numeric_limits<double>::max();
+        }
+        for (; next < arrivals.size() && arrivals[next].time <= step * settings.timeStep; ++next) {
+            clone.addRequest(arrivals[next].fromFloor, arrivals[next].toFloor, 1);
+        }
+        clone.update(settings.timeStep);
+    }
+    
+    return (metrics.getTotalWaitTime() - waitBefore) +
+           (metrics.getTimedOutPassengers() - timeoutsBefore) * ElevatorConfig::MAX_WAIT_TIME +
+           clone.getPendingWaitTime();
+}
+
+int RolloutDispatcher::estimateElevator(const std::vector<Elevator>& elevators,
+                                        const Passenger& passenger) {
+    int bestElevator = -1;
+    double minTime = std::numeric_limits<double>::max();
+    
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const auto& elevator = elevators[i];
+        if (!elevator.isInService() || elevator.getCommittedLoad() >= elevator.getCapacity()) {
+            continue;
+        }
+        
+        double time = elevator.estimateArrivalTime(passenger.getSourceFloor());
+        if (time < minTime) {
+            minTime = time;
+            bestElevator = i;
+        }
+    }
+    
+    return bestElevator;
+}
+
+void RolloutDispatcher::setSettings(const Settings& newSettings) {
+    if (newSettings.threadCount != settings.threadCount) {
+        pool.reset();
+    }
+    settings = newSettings;
+}
+
+const RolloutDispatcher::Settings& RolloutDispatcher::getSettings() const {
+    return settings;
+}
+
+const RolloutDispatcher::Statistics& RolloutDispatcher::getStatistics() const {
+    return stats;
+}
+
+void RolloutDispatcher::resetStatistics() {
+    stats = {0, 0, 0, 0.0, 0.0};
+}
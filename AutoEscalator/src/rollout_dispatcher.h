@@ -0,0 +1,65 @@
+#pragma once
+#include "demand_profile.h"
+#include "elevator.h"
+#include "passenger.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class Building;
+
+// 前瞻推演调度：对每个新的候梯请求，为每部能接载的电梯各复制一份楼宇，
+// 在副本里把请求分给这部电梯，按预期客流往后模拟一段时间，选总等待时间最少的电梯。
+// 各副本在线程池上并行推演；每次决策有时间预算，超时则改用按到达时间估算的启发式。
+// 副本内部按最近优先调度，不再嵌套推演。
+class RolloutDispatcher {
+public:
+    struct Settings {
+        double horizon = 90.0;    // 推演时长（秒）
+        double timeStep = 0.5;    // 推演步长（秒）
+        double budgetMs = 20.0;   // 每次决策的时间预算（毫秒），0表示不限时，结果可复现
+        size_t threadCount = 0;   // 推演线程数，0表示硬件线程数
+    };
+    
+    struct Statistics {
+        long long decisions;      // 有两部以上候选电梯、需要推演的决策
+        long long rollouts;
+        long long fallbacks;      // 超出预算改用估算的决策
+        double totalDecisionMs;
+        double maxDecisionMs;
+    };
+    
+    // 预期客流：推演期间按需求曲线抽取的到达，时刻相对决策时刻
+    struct Arrival {
+        double time;
+        int fromFloor;
+        int toFloor;
+    };
+    
+private:
+    Settings settings;
+    Statistics stats;
+    std::unique_ptr<ThreadPool> pool;  // 第一次需要推演时创建
+    unsigned int decisionCount;        // 抽取预期客流的种子，同一决策的各候选看到相同客流
+    
+    std::vector<Arrival> sampleArrivals(const Building& building);
+    static double rollout(Building& clone, int floor, int elevatorIndex,
+                          const std::vector<Arrival>& arrivals, const Settings& settings,
+                          const std::atomic<bool>& cancelled);
+    
+public:
+    RolloutDispatcher();
+    explicit RolloutDispatcher(const Settings& settings);
+    
+    // 为 floor 层队首的乘客选择电梯，没有电梯能接载时返回-1
+    int assign(const Building& building, int floor);
+    
+    // 按 Elevator::estimateArrivalTime 选最早到达的电梯
+    static int estimateElevator(const std::vector<Elevator>& elevators, const Passenger& passenger);
+    
+    void setSettings(const Settings& newSettings);
+    const Settings& getSettings() const;
+    const Statistics& getStatistics() const;
+    void resetStatistics();
+};
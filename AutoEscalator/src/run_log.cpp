@@ -0,0 +1,542 @@
+#include "run_log.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+namespace RunLog {
+    namespace {
+        const char FILE_MAGIC[4] = {'E', 'L', 'R', 'L'};
+        const char INDEX_MAGIC[4] = {'E', 'L', 'I', 'X'};
+        const char END_MAGIC[4] = {'E', 'L', 'R', 'E'};
+        const size_t FOOTER_SIZE = 12;
+        
+        // 状态事件中哪些字段发生了变化
+        const uint8_t CHANGED_FLOOR = 1;
+        const uint8_t CHANGED_PASSENGERS = 2;
+        const uint8_t CHANGED_STATE = 4;
+        const uint8_t CHANGED_ENERGY = 8;
+        
+        void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+        
+        void putSigned(std::vector<uint8_t>& out, long long value) {
+            // zigzag：小的负数也编码成短的变长整数
+            putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+        
+        void putFixed(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; ++i) {
+                out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+        
+        void putDouble(std::vector<uint8_t>& out, double value) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            putFixed(out, bits, 8);
+        }
+        
+        // 从缓冲区顺序读取，越界时置 ok=false 并返回0
+        struct Cursor {
+            const uint8_t* data;
+            size_t size;
+            size_t pos;
+            bool ok;
+            
+            Cursor(const uint8_t* d, size_t s, size_t p = 0) : data(d), size(s), pos(p), ok(true) {}
+            
+            uint64_t varint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    if (pos >= size) break;
+                    uint8_t byte = data[pos++];
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) return value;
+                }
+                ok = false;
+                return 0;
+            }
+            
+            long long signedVarint() {
+                uint64_t value = varint();
+                return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+            }
+            
+            uint64_t fixed(int bytes) {
+                if (pos + bytes > size) {
+                    ok = false;
+                    return 0;
+                }
+                uint64_t value = 0;
+                for (int i = 0; i < bytes; ++i) {
+                    value |= static_cast<uint64_t>(data[pos++]) << (8 * i);
+                }
+                return value;
+            }
+            
+            double fixedDouble() {
+                uint64_t bits = fixed(8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            
+            uint8_t byte() {
+                if (pos >= size) {
+                    ok = false;
+                    return 0;
+                }
+                return data[pos++];
+            }
+        };
+        
+        void writeBytes(std::ofstream& file, const std::vector<uint8_t>& bytes) {
+            file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+    }
+    
+    const char* getEventName(EventType type) {
+        switch (type) {
+            case EventType::CAR_KEYFRAME: return "keyframe";
+            case EventType::CAR_STATE: return "car_state";
+            case EventType::REQUEST: return "request";
+            case EventType::BOARDING: return "boarding";
+            case EventType::DELIVERY: return "delivery";
+            case EventType::TIMEOUT: return "timeout";
+        }
+        return "unknown";
+    }
+    
+    // ---------------- Writer ----------------
+    
+    Writer::Writer(size_t blockLimit)
+        : blockEvents(0), blockStartTime(0), lastTimeMs(0), blockLimit(blockLimit) {}
+    
+    Writer::~Writer() {
+        close();
+    }
+    
+    bool Writer::open(const std::string& filename, const Config& config) {
+        close();
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        
+        std::vector<uint8_t> header(FILE_MAGIC, FILE_MAGIC + 4);
+        putFixed(header, VERSION, 2);
+        putFixed(header, static_cast<uint32_t>(config.floorCount), 4);
+        putFixed(header, static_cast<uint32_t>(config.elevatorCount), 4);
+        putFixed(header, static_cast<uint32_t>(config.capacity), 4);
+        putFixed(header, static_cast<uint32_t>(config.strategy), 4);
+        putDouble(header, config.floorTravelTime);
+        putDouble(header, config.maxIdleTime);
+        putDouble(header, config.maxWaitTime);
+        writeBytes(file, header);
+        
+        block.clear();
+        blockEvents = 0;
+        lastTimeMs = 0;
+        index.clear();
+        cars.assign(std::max(config.elevatorCount, 0), CarState());
+        return file.good();
+    }
+    
+    void Writer::close() {
+        if (!file.is_open()) return;
+        flushBlock();
+        
+        uint64_t indexOffset = static_cast<uint64_t>(file.tellp());
+        std::vector<uint8_t> tail(INDEX_MAGIC, INDEX_MAGIC + 4);
+        putVarint(tail, index.size());
+        long long previousTime = 0;
+        uint64_t previousOffset = 0;
+        for (const auto& entry : index) {
+            putVarint(tail, entry.first - previousTime);
+            putVarint(tail, entry.second - previousOffset);
+            previousTime = entry.first;
+            previousOffset = entry.second;
+        }
+        putFixed(tail, indexOffset, 8);
+        tail.insert(tail.end(), END_MAGIC, END_MAGIC + 4);
+        writeBytes(file, tail);
+        file.close();
+        index.clear();
+    }
+    
+    bool Writer::isOpen() const {
+        return file.is_open();
+    }
+    
+    void Writer::write(const Event& event) {
+        if (!file.is_open()) return;
+        
+        if (event.type == EventType::CAR_STATE) {
+            if (event.elevator < 0 || event.elevator >= static_cast<int>(cars.size())) return;
+            const CarState& car = cars[event.elevator];
+            if (car.floor == event.floor && car.passengers == event.passengers &&
+                car.state == event.state) {
+                return;  // 只有能耗变化不算状态转换
+            }
+        }
+        
+        Event timed = event;
+        timed.timeMs = std::max(event.timeMs, lastTimeMs);
+        if (block.empty()) {
+            beginBlock(timed.timeMs);
+        }
+        encode(timed);
+        
+        if (block.size() >= blockLimit) {
+            flushBlock();
+        }
+    }
+    
+    void Writer::beginBlock(long long timeMs) {
+        blockStartTime = timeMs;
+        lastTimeMs = timeMs;
+        putVarint(block, timeMs);
+        
+        // 关键帧让每一块都能独立解码，读取方可以直接跳到任何一块
+        for (size_t i = 0; i < cars.size(); ++i) {
+            Event keyframe;
+            keyframe.timeMs = timeMs;
+            keyframe.type = EventType::CAR_KEYFRAME;
+            keyframe.elevator = static_cast<int>(i);
+            keyframe.floor = cars[i].floor;
+            keyframe.passengers = cars[i].passengers;
+            keyframe.state = cars[i].state;
+            keyframe.energyWh = cars[i].energyWh;
+            encode(keyframe);
+        }
+    }
+    
+    void Writer::flushBlock() {
+        if (block.empty()) return;
+        
+        index.emplace_back(blockStartTime, static_cast<uint64_t>(file.tellp()));
+        std::vector<uint8_t> header;
+        putFixed(header, block.size(), 4);
+        putFixed(header, blockEvents, 4);
+        writeBytes(file, header);
+        writeBytes(file, block);
+        
+        block.clear();
+        blockEvents = 0;
+    }
+    
+    void Writer::encode(const Event& event) {
+        putVarint(block, event.timeMs - lastTimeMs);
+        lastTimeMs = event.timeMs;
+        block.push_back(static_cast<uint8_t>(event.type));
+        ++blockEvents;
+        
+        switch (event.type) {
+            case EventType::CAR_KEYFRAME:
+                putVarint(block, event.elevator);
+                putSigned(block, event.floor);
+                putVarint(block, event.passengers);
+                putVarint(block, event.state);
+                putSigned(block, event.energyWh);
+                break;
+                
+            case EventType::CAR_STATE: {
+                CarState& car = cars[event.elevator];
+                uint8_t changed = 0;
+                if (event.floor != car.floor) changed |= CHANGED_FLOOR;
+                if (event.passengers != car.passengers) changed |= CHANGED_PASSENGERS;
+                if (event.state != car.state) changed |= CHANGED_STATE;
+                if (event.energyWh != car.energyWh) changed |= CHANGED_ENERGY;
+                
+                putVarint(block, event.elevator);
+                block.push_back(changed);
+                if (changed & CHANGED_FLOOR) putSigned(block, event.floor - car.floor);
+                if (changed & CHANGED_PASSENGERS) putSigned(block, event.passengers - car.passengers);
+                if (changed & CHANGED_STATE) putVarint(block, event.state);
+                if (changed & CHANGED_ENERGY) putSigned(block, event.energyWh - car.energyWh);
+                
+                car.floor = event.floor;
+                car.passengers = event.passengers;
+                car.state = event.state;
+                car.energyWh = event.energyWh;
+                break;
+            }
+                
+            case EventType::REQUEST:
+                putSigned(block, event.floor);
+                putSigned(block, event.target);
+                putVarint(block, event.passengers);
+                break;
+                
+            case EventType::BOARDING:
+                putVarint(block, event.elevator);
+                putSigned(block, event.floor);
+                putVarint(block, event.waitMs);
+                break;
+                
+            case EventType::DELIVERY:
+                putVarint(block, event.elevator);
+                putSigned(block, event.floor);
+                putVarint(block, event.passengers);
+                break;
+                
+            case EventType::TIMEOUT:
+                putSigned(block, event.floor);
+                putVarint(block, event.waitMs);
+                break;
+        }
+    }
+    
+    // ---------------- Reader ----------------
+    
+    Reader::Reader()
+        : blockPos(0), blockRemaining(0), nextBlock(0), lastTimeMs(0), skipBeforeMs(0) {}
+    
+    bool Reader::fail(const std::string& message) {
+        lastError = message;
+        index.clear();
+        block.clear();
+        blockRemaining = 0;
+        if (file.is_open()) file.close();
+        return false;
+    }
+    
+    bool Reader::open(const std::string& filename) {
+        if (file.is_open()) file.close();
+        lastError.clear();
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) return fail("无法打开文件: " + filename);
+        
+        // 文件头和配置
+        std::vector<uint8_t> header(4 + 2 + 4 * 4 + 8 * 3);
+        file.read(reinterpret_cast<char*>(header.data()), header.size());
+        if (file.gcount() != static_cast<std::streamsize>(header.size()) ||
+            std::memcmp(header.data(), FILE_MAGIC, 4) != 0) {
+            return fail("不是运行日志文件: " + filename);
+        }
+        Cursor cursor(header.data(), header.size(), 4);
+        uint64_t version = cursor.fixed(2);
+        if (version != VERSION) {
+            return fail("不支持的日志版本: " + std::to_string(version));
+        }
+        config.floorCount = static_cast<int>(cursor.fixed(4));
+        config.elevatorCount = static_cast<int>(cursor.fixed(4));
+        config.capacity = static_cast<int>(cursor.fixed(4));
+        config.strategy = static_cast<int>(cursor.fixed(4));
+        config.floorTravelTime = cursor.fixedDouble();
+        config.maxIdleTime = cursor.fixedDouble();
+        config.maxWaitTime = cursor.fixedDouble();
+        if (config.elevatorCount < 0 || config.elevatorCount > 4096) {
+            return fail("日志配置损坏");
+        }
+        
+        // 文件尾指向索引
+        file.seekg(0, std::ios::end);
+        std::streamoff fileSize = file.tellg();
+        if (fileSize < static_cast<std::streamoff>(header.size() + FOOTER_SIZE)) {
+            return fail("日志文件不完整（写入时未正常关闭？）");
+        }
+        std::vector<uint8_t> footer(FOOTER_SIZE);
+        file.seekg(fileSize - static_cast<std::streamoff>(FOOTER_SIZE));
+        file.read(reinterpret_cast<char*>(footer.data()), footer.size());
+        if (std::memcmp(footer.data() + 8, END_MAGIC, 4) != 0) {
+            return fail("日志文件不完整（写入时未正常关闭？）");
+        }
+        Cursor footerCursor(footer.data(), footer.size());
+        uint64_t indexOffset = footerCursor.fixed(8);
+        if (indexOffset < header.size() ||
+            indexOffset > static_cast<uint64_t>(fileSize) - FOOTER_SIZE) {
+            return fail("索引偏移无效");
+        }
+        
+        std::vector<uint8_t> indexBytes(static_cast<size_t>(fileSize) - FOOTER_SIZE - indexOffset);
+        file.seekg(static_cast<std::streamoff>(indexOffset));
+        file.read(reinterpret_cast<char*>(indexBytes.data()), indexBytes.size());
+        if (indexBytes.size() < 4 || std::memcmp(indexBytes.data(), INDEX_MAGIC, 4) != 0) {
+            return fail("索引损坏");
+        }
+        Cursor indexCursor(indexBytes.data(), indexBytes.size(), 4);
+        uint64_t count = indexCursor.varint();
+        index.clear();
+        long long time = 0;
+        uint64_t offset = 0;
+        for (uint64_t i = 0; i < count && indexCursor.ok; ++i) {
+            time += static_cast<long long>(indexCursor.varint());
+            offset += indexCursor.varint();
+            index.emplace_back(time, offset);
+        }
+        if (!indexCursor.ok) return fail("索引损坏");
+        
+        cars.assign(config.elevatorCount, CarState());
+        return seek(getStartTime());
+    }
+    
+    const Config& Reader::getConfig() const {
+        return config;
+    }
+    
+    const std::string& Reader::getLastError() const {
+        return lastError;
+    }
+    
+    size_t Reader::getBlockCount() const {
+        return index.size();
+    }
+    
+    long long Reader::getStartTime() const {
+        return index.empty() ? 0 : index.front().first;
+    }
+    
+    bool Reader::seek(long long timeMs) {
+        if (!file.is_open()) return false;
+        skipBeforeMs = timeMs;
+        block.clear();
+        blockRemaining = 0;
+        
+        // 从起始时间早于 timeMs 的最后一块开始，同一时刻的事件跨块时也不会漏掉
+        auto it = std::lower_bound(index.begin(), index.end(), timeMs,
+            [](const std::pair<long long, uint64_t>& entry, long long t) { return entry.first < t; });
+        size_t target = static_cast<size_t>(it - index.begin());
+        if (target > 0) --target;
+        nextBlock = target;
+        return true;
+    }
+    
+    bool Reader::loadBlock(size_t blockIndex) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(index[blockIndex].second));
+        uint8_t header[8];
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (file.gcount() != sizeof(header)) return fail("数据块损坏");
+        
+        Cursor headerCursor(header, sizeof(header));
+        uint64_t length = headerCursor.fixed(4);
+        blockRemaining = static_cast<uint32_t>(headerCursor.fixed(4));
+        block.resize(length);
+        file.read(reinterpret_cast<char*>(block.data()), length);
+        if (file.gcount() != static_cast<std::streamsize>(length)) return fail("数据块损坏");
+        
+        Cursor cursor(block.data(), block.size());
+        lastTimeMs = static_cast<long long>(cursor.varint());
+        blockPos = cursor.pos;
+        return cursor.ok;
+    }
+    
+    bool Reader::next(Event& event) {
+        while (true) {
+            while (blockRemaining == 0) {
+                if (nextBlock >= index.size()) return false;
+                if (!loadBlock(nextBlock++)) return false;
+            }
+            if (!decode(event)) return fail("数据块损坏");
+            --blockRemaining;
+            // 定位点之前的事件只用来恢复电梯状态
+            if (event.timeMs >= skipBeforeMs) return true;
+        }
+    }
+    
+    bool Reader::decode(Event& event) {
+        Cursor cursor(block.data(), block.size(), blockPos);
+        event = Event();
+        lastTimeMs += static_cast<long long>(cursor.varint());
+        event.timeMs = lastTimeMs;
+        event.type = static_cast<EventType>(cursor.byte());
+        
+        switch (event.type) {
+            case EventType::CAR_KEYFRAME: {
+                event.elevator = static_cast<int>(cursor.varint());
+                event.floor = static_cast<int>(cursor.signedVarint());
+                event.passengers = static_cast<int>(cursor.varint());
+                event.state = static_cast<int>(cursor.varint());
+                event.energyWh = cursor.signedVarint();
+                if (event.elevator >= static_cast<int>(cars.size())) return false;
+                CarState& car = cars[event.elevator];
+                car.floor = event.floor;
+                car.passengers = event.passengers;
+                car.state = event.state;
+                car.energyWh = event.energyWh;
+                break;
+            }
+                
+            case EventType::CAR_STATE: {
+                event.elevator = static_cast<int>(cursor.varint());
+                if (event.elevator >= static_cast<int>(cars.size())) return false;
+                CarState& car = cars[event.elevator];
+                uint8_t changed = cursor.byte();
+                if (changed & CHANGED_FLOOR) car.floor += static_cast<int>(cursor.signedVarint());
+                if (changed & CHANGED_PASSENGERS) car.passengers += static_cast<int>(cursor.signedVarint());
+                if (changed & CHANGED_STATE) car.state = static_cast<int>(cursor.varint());
+                if (changed & CHANGED_ENERGY) car.energyWh += cursor.signedVarint();
+                event.floor = car.floor;
+                event.passengers = car.passengers;
+                event.state = car.state;
+                event.energyWh = car.energyWh;
+                break;
+            }
+                
+            case EventType::REQUEST:
+                event.floor = static_cast<int>(cursor.signedVarint());
+                event.target = static_cast<int>(cursor.signedVarint());
+                event.passengers = static_cast<int>(cursor.varint());
+                break;
+                
+            case EventType::BOARDING:
+                event.elevator = static_cast<int>(cursor.varint());
+                event.floor = static_cast<int>(cursor.signedVarint());
+                event.waitMs = static_cast<long long>(cursor.varint());
+                break;
+                
+            case EventType::DELIVERY:
+                event.elevator = static_cast<int>(cursor.varint());
+                event.floor = static_cast<int>(cursor.signedVarint());
+                event.passengers = static_cast<int>(cursor.varint());
+                break;
+                
+            case EventType::TIMEOUT:
+                event.floor = static_cast<int>(cursor.signedVarint());
+                event.waitMs = static_cast<long long>(cursor.varint());
+                break;
+                
+            default:
+                return false;
+        }
+        
+        blockPos = cursor.pos;
+        return cursor.ok;
+    }
+    
+    long long exportToCSV(Reader& reader, const std::string& filename,
+                          long long fromMs, long long toMs) {
+        std::ofstream out(filename);
+        if (!out.is_open() || !reader.seek(fromMs)) return -1;
+        
+        out << "Time,Event,ElevatorID,Floor,Target,Passengers,State,WaitTime,Energy(kWh)\n";
+        out << std::fixed << std::setprecision(3);
+        
+        long long rows = 0;
+        Event event;
+        while (reader.next(event)) {
+            if (toMs >= 0 && event.timeMs > toMs) break;
+            bool isCar = event.type == EventType::CAR_KEYFRAME || event.type == EventType::CAR_STATE;
+            
+            out << event.timeMs / 1000.0 << ',' << getEventName(event.type) << ',';
+            if (event.elevator >= 0) out << event.elevator;
+            out << ',' << event.floor << ',';
+            if (event.type == EventType::REQUEST) out << event.target;
+            out << ',' << event.passengers << ',';
+            if (isCar) out << event.state;
+            out << ',';
+            if (event.type == EventType::BOARDING || event.type == EventType::TIMEOUT) {
+                out << event.waitMs / 1000.0;
+            }
+            out << ',';
+            if (isCar) out << event.energyWh / 1000.0;
+            out << '\n';
+            ++rows;
+        }
+        return reader.getLastError().empty() ? rows : -1;
+    }
+}
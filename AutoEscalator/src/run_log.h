@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 二进制运行日志：记录模拟配置、电梯状态变化和乘客从请求到送达/超时的全过程。
+//
+// 文件结构（整数均为小端）：
+//   文件头   "ELRL" + 版本(u16) + 配置
+//   数据块   负载长度(u32) + 事件数(u32) + 负载；块内事件按时间排序，
+//            时间(毫秒)相对上一事件做差分，字段用 LEB128 变长整数编码。
+//            每块开头是所有电梯的完整状态（关键帧），之后的状态事件只记变化量，
+//            因此从任何一块开始都能独立解码
+//   索引     "ELIX" + 块数 + 每块(起始时间, 文件偏移)，均差分编码
+//   文件尾   索引偏移(u64) + "ELRE"
+// 读取时按索引二分找到目标时刻所在的块，只解码这一块之后的数据。
+namespace RunLog {
+    const uint16_t VERSION = 1;
+    
+    enum class EventType : uint8_t {
+        CAR_KEYFRAME = 1,  // 块开头的电梯完整状态
+        CAR_STATE,         // 电梯楼层、载客或运行状态变化
+        REQUEST,           // 乘客请求到达
+        BOARDING,          // 乘客上梯
+        DELIVERY,          // 乘客送达
+        TIMEOUT            // 乘客等待超时离开
+    };
+    
+    // 各事件用到的字段：
+    //   CAR_*     elevator, floor, passengers(载客), state, energyWh(累计能耗)
+    //   REQUEST   floor(出发层), target(目的层), passengers
+    //   BOARDING  elevator, floor, waitMs
+    //   DELIVERY  elevator, floor, passengers
+    //   TIMEOUT   floor, waitMs
+    struct Event {
+        long long timeMs = 0;
+        EventType type = EventType::CAR_STATE;
+        int elevator = -1;
+        int floor = 0;
+        int target = 0;
+        int passengers = 0;
+        int state = 0;
+        long long waitMs = 0;
+        long long energyWh = 0;
+    };
+    
+    struct Config {
+        int floorCount = 0;
+        int elevatorCount = 0;
+        int capacity = 0;
+        int strategy = 0;
+        double floorTravelTime = 0.0;
+        double maxIdleTime = 0.0;
+        double maxWaitTime = 0.0;
+    };
+    
+    // 编解码时跟踪的单台电梯状态，状态事件相对它差分
+    struct CarState {
+        int floor = 0;
+        int passengers = 0;
+        int state = 0;
+        long long energyWh = 0;
+    };
+    
+    const char* getEventName(EventType type);
+    
+    class Writer {
+    private:
+        std::ofstream file;
+        std::vector<uint8_t> block;      // 当前块的负载
+        uint32_t blockEvents;
+        long long blockStartTime;
+        long long lastTimeMs;
+        std::vector<CarState> cars;      // 已写出的电梯状态，状态事件据此差分
+        std::vector<std::pair<long long, uint64_t>> index;  // (块起始时间, 块偏移)
+        size_t blockLimit;
+        
+        void beginBlock(long long timeMs);
+        void flushBlock();
+        void encode(const Event& event);
+        
+    public:
+        explicit Writer(size_t blockLimit = 64 * 1024);
+        ~Writer();
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+        
+        bool open(const std::string& filename, const Config& config);
+        void close();
+        bool isOpen() const;
+        
+        // 事件时间应单调不减，早于上一事件的时间按上一事件处理。
+        // 电梯状态事件传入完整状态，楼层、载客和运行状态都没变时不写入
+        void write(const Event& event);
+    };
+    
+    class Reader {
+    private:
+        std::ifstream file;
+        Config config;
+        std::vector<std::pair<long long, uint64_t>> index;
+        std::vector<uint8_t> block;
+        size_t blockPos;
+        uint32_t blockRemaining;
+        size_t nextBlock;
+        long long lastTimeMs;
+        long long skipBeforeMs;
+        std::vector<CarState> cars;
+        std::string lastError;
+        
+        bool loadBlock(size_t blockIndex);
+        bool decode(Event& event);
+        bool fail(const std::string& message);
+        
+    public:
+        Reader();
+        
+        bool open(const std::string& filename);
+        const Config& getConfig() const;
+        const std::string& getLastError() const;
+        
+        size_t getBlockCount() const;
+        long long getStartTime() const;   // 第一个事件的时刻（毫秒）
+        
+        // 定位到不早于 timeMs 的第一个事件
+        bool seek(long long timeMs);
+        bool next(Event& event);
+    };
+    
+    // 把 [fromMs, toMs] 内的事件导出为CSV，返回导出的行数，失败返回 -1
+    long long exportToCSV(Reader& reader, const std::string& filename,
+                          long long fromMs = 0, long long toMs = -1);
+}
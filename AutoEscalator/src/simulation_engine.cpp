@@ -0,0 +1,658 @@
+#include "simulation_engine.h"
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+SimulationEngine::SimulationEngine(double dayLength)
+    : traffic(dayLength), nextTraceRecord{}, hasNextTraceRecord(false),
+      currentTime(0.0), totalTime(dayLength), isRunning(false), trafficEnabled(true),
+      journalSteps(0), journalDeltaTime(0.0), replayCursor(0), replayDeltaTime(0.0),
+      replaying(false) {
+    building.setDayLength(dayLength);
+}
+
+SimulationEngine::SimulationEngine(double dayLength, int floorCount, int elevatorCount, int capacity)
+    : building(floorCount, elevatorCount, capacity), stats(floorCount), traffic(dayLength), nextTraceRecord{},
+      hasNextTraceRecord(false), currentTime(0.0), totalTime(dayLength), isRunning(false),
+      trafficEnabled(true), journalSteps(0), journalDeltaTime(0.0), replayCursor(0),
+      replayDeltaTime(0.0), replaying(false) {
+    building.setDayLength(dayLength);
+}
+
+SimulationEngine::SimulationEngine(const SimulationEngine& other)
+    : building(other.building), stats(other.stats), traffic(other.traffic),
+      nextTraceRecord{}, hasNextTraceRecord(false),
+      currentTime(other.currentTime), totalTime(other.totalTime), isRunning(other.isRunning),
+      trafficEnabled(other.trafficEnabled),
+      journalSteps(0), journalDeltaTime(0.0), replayCursor(0), replayDeltaTime(0.0),
+      replaying(false) {
+    if (other.trace) {
+        reopenTrace(other.traceFilename, other.trace->getRecordCount());
+    }
+}
+
+void SimulationEngine::start() {
+    writeJournal(InputJournal::Kind::START);
+    resetState();
+    isRunning = true;
+}
+
+void SimulationEngine::startNextDay() {
+    writeJournal(InputJournal::Kind::NEXT_DAY);
+    resetState(true);
+    isRunning = true;
+}
+
+void SimulationEngine::reset() {
+    writeJournal(InputJournal::Kind::RESET);
+    resetState();
+}
+
+void SimulationEngine::resetState(bool nextDay) {
+    isRunning = false;
+    currentTime = 0.0;
+    stats.reset();
+    if (nextDay) {
+        building.startNextDay();
+    } else {
+        building.reset();
+    }
+    traffic.reset();
+    if (trace) {
+        trace->rewind();
+        hasNextTraceRecord = trace->next(nextTraceRecord);
+    }
+}
+
+void SimulationEngine::step(double deltaTime) {
+    if (!isRunning) return;
+    
+    double previousTime = currentTime;
+    currentTime += deltaTime;
+    
+    if (isJournaling() && deltaTime != journalDeltaTime) {
+        writeJournalValue(InputJournal::Kind::DELTA_TIME, deltaTime);
+        journalDeltaTime = deltaTime;
+    }
+    
+    if (replaying) {
+        // 重放时客流和故障都来自日志
+        for (const auto& input : replayInputs) {
+            if (input.kind == InputJournal::Kind::ARRIVAL) {
+                admitRequest(input.args[0], input.args[1], input.args[2]);
+            } else if (input.kind == InputJournal::Kind::FAULT) {
+                building.getMaintenanceManager().simulateFault(
+                    input.args[0], static_cast<MaintenanceManager::FaultType>(input.args[1]));
+            }
+        }
+    } else if (trace) {
+        // 打开了请求轨迹时客流只来自轨迹，不再叠加生成的客流
+        feedTrace();
+    } else if (trafficEnabled) {
+        // 生成到达高峰时刻的请求
+        pendingTraffic.clear();
+        traffic.generate(previousTime, currentTime, pendingTraffic);
+        for (const auto& request : pendingTraffic) {
+            if (admitRequest(request.fromFloor, request.toFloor, request.passengerCount)) {
+                writeJournal(InputJournal::Kind::ARRIVAL,
+                             request.fromFloor, request.toFloor, request.passengerCount);
+            }
+        }
+    }
+    
+    // 更新建筑物状态
+    building.update(deltaTime);
+    
+    // 本步的随机故障在楼宇更新中产生，重放时于更新前注入，效果相同
+    building.getMaintenanceManager().takeRecentFaults(recentFaults);
+    for (const auto& fault : recentFaults) {
+        if (!replaying) {
+            writeJournal(InputJournal::Kind::FAULT, fault.first, static_cast<int>(fault.second));
+        }
+    }
+    recentFaults.clear();
+    ++journalSteps;
+    
+    // 检查是否结束模拟
+    if (currentTime >= totalTime) {
+        isRunning = false;
+    }
+}
+
+int SimulationEngine::advance(double duration, double deltaTime) {
+    if (deltaTime <= 0) return 0;
+    
+    int steps = 0;
+    double endTime = currentTime + duration;
+    while (isRunning && currentTime + deltaTime * 0.5 < endTime) {
+        step(deltaTime);
+        ++steps;
+    }
+    return steps;
+}
+
+bool SimulationEngine::addRequest(int fromFloor, int toFloor, int passengerCount) {
+    if (!admitRequest(fromFloor, toFloor, passengerCount)) {
+        return false;
+    }
+    writeJournal(InputJournal::Kind::REQUEST, fromFloor, toFloor, passengerCount);
+    return true;
+}
+
+bool SimulationEngine::admitRequest(int fromFloor, int toFloor, int passengerCount) {
+    if (!building.addRequest(fromFloor, toFloor, passengerCount)) {
+        return false;
+    }
+    stats.recordPassenger(fromFloor, toFloor);
+    return true;
+}
+
+bool SimulationEngine::loadRequestsFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    int fromFloor, toFloor, passengerCount;
+    while (file >> fromFloor >> toFloor >> passengerCount) {
+        addRequest(fromFloor, toFloor, passengerCount);
+    }
+    return true;
+}
+
+bool SimulationEngine::openTrace(const std::string& filename) {
+    auto reader = std::make_unique<TraceReader>();
+    if (!reader->open(filename)) {
+        return false;
+    }
+    trace = std::move(reader);
+    traceFilename = filename;
+    hasNextTraceRecord = trace->next(nextTraceRecord);
+    return true;
+}
+
+void SimulationEngine::closeTrace() {
+    trace.reset();
+    traceFilename.clear();
+    hasNextTraceRecord = false;
+}
+
+// 重新打开轨迹并跳过已读的记录（含预读的下一条），使读取位置与原引擎一致
+bool SimulationEngine::reopenTrace(const std::string& filename, long long consumedRecords) {
+    if (!openTrace(filename)) {
+        return false;
+    }
+    while (hasNextTraceRecord && trace->getRecordCount() < consumedRecords) {
+        hasNextTraceRecord = trace->next(nextTraceRecord);
+    }
+    return true;
+}
+
+const TraceReader* SimulationEngine::getTrace() const {
+    return trace.get();
+}
+
+void SimulationEngine::feedTrace() {
+    long long nowMs = static_cast<long long>(std::llround(currentTime * 1000.0));
+    while (hasNextTraceRecord && nextTraceRecord.timeMs <= nowMs) {
+        if (admitRequest(nextTraceRecord.fromFloor, nextTraceRecord.toFloor,
+                         nextTraceRecord.passengerCount)) {
+            writeJournal(InputJournal::Kind::ARRIVAL, nextTraceRecord.fromFloor,
+                         nextTraceRecord.toFloor, nextTraceRecord.passengerCount);
+        }
+        hasNextTraceRecord = trace->next(nextTraceRecord);
+    }
+}
+
+bool SimulationEngine::setDemandProfile(const DemandProfile& profile) {
+    if (!traffic.setDemandProfile(profile)) {
+        return false;
+    }
+    updateExpectedTraffic();
+    return true;
+}
+
+void SimulationEngine::clearDemandProfile() {
+    traffic.clearDemandProfile();
+    updateExpectedTraffic();
+}
+
+void SimulationEngine::updateExpectedTraffic() {
+    building.setDayLength(totalTime);
+    if (traffic.hasDemandProfile()) {
+        building.setExpectedTraffic(traffic.getDemandProfile(), totalTime / (24.0 * 3600));
+    } else {
+        building.clearExpectedTraffic();
+    }
+}
+
+bool SimulationEngine::hasDemandProfile() const {
+    return traffic.hasDemandProfile();
+}
+
+void SimulationEngine::setTrafficEnabled(bool enabled) {
+    trafficEnabled = enabled;
+}
+
+bool SimulationEngine::isTrafficEnabled() const {
+    return trafficEnabled;
+}
+
+namespace {
+    const char CHECKPOINT_MAGIC[] = "ELCK";
+    const uint64_t CHECKPOINT_VERSION = 8;  // 2: 调度权重  3: 需求模型和待命楼层  4: 维护事件调度  5: 人工停用  6: 停用电梯放下乘客  7: 待生效的故障  8: 乘客上梯记录
+    const size_t CHECKSUM_SIZE = 8;
+    
+    // 检查点末尾附带 FNV-1a 校验，读取时先核对，避免把损坏的文件当作有效状态
+    uint64_t checksum(const uint8_t* data, size_t size) {
+        uint64_t hash = 1469598103934665603ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+std::vector<uint8_t> SimulationEngine::saveCheckpoint() const {
+    StateWriter out;
+    out.writeString(CHECKPOINT_MAGIC);
+    out.writeUnsigned(CHECKPOINT_VERSION);
+    
+    for (int i = 0; i < ElevatorConfig::KEY_COUNT; ++i) {
+        double value = 0.0;
+        ElevatorConfig::getValue(ElevatorConfig::KEYS[i], value);
+        out.writeDouble(value);
+    }
+    
+    building.saveState(out);
+    stats.saveState(out);
+    traffic.saveState(out);
+    out.writeDouble(currentTime);
+    out.writeDouble(totalTime);
+    out.writeBool(isRunning);
+    
+    // 轨迹只记文件名和读取位置，恢复时重新打开
+    out.writeString(trace ? traceFilename : std::string());
+    out.writeInt(trace ? trace->getRecordCount() : 0);
+    
+    std::vector<uint8_t> data = out.getData();
+    uint64_t hash = checksum(data.data(), data.size());
+    for (size_t i = 0; i < CHECKSUM_SIZE; ++i) {
+        data.push_back(static_cast<uint8_t>(hash >> (8 * i)));
+    }
+    return data;
+}
+
+bool SimulationEngine::loadModelState(StateReader& in, std::string& traceFile, long long& traceRecords) {
+    if (in.readString() != CHECKPOINT_MAGIC || in.readUnsigned() != CHECKPOINT_VERSION) {
+        return false;
+    }
+    
+    std::vector<double> config(ElevatorConfig::KEY_COUNT);
+    for (double& value : config) {
+        value = in.readDouble();
+    }
+    
+    building.loadState(in);
+    stats.loadState(in);
+    traffic.loadState(in);
+    currentTime = in.readDouble();
+    totalTime = in.readDouble();
+    isRunning = in.readBool();
+    traceFile = in.readString();
+    traceRecords = in.readInt();
+    if (!in.isOk() || !in.atEnd()) {
+        return false;
+    }
+    updateExpectedTraffic();
+    
+    for (int i = 0; i < ElevatorConfig::KEY_COUNT; ++i) {
+        ElevatorConfig::setValue(ElevatorConfig::KEYS[i], config[i]);
+    }
+    return true;
+}
+
+bool SimulationEngine::restoreCheckpoint(const std::vector<uint8_t>& data) {
+    if (replaying || data.size() < CHECKSUM_SIZE) {
+        return false;
+    }
+    size_t payloadSize = data.size() - CHECKSUM_SIZE;
+    uint64_t stored = 0;
+    for (size_t i = 0; i < CHECKSUM_SIZE; ++i) {
+        stored |= static_cast<uint64_t>(data[payloadSize + i]) << (8 * i);
+    }
+    if (stored != checksum(data.data(), payloadSize)) {
+        return false;
+    }
+    
+    std::string traceFile;
+    long long traceRecords = 0;
+    
+    // 先在临时引擎上完整解码一遍，数据损坏时不改动当前状态
+    {
+        SimulationEngine scratch(totalTime);
+        StateReader probe(data.data(), payloadSize);
+        if (!scratch.loadModelState(probe, traceFile, traceRecords)) {
+            return false;
+        }
+    }
+    
+    stopRecording();  // 输入日志无法表达状态的跳变
+    StateReader in(data.data(), payloadSize);
+    loadModelState(in, traceFile, traceRecords);
+    if (traceFile.empty()) {
+        closeTrace();
+    } else if (!reopenTrace(traceFile, traceRecords)) {
+        closeTrace();
+        return false;
+    }
+    return true;
+}
+
+bool SimulationEngine::saveCheckpoint(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> data = saveCheckpoint();
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return file.good();
+}
+
+bool SimulationEngine::loadCheckpoint(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return restoreCheckpoint(data);
+}
+
+std::unique_ptr<SimulationEngine> SimulationEngine::fork() const {
+    return std::unique_ptr<SimulationEngine>(new SimulationEngine(*this));
+}
+
+void SimulationEngine::seedRandom(unsigned int seed) {
+    // 两个随机源用不同的种子，避免客流和故障抽到相关的序列
+    traffic.seedRandom(seed);
+    building.getMaintenanceManager().seedRandom(seed ^ 0x9E3779B9u);
+}
+
+bool SimulationEngine::isSimulationRunning() const {
+    return isRunning;
+}
+
+double SimulationEngine::getCurrentTime() const {
+    return currentTime;
+}
+
+double SimulationEngine::getDayLength() const {
+    return totalTime;
+}
+
+void SimulationEngine::takeSnapshot(EngineSnapshot& snapshot) const {
+    snapshot.time = currentTime;
+    building.fillSnapshot(snapshot);
+    snapshot.requested = building.getMetrics().getRequestedPassengers();
+    snapshot.delivered = building.getMetrics().getDeliveredPassengers();
+}
+
+void SimulationEngine::setDayLength(double length) {
+    writeJournalValue(InputJournal::Kind::DAY_LENGTH, length);
+    totalTime = length;
+    traffic.setDayLength(length);
+    updateExpectedTraffic();
+}
+
+void SimulationEngine::setDispatchStrategy(Dispatcher::Strategy strategy) {
+    writeJournal(InputJournal::Kind::STRATEGY, static_cast<int>(strategy));
+    building.setDispatchStrategy(strategy);
+}
+
+void SimulationEngine::setDispatchWeights(const DispatchWeights& weights) {
+    writeJournalWeights(weights, true);
+    building.setDispatchWeights(weights);
+}
+
+void SimulationEngine::performMaintenance(int elevatorId) {
+    writeJournal(InputJournal::Kind::SERVICE, elevatorId);
+    building.getMaintenanceManager().performMaintenance(elevatorId, currentTime);
+}
+
+void SimulationEngine::repairFault(int elevatorId) {
+    writeJournal(InputJournal::Kind::REPAIR, elevatorId);
+    building.getMaintenanceManager().repairFault(elevatorId, currentTime);
+}
+
+void SimulationEngine::setElevatorLockedOut(int elevatorId, bool value) {
+    writeJournal(InputJournal::Kind::LOCKOUT, elevatorId, value ? 1 : 0);
+    building.getMaintenanceManager().setLockedOut(elevatorId, value);
+}
+
+void SimulationEngine::recordConfigChanges() {
+    if (!isJournaling()) return;
+    
+    journalConfig.resize(ElevatorConfig::KEY_COUNT, 0.0);
+    for (int i = 0; i < ElevatorConfig::KEY_COUNT; ++i) {
+        double value = 0.0;
+        ElevatorConfig::getValue(ElevatorConfig::KEYS[i], value);
+        if (value != journalConfig[i]) {
+            writeJournalValue(InputJournal::Kind::CONFIG, value, ElevatorConfig::KEYS[i]);
+            journalConfig[i] = value;
+        }
+    }
+}
+
+bool SimulationEngine::startRecording(const std::string& filename) {
+    if (replaying || !journal.open(filename)) {
+        return false;
+    }
+    journalSteps = 0;
+    journalDeltaTime = 0.0;
+    
+    // 先写入当前的全部设置，重放从同样的起点出发
+    journalConfig.assign(ElevatorConfig::KEY_COUNT, std::numeric_limits<double>::quiet_NaN());
+    recordConfigChanges();
+    writeJournal(InputJournal::Kind::STRATEGY, static_cast<int>(building.getDispatchStrategy()));
+    writeJournalWeights(building.getDispatchWeights(), false);
+    writeJournal(InputJournal::Kind::MAINTENANCE, building.getMaintenanceManager().isEnabled() ? 1 : 0);
+    writeJournalValue(InputJournal::Kind::DAY_LENGTH, totalTime);
+    return true;
+}
+
+void SimulationEngine::stopRecording() {
+    if (!journal.isOpen()) return;
+    writeJournal(InputJournal::Kind::END);
+    journal.close();
+}
+
+bool SimulationEngine::isRecording() const {
+    return journal.isOpen();
+}
+
+bool SimulationEngine::isJournaling() const {
+    return journal.isOpen() && !replaying;
+}
+
+void SimulationEngine::writeJournal(InputJournal::Kind kind, int a, int b, int c) {
+    if (!isJournaling()) return;
+    
+    InputJournal::Entry entry;
+    entry.step = journalSteps;
+    entry.timeMs = std::llround(currentTime * 1000.0);
+    entry.kind = kind;
+    entry.args[0] = a;
+    entry.args[1] = b;
+    entry.args[2] = c;
+    journal.write(entry);
+}
+
+void SimulationEngine::writeJournalValue(InputJournal::Kind kind, double value, const std::string& key) {
+    if (!isJournaling()) return;
+    
+    InputJournal::Entry entry;
+    entry.step = journalSteps;
+    entry.timeMs = std::llround(currentTime * 1000.0);
+    entry.kind = kind;
+    entry.key = key;
+    entry.value = value;
+    journal.write(entry);
+}
+
+void SimulationEngine::writeJournalWeights(const DispatchWeights& weights, bool changedOnly) {
+    std::vector<double> values = weights.toVector();
+    std::vector<double> current = building.getDispatchWeights().toVector();
+    for (int i = 0; i < DispatchWeights::KEY_COUNT; ++i) {
+        if (!changedOnly || values[i] != current[i]) {
+            writeJournalValue(InputJournal::Kind::WEIGHT, values[i], DispatchWeights::KEYS[i]);
+        }
+    }
+}
+
+bool SimulationEngine::openReplay(const std::string& filename) {
+    closeReplay();
+    stopRecording();  // 重放会重置步号，正在进行的记录到此结束
+    replayError.clear();
+    if (!InputJournal::load(filename, replayEntries, replayError)) {
+        return false;
+    }
+    
+    resetState();
+    replaying = true;
+    replayCursor = 0;
+    replayDeltaTime = 0.0;
+    journalSteps = 0;
+    building.getMaintenanceManager().setRandomFaultsEnabled(false);
+    return true;
+}
+
+bool SimulationEngine::replayRun() {
+    while (replaying && replayCursor < replayEntries.size()) {
+        const InputJournal::Entry& entry = replayEntries[replayCursor];
+        
+        // 两条记录之间没有输入的步
+        while (journalSteps < entry.step) {
+            if (!isRunning || replayDeltaTime <= 0) {
+                replayError = "日志与模拟进度不一致（步号 " + std::to_string(entry.step) + "）";
+                replayCursor = replayEntries.size();
+                return false;
+            }
+            step(replayDeltaTime);
+            if (!isRunning) return true;  // 一轮模拟结束
+        }
+        
+        if (InputJournal::isStepInput(entry.kind)) {
+            // 同一步的步内输入一起注入
+            replayInputs.clear();
+            while (replayCursor < replayEntries.size() &&
+                   replayEntries[replayCursor].step == journalSteps &&
+                   InputJournal::isStepInput(replayEntries[replayCursor].kind)) {
+                const auto& input = replayEntries[replayCursor++];
+                if (input.kind == InputJournal::Kind::DELTA_TIME) {
+                    replayDeltaTime = input.value;
+                } else {
+                    replayInputs.push_back(input);
+                }
+            }
+            if (!isRunning) {
+                replayError = "日志中的步内输入不在模拟运行期间（步号 " + std::to_string(journalSteps) + "）";
+                replayCursor = replayEntries.size();
+                return false;
+            }
+            step(replayDeltaTime);
+            replayInputs.clear();
+            if (!isRunning) return true;
+        } else {
+            ++replayCursor;
+            applyJournalEntry(entry);
+            if (entry.kind == InputJournal::Kind::END) {
+                replayCursor = replayEntries.size();
+            }
+        }
+    }
+    return false;
+}
+
+void SimulationEngine::applyJournalEntry(const InputJournal::Entry& entry) {
+    switch (entry.kind) {
+        case InputJournal::Kind::CONFIG:
+            ElevatorConfig::setValue(entry.key, entry.value);
+            break;
+        case InputJournal::Kind::STRATEGY:
+            building.setDispatchStrategy(static_cast<Dispatcher::Strategy>(entry.args[0]));
+            break;
+        case InputJournal::Kind::WEIGHT: {
+            DispatchWeights weights = building.getDispatchWeights();
+            weights.setValue(entry.key, entry.value);
+            building.setDispatchWeights(weights);
+            break;
+        }
+        case InputJournal::Kind::MAINTENANCE:
+            building.getMaintenanceManager().setEnabled(entry.args[0] != 0);
+            break;
+        case InputJournal::Kind::DAY_LENGTH:
+            setDayLength(entry.value);
+            break;
+        case InputJournal::Kind::START:
+            start();
+            break;
+        case InputJournal::Kind::RESET:
+            reset();
+            break;
+        case InputJournal::Kind::NEXT_DAY:
+            startNextDay();
+            break;
+        case InputJournal::Kind::REQUEST:
+            addRequest(entry.args[0], entry.args[1], entry.args[2]);
+            break;
+        case InputJournal::Kind::SERVICE:
+            performMaintenance(entry.args[0]);
+            break;
+        case InputJournal::Kind::REPAIR:
+            repairFault(entry.args[0]);
+            break;
+        case InputJournal::Kind::LOCKOUT:
+            setElevatorLockedOut(entry.args[0], entry.args[1] != 0);
+            break;
+        default:
+            break;
+    }
+}
+
+void SimulationEngine::closeReplay() {
+    if (!replaying) return;
+    replaying = false;
+    replayEntries.clear();
+    replayInputs.clear();
+    replayCursor = 0;
+    building.getMaintenanceManager().setRandomFaultsEnabled(true);
+}
+
+bool SimulationEngine::isReplaying() const {
+    return replaying;
+}
+
+long long SimulationEngine::getJournalSteps() const {
+    return journalSteps;
+}
+
+const std::string& SimulationEngine::getReplayError() const {
+    return replayError;
+}
+
+Building& SimulationEngine::getBuilding() {
+    return building;
+}
+
+const Building& SimulationEngine::getBuilding() const {
+    return building;
+}
+
+const Statistics& SimulationEngine::getStatistics() const {
+    return stats;
+}
+
+const SimulationMetrics& SimulationEngine::getMetrics() const {
+    return building.getMetrics();
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include "building.h"
+#include "engine_snapshot.h"
+#include "input_journal.h"
+#include "statistics.h"
+#include "traffic_generator.h"
+#include "trace_reader.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// 与界面无关的模拟核心：推进时间、生成客流、更新楼宇并汇总指标。
+// 控制台前端和基准测试都通过 step/advance 驱动它。
+class SimulationEngine {
+private:
+    Building building;
+    Statistics stats;
+    TrafficGenerator traffic;
+    std::vector<TrafficGenerator::Request> pendingTraffic;  // 复用的客流缓冲
+    std::unique_ptr<TraceReader> trace;   // 带时刻的请求轨迹，按模拟时间逐条送入
+    std::string traceFilename;
+    TraceReader::Record nextTraceRecord;
+    bool hasNextTraceRecord;
+    double currentTime;
+    double totalTime;
+    bool isRunning;
+    bool trafficEnabled;
+    
+    // 输入日志的记录与重放
+    InputJournal journal;
+    long long journalSteps;                      // 开始记录或重放以来执行的步数
+    double journalDeltaTime;                     // 日志中最近一次记录的步长
+    std::vector<InputJournal::Entry> replayEntries;
+    size_t replayCursor;
+    std::vector<InputJournal::Entry> replayInputs;  // 当前步要注入的步内输入
+    double replayDeltaTime;
+    bool replaying;
+    std::string replayError;
+    std::vector<std::pair<int, MaintenanceManager::FaultType>> recentFaults;
+    std::vector<double> journalConfig;           // 日志中各配置项的最新值
+    
+    SimulationEngine(const SimulationEngine& other);  // 供 fork 使用
+    
+    void resetState(bool nextDay = false);
+    void feedTrace();
+    void updateExpectedTraffic();  // 把需求曲线和日长交给楼宇，供前瞻推演和需求预测使用
+    bool reopenTrace(const std::string& filename, long long consumedRecords);
+    bool loadModelState(StateReader& in, std::string& traceFile, long long& traceRecords);
+    bool admitRequest(int fromFloor, int toFloor, int passengerCount);
+    bool isJournaling() const;
+    void writeJournal(InputJournal::Kind kind, int a = 0, int b = 0, int c = 0);
+    void writeJournalValue(InputJournal::Kind kind, double value, const std::string& key = "");
+    void writeJournalWeights(const DispatchWeights& weights, bool changedOnly);
+    void applyJournalEntry(const InputJournal::Entry& entry);
+    
+public:
+    explicit SimulationEngine(double dayLength = 24.0 * 3600);
+    // 指定楼型；客流生成仍按 ElevatorConfig::FLOOR_COUNT 取楼层，楼层不同时通常与 setTrafficEnabled(false) 一起使用
+    SimulationEngine(double dayLength, int floorCount, int elevatorCount, int capacity);
+    SimulationEngine& operator=(const SimulationEngine&) = delete;
+    
+    void start();
+    void reset();
+    // 与 start 相同，但维护状态（运行次数、距上次维护的时间、未修复的故障）从前一天延续，
+    // 供多天连续模拟逐天调用
+    void startNextDay();
+    
+    // 推进一个时间步；模拟未运行时不做任何事
+    void step(double deltaTime);
+    // 以固定步长推进一段时间（或直到一天结束），返回实际执行的步数
+    int advance(double duration, double deltaTime);
+    
+    // 添加乘客请求并计入楼层统计，请求无效时返回false
+    bool addRequest(int fromFloor, int toFloor, int passengerCount);
+    bool loadRequestsFromFile(const std::string& filename);
+    
+    // 带到达时刻的请求轨迹，模拟时间到达记录的时刻时才加入请求；每次 start 从头重放。
+    // 打开轨迹期间不生成高峰或客流曲线的请求，关闭后恢复
+    bool openTrace(const std::string& filename);
+    void closeTrace();
+    const TraceReader* getTrace() const;
+    
+    // 客流需求曲线，设置后代替默认的上下班高峰，从下一次 start 开始生效；
+    // 同时作为前瞻推演调度的预期客流（不记入输入日志）
+    bool setDemandProfile(const DemandProfile& profile);
+    void clearDemandProfile();
+    bool hasDemandProfile() const;
+    
+    // 关闭后不再生成高峰或客流曲线的请求，只处理 addRequest 和轨迹中的请求，
+    // 供自己产生客流的前端使用。不写入检查点
+    void setTrafficEnabled(bool enabled);
+    bool isTrafficEnabled() const;
+    
+    // 经由引擎修改调度策略、调度权重和维护状态，以便记入输入日志
+    void setDispatchStrategy(Dispatcher::Strategy strategy);
+    void setDispatchWeights(const DispatchWeights& weights);
+    void performMaintenance(int elevatorId);
+    void repairFault(int elevatorId);
+    void setElevatorLockedOut(int elevatorId, bool value);
+    // 修改 ElevatorConfig 后调用，把变化的配置项记入输入日志
+    void recordConfigChanges();
+    
+    // 输入日志：记录请求、配置、策略、维护以及生成的客流和随机故障。
+    // 开始记录时先写入当前配置、策略和日长，之后从 start 起重放即可复现
+    bool startRecording(const std::string& filename);
+    void stopRecording();
+    bool isRecording() const;
+    
+    // 重放输入日志：先 openReplay，再反复 replayRun，每次执行到一轮模拟结束时返回true；
+    // 日志执行完时返回false，此时中途停止记录的那一轮保留在当前状态。重放期间不生成随机客流、不产生随机故障，
+    // 开始重放会结束正在进行的记录
+    bool openReplay(const std::string& filename);
+    bool replayRun();
+    void closeReplay();
+    bool isReplaying() const;
+    long long getJournalSteps() const;  // 开始记录或重放以来执行的步数
+    const std::string& getReplayError() const;
+    
+    // 检查点：模拟所需的全部状态（配置、楼宇、客流生成器及其随机数、轨迹读取位置），
+    // 不含记录器历史、运行日志和输入日志。恢复失败时当前状态保持不变；
+    // 恢复会结束正在进行的输入日志记录，重放期间不能恢复
+    std::vector<uint8_t> saveCheckpoint() const;
+    bool restoreCheckpoint(const std::vector<uint8_t>& data);
+    bool saveCheckpoint(const std::string& filename) const;
+    bool loadCheckpoint(const std::string& filename);
+    
+    // 从当前时刻分出一个独立的引擎做假设分析，可在其他线程上运行。
+    // 分支复制随机数状态，默认与原引擎抽到相同的后续客流和故障；需要不同的随机序列时调用 seedRandom
+    std::unique_ptr<SimulationEngine> fork() const;
+    void seedRandom(unsigned int seed);
+    
+    bool isSimulationRunning() const;
+    double getCurrentTime() const;
+    double getDayLength() const;
+    // 当前时刻的电梯和各层候梯状态，供图形前端绘制
+    void takeSnapshot(EngineSnapshot& snapshot) const;
+    void setDayLength(double length);
+    
+    Building& getBuilding();
+    const Building& getBuilding() const;
+    const Statistics& getStatistics() const;
+    const SimulationMetrics& getMetrics() const;
+};
@@ -1,49 +1,51 @@
 #include "simulator.h"
-#include "utils.h"
+#include "building_registry.h"
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <random>
 
 Simulator::Simulator() 
-    : currentTime(0.0), totalTime(24.0 * 3600), isRunning(false),
-      monitor(building) {} // 24小时转换为秒
+    : monitor(engine.getBuilding()) {
+    // 调优工具写出的调度权重（tune_dispatch），没有时使用默认权重
+    DispatchWeights weights;
+    std::string error;
+    if (weights.loadFromFile("dispatch.weights", &error)) {
+        engine.setDispatchWeights(weights);
+        std::cout << "已加载调度权重 dispatch.weights" << std::endl;
+    } else if (std::ifstream("dispatch.weights").is_open()) {
+        std::cout << "调度权重 dispatch.weights 无效，使用默认权重: " << error << std::endl;
+    }
+    
+    // 控制台前端把运行数据同时写入CSV日志和二进制运行日志，并记录全部输入以便重放
+    engine.getBuilding().startDataLogging("elevator_data.csv");
+    engine.getBuilding().startRunLog("elevator_run.elrl");
+    engine.startRecording("elevator_input.journal");
+}
 
 void Simulator::start() {
-    isRunning = true;
-    currentTime = 0.0;
-    stats.reset();
-    building.reset();
+    engine.start();
     std::cout << "模拟开始..." << std::endl;
 }
 
 void Simulator::reset() {
-    isRunning = false;
-    currentTime = 0.0;
-    stats.reset();
-    building.reset();
+    engine.reset();
     std::cout << "系统已重置" << std::endl;
 }
 
 void Simulator::update(double deltaTime) {
-    if (!isRunning) return;
+    if (!engine.isSimulationRunning()) return;
     
     performance.startMeasure("update_cycle");
     
-    currentTime += deltaTime;
-    
-    // 检查是否到达上下班时间点
-    performance.startMeasure("rush_hour_check");
-    checkRushHour();
-    performance.endMeasure("rush_hour_check");
-    
-    // 更新建筑物状态
-    performance.startMeasure("building_update");
-    building.update(deltaTime);
-    performance.endMeasure("building_update");
+    // 推进模拟（客流生成和建筑物更新）
+    performance.startMeasure("engine_step");
+    engine.step(deltaTime);
+    performance.endMeasure("engine_step");
     
     // 更新监控系统
     performance.startMeasure("monitor_update");
-    monitor.update(currentTime);
+    monitor.update(engine.getCurrentTime());
     performance.endMeasure("monitor_update");
     
     // 显示当前状态
@@ -54,80 +56,152 @@ void Simulator::update(double deltaTime) {
     performance.endMeasure("update_cycle");
     
     // 检查是否结束模拟
-    if (currentTime >= totalTime) {
+    if (!engine.isSimulationRunning()) {
         endSimulation();
     }
 }
 
-void Simulator::generateRandomRequests() {
-    const int DEFAULT_REQUEST_COUNT = 5;
-    
-    for (int i = 0; i < DEFAULT_REQUEST_COUNT; ++i) {
-        int fromFloor = 1; // 上班高峰期从1楼出发
-        int toFloor = Utils::generateRandomNumber(2, 14);
-        int passengerCount = Utils::generateRandomNumber(1, 5);
-        
-        building.addRequest(fromFloor, toFloor, passengerCount);
-        stats.recordPassenger(fromFloor, toFloor);
+void Simulator::loadRequestsFromFile(const std::string& filename) {
+    if (!engine.loadRequestsFromFile(filename)) {
+        std::cout << "无法打开文件: " << filename << std::endl;
     }
 }
 
-void Simulator::loadRequestsFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "无法打开文件: " << filename << std::endl;
+void Simulator::loadTrace(const std::string& filename) {
+    if (!engine.openTrace(filename)) {
+        std::cout << "无法打开轨迹文件: " << filename << std::endl;
+        return;
+    }
+    std::cout << "已加载请求轨迹，开始模拟后按到达时刻送入" << std::endl;
+}
+
+void Simulator::replayJournal(const std::string& filename) {
+    if (!engine.openReplay(filename)) {
+        std::cout << "无法重放输入日志: " << engine.getReplayError() << std::endl;
         return;
     }
     
-    int fromFloor, toFloor, passengerCount;
-    while (file >> fromFloor >> toFloor >> passengerCount) {
-        building.addRequest(fromFloor, toFloor, passengerCount);
-        stats.recordPassenger(fromFloor, toFloor);
+    std::cout << "正在重放输入日志..." << std::endl;
+    int runs = 0;
+    while (engine.replayRun()) {
+        ++runs;
+        endSimulation();
     }
+    engine.closeReplay();
     
-    file.close();
-}
-
-bool Simulator::isSimulationRunning() const {
-    return isRunning;
+    if (!engine.getReplayError().empty()) {
+        std::cout << "重放中止: " << engine.getReplayError() << std::endl;
+    }
+    std::cout << "重放完成，共 " << runs << " 轮模拟" << std::endl;
 }
 
-double Simulator::getCurrentTime() const {
-    return currentTime;
+void Simulator::runCalendar() {
+    int days = 0;
+    std::string calendarFile;
+    std::cout << "请输入模拟天数: ";
+    std::cin >> days;
+    std::cout << "请输入日历文件名（- 表示从星期一开始、没有节假日）: ";
+    std::cin >> calendarFile;
+    if (days <= 0) {
+        std::cout << "无效的天数" << std::endl;
+        return;
+    }
+    
+    MultiDaySimulation simulation(engine);
+    if (calendarFile != "-") {
+        Calendar calendar;
+        if (!calendar.loadFromFile(calendarFile)) {
+            std::cout << "无法加载日历: " << calendar.getLastError() << std::endl;
+            return;
+        }
+        simulation.setCalendar(calendar);
+    }
+    MultiDaySimulation::Settings settings;
+    settings.days = days;
+    settings.deltaTime = 0.5;  // 多天运行用较大的步长
+    simulation.setSettings(settings);
+    
+    // 逐步的运行数据按天累积在内存中，多天运行时关闭，只保留日指标
+    engine.getBuilding().setRecordingEnabled(false);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n天数  星期  类型      请求    超时  平均等待  P95等待  能耗kWh  故障  维护" << std::endl;
+    simulation.run([](const DailyKpi& kpi) {
+        std::cout << std::setw(4) << kpi.day + 1 << "  " << Calendar::getWeekdayName(kpi.weekday)
+                  << "  " << Calendar::getDayTypeName(kpi.dayType)
+                  << std::setw(8) << kpi.requested << std::setw(8) << kpi.timedOut
+                  << std::setw(10) << kpi.averageWait << std::setw(9) << kpi.p95Wait
+                  << std::setw(9) << kpi.energy << std::setw(6) << kpi.faults
+                  << std::setw(6) << kpi.services << std::endl;
+    });
+    engine.getBuilding().setRecordingEnabled(true);
+    std::cout << simulation.getRollup().getReport();
 }
 
-void Simulator::checkRushHour() {
-    double dayProgress = currentTime / totalTime;
-    
-    // 上班高峰期（2/10和6/10时刻）
-    if (isNearTime(dayProgress, 0.2) || isNearTime(dayProgress, 0.6)) {
-        generateRandomRequests();
+void Simulator::runTopologyStudy() {
+    BuildingTopology topology{ElevatorConfig::FLOOR_COUNT, ElevatorConfig::ELEVATOR_COUNT,
+                              ElevatorConfig::MAX_CAPACITY};
+    double hours = 0.0;
+    double rate = 0.0;
+    std::cout << "请输入楼层数、电梯数和电梯容量: ";
+    std::cin >> topology.floors >> topology.elevators >> topology.capacity;
+    std::cout << "请输入模拟小时数和每层每小时到达人数: ";
+    std::cin >> hours >> rate;
+    if (topology.floors < 2 || topology.elevators < 1 || topology.capacity < 1 || hours <= 0 || rate < 0) {
+        std::cout << "无效的楼型或客流参数" << std::endl;
+        return;
     }
-    // 下班高峰期（4/10和8/10时刻）
-    else if (isNearTime(dayProgress, 0.4) || isNearTime(dayProgress, 0.8)) {
-        generateDownwardRequests();
+    
+    std::unique_ptr<BuildingModel> model = BuildingRegistry::create(topology);
+    std::cout << "使用" << (model->isSpecialized() ? "编译期特化模型" : "通用模型（Building）") << std::endl;
+    
+    // 上行（从1楼出发）、下行（到1楼）和层间各占 4:4:2
+    const double deltaTime = 0.1;
+    std::mt19937 random(42);
+    std::poisson_distribution<int> arrivals(rate * topology.floors / 3600.0 * deltaTime);
+    std::uniform_real_distribution<double> kind(0.0, 1.0);
+    std::uniform_int_distribution<int> upper(2, topology.floors);
+    std::uniform_int_distribution<int> any(1, topology.floors);
+    long long steps = static_cast<long long>(hours * 3600 / deltaTime);
+    for (long long step = 0; step < steps; ++step) {
+        for (int n = arrivals(random); n > 0; --n) {
+            double k = kind(random);
+            int fromFloor = 1;
+            int toFloor = 1;
+            if (k < 0.4) {
+                toFloor = upper(random);
+            } else if (k < 0.8) {
+                fromFloor = upper(random);
+            } else {
+                fromFloor = any(random);
+                do {
+                    toFloor = any(random);
+                } while (toFloor == fromFloor);
+            }
+            model->addRequest(fromFloor, toFloor, 1);
+        }
+        model->update(deltaTime);
     }
+    
+    const auto& metrics = model->getMetrics();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "请求/上梯/送达/超时: " << metrics.getRequestedPassengers() << " / "
+              << metrics.getBoardedPassengers() << " / " << metrics.getDeliveredPassengers() << " / "
+              << metrics.getTimedOutPassengers() << std::endl;
+    std::cout << "平均等待: " << metrics.getAverageWaitTime() << " s  最长等待: "
+              << metrics.getMaxWaitTime() << " s" << std::endl;
 }
 
-bool Simulator::isNearTime(double current, double target) {
-    const double THRESHOLD = 0.01; // 1%的时间窗口
-    return std::abs(current - target) < THRESHOLD;
+bool Simulator::isSimulationRunning() const {
+    return engine.isSimulationRunning();
 }
 
-void Simulator::generateDownwardRequests() {
-    const int DEFAULT_REQUEST_COUNT = 5;
-    
-    for (int i = 0; i < DEFAULT_REQUEST_COUNT; ++i) {
-        int fromFloor = Utils::generateRandomNumber(2, 14);
-        int toFloor = 1; // 下班高峰期到1楼
-        int passengerCount = Utils::generateRandomNumber(1, 5);
-        
-        building.addRequest(fromFloor, toFloor, passengerCount);
-        stats.recordPassenger(fromFloor, toFloor);
-    }
+double Simulator::getCurrentTime() const {
+    return engine.getCurrentTime();
 }
 
 void Simulator::displayStatus() {
+    const auto& building = engine.getBuilding();
+    
     // 更新动画
     if (animator.shouldUpdateFrame()) {
         animator.update(building);
@@ -143,9 +217,8 @@ void Simulator::displayStatus() {
 }
 
 void Simulator::endSimulation() {
-    isRunning = false;
     std::cout << "\n模拟结束！" << std::endl;
-    stats.displayChart();
+    engine.getStatistics().displayChart();
 }
 
 std::string Simulator::formatTime(double seconds) {
@@ -179,8 +252,7 @@ void Simulator::handleManualRequest() {
         fromFloor != toFloor && 
         passengerCount > 0 && passengerCount <= 12) {
         
-        building.addRequest(fromFloor, toFloor, passengerCount);
-        stats.recordPassenger(fromFloor, toFloor);
+        engine.addRequest(fromFloor, toFloor, passengerCount);
         std::cout << "请求已添加" << std::endl;
     } else {
         std::cout << "无效的请求参数" << std::endl;
@@ -199,6 +271,9 @@ void Simulator::showConfigMenu() {
         std::cout << "7. 加载配置" << std::endl;
         std::cout << "8. 恢复默认设置" << std::endl;
         std::cout << "9. 返回主菜单" << std::endl;
+        std::cout << "A. 加载客流需求曲线 (当前: "
+                  << (engine.hasDemandProfile() ? "需求曲线" : "上下班高峰") << ")" << std::endl;
+        std::cout << "B. 恢复上下班高峰客流" << std::endl;
         
         char choice;
         std::cout << "\n请选择: ";
@@ -259,23 +334,55 @@ void Simulator::showConfigMenu() {
             case '9':
                 return;
                 
+            case 'A':
+            case 'a': {
+                std::string filename;
+                std::cout << "请输入客流曲线文件名: ";
+                std::cin >> filename;
+                loadDemandProfile(filename);
+                break;
+            }
+                
+            case 'B':
+            case 'b':
+                engine.clearDemandProfile();
+                std::cout << "已恢复上下班高峰客流" << std::endl;
+                break;
+                
             default:
                 std::cout << "无效选择" << std::endl;
         }
+        engine.recordConfigChanges();
+    }
+}
+
+void Simulator::loadDemandProfile(const std::string& filename) {
+    DemandProfile profile(ElevatorConfig::FLOOR_COUNT);
+    if (!profile.loadFromFile(filename)) {
+        std::cout << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+        return;
+    }
+    if (!engine.setDemandProfile(profile)) {
+        std::cout << "客流曲线的楼层数与当前配置不一致" << std::endl;
+        return;
     }
+    std::cout << "已加载客流曲线，预计全天到达 "
+              << static_cast<int>(profile.getExpectedDailyArrivals()) << " 人" << std::endl;
 }
 
 void Simulator::showDispatcherMenu() {
     while (true) {
         std::cout << "\n=== 调度策略管理 ===" << std::endl;
         std::cout << "当前策略: " 
-                 << Dispatcher::getStrategyName(building.getDispatchStrategy()) 
+                 << Dispatcher::getStrategyName(engine.getBuilding().getDispatchStrategy()) 
                  << std::endl;
         std::cout << "1. 切换到最近优先策略" << std::endl;
         std::cout << "2. 切换到负载均衡策略" << std::endl;
         std::cout << "3. 切换到节能模式策略" << std::endl;
-        std::cout << "4. 显示调度统计信息" << std::endl;
-        std::cout << "5. 返回主菜单" << std::endl;
+        std::cout << "4. 切换到前瞻推演策略" << std::endl;
+        std::cout << "5. 切换到批量最优策略" << std::endl;
+        std::cout << "6. 显示调度统计信息" << std::endl;
+        std::cout << "7. 返回主菜单" << std::endl;
         
         char choice;
         std::cout << "\n请选择: ";
@@ -283,25 +390,35 @@ void Simulator::showDispatcherMenu() {
         
         switch (choice) {
             case '1':
-                building.setDispatchStrategy(Dispatcher::Strategy::NEAREST_FIRST);
+                engine.setDispatchStrategy(Dispatcher::Strategy::NEAREST_FIRST);
                 std::cout << "已切换到最近优先策略" << std::endl;
                 break;
                 
             case '2':
-                building.setDispatchStrategy(Dispatcher::Strategy::LOAD_BALANCED);
+                engine.setDispatchStrategy(Dispatcher::Strategy::LOAD_BALANCED);
                 std::cout << "已切换到负载均衡策略" << std::endl;
                 break;
                 
             case '3':
-                building.setDispatchStrategy(Dispatcher::Strategy::ENERGY_SAVING);
+                engine.setDispatchStrategy(Dispatcher::Strategy::ENERGY_SAVING);
                 std::cout << "已切换到节能模式策略" << std::endl;
                 break;
                 
             case '4':
-                displayDispatcherStatistics();
+                engine.setDispatchStrategy(Dispatcher::Strategy::ROLLOUT);
+                std::cout << "已切换到前瞻推演策略" << std::endl;
                 break;
                 
             case '5':
+                engine.setDispatchStrategy(Dispatcher::Strategy::BATCH_OPTIMAL);
+                std::cout << "已切换到批量最优策略" << std::endl;
+                break;
+                
+            case '6':
+                displayDispatcherStatistics();
+                break;
+                
+            case '7':
                 return;
                 
             default:
@@ -311,7 +428,7 @@ void Simulator::showDispatcherMenu() {
 }
 
 void Simulator::displayDispatcherStatistics() const {
-    const auto& stats = building.getDispatcherStatistics();
+    const auto& stats = engine.getBuilding().getDispatcherStatistics();
     
     std::cout << "\n=== 调度统计信息 ===" << std::endl;
     std::cout << "总分配请求数: " << stats.totalAssignments << std::endl;
@@ -326,6 +443,26 @@ void Simulator::displayDispatcherStatistics() const {
                  << (stats.successfulAssignments * 100.0 / stats.totalAssignments)
                  << "%" << std::endl;
     }
+    
+    if (engine.getBuilding().getDispatchStrategy() == Dispatcher::Strategy::ROLLOUT) {
+        const auto& rollout = engine.getBuilding().getRolloutDispatcher().getStatistics();
+        std::cout << "推演决策数: " << rollout.decisions << std::endl;
+        std::cout << "超时改用估算: " << rollout.fallbacks << std::endl;
+        if (rollout.decisions > 0) {
+            std::cout << "平均决策耗时: " << std::fixed << std::setprecision(2)
+                     << rollout.totalDecisionMs / rollout.decisions << "毫秒" << std::endl;
+        }
+    }
+    
+    if (engine.getBuilding().getDispatchStrategy() == Dispatcher::Strategy::BATCH_OPTIMAL) {
+        const auto& batch = engine.getBuilding().getBatchDispatcher().getStatistics();
+        std::cout << "调度周期数: " << batch.cycles << std::endl;
+        std::cout << "改派次数: " << batch.reassignments << std::endl;
+        if (batch.cycles > 0) {
+            std::cout << "平均求解耗时: " << std::fixed << std::setprecision(3)
+                     << batch.totalSolveMs / batch.cycles << "毫秒" << std::endl;
+        }
+    }
 }
 
 void Simulator::showPerformanceReport() const {
@@ -333,8 +470,9 @@ void Simulator::showPerformanceReport() const {
 }
 
 void Simulator::showEnergyReport() const {
-    std::cout << building.getEnergyManager().getEnergyReport();
-    std::cout << building.getEnergyManager().getEnergyOptimizationTips();
+    const auto& energyManager = engine.getBuilding().getEnergyManager();
+    std::cout << energyManager.getEnergyReport();
+    std::cout << energyManager.getEnergyOptimizationTips();
 }
 
 void Simulator::showMaintenanceMenu() {
@@ -344,7 +482,8 @@ void Simulator::showMaintenanceMenu() {
         std::cout << "2. 执行维护" << std::endl;
         std::cout << "3. 维修故障" << std::endl;
         std::cout << "4. 查看维护历史" << std::endl;
-        std::cout << "5. 返回主菜单" << std::endl;
+        std::cout << "5. 停用/恢复电梯" << std::endl;
+        std::cout << "6. 返回主菜单" << std::endl;
         
         char choice;
         std::cout << "\n请选择: ";
@@ -360,8 +499,7 @@ void Simulator::showMaintenanceMenu() {
                 std::cout << "请输入要维护的电梯编号(1-4): ";
                 std::cin >> elevatorId;
                 if (elevatorId >= 1 && elevatorId <= 4) {
-                    building.getMaintenanceManager().performMaintenance(
-                        elevatorId - 1, currentTime);
+                    engine.performMaintenance(elevatorId - 1);
                     std::cout << "维护完成" << std::endl;
                 } else {
                     std::cout << "无效的电梯编号" << std::endl;
@@ -374,8 +512,7 @@ void Simulator::showMaintenanceMenu() {
                 std::cout << "请输入要维修的电梯编号(1-4): ";
                 std::cin >> elevatorId;
                 if (elevatorId >= 1 && elevatorId <= 4) {
-                    building.getMaintenanceManager().repairFault(
-                        elevatorId - 1, currentTime);
+                    engine.repairFault(elevatorId - 1);
                     std::cout << "维修完成" << std::endl;
                 } else {
                     std::cout << "无效的电梯编号" << std::endl;
@@ -387,7 +524,21 @@ void Simulator::showMaintenanceMenu() {
                 displayMaintenanceHistory();
                 break;
                 
-            case '5':
+            case '5': {
+                int elevatorId;
+                std::cout << "请输入要停用或恢复的电梯编号(1-4): ";
+                std::cin >> elevatorId;
+                if (elevatorId >= 1 && elevatorId <= 4) {
+                    bool lockedOut = !engine.getBuilding().getMaintenanceManager().isLockedOut(elevatorId - 1);
+                    engine.setElevatorLockedOut(elevatorId - 1, lockedOut);
+                    std::cout << (lockedOut ? "已停用，候梯乘客将改派其他电梯" : "已解除停用") << std::endl;
+                } else {
+                    std::cout << "无效的电梯编号" << std::endl;
+                }
+                break;
+            }
+                
+            case '6':
                 return;
                 
             default:
@@ -397,11 +548,11 @@ void Simulator::showMaintenanceMenu() {
 }
 
 void Simulator::displayMaintenanceStatus() const {
-    std::cout << building.getMaintenanceManager().getMaintenanceReport();
+    std::cout << engine.getBuilding().getMaintenanceManager().getMaintenanceReport();
 }
 
 void Simulator::displayMaintenanceHistory() const {
-    const auto& history = building.getMaintenanceManager().getMaintenanceHistory();
+    const auto& history = engine.getBuilding().getMaintenanceManager().getMaintenanceHistory();
     
     std::cout << "\n=== 维护历史记录 ===" << std::endl;
     if (history.empty()) {
@@ -431,7 +582,7 @@ void Simulator::showDataAnalysisMenu() const {
         std::cout << "\n请选择: ";
         std::cin >> choice;
         
-        const auto& recorder = building.getDataRecorder();
+        const auto& recorder = engine.getBuilding().getDataRecorder();
         
         switch (choice) {
             case '1':
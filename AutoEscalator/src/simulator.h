@@ -1,6 +1,6 @@
 #pragma once
-#include "building.h"
-#include "statistics.h"
+#include "simulation_engine.h"
+#include "multi_day_simulation.h"
 #include <string>
 #include "visualizer.h"
 #include "monitor.h"
@@ -9,13 +9,10 @@
 #include "help_system.h"
 #include "animation_controller.h"
 
+// 控制台前端：菜单、显示和监控，模拟本身由 SimulationEngine 完成
 class Simulator {
 private:
-    Building building;
-    Statistics stats;
-    double currentTime;
-    double totalTime;
-    bool isRunning;
+    SimulationEngine engine;
     Visualizer visualizer;
     Monitor monitor;
     Performance performance;
@@ -23,14 +20,9 @@ private:
     HelpSystem helpSystem;
     AnimationController animator;
     
-    void checkRushHour();
-    bool isNearTime(double current, double target);
-    void generateDownwardRequests();
-    void displayStatus();
     void endSimulation();
-    std::string formatTime(double seconds);
+    static std::string formatTime(double seconds);
     std::string getStateString(ElevatorState state);
-    void handleHelpCommand(const std::string& command);
     
 public:
     Simulator();
@@ -38,8 +30,17 @@ public:
     void start();
     void reset();
     void update(double deltaTime);
-    void generateRandomRequests();
     void loadRequestsFromFile(const std::string& filename);
+    void loadDemandProfile(const std::string& filename);
+    void loadTrace(const std::string& filename);
+    void replayJournal(const std::string& filename);
+    // 按日历连续模拟多天（不显示动画），逐天输出指标并汇总
+    void runCalendar();
+    // 楼型研究：按输入的楼型从 BuildingRegistry 取模型（有特化时用编译期特化版本），
+    // 以均匀客流无界面运行若干小时并输出服务指标，不影响当前模拟
+    void runTopologyStudy();
+    void displayStatus();
+    void handleHelpCommand(const std::string& command);
     
     // 状态查询
     bool isSimulationRunning() const;
@@ -54,6 +55,7 @@ public:
     void showEnergyReport() const;
     void showMaintenanceMenu();
     void displayMaintenanceStatus() const;
+    void displayMaintenanceHistory() const;
     void showDataAnalysisMenu() const;
     void showHelp(const std::string& topic = "") const;
 }; 
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "state_io.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+    // mt19937 的状态为624个字加一个位置，按标准流格式导出后逐个保存
+    const size_t RANDOM_STATE_WORDS = std::mt19937::state_size + 1;
+}
+
+void StateWriter::writeInt(long long value) {
+    writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void StateWriter::writeUnsigned(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void StateWriter::writeDouble(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+}
+
+void StateWriter::writeBool(bool value) {
+    buffer.push_back(value ? 1 : 0);
+}
+
+void StateWriter::writeString(const std::string& value) {
+    writeUnsigned(value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void StateWriter::writeRandom(const std::mt19937& engine) {
+    std::ostringstream text;
+    text << engine;
+    std::istringstream words(text.str());
+    uint32_t word;
+    for (size_t i = 0; i < RANDOM_STATE_WORDS && words >> word; ++i) {
+        for (int b = 0; b < 4; ++b) {
+            buffer.push_back(static_cast<uint8_t>(word >> (8 * b)));
+        }
+    }
+}
+
+const std::vector<uint8_t>& StateWriter::getData() const {
+    return buffer;
+}
+
+StateReader::StateReader(const std::vector<uint8_t>& bytes)
+    : data(bytes.data()), size(bytes.size()), position(0), ok(true) {}
+
+StateReader::StateReader(const uint8_t* bytes, size_t length)
+    : data(bytes), size(length), position(0), ok(true) {}
+
+long long StateReader::readInt() {
+    uint64_t value = readUnsigned();
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+uint64_t StateReader::readUnsigned() {
+    uint64_t value = 0;
+    for (int shift = 0; ok && shift < 64; shift += 7) {
+        if (position >= size) break;
+        uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    fail();
+    return 0;
+}
+
+double StateReader::readDouble() {
+    if (!ok || size - position < 8) {
+        fail();
+        return 0.0;
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+        bits |= static_cast<uint64_t>(data[position++]) << (8 * i);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool StateReader::readBool() {
+    if (!ok || position >= size) {
+        fail();
+        return false;
+    }
+    return data[position++] != 0;
+}
+
+std::string StateReader::readString() {
+    size_t length = readCount();
+    if (!ok) return std::string();
+    std::string value(reinterpret_cast<const char*>(data + position), length);
+    position += length;
+    return value;
+}
+
+void StateReader::readRandom(std::mt19937& engine) {
+    if (!ok || size - position < RANDOM_STATE_WORDS * 4) {
+        fail();
+        return;
+    }
+    std::ostringstream text;
+    for (size_t i = 0; i < RANDOM_STATE_WORDS; ++i) {
+        uint32_t word = 0;
+        for (int b = 0; b < 4; ++b) {
+            word |= static_cast<uint32_t>(data[position++]) << (8 * b);
+        }
+        text << word << ' ';
+    }
+    std::istringstream words(text.str());
+    words >> engine;
+}
+
+size_t StateReader::readCount(size_t maxCount) {
+    uint64_t count = readUnsigned();
+    if (!ok || count > maxCount || count > size - position) {
+        fail();
+        return 0;
+    }
+    return static_cast<size_t>(count);
+}
+
+void StateReader::fail() {
+    ok = false;
+}
+
+bool StateReader::isOk() const {
+    return ok;
+}
+
+bool StateReader::atEnd() const {
+    return position == size;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// 检查点的二进制编码：整数用 zigzag + LEB128 变长编码，浮点数按位原样保存，
+// 字符串和数组先写长度。各模块的 saveState/loadState 按相同顺序读写字段。
+class StateWriter {
+private:
+    std::vector<uint8_t> buffer;
+    
+public:
+    void writeInt(long long value);
+    void writeUnsigned(uint64_t value);
+    void writeDouble(double value);
+    void writeBool(bool value);
+    void writeString(const std::string& value);
+    void writeRandom(const std::mt19937& engine);
+    
+    const std::vector<uint8_t>& getData() const;
+};
+
+// 读取越界或数据不合理时进入失败状态，之后的读取都返回0，由调用方最后检查 isOk
+class StateReader {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    bool ok;
+    
+public:
+    explicit StateReader(const std::vector<uint8_t>& bytes);
+    StateReader(const uint8_t* bytes, size_t length);
+    
+    long long readInt();
+    uint64_t readUnsigned();
+    double readDouble();
+    bool readBool();
+    std::string readString();
+    void readRandom(std::mt19937& engine);
+    // 数组长度；超过 maxCount 或剩余字节数（每个元素至少一个字节）视为数据损坏
+    size_t readCount(size_t maxCount = SIZE_MAX);
+    
+    void fail();
+    bool isOk() const;
+    bool atEnd() const;
+};
@@ -1,9 +1,10 @@
 #include "statistics.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
-Statistics::Statistics() {
-    floorUsage.resize(15, 0); // 0号索引不使用，1-14层
+Statistics::Statistics(int floorCount) {
+    floorUsage.resize(floorCount + 1, 0); // 0号索引不使用
 }
 
 void Statistics::recordPassenger(int fromFloor, int toFloor) {
@@ -24,7 +25,7 @@ void Statistics::displayChart() const {
     const int chartWidth = 50; // 图表最大宽度
     
     // 显示柱状图
-    for (int floor = 14; floor >= 1; --floor) {
+    for (int floor = static_cast<int>(floorUsage.size()) - 1; floor >= 1; --floor) {
         std::cout << std::setw(2) << floor << " |";
         
         // 计算显示的字符数量
@@ -43,4 +44,21 @@ void Statistics::displayChart() const {
 
 const std::vector<int>& Statistics::getFloorUsage() const {
     return floorUsage;
-} 
\ No newline at end of file
+}
+
+void Statistics::saveState(StateWriter& out) const {
+    out.writeUnsigned(floorUsage.size());
+    for (int usage : floorUsage) {
+        out.writeInt(usage);
+    }
+}
+
+void Statistics::loadState(StateReader& in) {
+    if (in.readCount() != floorUsage.size()) {
+        in.fail();
+        return;
+    }
+    for (int& usage : floorUsage) {
+        usage = static_cast<int>(in.readInt());
+    }
+}
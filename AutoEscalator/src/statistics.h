@@ -1,4 +1,5 @@
 #pragma once
+#include "state_io.h"
 #include <vector>
 
 class Statistics {
@@ -6,10 +7,13 @@ private:
     std::vector<int> floorUsage;
     
 public:
-    Statistics();
+    explicit Statistics(int floorCount = 14);
     
     void recordPassenger(int fromFloor, int toFloor);
     void reset();
     void displayChart() const;
     const std::vector<int>& getFloorUsage() const;
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
 }; 
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// 固定数量工作线程的任务池，任务按提交顺序执行
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+    
+    void workerLoop();
+    
+public:
+    // threadCount 为0时取硬件线程数
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    size_t getThreadCount() const;
+    
+    // 提交任务，通过返回的 future 取结果；析构时会先执行完已提交的任务
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())> {
+        using Result = decltype(function());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push([task]() { (*task)(); });
+        }
+        available.notify_one();
+        return result;
+    }
+};
@@ -0,0 +1,242 @@
+#include "trace_reader.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TRACE_READER_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const size_t CHUNK_SIZE = 1 << 20;             // 分块读取的块大小
+    const size_t RELEASE_INTERVAL = 16 << 20;      // 每读过这么多字节交还一次映射页
+    
+    inline bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+    
+    inline void skipBlanks(const char*& cursor, const char* end) {
+        while (cursor < end && isBlank(*cursor)) ++cursor;
+    }
+    
+    // 无符号十进制整数，至少一位数字，溢出或后面紧跟非空白字符都视为错误
+    inline bool parseNumber(const char*& cursor, const char* end, long long maxValue, long long& value) {
+        skipBlanks(cursor, end);
+        const char* start = cursor;
+        long long result = 0;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            result = result * 10 + (*cursor - '0');
+            if (result > maxValue) return false;
+            ++cursor;
+        }
+        if (cursor == start) return false;
+        if (cursor < end && !isBlank(*cursor) && *cursor != '#') return false;
+        value = result;
+        return true;
+    }
+}
+
+TraceReader::TraceReader()
+    : data(nullptr), size(0), offset(0), releasedUpTo(0), mapped(false),
+      fileDescriptor(-1), file(nullptr), endOfFile(false),
+      lineNumber(0), recordCount(0), skippedLines(0), lastTimeMs(0) {}
+
+TraceReader::~TraceReader() {
+    close();
+}
+
+bool TraceReader::open(const std::string& filename) {
+    close();
+    
+#ifdef TRACE_READER_USE_MMAP
+    fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        lastError = "无法打开文件: " + filename;
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fileDescriptor, &info) == 0 && info.st_size > 0) {
+        void* region = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+                            fileDescriptor, 0);
+        if (region != MAP_FAILED) {
+            madvise(region, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            data = static_cast<const char*>(region);
+            size = static_cast<size_t>(info.st_size);
+            mapped = true;
+            endOfFile = true;
+            return true;
+        }
+    }
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    
+    // 无法映射（空文件、管道或非 POSIX 平台）时分块读取
+    file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        lastError = "无法打开文件: " + filename;
+        return false;
+    }
+    chunk.resize(CHUNK_SIZE);
+    data = chunk.data();
+    return true;
+}
+
+void TraceReader::close() {
+#ifdef TRACE_READER_USE_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+    }
+#endif
+    if (file) {
+        std::fclose(file);
+    }
+    
+    data = nullptr;
+    size = offset = releasedUpTo = 0;
+    mapped = false;
+    fileDescriptor = -1;
+    file = nullptr;
+    std::vector<char>().swap(chunk);
+    endOfFile = false;
+    lineNumber = recordCount = skippedLines = lastTimeMs = 0;
+}
+
+bool TraceReader::isOpen() const {
+    return mapped || file != nullptr;
+}
+
+void TraceReader::rewind() {
+    if (!isOpen()) return;
+    
+    offset = releasedUpTo = 0;
+    if (file) {
+        std::rewind(file);
+        size = 0;
+        endOfFile = false;
+    }
+    lineNumber = recordCount = skippedLines = lastTimeMs = 0;
+}
+
+bool TraceReader::next(Record& record) {
+    const char* begin;
+    const char* end;
+    while (nextLine(begin, end)) {
+        ++lineNumber;
+        skipBlanks(begin, end);
+        if (begin == end || *begin == '#') continue;
+        
+        // 轨迹必须按时间排序，倒退的记录无法按时送入模拟，跳过
+        if (!parseLine(begin, end, record) || record.timeMs < lastTimeMs) {
+            ++skippedLines;
+            continue;
+        }
+        lastTimeMs = record.timeMs;
+        ++recordCount;
+        return true;
+    }
+    return false;
+}
+
+bool TraceReader::nextLine(const char*& begin, const char*& end) {
+    while (true) {
+        const char* start = data + offset;
+        const char* limit = data + size;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', limit - start));
+        if (newline) {
+            begin = start;
+            end = newline;
+            offset = newline - data + 1;
+            if (mapped && offset - releasedUpTo >= RELEASE_INTERVAL) {
+                releaseConsumed();
+            }
+            return true;
+        }
+        
+        if (endOfFile) {
+            // 最后一行可能没有换行符
+            if (start == limit) return false;
+            begin = start;
+            end = limit;
+            offset = size;
+            return true;
+        }
+        if (!refill()) return false;
+    }
+}
+
+// 把未读完的半行移到缓冲区开头，再读入下一块；一行比整个缓冲区还长时扩大缓冲区
+bool TraceReader::refill() {
+    size_t remaining = size - offset;
+    if (remaining > 0 && offset > 0) {
+        std::memmove(chunk.data(), chunk.data() + offset, remaining);
+    }
+    if (remaining == chunk.size()) {
+        chunk.resize(chunk.size() * 2);
+    }
+    data = chunk.data();
+    offset = 0;
+    size = remaining;
+    
+    size_t bytes = std::fread(chunk.data() + size, 1, chunk.size() - size, file);
+    size += bytes;
+    if (bytes == 0) {
+        endOfFile = true;
+    }
+    return true;
+}
+
+// 已读过的整页不再需要，交还给系统，使常驻内存不随读取进度增长
+void TraceReader::releaseConsumed() {
+#ifdef TRACE_READER_USE_MMAP
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t releaseEnd = offset / pageSize * pageSize;
+    if (releaseEnd > releasedUpTo) {
+        madvise(const_cast<char*>(data) + releasedUpTo, releaseEnd - releasedUpTo, MADV_DONTNEED);
+        releasedUpTo = releaseEnd;
+    }
+#endif
+}
+
+bool TraceReader::parseLine(const char* cursor, const char* end, Record& record) {
+    const long long MAX_TIME_MS = 1LL << 52;
+    const long long MAX_FIELD = 1 << 20;
+    long long timeMs, fromFloor, toFloor, passengerCount;
+    if (!parseNumber(cursor, end, MAX_TIME_MS, timeMs) ||
+        !parseNumber(cursor, end, MAX_FIELD, fromFloor) ||
+        !parseNumber(cursor, end, MAX_FIELD, toFloor) ||
+        !parseNumber(cursor, end, MAX_FIELD, passengerCount)) {
+        return false;
+    }
+    
+    skipBlanks(cursor, end);
+    if (cursor < end && *cursor != '#') return false;
+    
+    record.timeMs = timeMs;
+    record.fromFloor = static_cast<int>(fromFloor);
+    record.toFloor = static_cast<int>(toFloor);
+    record.passengerCount = static_cast<int>(passengerCount);
+    return true;
+}
+
+long long TraceReader::getLineNumber() const {
+    return lineNumber;
+}
+
+long long TraceReader::getRecordCount() const {
+    return recordCount;
+}
+
+long long TraceReader::getSkippedLines() const {
+    return skippedLines;
+}
+
+const std::string& TraceReader::getLastError() const {
+    return lastError;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 带到达时刻的请求轨迹（如门禁刷卡、呼梯记录）的流式读取器。
+//
+// 文件为文本，每行一条请求，按到达时刻非递减排列，# 之后为注释：
+//   <到达时刻(毫秒)> <出发层> <目的层> <人数>
+// 时刻从模拟一天开始算起。格式错误的行会被跳过并计数，不中断读取。
+//
+// POSIX 平台上整个文件以只读方式 mmap，已读过的部分定期交还给系统，
+// 其他平台按固定大小分块读取；两种方式的内存占用都与文件大小无关。
+// 数字用手写的整数解析，不受 locale 影响。
+class TraceReader {
+public:
+    struct Record {
+        long long timeMs;
+        int fromFloor;
+        int toFloor;
+        int passengerCount;
+    };
+    
+private:
+    const char* data;     // 映射区或分块缓冲区的起点
+    size_t size;          // 映射区或缓冲区中有效数据的长度
+    size_t offset;        // 下一行的起点
+    size_t releasedUpTo;  // 映射区中已交还给系统的前缀长度
+    bool mapped;
+    int fileDescriptor;
+    std::FILE* file;                 // 分块读取时使用
+    std::vector<char> chunk;
+    bool endOfFile;
+    
+    long long lineNumber;
+    long long recordCount;
+    long long skippedLines;
+    long long lastTimeMs;
+    std::string lastError;
+    
+    bool nextLine(const char*& begin, const char*& end);
+    bool refill();
+    void releaseConsumed();
+    static bool parseLine(const char* cursor, const char* end, Record& record);
+    
+public:
+    TraceReader();
+    ~TraceReader();
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+    
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+    // 回到文件开头重新读取
+    void rewind();
+    
+    // 读取下一条请求，文件结束时返回false
+    bool next(Record& record);
+    
+    long long getLineNumber() const;
+    long long getRecordCount() const;
+    long long getSkippedLines() const;  // 格式错误或时刻倒退而被跳过的行数
+    const std::string& getLastError() const;
+};
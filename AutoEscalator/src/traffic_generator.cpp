@@ -0,0 +1,157 @@
+#include "traffic_generator.h"
+#include "config.h"
+#include "utils.h"
+#include <algorithm>
+
+namespace {
+    const double UPWARD_PEAKS[] = {0.2, 0.6};    // 上班高峰
+    const double DOWNWARD_PEAKS[] = {0.4, 0.8};  // 下班高峰
+    
+    const double DAY_SECONDS = 24.0 * 3600;
+    const double NEVER = std::numeric_limits<double>::infinity();
+    
+    bool crosses(double previousTime, double currentTime, double peakTime) {
+        return previousTime < peakTime && peakTime <= currentTime;
+    }
+}
+
+TrafficGenerator::TrafficGenerator(double length)
+    : dayLength(length), profile(ElevatorConfig::FLOOR_COUNT), useProfile(false),
+      slotIndex(0), nextArrival(NEVER), nextFromFloor(1), nextToFloor(1),
+      random(Utils::randomEngine()()) {}
+
+void TrafficGenerator::generate(double previousTime, double currentTime,
+                                std::vector<Request>& out) {
+    if (useProfile) {
+        // 到达时刻按曲线的24小时计，模拟的一天更短时整体按比例压缩
+        double profileTime = currentTime / getTimeScale();
+        while (nextArrival <= profileTime) {
+            out.push_back({nextFromFloor, nextToFloor, 1});
+            scheduleNextArrival(nextArrival);
+        }
+        return;
+    }
+    
+    for (double peak : UPWARD_PEAKS) {
+        if (crosses(previousTime, currentTime, peak * dayLength)) {
+            generateUpwardRequests(out);
+        }
+    }
+    for (double peak : DOWNWARD_PEAKS) {
+        if (crosses(previousTime, currentTime, peak * dayLength)) {
+            generateDownwardRequests(out);
+        }
+    }
+}
+
+void TrafficGenerator::generateUpwardRequests(std::vector<Request>& out) {
+    std::uniform_int_distribution<> floors(2, ElevatorConfig::FLOOR_COUNT);
+    std::uniform_int_distribution<> counts(1, 5);
+    for (int i = 0; i < ElevatorConfig::DEFAULT_REQUEST_COUNT; ++i) {
+        int toFloor = floors(random);
+        int passengerCount = counts(random);
+        out.push_back({1, toFloor, passengerCount});  // 上班高峰期从1楼出发
+    }
+}
+
+void TrafficGenerator::generateDownwardRequests(std::vector<Request>& out) {
+    std::uniform_int_distribution<> floors(2, ElevatorConfig::FLOOR_COUNT);
+    std::uniform_int_distribution<> counts(1, 5);
+    for (int i = 0; i < ElevatorConfig::DEFAULT_REQUEST_COUNT; ++i) {
+        int fromFloor = floors(random);
+        int passengerCount = counts(random);
+        out.push_back({fromFloor, 1, passengerCount});  // 下班高峰期到1楼
+    }
+}
+
+void TrafficGenerator::reset() {
+    slotIndex = 0;
+    nextArrival = NEVER;
+    if (useProfile) {
+        scheduleNextArrival(0.0);
+    }
+}
+
+// 分段常数到达率：时段内按指数间隔抽取，越过时段末尾时从下一时段开始重新抽取
+// （泊松过程无记忆，这样得到的正是非齐次泊松过程）
+void TrafficGenerator::scheduleNextArrival(double after) {
+    const auto& slots = profile.getSlots();
+    double time = after;
+    while (slotIndex < slots.size()) {
+        const auto& slot = slots[slotIndex];
+        time = std::max(time, slot.startTime);
+        if (slot.arrivalRate > 0) {
+            std::exponential_distribution<double> interval(slot.arrivalRate);
+            time += interval(random);
+            if (time < slot.endTime) {
+                nextArrival = time;
+                profile.sampleTrip(slot, random, nextFromFloor, nextToFloor);
+                return;
+            }
+        }
+        time = slot.endTime;
+        ++slotIndex;
+    }
+    nextArrival = NEVER;
+}
+
+double TrafficGenerator::getTimeScale() const {
+    return dayLength / DAY_SECONDS;
+}
+
+bool TrafficGenerator::setDemandProfile(const DemandProfile& demandProfile) {
+    if (demandProfile.getFloorCount() != ElevatorConfig::FLOOR_COUNT) {
+        return false;
+    }
+    profile = demandProfile;
+    useProfile = true;
+    reset();
+    return true;
+}
+
+void TrafficGenerator::clearDemandProfile() {
+    useProfile = false;
+    reset();
+}
+
+bool TrafficGenerator::hasDemandProfile() const {
+    return useProfile;
+}
+
+const DemandProfile& TrafficGenerator::getDemandProfile() const {
+    return profile;
+}
+
+void TrafficGenerator::setDayLength(double length) {
+    dayLength = length;
+}
+
+double TrafficGenerator::getDayLength() const {
+    return dayLength;
+}
+
+void TrafficGenerator::seedRandom(unsigned int seed) {
+    random.seed(seed);
+}
+
+void TrafficGenerator::saveState(StateWriter& out) const {
+    out.writeDouble(dayLength);
+    profile.saveState(out);
+    out.writeBool(useProfile);
+    out.writeUnsigned(slotIndex);
+    out.writeDouble(nextArrival);
+    out.writeInt(nextFromFloor);
+    out.writeInt(nextToFloor);
+    out.writeRandom(random);
+}
+
+void TrafficGenerator::loadState(StateReader& in) {
+    dayLength = in.readDouble();
+    profile.loadState(in);
+    useProfile = in.readBool();
+    slotIndex = static_cast<size_t>(in.readUnsigned());
+    nextArrival = in.readDouble();
+    nextFromFloor = static_cast<int>(in.readInt());
+    nextToFloor = static_cast<int>(in.readInt());
+    in.readRandom(random);
+}
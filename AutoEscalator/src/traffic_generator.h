@@ -0,0 +1,59 @@
+#pragma once
+#include "demand_profile.h"
+#include "state_io.h"
+#include <limits>
+#include <random>
+#include <vector>
+
+// 客流生成，两种模式：
+// - 默认的上下班高峰：一天的2/10和6/10时刻为上班高峰（1楼到随机楼层），
+//   4/10和8/10时刻为下班高峰（随机楼层到1楼）
+// - 需求曲线：按 DemandProfile 的分时段到达率做非齐次泊松到达，
+//   只预先抽好下一位乘客的到达时刻和起止楼层，没有到达的时间步只做一次比较
+class TrafficGenerator {
+public:
+    struct Request {
+        int fromFloor;
+        int toFloor;
+        int passengerCount;
+    };
+    
+private:
+    double dayLength;
+    
+    DemandProfile profile;
+    bool useProfile;
+    size_t slotIndex;          // 下一位乘客所在的时段
+    double nextArrival;        // 下一位乘客的到达时刻（按24小时制一天的秒数）
+    int nextFromFloor;
+    int nextToFloor;
+    std::mt19937 random;       // 各生成器独立的随机数，复制时随之复制
+    
+    void generateUpwardRequests(std::vector<Request>& out);
+    void generateDownwardRequests(std::vector<Request>& out);
+    void scheduleNextArrival(double after);
+    double getTimeScale() const;  // 模拟一天与24小时的比例
+    
+public:
+    explicit TrafficGenerator(double dayLength);
+    
+    // 生成时间区间 (previousTime, currentTime] 内到达的请求。
+    // 高峰模式下每个高峰时刻只触发一次；曲线模式下时间需从0开始单调推进
+    void generate(double previousTime, double currentTime, std::vector<Request>& out);
+    
+    // 回到一天开始
+    void reset();
+    
+    // 改用需求曲线生成客流；曲线的楼层数需与当前配置一致
+    bool setDemandProfile(const DemandProfile& demandProfile);
+    void clearDemandProfile();
+    bool hasDemandProfile() const;
+    const DemandProfile& getDemandProfile() const;
+    
+    void setDayLength(double length);
+    double getDayLength() const;
+    void seedRandom(unsigned int seed);
+    
+    void saveState(StateWriter& out) const;
+    void loadState(StateReader& in);
+};
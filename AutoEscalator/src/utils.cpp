@@ -1,14 +1,20 @@
 #include "utils.h"
 #include <chrono>
 #include <thread>
-#include <random>
 
 namespace Utils {
+    std::mt19937& randomEngine() {
+        static std::mt19937 gen(std::random_device{}());
+        return gen;
+    }
+    
+    void seedRandom(unsigned int seed) {
+        randomEngine().seed(seed);
+    }
+    
     int generateRandomNumber(int min, int max) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
         std::uniform_int_distribution<> dis(min, max);
-        return dis(gen);
+        return dis(randomEngine());
     }
     
     double getCurrentTime() {
@@ -20,4 +26,4 @@ namespace Utils {
     void sleep(int milliseconds) {
         std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
     }
-} 
\ No newline at end of file
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <random>
+
+namespace Utils {
+    int generateRandomNumber(int min, int max);
+    double getCurrentTime();
+    void sleep(int milliseconds);
+    
+    // 全局随机数引擎，默认以随机设备播种；固定种子后整次模拟可复现
+    std::mt19937& randomEngine();
+    void seedRandom(unsigned int seed);
+}
@@ -17,7 +17,7 @@ void Visualizer::update(const Building& building) {
     initScreen();
     drawBuilding();
     drawElevators(building.getElevators());
-    drawWaitingPassengers(building.getWaitingPassengers());
+    drawWaitingPassengers(building);
 }
 
 void Visualizer::render() const {
@@ -80,11 +80,11 @@ void Visualizer::drawElevators(const std::vector<Elevator>& elevators) {
     }
 }
 
-void Visualizer::drawWaitingPassengers(const std::vector<std::queue<Passenger>>& passengers) {
+void Visualizer::drawWaitingPassengers(const Building& building) {
     for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
-        if (!passengers[floor].empty()) {
+        int count = building.getWaitingCountAtFloor(floor);
+        if (count > 0) {
             int y = (ElevatorConfig::FLOOR_COUNT - floor) * FLOOR_HEIGHT;
-            int count = passengers[floor].size();
             
             // 在楼层右侧显示等待人数
             std::string waitStr = "(" + std::to_string(count) + ")";
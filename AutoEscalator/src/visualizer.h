@@ -17,7 +17,7 @@ private:
     void initScreen();
     void drawBuilding();
     void drawElevators(const std::vector<Elevator>& elevators);
-    void drawWaitingPassengers(const std::vector<std::queue<Passenger>>& passengers);
+    void drawWaitingPassengers(const Building& building);
     std::string getFloorLabel(int floor) const;
     
 public:
@@ -0,0 +1,50 @@
+// 把二进制运行日志转换为CSV，可只导出其中一段时间
+//
+// 用法: runlog_to_csv <日志文件> <CSV文件> [--from 秒] [--to 秒]
+#include "run_log.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "用法: runlog_to_csv <日志文件> <CSV文件> [--from 秒] [--to 秒]" << std::endl;
+        return 1;
+    }
+    
+    long long fromMs = 0, toMs = -1;
+    for (int i = 3; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) {
+            std::cerr << "缺少参数值: " << arg << std::endl;
+            return 1;
+        }
+        if (std::strcmp(arg, "--from") == 0) fromMs = std::llround(std::atof(value) * 1000.0);
+        else if (std::strcmp(arg, "--to") == 0) toMs = std::llround(std::atof(value) * 1000.0);
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return 1;
+        }
+        ++i;
+    }
+    
+    RunLog::Reader reader;
+    if (!reader.open(argv[1])) {
+        std::cerr << "无法读取运行日志: " << reader.getLastError() << std::endl;
+        return 1;
+    }
+    
+    const auto& config = reader.getConfig();
+    std::cout << "楼层: " << config.floorCount << "  电梯: " << config.elevatorCount
+              << "  载客量: " << config.capacity << "  数据块: " << reader.getBlockCount() << std::endl;
+    
+    long long rows = RunLog::exportToCSV(reader, argv[2], fromMs, toMs);
+    if (rows < 0) {
+        std::cerr << "导出失败: " << reader.getLastError() << std::endl;
+        return 1;
+    }
+    std::cout << "已导出 " << rows << " 条事件到 " << argv[2] << std::endl;
+    return 0;
+}
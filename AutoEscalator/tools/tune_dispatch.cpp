@@ -0,0 +1,314 @@
+// 调度权重离线调优：用实数编码的遗传算法搜索 DispatchWeights，
+// 每个候选在固定的客流曲线上做若干次无界面模拟（各候选使用相同的随机种子，便于公平比较），
+// 全部 候选×重复 在所有核上并行。结束后用另一组种子复核最优解与默认权重，
+// 复核结果优于默认权重才写出权重文件，否则不写文件并返回2，模拟器继续使用默认权重。
+//
+// 目标值 = 平均等待时间 + 超时比例 × 最长等待时间（秒，越小越好）
+//
+// 用法: tune_dispatch [--strategy balanced|energy|batch] [--profile office|文件]
+//                     [--population N] [--generations N] [--replications N]
+//                     [--dt 秒] [--threads N] [--seed N] [--output 文件]
+#include "simulation_engine.h"
+#include "config.h"
+#include "logger.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Options {
+        Dispatcher::Strategy strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        std::string profile = "office";
+        int population = 12;
+        int generations = 8;
+        int replications = 2;
+        double deltaTime = 0.5;
+        int threads = 0;  // 0 表示按硬件线程数
+        unsigned int seed = 42;
+        std::string output = "dispatch.weights";
+    };
+
+    struct Candidate {
+        std::vector<double> genes;  // 各调优项在取值范围内的相对位置 [0,1]
+        double fitness = 0.0;
+        bool evaluated = false;
+    };
+
+    bool parseStrategy(const std::string& name, Dispatcher::Strategy& strategy) {
+        if (name == "balanced") strategy = Dispatcher::Strategy::LOAD_BALANCED;
+        else if (name == "energy") strategy = Dispatcher::Strategy::ENERGY_SAVING;
+        else if (name == "batch") strategy = Dispatcher::Strategy::BATCH_OPTIMAL;
+        else return false;
+        return true;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--profile") == 0) options.profile = value;
+            else if (std::strcmp(arg, "--population") == 0) options.population = std::atoi(value);
+            else if (std::strcmp(arg, "--generations") == 0) options.generations = std::atoi(value);
+            else if (std::strcmp(arg, "--replications") == 0) options.replications = std::atoi(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--threads") == 0) options.threads = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--output") == 0) options.output = value;
+            else if (std::strcmp(arg, "--strategy") == 0) {
+                if (!parseStrategy(value, options.strategy)) {
+                    std::cerr << "未知调度策略: " << value << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.population >= 4 && options.generations > 0 && options.replications > 0 &&
+               options.deltaTime > 0 && options.threads >= 0;
+    }
+
+    // 各策略实际用到的权重项（DispatchWeights::KEYS 的下标），只搜索这些项
+    std::vector<int> getTunedKeys(Dispatcher::Strategy strategy) {
+        switch (strategy) {
+            case Dispatcher::Strategy::LOAD_BALANCED: return {0};
+            case Dispatcher::Strategy::ENERGY_SAVING: return {1};
+            default: return {2, 3, 4};
+        }
+    }
+
+    class Tuner {
+    private:
+        const Options& options;
+        const SimulationEngine& base;   // 设置好客流曲线和策略、尚未开始的引擎，各次模拟从它分出
+        std::vector<int> keys;
+        int threadCount;
+
+    public:
+        Tuner(const Options& options, const SimulationEngine& base)
+            : options(options), base(base), keys(getTunedKeys(options.strategy)) {
+            threadCount = options.threads > 0 ? options.threads
+                                              : static_cast<int>(std::thread::hardware_concurrency());
+            threadCount = std::max(1, threadCount);
+        }
+
+        int getThreadCount() const { return threadCount; }
+        const std::vector<int>& getKeys() const { return keys; }
+
+        DispatchWeights toWeights(const std::vector<double>& genes) const {
+            std::vector<double> values = DispatchWeights().toVector();
+            for (size_t i = 0; i < keys.size(); ++i) {
+                int key = keys[i];
+                values[key] = DispatchWeights::LOWER_BOUNDS[key] +
+                              genes[i] * (DispatchWeights::UPPER_BOUNDS[key] - DispatchWeights::LOWER_BOUNDS[key]);
+            }
+            return DispatchWeights::fromVector(values);
+        }
+
+        std::vector<double> toGenes(const DispatchWeights& weights) const {
+            std::vector<double> values = weights.toVector();
+            std::vector<double> genes(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                int key = keys[i];
+                genes[i] = (values[key] - DispatchWeights::LOWER_BOUNDS[key]) /
+                           (DispatchWeights::UPPER_BOUNDS[key] - DispatchWeights::LOWER_BOUNDS[key]);
+            }
+            return genes;
+        }
+
+        double simulate(const DispatchWeights& weights, unsigned int seed) const {
+            auto engine = base.fork();
+            engine->seedRandom(seed);
+            engine->setDispatchWeights(weights);
+            engine->start();
+            engine->advance(engine->getDayLength(), options.deltaTime);
+
+            const auto& metrics = engine->getMetrics();
+            double timeoutRate = metrics.getRequestedPassengers() > 0
+                ? static_cast<double>(metrics.getTimedOutPassengers()) / metrics.getRequestedPassengers()
+                : 0.0;
+            return metrics.getAverageWaitTime() + timeoutRate * ElevatorConfig::MAX_WAIT_TIME;
+        }
+
+        // 并行评估一组权重，每组跑 replications 次，种子从 firstSeed 起连续编号
+        std::vector<double> evaluate(const std::vector<DispatchWeights>& batch, unsigned int firstSeed) const {
+            size_t jobCount = batch.size() * options.replications;
+            std::vector<double> results(jobCount, 0.0);
+            std::atomic<size_t> nextJob(0);
+            auto worker = [&]() {
+                Logger::setThreadEnabled(false);
+                for (size_t job = nextJob++; job < jobCount; job = nextJob++) {
+                    size_t candidate = job / options.replications;
+                    unsigned int seed = firstSeed + static_cast<unsigned int>(job % options.replications);
+                    results[job] = simulate(batch[candidate], seed);
+                }
+            };
+
+            std::vector<std::thread> workers;
+            int count = std::min<int>(threadCount, static_cast<int>(jobCount));
+            for (int i = 0; i < count; ++i) {
+                workers.emplace_back(worker);
+            }
+            for (auto& thread : workers) {
+                thread.join();
+            }
+
+            std::vector<double> fitness(batch.size(), 0.0);
+            for (size_t job = 0; job < jobCount; ++job) {
+                fitness[job / options.replications] += results[job] / options.replications;
+            }
+            return fitness;
+        }
+    };
+
+    const Candidate& tournament(const std::vector<Candidate>& population, std::mt19937& random) {
+        std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+        const Candidate* best = &population[pick(random)];
+        for (int i = 0; i < 2; ++i) {
+            const Candidate& other = population[pick(random)];
+            if (other.fitness < best->fitness) best = &other;
+        }
+        return *best;
+    }
+
+    void printWeights(const Tuner& tuner, const DispatchWeights& weights) {
+        for (int key : tuner.getKeys()) {
+            double value = 0.0;
+            weights.getValue(DispatchWeights::KEYS[key], value);
+            std::cout << "  " << DispatchWeights::KEYS[key] << "=" << value << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: tune_dispatch [--strategy balanced|energy|batch] [--profile office|文件] "
+                     "[--population N] [--generations N] [--replications N] [--dt 秒] "
+                     "[--threads N] [--seed N] [--output 文件]" << std::endl;
+        return 1;
+    }
+
+    Utils::seedRandom(options.seed);
+    SimulationEngine base;
+    base.getBuilding().setRecordingEnabled(false);
+    base.getBuilding().getMaintenanceManager().setEnabled(false);
+    base.setDispatchStrategy(options.strategy);
+
+    DemandProfile profile = DemandProfile::createOfficeDay(ElevatorConfig::FLOOR_COUNT);
+    if (options.profile != "office" && !profile.loadFromFile(options.profile)) {
+        std::cerr << "无法加载客流曲线: " << profile.getLastError() << std::endl;
+        return 1;
+    }
+    base.setDemandProfile(profile);
+
+    Tuner tuner(options, base);
+    std::mt19937 random(options.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const int ELITES = 2;
+
+    // 初始种群：默认权重加上随机个体
+    std::vector<Candidate> population(options.population);
+    population[0].genes = tuner.toGenes(DispatchWeights());
+    for (size_t i = 1; i < population.size(); ++i) {
+        population[i].genes.resize(tuner.getKeys().size());
+        for (double& gene : population[i].genes) gene = unit(random);
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 调度权重调优 ===" << std::endl;
+    std::cout << "调度策略: " << Dispatcher::getStrategyName(options.strategy)
+              << "  客流: " << options.profile << "  线程: " << tuner.getThreadCount() << std::endl;
+    std::cout << "种群: " << options.population << "  代数: " << options.generations
+              << "  每个候选模拟: " << options.replications << " 天" << std::endl;
+
+    auto begin = std::chrono::steady_clock::now();
+    double defaultFitness = 0.0;
+    for (int generation = 0; generation < options.generations; ++generation) {
+        std::vector<DispatchWeights> batch;
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < population.size(); ++i) {
+            if (!population[i].evaluated) {
+                batch.push_back(tuner.toWeights(population[i].genes));
+                pending.push_back(i);
+            }
+        }
+        std::vector<double> fitness = tuner.evaluate(batch, options.seed);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            population[pending[i]].fitness = fitness[i];
+            population[pending[i]].evaluated = true;
+        }
+        if (generation == 0) {
+            defaultFitness = population[0].fitness;
+        }
+
+        std::sort(population.begin(), population.end(),
+                  [](const Candidate& a, const Candidate& b) { return a.fitness < b.fitness; });
+        double mean = 0.0;
+        for (const auto& candidate : population) mean += candidate.fitness / population.size();
+        std::cout << "第 " << generation + 1 << " 代  最优 " << population[0].fitness
+                  << "  平均 " << mean << std::endl;
+        if (generation + 1 == options.generations) break;
+
+        // 保留精英，其余由锦标赛选出的父代做混合交叉（BLX-0.5）和高斯变异产生，变异幅度逐代减小
+        double sigma = 0.2 * (1.0 - static_cast<double>(generation) / options.generations) + 0.02;
+        std::normal_distribution<double> mutation(0.0, sigma);
+        std::vector<Candidate> next(population.begin(), population.begin() + ELITES);
+        while (next.size() < population.size()) {
+            const Candidate& first = tournament(population, random);
+            const Candidate& second = tournament(population, random);
+            Candidate child;
+            child.genes.resize(first.genes.size());
+            for (size_t i = 0; i < child.genes.size(); ++i) {
+                double low = std::min(first.genes[i], second.genes[i]);
+                double high = std::max(first.genes[i], second.genes[i]);
+                double spread = 0.5 * (high - low);
+                double gene = std::uniform_real_distribution<double>(low - spread, high + spread)(random);
+                if (unit(random) < 0.5) gene += mutation(random);
+                child.genes[i] = std::clamp(gene, 0.0, 1.0);
+            }
+            next.push_back(child);
+        }
+        population.swap(next);
+    }
+    double searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // 用搜索时没用过的种子复核，防止只是适应了那几天的客流
+    DispatchWeights best = tuner.toWeights(population[0].genes);
+    unsigned int validationSeed = options.seed + 1000;
+    std::vector<double> validation = tuner.evaluate({DispatchWeights(), best}, validationSeed);
+
+    std::cout << "搜索耗时: " << searchSeconds << " s" << std::endl;
+    std::cout << "默认权重: 搜索 " << defaultFitness << "  复核 " << validation[0] << std::endl;
+    std::cout << "最优权重: 搜索 " << population[0].fitness << "  复核 " << validation[1] << std::endl;
+    printWeights(tuner, best);
+    if (!(validation[1] < validation[0])) {
+        std::cerr << "最优权重在复核种子上不优于默认权重，未写出: " << options.output << std::endl;
+        return 2;
+    }
+
+    std::string comment = "tune_dispatch 调优结果（" + Dispatcher::getStrategyName(options.strategy) +
+                          "，客流 " + options.profile + "），复核目标值 " + std::to_string(validation[1]) +
+                          "，默认权重 " + std::to_string(validation[0]);
+    if (!best.saveToFile(options.output, comment)) {
+        std::cerr << "无法写出权重文件: " << options.output << std::endl;
+        return 1;
+    }
+    std::cout << "已写出: " << options.output << std::endl;
+    return 0;
+}
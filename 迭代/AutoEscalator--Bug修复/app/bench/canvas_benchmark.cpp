@@ -0,0 +1,124 @@
+// 楼宇画布绘制基准：在离屏平台上按给定楼层数和电梯数创建画布，每层都有呼梯和等待队列，
+// 分别测量整幅重绘和轿厢运行时逐帧局部重绘的 paintEvent 耗时（画布自身的计时），
+// 与约 16 ms 的帧间隔比较。
+//
+// 用法: canvas_benchmark [--floors N] [--elevators N] [--width 像素] [--height 像素]
+//                        [--repaints N] [--seconds N]
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <cstdio>
+#include "canvas/buildingcanvas.h"
+
+namespace {
+    struct Options {
+        int floors = 100;
+        int elevators = 16;
+        int width = 1280;
+        int height = 900;
+        int repaints = 300;
+        int seconds = 5;
+    };
+
+    bool parseOptions(const QApplication& app, Options& options) {
+        QCommandLineParser parser;
+        parser.addHelpOption();
+        QCommandLineOption floors("floors", "楼层数（默认100）", "N");
+        QCommandLineOption elevators("elevators", "电梯数（默认16）", "N");
+        QCommandLineOption width("width", "画布宽度（默认1280）", "像素");
+        QCommandLineOption height("height", "画布高度（默认900）", "像素");
+        QCommandLineOption repaints("repaints", "整幅重绘次数（默认300）", "N");
+        QCommandLineOption seconds("seconds", "运行动画的秒数（默认5）", "N");
+        parser.addOptions({floors, elevators, width, height, repaints, seconds});
+        parser.process(app);
+
+        if (parser.isSet(floors)) options.floors = parser.value(floors).toInt();
+        if (parser.isSet(elevators)) options.elevators = parser.value(elevators).toInt();
+        if (parser.isSet(width)) options.width = parser.value(width).toInt();
+        if (parser.isSet(height)) options.height = parser.value(height).toInt();
+        if (parser.isSet(repaints)) options.repaints = parser.value(repaints).toInt();
+        if (parser.isSet(seconds)) options.seconds = parser.value(seconds).toInt();
+        return options.floors >= 2 && options.elevators >= 1 && options.width > 0 &&
+               options.height > 0 && options.repaints > 0 && options.seconds > 0;
+    }
+
+    void printStats(const char* label, const BuildingCanvas::PaintStats& stats) {
+        std::printf("%s: %6d 次  平均 %7.3f ms  最长 %7.3f ms\n",
+                    label, stats.frames, stats.averageMs, stats.maxMs);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // 不需要显示器
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    Options options;
+    if (!parseOptions(app, options)) {
+        std::fprintf(stderr, "用法: canvas_benchmark [--floors N] [--elevators N] [--width 像素] "
+                             "[--height 像素] [--repaints N] [--seconds N]\n");
+        return 1;
+    }
+
+    BuildingCanvas canvas(options.floors, options.elevators);
+    canvas.setFloorTransitionTime(1000);  // 与主窗口的模拟周期一致
+    canvas.resize(options.width, options.height);
+    canvas.show();
+    app.processEvents();
+
+    // 每层都有呼梯和等待队列，是画布最重的状态
+    QRandomGenerator random(42);
+    for (int floor = 1; floor <= options.floors; ++floor) {
+        HallCallState state{floor < options.floors, floor > 1 && random.bounded(2) == 1,
+                            random.bounded(1, 25)};
+        canvas.onHallCallChanged(floor, state);
+    }
+    for (int i = 0; i < options.elevators; ++i) {
+        canvas.onElevatorUpdated(i, random.bounded(1, options.floors + 1), Direction::UP,
+                                 random.bounded(0, 13));
+    }
+    app.processEvents();
+
+    std::printf("=== 画布绘制基准 ===\n");
+    std::printf("楼层: %d  电梯: %d  画布: %dx%d  帧间隔: 16 ms\n",
+                options.floors, options.elevators, options.width, options.height);
+
+    // 整幅重绘：窗口缩放、遮挡恢复等情况下的上限
+    canvas.resetPaintStats();
+    for (int i = 0; i < options.repaints; ++i) {
+        canvas.repaint();
+    }
+    printStats("整幅重绘    ", canvas.paintStats());
+
+    // 逐帧局部重绘：每秒把所有轿厢派往新楼层并改动部分呼梯，和主窗口的更新节奏相同
+    auto dispatch = [&]() {
+        for (int i = 0; i < options.elevators; ++i) {
+            int floor = random.bounded(1, options.floors + 1);
+            canvas.onElevatorUpdated(i, floor, random.bounded(2) == 1 ? Direction::UP : Direction::DOWN,
+                                     random.bounded(0, 13));
+        }
+        for (int n = 0; n < options.floors / 10; ++n) {
+            int floor = random.bounded(1, options.floors + 1);
+            HallCallState state{random.bounded(2) == 1, random.bounded(2) == 1, random.bounded(0, 25)};
+            canvas.onHallCallChanged(floor, state);
+        }
+    };
+    QTimer tick;
+    tick.setInterval(1000);
+    QObject::connect(&tick, &QTimer::timeout, dispatch);
+
+    // 开始计时时立即派一次，保证整个测量期间轿厢都在运行
+    canvas.resetPaintStats();
+    dispatch();
+    tick.start();
+    QTimer::singleShot(options.seconds * 1000, &app, &QApplication::quit);
+    app.exec();
+
+    BuildingCanvas::PaintStats running = canvas.paintStats();
+    printStats("运行逐帧重绘", running);
+    std::printf("绘制帧率: %.1f 帧/秒\n", double(running.frames) / options.seconds);
+    return 0;
+}
@@ -0,0 +1,320 @@
+#include "buildingcanvas.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QtMath>
+#include "../common/logging.h"
+
+BuildingCanvas::BuildingCanvas(int floorCount, int elevatorCount, QWidget *parent)
+    : QWidget(parent)
+    , m_floorCount(floorCount)
+    , m_selectedFloor(0)
+    , m_frameTimer(new QTimer(this))
+    , m_transitionMs(1000)
+    , m_paintCount(0)
+    , m_paintTotalNs(0)
+    , m_paintMaxNs(0)
+{
+    m_cars.fill(CarState{1.0, 1.0, 1, 0, false, Direction::IDLE, 0}, elevatorCount);
+    m_hallCalls.fill(HallCallState{false, false, 0}, m_floorCount + 1);
+
+    // 背景由缓存位图整体覆盖，无需系统预先擦除
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(LABEL_WIDTH + HALL_CALL_WIDTH + elevatorCount * 12, m_floorCount * 4);
+
+    m_frameTimer->setInterval(FRAME_INTERVAL);
+    connect(m_frameTimer, &QTimer::timeout, this, &BuildingCanvas::onFrame);
+    m_clock.start();
+}
+
+QSize BuildingCanvas::sizeHint() const {
+    return QSize(LABEL_WIDTH + HALL_CALL_WIDTH + m_cars.size() * 120, m_floorCount * 30);
+}
+
+void BuildingCanvas::setFloorTransitionTime(int milliseconds) {
+    m_transitionMs = qMax(1, milliseconds);
+}
+
+BuildingCanvas::PaintStats BuildingCanvas::paintStats() const {
+    PaintStats stats;
+    stats.frames = m_paintCount;
+    stats.averageMs = m_paintCount > 0 ? m_paintTotalNs / 1e6 / m_paintCount : 0.0;
+    stats.maxMs = m_paintMaxNs / 1e6;
+    return stats;
+}
+
+void BuildingCanvas::resetPaintStats() {
+    m_paintCount = 0;
+    m_paintTotalNs = 0;
+    m_paintMaxNs = 0;
+}
+
+void BuildingCanvas::reset() {
+    m_frameTimer->stop();
+    for (auto& car : m_cars) {
+        car = CarState{1.0, 1.0, 1, 0, false, Direction::IDLE, 0};
+    }
+    m_hallCalls.fill(HallCallState{false, false, 0});
+    update();
+}
+
+void BuildingCanvas::onElevatorUpdated(int elevatorId, int floor, Direction direction, int passengerCount) {
+    if (elevatorId < 0 || elevatorId >= m_cars.size()) return;
+    auto& car = m_cars[elevatorId];
+
+    bool labelChanged = car.direction != direction || car.passengerCount != passengerCount;
+    car.direction = direction;
+    car.passengerCount = passengerCount;
+
+    if (floor != car.targetFloor) {
+        // 从当前绘制位置开始向新楼层插值，避免跳变
+        car.startFloor = car.displayFloor;
+        car.targetFloor = floor;
+        car.moveStartMs = m_clock.elapsed();
+        car.animating = true;
+        if (!m_frameTimer->isActive()) {
+            m_frameTimer->start();
+        }
+    } else if (labelChanged) {
+        update(carRect(elevatorId, car.displayFloor).toAlignedRect().adjusted(-1, -1, 1, 1));
+    }
+}
+
+void BuildingCanvas::onHallCallChanged(int floor, const HallCallState& state) {
+    if (floor < 1 || floor > m_floorCount) return;
+    m_hallCalls[floor] = state;
+    update(hallCallRect(floor));
+}
+
+void BuildingCanvas::setSelectedFloor(int floor) {
+    if (floor < 1 || floor > m_floorCount) floor = 0;
+    if (floor == m_selectedFloor) return;
+
+    if (m_selectedFloor > 0) update(labelRect(m_selectedFloor));
+    m_selectedFloor = floor;
+    if (m_selectedFloor > 0) update(labelRect(m_selectedFloor));
+}
+
+void BuildingCanvas::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton &&
+        event->pos().x() < MARGIN + LABEL_WIDTH + HALL_CALL_WIDTH &&
+        event->pos().y() >= MARGIN && event->pos().y() < height() - MARGIN) {
+        emit floorClicked(floorAt(event->pos().y()));
+        return;
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void BuildingCanvas::onFrame() {
+    qint64 now = m_clock.elapsed();
+    bool anyAnimating = false;
+
+    for (int i = 0; i < m_cars.size(); ++i) {
+        auto& car = m_cars[i];
+        if (!car.animating) continue;
+
+        double t = qMin(1.0, double(now - car.moveStartMs) / m_transitionMs);
+        double next = car.startFloor + (car.targetFloor - car.startFloor) * t;
+
+        // 只重绘轿厢扫过的区域
+        QRectF dirty = carRect(i, car.displayFloor).united(carRect(i, next));
+        car.displayFloor = next;
+        update(dirty.toAlignedRect().adjusted(-1, -1, 1, 1));
+
+        if (t >= 1.0) {
+            car.animating = false;
+        } else {
+            anyAnimating = true;
+        }
+    }
+
+    if (!anyAnimating) {
+        m_frameTimer->stop();
+    }
+}
+
+void BuildingCanvas::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    // 尺寸变化后整个控件会被重绘，这里只重建背景缓存，不再额外请求重绘
+    rebuildBackground();
+}
+
+double BuildingCanvas::floorHeight() const {
+    return double(height() - 2 * MARGIN) / m_floorCount;
+}
+
+// 楼层（可为小数）对应的顶部纵坐标，1楼在最下方
+double BuildingCanvas::floorTop(double floor) const {
+    return MARGIN + (m_floorCount - floor) * floorHeight();
+}
+
+int BuildingCanvas::floorAt(double y) const {
+    int floor = m_floorCount - int(qFloor((y - MARGIN) / floorHeight()));
+    return qBound(1, floor, m_floorCount);
+}
+
+QRectF BuildingCanvas::shaftRect(int elevatorId) const {
+    double left = MARGIN + LABEL_WIDTH + HALL_CALL_WIDTH;
+    double width = (this->width() - left - MARGIN) / m_cars.size();
+    return QRectF(left + elevatorId * width + SHAFT_GAP / 2.0, MARGIN,
+                  width - SHAFT_GAP, height() - 2 * MARGIN);
+}
+
+QRectF BuildingCanvas::carRect(int elevatorId, double floor) const {
+    QRectF shaft = shaftRect(elevatorId);
+    double h = floorHeight();
+    return QRectF(shaft.left() + 2, floorTop(floor) + 1, shaft.width() - 4, h - 2);
+}
+
+QRect BuildingCanvas::hallCallRect(int floor) const {
+    return QRectF(MARGIN + LABEL_WIDTH, floorTop(floor), HALL_CALL_WIDTH, floorHeight())
+        .toAlignedRect();
+}
+
+QRect BuildingCanvas::labelRect(int floor) const {
+    return QRectF(MARGIN, floorTop(floor), LABEL_WIDTH, floorHeight()).toAlignedRect();
+}
+
+void BuildingCanvas::rebuildBackground() {
+    if (width() <= 0 || height() <= 0) return;
+
+    m_background = QPixmap(size());
+    m_background.fill(Qt::white);
+
+    QPainter painter(&m_background);
+    double h = floorHeight();
+
+    // 井道
+    painter.setPen(QColor("#cccccc"));
+    painter.setBrush(QColor("#f5f5f5"));
+    for (int i = 0; i < m_cars.size(); ++i) {
+        painter.drawRect(shaftRect(i));
+    }
+
+    // 楼层线和楼层号（楼层过密时隔层标注）
+    int labelStep = qMax(1, int(qCeil(12.0 / h)));
+    QFont font = painter.font();
+    font.setPixelSize(qBound(8, int(h * 0.6), 12));
+    painter.setFont(font);
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        double top = floorTop(floor);
+        painter.setPen(QColor("#e0e0e0"));
+        painter.drawLine(QPointF(MARGIN, top + h), QPointF(width() - MARGIN, top + h));
+        if (floor % labelStep == 0 || floor == 1) {
+            painter.setPen(QColor("#333333"));
+            painter.drawText(QRectF(MARGIN, top, LABEL_WIDTH, h),
+                             Qt::AlignCenter, QString("%1层").arg(floor));
+        }
+    }
+}
+
+void BuildingCanvas::paintEvent(QPaintEvent* event) {
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+
+    // 正常情况下 resizeEvent 已重建好背景，这里只补救尚未收到尺寸事件的情况
+    if (m_background.size() != size()) {
+        rebuildBackground();
+    }
+    painter.drawPixmap(dirty, m_background, dirty);
+
+    if (m_selectedFloor > 0 && labelRect(m_selectedFloor).intersects(dirty)) {
+        painter.fillRect(labelRect(m_selectedFloor), QColor(33, 150, 243, 60));
+    }
+
+    // 只处理与脏区域相交的楼层
+    int topFloor = floorAt(dirty.top());
+    int bottomFloor = floorAt(dirty.bottom());
+
+    if (dirty.right() >= MARGIN + LABEL_WIDTH && dirty.left() <= MARGIN + LABEL_WIDTH + HALL_CALL_WIDTH) {
+        for (int floor = bottomFloor; floor <= topFloor; ++floor) {
+            drawHallCall(painter, floor);
+        }
+    }
+
+    for (int i = 0; i < m_cars.size(); ++i) {
+        QRectF car = carRect(i, m_cars[i].displayFloor);
+        if (car.intersects(dirty)) {
+            drawCar(painter, i);
+        }
+    }
+
+    qint64 elapsed = paintTimer.nsecsElapsed();
+    ++m_paintCount;
+    m_paintTotalNs += elapsed;
+    m_paintMaxNs = qMax(m_paintMaxNs, elapsed);
+    if (m_paintCount % PAINT_LOG_INTERVAL == 0) {
+        PaintStats stats = paintStats();
+        qCDebug(lcCanvas) << m_floorCount << "floors," << m_cars.size() << "cars:"
+                          << stats.frames << "paints, avg" << stats.averageMs
+                          << "ms, max" << stats.maxMs << "ms";
+    }
+}
+
+void BuildingCanvas::drawHallCall(QPainter& painter, int floor) const {
+    const auto& state = m_hallCalls[floor];
+    if (!state.upCall && !state.downCall && state.waitingCount <= 0) return;
+
+    QRect area = hallCallRect(floor);
+    double h = area.height();
+    double arrow = qMin(h * 0.6, 10.0);
+    double cy = area.center().y() + 0.5;
+    double x = area.left() + 4;
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor("#f44336"));
+    if (state.upCall) {
+        QPolygonF up;
+        up << QPointF(x, cy + arrow / 2) << QPointF(x + arrow, cy + arrow / 2)
+           << QPointF(x + arrow / 2, cy - arrow / 2);
+        painter.drawPolygon(up);
+    }
+    x += arrow + 2;
+    if (state.downCall) {
+        QPolygonF down;
+        down << QPointF(x, cy - arrow / 2) << QPointF(x + arrow, cy - arrow / 2)
+             << QPointF(x + arrow / 2, cy + arrow / 2);
+        painter.drawPolygon(down);
+    }
+    x += arrow + 4;
+
+    if (state.waitingCount <= 0) return;
+
+    // 候梯队列：长度与等待人数成正比，楼层过密、写不下人数时仍可看出队列长短
+    double available = area.right() - x - 2;
+    double length = available * qMin(state.waitingCount, int(QUEUE_BAR_FULL)) / QUEUE_BAR_FULL;
+    double barHeight = qMax(2.0, h * 0.5);
+    painter.setBrush(QColor("#ffcc80"));
+    painter.drawRect(QRectF(x, cy - barHeight / 2, qMax(2.0, length), barHeight));
+
+    if (h >= 8) {
+        painter.setPen(QColor("#333333"));
+        painter.drawText(QRectF(x, area.top(), area.right() - x, h),
+                         Qt::AlignLeft | Qt::AlignVCenter,
+                         QString("%1人").arg(state.waitingCount));
+    }
+}
+
+void BuildingCanvas::drawCar(QPainter& painter, int elevatorId) const {
+    const auto& car = m_cars[elevatorId];
+    QRectF rect = carRect(elevatorId, car.displayFloor);
+
+    QColor color;
+    switch (car.direction) {
+        case Direction::UP: color = QColor("#2ecc71"); break;
+        case Direction::DOWN: color = QColor("#3498db"); break;
+        default: color = QColor("#808080"); break;
+    }
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(color);
+    painter.drawRect(rect);
+
+    if (rect.height() >= 10 && rect.width() >= 16) {
+        painter.setPen(Qt::white);
+        painter.drawText(rect, Qt::AlignCenter, QString::number(car.passengerCount));
+    }
+}
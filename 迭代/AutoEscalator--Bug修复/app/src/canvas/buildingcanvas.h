@@ -0,0 +1,97 @@
+#ifndef BUILDINGCANVAS_H
+#define BUILDINGCANVAS_H
+
+#include <QWidget>
+#include <QVector>
+#include <QTimer>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include "../common/types.h"
+
+// 整栋楼的单一绘制画布：井道、轿厢、呼梯指示和各层候梯队列都由这里绘制，
+// 取代每层/每部电梯各自的子控件。只重绘发生变化的区域。
+// 每次 paintEvent 的耗时会被累计，可用 QT_LOGGING_RULES="elevator.canvas.debug=true" 输出。
+class BuildingCanvas : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit BuildingCanvas(int floorCount, int elevatorCount, QWidget *parent = nullptr);
+    ~BuildingCanvas() = default;
+
+    // 轿厢移动一层的插值时长（应与控制器的更新周期一致）
+    void setFloorTransitionTime(int milliseconds);
+    void reset();
+
+    QSize sizeHint() const override;
+
+    // 绘制耗时统计（自上次 resetPaintStats 起）
+    struct PaintStats {
+        int frames;
+        double averageMs;
+        double maxMs;
+    };
+    PaintStats paintStats() const;
+    void resetPaintStats();
+
+signals:
+    void floorClicked(int floor);  // 点击楼层号或呼梯区域
+
+public slots:
+    void onElevatorUpdated(int elevatorId, int floor, Direction direction, int passengerCount);
+    void onHallCallChanged(int floor, const HallCallState& state);
+    void setSelectedFloor(int floor);  // 高亮选中的楼层，0 表示不高亮
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+
+private slots:
+    void onFrame();
+
+private:
+    struct CarState {
+        double displayFloor;     // 当前绘制位置（可为小数）
+        double startFloor;       // 插值起点
+        int targetFloor;         // 插值终点
+        qint64 moveStartMs;      // 插值开始时间
+        bool animating;
+        Direction direction;
+        int passengerCount;
+    };
+
+    double floorHeight() const;
+    double floorTop(double floor) const;
+    int floorAt(double y) const;
+    QRectF shaftRect(int elevatorId) const;
+    QRectF carRect(int elevatorId, double floor) const;
+    QRect hallCallRect(int floor) const;
+    QRect labelRect(int floor) const;
+    void rebuildBackground();
+    void drawHallCall(QPainter& painter, int floor) const;
+    void drawCar(QPainter& painter, int elevatorId) const;
+
+    int m_floorCount;
+    QVector<CarState> m_cars;
+    QVector<HallCallState> m_hallCalls;  // 下标为楼层
+    int m_selectedFloor;                 // 0 表示未选中
+
+    QPixmap m_background;                // 井道与楼层线的静态背景缓存
+    QTimer* m_frameTimer;
+    QElapsedTimer m_clock;
+    int m_transitionMs;
+
+    int m_paintCount;
+    qint64 m_paintTotalNs;
+    qint64 m_paintMaxNs;
+
+    static const int FRAME_INTERVAL = 16;    // 约60帧
+    static const int LABEL_WIDTH = 44;
+    static const int HALL_CALL_WIDTH = 64;
+    static const int SHAFT_GAP = 6;
+    static const int MARGIN = 6;
+    static const int QUEUE_BAR_FULL = 20;       // 等待人数达到该值时队列条占满
+    static const int PAINT_LOG_INTERVAL = 600;  // 每绘制这么多帧输出一次耗时
+};
+
+#endif // BUILDINGCANVAS_H
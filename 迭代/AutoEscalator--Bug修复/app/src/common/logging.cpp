@@ -0,0 +1,5 @@
+#include "logging.h"
+
+Q_LOGGING_CATEGORY(lcController, "elevator.controller", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcControllerState, "elevator.controller.state", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcCanvas, "elevator.canvas", QtInfoMsg)
@@ -0,0 +1,13 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QLoggingCategory>
+
+// 分类日志：默认只输出 info 及以上级别，debug 输出需要显式打开，例如
+//   QT_LOGGING_RULES="elevator.controller.debug=true"
+// 关闭时 qCDebug 在判断类别开关后直接跳过，不会构造任何格式化字符串。
+Q_DECLARE_LOGGING_CATEGORY(lcController)       // 参数设置、电梯移动等单条事件
+Q_DECLARE_LOGGING_CATEGORY(lcControllerState)  // 每秒一次的系统状态快照
+Q_DECLARE_LOGGING_CATEGORY(lcCanvas)           // 楼宇画布的绘制耗时
+
+#endif // LOGGING_H
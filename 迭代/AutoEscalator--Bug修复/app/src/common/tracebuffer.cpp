@@ -0,0 +1,63 @@
+#include "tracebuffer.h"
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+
+// QDataStream 以引用方式接收，需要类外定义
+const quint16 TraceBuffer::FORMAT_VERSION;
+const quint16 TraceBuffer::RECORD_BYTES;
+
+TraceBuffer::TraceBuffer(int capacity)
+    : m_next(0)
+    , m_size(0)
+    , m_totalRecorded(0)
+{
+    // 一次性分配全部空间，记录时不再分配内存
+    m_records.resize(qMax(1, capacity));
+    m_clock.start();
+}
+
+void TraceBuffer::clear() {
+    m_next = 0;
+    m_size = 0;
+    m_totalRecorded = 0;
+}
+
+QVector<TraceRecord> TraceBuffer::snapshot() const {
+    QVector<TraceRecord> ordered;
+    ordered.reserve(m_size);
+
+    // 缓冲区未写满时从0开始，写满后最旧的记录位于 m_next
+    int start = (m_size < m_records.size()) ? 0 : m_next;
+    for (int i = 0; i < m_size; ++i) {
+        ordered.append(m_records[(start + i) % m_records.size()]);
+    }
+    return ordered;
+}
+
+bool TraceBuffer::dump(QIODevice* device) const {
+    if (!device || !device->isWritable()) {
+        return false;
+    }
+
+    QDataStream out(device);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out.writeRawData("ELTR", 4);
+    out << FORMAT_VERSION << RECORD_BYTES << quint32(m_size);
+
+    for (const auto& record : snapshot()) {
+        out << record.elapsedMs << record.tick << record.event
+            << record.elevatorId << record.arg1 << record.arg2;
+    }
+
+    return out.status() == QDataStream::Ok;
+}
+
+bool TraceBuffer::dumpToFile(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return dump(&file);
+}
@@ -0,0 +1,80 @@
+#ifndef TRACEBUFFER_H
+#define TRACEBUFFER_H
+
+#include <QVector>
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+class QIODevice;
+
+// 追踪事件类型
+enum class TraceEvent : quint16 {
+    RequestAdded = 1,      // arg1: 出发楼层, arg2: 目标楼层
+    RequestQueued,         // arg1: 出发楼层, arg2: 目标楼层（未分配，进入等待队列）
+    RequestAssigned,       // arg1: 出发楼层, arg2: 目标楼层
+    ElevatorMoved,         // arg1: 当前楼层, arg2: 方向
+    ElevatorArrived,       // arg1: 当前楼层, arg2: 载客数
+    PassengersBoarded,     // arg1: 当前楼层, arg2: 上客人数
+    PassengersAlighted,    // arg1: 当前楼层, arg2: 下客人数
+    Reset
+};
+
+// 定长二进制记录，写入时不做任何格式化
+struct TraceRecord {
+    qint64 elapsedMs;   // 自缓冲区创建起的毫秒数
+    quint32 tick;       // 控制器模拟时间（秒）
+    quint16 event;      // TraceEvent
+    qint16 elevatorId;  // 无关电梯时为 -1
+    qint32 arg1;
+    qint32 arg2;
+};
+
+// 固定容量的环形追踪缓冲区：写满后覆盖最旧的记录，只在需要时导出。
+// 导出格式（小端）：
+//   char[4] "ELTR" | quint16 版本 | quint16 记录字节数 | quint32 记录数 | 记录...
+// 记录按时间先后排列，字段顺序与 TraceRecord 相同。
+class TraceBuffer {
+public:
+    explicit TraceBuffer(int capacity = DEFAULT_CAPACITY);
+
+    void record(TraceEvent event, int tick, int elevatorId, int arg1 = 0, int arg2 = 0) {
+        TraceRecord& slot = m_records[m_next];
+        slot.elapsedMs = m_clock.elapsed();
+        slot.tick = quint32(tick);
+        slot.event = quint16(event);
+        slot.elevatorId = qint16(elevatorId);
+        slot.arg1 = arg1;
+        slot.arg2 = arg2;
+
+        m_next = (m_next + 1) % m_records.size();
+        if (m_size < m_records.size()) {
+            ++m_size;
+        }
+        ++m_totalRecorded;
+    }
+
+    void clear();
+
+    int size() const { return m_size; }
+    int capacity() const { return m_records.size(); }
+    quint64 totalRecorded() const { return m_totalRecorded; }  // 包括已被覆盖的记录
+
+    // 按时间顺序取出当前保存的记录
+    QVector<TraceRecord> snapshot() const;
+    // 以二进制格式写出当前保存的记录
+    bool dump(QIODevice* device) const;
+    bool dumpToFile(const QString& fileName) const;
+
+    static const int DEFAULT_CAPACITY = 8192;
+    static const quint16 FORMAT_VERSION = 1;
+    static const quint16 RECORD_BYTES = 24;
+
+private:
+    QVector<TraceRecord> m_records;
+    int m_next;
+    int m_size;
+    quint64 m_totalRecorded;
+    QElapsedTimer m_clock;
+};
+
+#endif // TRACEBUFFER_H
@@ -4,6 +4,13 @@
 #include <QString>
 #include <QtGlobal>  // for qint64
 
+// 电梯运行方向枚举
+enum class Direction {
+    UP,
+    DOWN,
+    IDLE
+};
+
 struct PassengerRequest {
     int currentFloor;    // 当前楼层
     int targetFloor;     // 目标楼层
@@ -11,4 +18,17 @@ struct PassengerRequest {
     qint64 timestamp;   // 请求时间戳
 };
 
-#endif // TYPES_H 
\ No newline at end of file
+// 楼层呼梯状态（供画布绘制使用）
+struct HallCallState {
+    bool upCall;         // 有上行呼叫
+    bool downCall;       // 有下行呼叫
+    int waitingCount;    // 等待人数
+
+    bool operator==(const HallCallState& other) const {
+        return upCall == other.upCall && downCall == other.downCall &&
+               waitingCount == other.waitingCount;
+    }
+    bool operator!=(const HallCallState& other) const { return !(*this == other); }
+};
+
+#endif // TYPES_H
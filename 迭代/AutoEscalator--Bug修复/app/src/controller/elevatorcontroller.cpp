@@ -3,9 +3,10 @@
 #include <QRandomGenerator>
 #include <QDebug>
 
-ElevatorController::ElevatorController(QVector<ElevatorWidget*>& elevators, QObject *parent)
-    : QObject(parent)
-    , m_elevators(elevators)
+ElevatorController::ElevatorController(int elevatorCount, int floorCount, QObject *parent)
+    : SimulationBackend(parent)
+    , m_floorCount(floorCount)
+    , m_statisticsFlushTimer(new QTimer(this))
     , m_maxPassengers(12)
     , m_floorTravelTime(5)
     , m_idleTime(10)
@@ -21,29 +22,33 @@ ElevatorController::ElevatorController(QVector<ElevatorWidget*>& elevators, QObj
     , m_requestInterval(10)  // 默认10秒生成一次随机乘客
 {
     // 检查电梯数量
-    if (m_elevators.isEmpty()) {
-        qDebug() << "Warning: No elevators provided to ElevatorController";
+    if (elevatorCount <= 0) {
+        qCWarning(lcController) << "No elevators provided to ElevatorController";
         return;
     }
 
     // 初始化电梯状态
-    m_elevatorStatus.resize(m_elevators.size());
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    m_elevatorStatus.resize(elevatorCount);
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         m_elevatorStatus[i] = {1, Direction::IDLE, 0, false, 0, QVector<int>()};
     }
 
     // 初始化定时器
     m_doorTimer->setSingleShot(true);  // 设置为单次触发
     m_requestTimer->setSingleShot(false);  // 设置为重复触发
+    m_statisticsFlushTimer->setSingleShot(true);
+    m_statisticsFlushTimer->setInterval(0);
+    connect(m_statisticsFlushTimer, &QTimer::timeout, this, &ElevatorController::flushStatistics);
     
     // 初始化统计数据
-    for (int floor = 1; floor <= 14; ++floor) {
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
         m_floorStatistics[floor] = 0;
     }
+    m_hallCalls.fill(HallCallState{false, false, 0}, m_floorCount + 1);
     
     // 初始化已分配请求容器
     m_assignedRequests.clear();
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         m_assignedRequests[i] = QVector<PassengerRequest>();
     }
 }
@@ -53,14 +58,14 @@ void ElevatorController::setParameters(int maxPassengers, int floorTravelTime, i
     m_floorTravelTime = floorTravelTime;
     m_idleTime = idleTime;
     
-    qDebug() << "Parameters updated - Max passengers:" << maxPassengers
+    qCDebug(lcController) << "Parameters updated - Max passengers:" << maxPassengers
              << "Floor travel time:" << floorTravelTime
              << "Idle time:" << idleTime;
 }
 
 void ElevatorController::addRequest(int currentFloor, int targetFloor, int passengerCount) {
     // 检查楼层范围
-    if (currentFloor < 1 || currentFloor > 14 || targetFloor < 1 || targetFloor > 14) {
+    if (currentFloor < 1 || currentFloor > m_floorCount || targetFloor < 1 || targetFloor > m_floorCount) {
         return;
     }
 
@@ -97,14 +102,17 @@ void ElevatorController::addRequest(int currentFloor, int targetFloor, int passe
     // 只有在成功分配或加入等待队列时才更新显示
     if (assigned || m_pendingRequests.size() < 15) {
         // 更新统计和显示
-        m_floorStatistics[currentFloor] += passengerCount;
-        emit statisticsUpdated(currentFloor, m_floorStatistics[currentFloor]);
+        updateStatistics(currentFloor, passengerCount);
         emit floorRequestAdded(currentFloor, targetFloor, passengerCount);
+        m_trace.record(TraceEvent::RequestAdded, m_simulationTime, -1, currentFloor, targetFloor);
         
         // 如果分配失败，加入等待队列
         if (!assigned) {
             m_pendingRequests.enqueue(request);
+            m_trace.record(TraceEvent::RequestQueued, m_simulationTime, -1, currentFloor, targetFloor);
         }
+        
+        publishHallCalls();
     }
 }
 
@@ -119,24 +127,26 @@ void ElevatorController::update() {
     // 更新模拟时间
     m_simulationTime++;
     
-    // 每秒打印一次状态信息
-    if (currentTime - lastPrintTime >= 1000) {
+    // 每秒打印一次状态信息（类别关闭时完全跳过收集和格式化）
+    if (lcControllerState().isDebugEnabled() && currentTime - lastPrintTime >= 1000) {
         printFloorRequests();
         lastPrintTime = currentTime;
     }
     
     // 更新每部电梯的状态
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         updateElevatorStatus(i);
     }
     
     // 处理未分配的请求
     processRequests();
+    
+    // 发布发生变化的楼层呼梯状态
+    publishHallCalls();
 }
 
 void ElevatorController::updateElevatorStatus(int elevatorId) {
     auto& status = m_elevatorStatus[elevatorId];
-    auto elevator = m_elevators[elevatorId];
     
     // 如果电梯正在开关门，不进行其他操作
     if (m_currentElevatorId == elevatorId) {
@@ -169,16 +179,14 @@ void ElevatorController::updateElevatorStatus(int elevatorId) {
     }
     
     // 更新电梯显示
-    elevator->setCurrentFloor(status.currentFloor);
-    elevator->setDirection(status.direction);
-    elevator->setPassengerCount(status.passengerCount);
+    publishElevator(elevatorId);
 }
 
 int ElevatorController::findBestElevator(const PassengerRequest& request) const {
     int bestElevator = -1;
     int minCost = INT_MAX;
     
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         if (!canElevatorTakeRequest(i, request)) {
             continue;
         }
@@ -190,7 +198,7 @@ int ElevatorController::findBestElevator(const PassengerRequest& request) const
         
         // 计算负载成本：当前乘客数量（满载度越高，成本越高）
         int loadFactor = (status.passengerCount * 100) / m_maxPassengers;  // 计算满载分比
-        int loadCost = loadFactor / 10;  // 每10%满载度增加1点成本
+        int loadCost = loadFactor / qMax(1, m_weights.loadPercentPerPoint);  // 默认每10%满载度增加1点成本
         
         // 计算方向兼容性成本
         int directionCost = 0;
@@ -203,15 +211,15 @@ int ElevatorController::findBestElevator(const PassengerRequest& request) const
                 directionCost = 0;
             } else {
                 // 方向相反，增加成本
-                directionCost = 15;
+                directionCost = m_weights.oppositeDirection;
             }
         } else {
             // 电梯，适当增加成本以平衡使用
-            directionCost = 5;
+            directionCost = m_weights.idle;
         }
         
         // 计算任队列成本（队列越长，成本越高）
-        int queueCost = m_assignedRequests[i].size() * 2;
+        int queueCost = m_assignedRequests[i].size() * m_weights.perQueuedRequest;
         
         // 计算楼层顺路成本
         int detourCost = 0;
@@ -229,7 +237,7 @@ int ElevatorController::findBestElevator(const PassengerRequest& request) const
             }
             
             if (!isOnTheWay) {
-                detourCost = 10;  // 需要改变路线时增加成本
+                detourCost = m_weights.detour;  // 需要改变路线时增加成本
             }
         }
         
@@ -237,8 +245,8 @@ int ElevatorController::findBestElevator(const PassengerRequest& request) const
         int totalCost = distance + loadCost + directionCost + queueCost + detourCost;
         
         // 如果电梯将满载，显著增加成本
-        if (status.passengerCount + request.passengerCount > m_maxPassengers * 0.8) {
-            totalCost += 20;
+        if (status.passengerCount + request.passengerCount > m_maxPassengers * m_weights.nearFullRatio) {
+            totalCost += m_weights.nearFull;
         }
         
         if (totalCost < minCost) {
@@ -312,8 +320,10 @@ void ElevatorController::moveElevator(int elevatorId) {
     status.isMoving = true;
     
     // 更新电梯显示
-    m_elevators[elevatorId]->setCurrentFloor(status.currentFloor);
-    qDebug() << QString("Elevator %1 moved to floor %2")
+    publishElevator(elevatorId);
+    m_trace.record(TraceEvent::ElevatorMoved, m_simulationTime, elevatorId,
+                   status.currentFloor, int(status.direction));
+    qCDebug(lcController) << QString("Elevator %1 moved to floor %2")
         .arg(elevatorId + 1)
         .arg(status.currentFloor);
 }
@@ -323,6 +333,8 @@ void ElevatorController::handleElevatorArrival(int elevatorId) {
     
     // 暂停移动状态
     status.isMoving = false;
+    m_trace.record(TraceEvent::ElevatorArrived, m_simulationTime, elevatorId,
+                   status.currentFloor, status.passengerCount);
     
     // 记录停靠时间
     status.lastStopTime = QDateTime::currentMSecsSinceEpoch() / 1000;
@@ -335,7 +347,7 @@ void ElevatorController::handleElevatorArrival(int elevatorId) {
     
     // 连接新的处理函数
     connect(m_doorTimer, &QTimer::timeout, this, [this]() {
-        if (m_currentElevatorId >= 0 && m_currentElevatorId < m_elevators.size()) {
+        if (m_currentElevatorId >= 0 && m_currentElevatorId < m_elevatorStatus.size()) {
             auto& status = m_elevatorStatus[m_currentElevatorId];
             
             // 处理乘客上下
@@ -377,7 +389,7 @@ void ElevatorController::updateElevatorDirection(int elevatorId) {
     }
     
     // 更新电梯显示
-    m_elevators[elevatorId]->setDirection(status.direction);
+    publishElevator(elevatorId);
 }
 
 bool ElevatorController::shouldStopAtFloor(int elevatorId, int floor) const {
@@ -419,6 +431,8 @@ void ElevatorController::processPassengersAtFloor(int elevatorId) {
         if (it->targetFloor == status.currentFloor) {
             // 乘客到达目标楼层
             status.passengerCount -= it->passengerCount;
+            m_trace.record(TraceEvent::PassengersAlighted, m_simulationTime, elevatorId,
+                           status.currentFloor, it->passengerCount);
             
             // 记录请求变化
             floorRequestChanges[it->currentFloor] += it->passengerCount;
@@ -469,6 +483,8 @@ void ElevatorController::processPassengersAtFloor(int elevatorId) {
         // 更新电梯状态
         status.passengerCount += actualPassengers;
         availableSpace -= actualPassengers;
+        m_trace.record(TraceEvent::PassengersBoarded, m_simulationTime, elevatorId,
+                       status.currentFloor, actualPassengers);
         
         // 记录请求变化
         floorRequestChanges[request.currentFloor] -= actualPassengers;
@@ -586,7 +602,22 @@ Direction ElevatorController::determineDirection(int elevatorId) const {
 
 void ElevatorController::updateStatistics(int floor, int passengerCount) {
     m_floorStatistics[floor] += passengerCount;
-    emit statisticsUpdated(floor, m_floorStatistics[floor]);
+    m_dirtyStatisticsFloors.insert(floor);
+    if (!m_statisticsFlushTimer->isActive()) {
+        m_statisticsFlushTimer->start();
+    }
+}
+
+void ElevatorController::flushStatistics() {
+    if (m_dirtyStatisticsFloors.isEmpty()) return;
+    
+    QMap<int, int> floorTotals;
+    for (int floor : m_dirtyStatisticsFloors) {
+        floorTotals[floor] = m_floorStatistics.value(floor, 0);
+    }
+    m_dirtyStatisticsFloors.clear();
+    
+    emit statisticsUpdated(floorTotals);
 }
 
 void ElevatorController::reset() {
@@ -599,24 +630,38 @@ void ElevatorController::reset() {
     m_assignedRequests.clear();
     
     // 重置电梯状态
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         m_elevatorStatus[i] = {1, Direction::IDLE, 0, false, 0, QVector<int>()};
-        m_elevators[i]->setCurrentFloor(1);
-        m_elevators[i]->setDirection(Direction::IDLE);
-        m_elevators[i]->setPassengerCount(0);
+        m_assignedRequests[i] = QVector<PassengerRequest>();
+        publishElevator(i);
     }
     
+    // 重置呼梯状态
+    publishHallCalls();
+    
     // 重置统计数据
     m_floorStatistics.clear();
-    for (int floor = 1; floor <= 14; ++floor) {
+    m_dirtyStatisticsFloors.clear();
+    m_statisticsFlushTimer->stop();
+    QMap<int, int> clearedTotals;
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
         m_floorStatistics[floor] = 0;
-        emit statisticsUpdated(floor, 0);
+        clearedTotals[floor] = 0;
         emit floorRequestCompleted(floor, 0, 0);  // 清空所有楼层的请求
     }
+    emit statisticsUpdated(clearedTotals);
     
     // 重置其他状态
     m_currentElevatorId = -1;
     m_isFirstRequest = true;
+    m_trace.record(TraceEvent::Reset, m_simulationTime, -1);
+}
+
+bool ElevatorController::dumpTrace(const QString& fileName) const {
+    bool ok = m_trace.dumpToFile(fileName);
+    qCInfo(lcController) << "Trace dump" << (ok ? "written to" : "failed:") << fileName
+                         << "records:" << m_trace.size() << "/" << m_trace.totalRecorded();
+    return ok;
 }
 
 bool ElevatorController::assignRequestToElevator(const PassengerRequest& request) {
@@ -650,6 +695,8 @@ bool ElevatorController::assignRequestToElevator(const PassengerRequest& request
         
         // 添加请求到电梯任务列表
         m_assignedRequests[bestElevator].append(request);
+        m_trace.record(TraceEvent::RequestAssigned, m_simulationTime, bestElevator,
+                       request.currentFloor, request.targetFloor);
         
         // 对电梯行方向对标楼层进行排序
         if (!status.targetFloors.contains(request.currentFloor)) {
@@ -709,7 +756,7 @@ void ElevatorController::generateRandomPassengers() {
 
     // 统计每层楼当前的请求数
     QMap<int, int> currentFloorRequests;
-    for (int floor = 1; floor <= 14; ++floor) {
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
         currentFloorRequests[floor] = 0;
     }
     
@@ -725,7 +772,7 @@ void ElevatorController::generateRandomPassengers() {
 
     // 收集可用的楼层（当前请求数小于2楼层）
     QVector<int> availableFloors;
-    for (int floor = 1; floor <= 14; ++floor) {
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
         if (currentFloorRequests[floor] < 2) {
             availableFloors.append(floor);
         }
@@ -745,7 +792,7 @@ void ElevatorController::generateRandomPassengers() {
         
         // 目标楼层（避免同）
         QVector<int> possibleTargets;
-        for (int floor = 1; floor <= 14; ++floor) {
+        for (int floor = 1; floor <= m_floorCount; ++floor) {
             if (floor != fromFloor) {
                 possibleTargets.append(floor);
             }
@@ -786,7 +833,7 @@ void ElevatorController::processRequests() {
 // 添加设置开关门时间的方法
 void ElevatorController::setDoorTime(int milliseconds) {
     m_doorTime = milliseconds;
-    qDebug() << "Door time updated to:" << milliseconds << "ms";
+    qCDebug(lcController) << "Door time updated to:" << milliseconds << "ms";
 }
 
 // 加新的私有方法来打印楼层请求信息
@@ -806,21 +853,21 @@ void ElevatorController::printFloorRequests() {
     }
 
     // 打印系统状态
-    qDebug() << "\n=== 系统状态信息 ===";
+    qCDebug(lcControllerState) << "\n=== 系统状态信息 ===";
     
     // 打印时间信息
     int daySeconds = m_simulationTime % m_dayDuration;
     int hour = (daySeconds * 24) / m_dayDuration;
     int minute = ((daySeconds * 24 * 60) / m_dayDuration) % 60;
-    qDebug().noquote() << QString("当前时间: %1:%2")
+    qCDebug(lcControllerState).noquote() << QString("当前时间: %1:%2")
         .arg(hour, 2, 10, QChar('0'))
         .arg(minute, 2, 10, QChar('0'));
     
-    qDebug().noquote() << QString("随机乘客生成间隔: %1秒").arg(m_requestInterval);
+    qCDebug(lcControllerState).noquote() << QString("随机乘客生成间隔: %1秒").arg(m_requestInterval);
     
     // 打印电梯状态
-    qDebug() << "\n--- 电梯状态 ---";
-    for (int i = 0; i < m_elevators.size(); ++i) {
+    qCDebug(lcControllerState) << "\n--- 电梯状态 ---";
+    for (int i = 0; i < m_elevatorStatus.size(); ++i) {
         const auto& status = m_elevatorStatus[i];
         QString dirStr;
         switch (status.direction) {
@@ -841,7 +888,7 @@ void ElevatorController::printFloorRequests() {
             targetFloorsStr = floors.join(",");
         }
         
-        qDebug().noquote() << QString("电梯%1: %2楼%3 载客:%4人 目标楼层:[%5]")
+        qCDebug(lcControllerState).noquote() << QString("电梯%1: %2楼%3 载客:%4人 目标楼层:[%5]")
             .arg(i + 1)
             .arg(status.currentFloor, 2)
             .arg(dirStr)
@@ -850,8 +897,8 @@ void ElevatorController::printFloorRequests() {
     }
     
     // 打印楼层请求状态
-    qDebug() << "\n--- 楼层请求状态 ---";
-    for (int floor = 14; floor >= 1; --floor) {
+    qCDebug(lcControllerState) << "\n--- 楼层请求状态 ---";
+    for (int floor = m_floorCount; floor >= 1; --floor) {
         QString floorInfo = QString("%1楼:").arg(floor, 2);
         
         if (floorRequests.contains(floor) && !floorRequests[floor].isEmpty()) {
@@ -864,10 +911,45 @@ void ElevatorController::printFloorRequests() {
             floorInfo += " 无请求";
         }
         
-        qDebug().noquote() << floorInfo;
+        qCDebug(lcControllerState).noquote() << floorInfo;
+    }
+    
+    qCDebug(lcControllerState) << "\n待处理请求数:" << m_pendingRequests.size();
+    qCDebug(lcControllerState) << "==================\n";
+}
+ 
+void ElevatorController::publishElevator(int elevatorId) {
+    const auto& status = m_elevatorStatus[elevatorId];
+    emit elevatorUpdated(elevatorId, status.currentFloor, status.direction, status.passengerCount);
+}
+
+// 汇总每层的呼梯方向和等待人数，只对发生变化的楼层发出信号
+void ElevatorController::publishHallCalls() {
+    QVector<HallCallState> current(m_floorCount + 1, HallCallState{false, false, 0});
+    
+    auto accumulate = [&current](const PassengerRequest& request) {
+        auto& state = current[request.currentFloor];
+        if (request.targetFloor > request.currentFloor) {
+            state.upCall = true;
+        } else {
+            state.downCall = true;
+        }
+        state.waitingCount += request.passengerCount;
+    };
+    
+    for (const auto& request : m_pendingRequests) {
+        accumulate(request);
+    }
+    for (const auto& requests : m_assignedRequests) {
+        for (const auto& request : requests) {
+            accumulate(request);
+        }
     }
     
-    qDebug() << "\n待处理请求数:" << m_pendingRequests.size();
-    qDebug() << "==================\n";
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        if (current[floor] != m_hallCalls[floor]) {
+            m_hallCalls[floor] = current[floor];
+            emit hallCallChanged(floor, current[floor]);
+        }
+    }
 }
- 
\ No newline at end of file
@@ -1,13 +1,15 @@
 #ifndef ELEVATORCONTROLLER_H
 #define ELEVATORCONTROLLER_H
 
-#include <QObject>
 #include <QVector>
 #include <QQueue>
 #include <QMap>
-#include <QDebug>
-#include "../elevator/elevatorwidget.h"
+#include <QSet>
+#include <QTimer>
 #include "../common/types.h"
+#include "../common/logging.h"
+#include "../common/tracebuffer.h"
+#include "simulationbackend.h"
 
 // 电梯状态结构体
 struct ElevatorStatus {
@@ -19,44 +21,61 @@ struct ElevatorStatus {
     QVector<int> targetFloors; // 目标楼层列表
 };
 
-class ElevatorController : public QObject {
+// 选择电梯时各项成本的权重，默认值为原先手工设定的数值
+struct DispatchCostWeights {
+    int loadPercentPerPoint = 10;   // 满载度每多少个百分点增加1点成本
+    int oppositeDirection = 15;     // 电梯运行方向与请求相反
+    int idle = 5;                   // 空闲电梯，平衡各电梯的使用
+    int perQueuedRequest = 2;       // 每个已分配请求
+    int detour = 10;                // 请求不在当前路线上，需要改变路线
+    double nearFullRatio = 0.8;     // 接上请求后超过该满载比例时
+    int nearFull = 20;              // 再增加的成本
+};
+
+class ElevatorController : public SimulationBackend {
     Q_OBJECT
 
 public:
-    explicit ElevatorController(QVector<ElevatorWidget*>& elevators, QObject *parent = nullptr);
+    explicit ElevatorController(int elevatorCount, int floorCount = 14, QObject *parent = nullptr);
     ~ElevatorController() = default;
 
     // 添加乘客请求
-    void addRequest(int currentFloor, int targetFloor, int passengerCount);
+    void addRequest(int currentFloor, int targetFloor, int passengerCount) override;
     // 添加高峰时段请求
-    void addRushHourRequests(bool isGroundFloor, const QString& type);
+    void addRushHourRequests(bool isGroundFloor, const QString& type) override;
     // 重置所有电梯状态
-    void reset();
+    void reset() override;
     // 设置系统参数
-    void setParameters(int maxPassengers, int floorTravelTime, int idleTime);
-    void generateRandomPassengers();  // 添加公共方法声明
+    void setParameters(int maxPassengers, int floorTravelTime, int idleTime) override;
+    void generateRandomPassengers() override;  // 添加公共方法声明
 
     // 设置乘客生成数量
-    void setRandomPassengerCount(int count) { 
+    void setRandomPassengerCount(int count) override { 
         m_randomPassengerCount = count; 
-        qDebug() << "Random passenger count updated:" << count;
+        qCDebug(lcController) << "Random passenger count updated:" << count;
     }
     
-    void setPeakPassengerCount(int count) { 
+    void setPeakPassengerCount(int count) override { 
         m_peakPassengerCount = count; 
-        qDebug() << "Peak passenger count updated:" << count;
+        qCDebug(lcController) << "Peak passenger count updated:" << count;
     }
 
     // 添加设置开关门时间的方法
-    void setDoorTime(int milliseconds);
+    void setDoorTime(int milliseconds) override;
 
-public slots:
-    void update(); // 更新电梯状态
+    // 调度成本权重
+    void setDispatchWeights(const DispatchCostWeights& weights) { m_weights = weights; }
+    const DispatchCostWeights& dispatchWeights() const { return m_weights; }
 
-signals:
-    void statisticsUpdated(int floor, int totalPassengers);
-    void floorRequestCompleted(int fromFloor, int toFloor, int count);
-    void floorRequestAdded(int fromFloor, int toFloor, int count);  // 添加新信号
+    int elevatorCount() const { return m_elevatorStatus.size(); }
+    int floorCount() const { return m_floorCount; }
+
+    // 运行轨迹（二进制环形缓冲区），按需导出
+    const TraceBuffer& trace() const { return m_trace; }
+    bool dumpTrace(const QString& fileName) const override;
+
+public slots:
+    void update() override; // 更新电梯状态
 
 private:
     void updateElevatorStatus(int elevatorId);
@@ -72,14 +91,21 @@ private:
     void processRequests();
     void printFloorRequests();
     void updateStatistics(int floor, int passengerCount);
+    void flushStatistics();
     Direction determineDirection(int elevatorId) const;
+    void publishElevator(int elevatorId);
+    void publishHallCalls();
 
     // 成员变量
-    QVector<ElevatorWidget*>& m_elevators;
+    int m_floorCount;
     QVector<ElevatorStatus> m_elevatorStatus;
+    QVector<HallCallState> m_hallCalls;  // 上次发布的呼梯状态，下标为楼层
     QQueue<PassengerRequest> m_pendingRequests;
     QMap<int, QVector<PassengerRequest>> m_assignedRequests;
     QMap<int, int> m_floorStatistics;
+    QSet<int> m_dirtyStatisticsFloors;  // 尚未发出的统计变化
+    QTimer* m_statisticsFlushTimer;     // 零间隔单次定时器，把一轮内的统计变化合并为一次信号
+    TraceBuffer m_trace;                // 关键事件的二进制记录，常开且不做格式化
 
     // 系统参数
     int m_maxPassengers;
@@ -95,6 +121,7 @@ private:
     int m_simulationTime;  // 模拟时间（秒）
     int m_dayDuration;    // 一天的持续时间（秒）
     int m_requestInterval;  // 随机乘客生成间隔（秒）
+    DispatchCostWeights m_weights;  // 调度成本权重
 };
 
 #endif // ELEVATORCONTROLLER_H 
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "enginecontroller.h"
+#include <QRandomGenerator>
+#include <utility>
+#include "config.h"
+
+namespace {
+    const double DAY_LENGTH = 24.0 * 3600;  // 引擎的一天（秒），结束后接着下一天
+    const double STEP_TIME = 0.1;           // 每次 update 推进一秒，按此步长分步
+
+    Direction toDirection(ElevatorState state) {
+        switch (state) {
+        case ElevatorState::MOVING_UP:
+            return Direction::UP;
+        case ElevatorState::MOVING_DOWN:
+            return Direction::DOWN;
+        default:
+            return Direction::IDLE;
+        }
+    }
+}
+
+EngineController::EngineController(int elevatorCount, int floorCount, QObject *parent)
+    : SimulationBackend(parent)
+    , m_floorCount(floorCount)
+    , m_elevatorCount(elevatorCount)
+    , m_statisticsFlushTimer(new QTimer(this))
+    , m_maxPassengers(12)
+    , m_randomPassengerCount(3)
+    , m_peakPassengerCount(15)
+    , m_doorTime(1000)
+{
+    m_statisticsFlushTimer->setSingleShot(true);
+    m_statisticsFlushTimer->setInterval(0);
+    connect(m_statisticsFlushTimer, &QTimer::timeout, this, &EngineController::flushStatistics);
+
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        m_floorStatistics[floor] = 0;
+    }
+    createEngine();
+}
+
+void EngineController::createEngine() {
+    m_engine.reset(new SimulationEngine(DAY_LENGTH, m_floorCount, m_elevatorCount, m_maxPassengers));
+    m_engine->setTrafficEnabled(false);
+    m_engine->start();
+
+    // 新引擎的电梯都停在1层、没有呼梯，与画布的初始状态一致
+    m_engine->takeSnapshot(m_published);
+}
+
+bool EngineController::isPristine() const {
+    return m_engine->getCurrentTime() == 0.0 &&
+           m_engine->getMetrics().getRequestedPassengers() == 0;
+}
+
+void EngineController::setParameters(int maxPassengers, int floorTravelTime, int idleTime) {
+    // 引擎从全局配置读取运行时间和空闲时间，界面只有一个引擎
+    m_maxPassengers = maxPassengers;
+    ElevatorConfig::FLOOR_TRAVEL_TIME = floorTravelTime;
+    ElevatorConfig::MAX_IDLE_TIME = idleTime;
+    if (isPristine()) {
+        createEngine();
+    }
+
+    qCDebug(lcController) << "Parameters updated - Max passengers:" << maxPassengers
+             << "Floor travel time:" << floorTravelTime
+             << "Idle time:" << idleTime;
+}
+
+void EngineController::addRequest(int currentFloor, int targetFloor, int passengerCount) {
+    // 范围检查由引擎完成，被拒绝的请求不出现在列表里
+    if (!m_engine->addRequest(currentFloor, targetFloor, passengerCount)) {
+        return;
+    }
+
+    updateStatistics(currentFloor, passengerCount);
+    emit floorRequestAdded(currentFloor, targetFloor, passengerCount);
+    m_trace.record(TraceEvent::RequestAdded, int(m_engine->getCurrentTime()), -1, currentFloor, targetFloor);
+    publishSnapshot(false);
+}
+
+void EngineController::addRushHourRequests(bool isGroundFloor, const QString& type) {
+    // 与 ElevatorController 相同，不单独处理高峰期请求
+    Q_UNUSED(isGroundFloor);
+    Q_UNUSED(type);
+}
+
+void EngineController::update() {
+    if (!m_engine->isSimulationRunning()) {
+        m_engine->startNextDay();
+    }
+    m_engine->advance(1.0, STEP_TIME);
+    publishSnapshot(false);
+}
+
+// 与上次发布的快照比较，只对变化的电梯和楼层发出信号
+void EngineController::publishSnapshot(bool publishAll) {
+    m_engine->takeSnapshot(m_snapshot);
+    int tick = int(m_snapshot.time);
+
+    for (int i = 0; i < int(m_snapshot.cars.size()); ++i) {
+        const auto& car = m_snapshot.cars[i];
+        const auto& previous = m_published.cars[i];
+        Direction direction = toDirection(car.state);
+        if (publishAll || car.floor != previous.floor || car.load != previous.load ||
+            direction != toDirection(previous.state)) {
+            emit elevatorUpdated(i, car.floor, direction, car.load);
+        }
+
+        // 轨迹按载客数的变化记录上下客，同一秒内先下后上时只记净变化
+        if (car.floor != previous.floor) {
+            m_trace.record(TraceEvent::ElevatorMoved, tick, i, car.floor, int(direction));
+        }
+        if (car.load > previous.load) {
+            m_trace.record(TraceEvent::PassengersBoarded, tick, i, car.floor, car.load - previous.load);
+        } else if (car.load < previous.load) {
+            m_trace.record(TraceEvent::PassengersAlighted, tick, i, car.floor, previous.load - car.load);
+        }
+    }
+
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        const auto& current = m_snapshot.floors[floor];
+        const auto& previous = m_published.floors[floor];
+        HallCallState state{current.upCall, current.downCall, current.waiting};
+        if (publishAll || state != HallCallState{previous.upCall, previous.downCall, previous.waiting}) {
+            emit hallCallChanged(floor, state);
+        }
+
+        // 引擎按乘客排队，完成通知不带目标楼层；该层清空时请求列表随之清空
+        if (current.waiting < previous.waiting) {
+            emit floorRequestCompleted(floor, 0, previous.waiting - current.waiting);
+            if (current.waiting == 0) {
+                emit floorRequestCompleted(floor, 0, 0);
+            }
+        }
+    }
+
+    std::swap(m_snapshot, m_published);
+}
+
+void EngineController::updateStatistics(int floor, int passengerCount) {
+    m_floorStatistics[floor] += passengerCount;
+    m_dirtyStatisticsFloors.insert(floor);
+    if (!m_statisticsFlushTimer->isActive()) {
+        m_statisticsFlushTimer->start();
+    }
+}
+
+void EngineController::flushStatistics() {
+    if (m_dirtyStatisticsFloors.isEmpty()) return;
+
+    QMap<int, int> floorTotals;
+    for (int floor : m_dirtyStatisticsFloors) {
+        floorTotals[floor] = m_floorStatistics.value(floor, 0);
+    }
+    m_dirtyStatisticsFloors.clear();
+
+    emit statisticsUpdated(floorTotals);
+}
+
+void EngineController::reset() {
+    // 重建引擎，期间修改的载客量随之生效
+    createEngine();
+    publishSnapshot(true);
+
+    // 重置统计数据
+    m_dirtyStatisticsFloors.clear();
+    m_statisticsFlushTimer->stop();
+    QMap<int, int> clearedTotals;
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        m_floorStatistics[floor] = 0;
+        clearedTotals[floor] = 0;
+        emit floorRequestCompleted(floor, 0, 0);  // 清空所有楼层的请求
+    }
+    emit statisticsUpdated(clearedTotals);
+
+    m_trace.record(TraceEvent::Reset, 0, -1);
+}
+
+void EngineController::generateRandomPassengers() {
+    // 引擎按乘客排队，不需要 ElevatorController 每层最多2个请求的限制；
+    // 每次仍从不同楼层出发，每个请求1-3人
+    QVector<int> availableFloors;
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        availableFloors.append(floor);
+    }
+
+    for (int i = 0; i < m_randomPassengerCount && !availableFloors.isEmpty(); ++i) {
+        int randomIndex = QRandomGenerator::global()->bounded(availableFloors.size());
+        int fromFloor = availableFloors[randomIndex];
+        availableFloors.removeAt(randomIndex);
+
+        // 在其余楼层中选目标楼层
+        int toFloor = QRandomGenerator::global()->bounded(1, m_floorCount);
+        if (toFloor >= fromFloor) {
+            ++toFloor;
+        }
+        int passengerCount = QRandomGenerator::global()->bounded(1, 4);
+
+        addRequest(fromFloor, toFloor, passengerCount);
+    }
+}
+
+void EngineController::setDoorTime(int milliseconds) {
+    m_doorTime = milliseconds;
+    qCDebug(lcController) << "Door time updated to:" << milliseconds
+                          << "ms (engine dwell is fixed at" << Elevator::DOOR_DWELL_TIME << "s)";
+}
+
+bool EngineController::dumpTrace(const QString& fileName) const {
+    bool ok = m_trace.dumpToFile(fileName);
+    qCInfo(lcController) << "Trace dump" << (ok ? "written to" : "failed:") << fileName
+                         << "records:" << m_trace.size() << "/" << m_trace.totalRecorded();
+    return ok;
+}
@@ -0,0 +1,77 @@
+#ifndef ENGINECONTROLLER_H
+#define ENGINECONTROLLER_H
+
+#include <QVector>
+#include <QMap>
+#include <QSet>
+#include <QTimer>
+#include <memory>
+#include "simulationbackend.h"
+#include "../common/logging.h"
+#include "../common/tracebuffer.h"
+#include "simulation_engine.h"
+
+// 用控制台版的模拟核心（elevator_core 的 SimulationEngine）驱动界面：
+// 每次 update 把引擎推进一秒，取一次状态快照，与上一次比较后只对变化的电梯和楼层发出信号。
+// 客流只来自请求面板和 generateRandomPassengers，引擎自己的客流生成保持关闭
+class EngineController : public SimulationBackend {
+    Q_OBJECT
+
+public:
+    explicit EngineController(int elevatorCount, int floorCount = 14, QObject *parent = nullptr);
+    ~EngineController() = default;
+
+    void addRequest(int currentFloor, int targetFloor, int passengerCount) override;
+    void addRushHourRequests(bool isGroundFloor, const QString& type) override;
+    void reset() override;
+    // 运行时间和空闲时间立即生效；载客量在模拟开始前或重置后重建引擎时生效
+    void setParameters(int maxPassengers, int floorTravelTime, int idleTime) override;
+    void generateRandomPassengers() override;
+
+    void setRandomPassengerCount(int count) override {
+        m_randomPassengerCount = count;
+        qCDebug(lcController) << "Random passenger count updated:" << count;
+    }
+
+    void setPeakPassengerCount(int count) override {
+        m_peakPassengerCount = count;
+        qCDebug(lcController) << "Peak passenger count updated:" << count;
+    }
+
+    // 引擎的停靠时间是固定值，只记录设置
+    void setDoorTime(int milliseconds) override;
+
+    int elevatorCount() const { return m_elevatorCount; }
+    int floorCount() const { return m_floorCount; }
+
+    const SimulationEngine& engine() const { return *m_engine; }
+    const TraceBuffer& trace() const { return m_trace; }
+    bool dumpTrace(const QString& fileName) const override;
+
+public slots:
+    void update() override;
+
+private:
+    void createEngine();
+    bool isPristine() const;  // 尚未推进也没有乘客，可以直接重建引擎
+    void publishSnapshot(bool publishAll);
+    void updateStatistics(int floor, int passengerCount);
+    void flushStatistics();
+
+    int m_floorCount;
+    int m_elevatorCount;
+    std::unique_ptr<SimulationEngine> m_engine;
+    EngineSnapshot m_snapshot;          // 本次推进后的状态
+    EngineSnapshot m_published;         // 上次发布的状态，两者交替复用
+    QMap<int, int> m_floorStatistics;
+    QSet<int> m_dirtyStatisticsFloors;  // 尚未发出的统计变化
+    QTimer* m_statisticsFlushTimer;     // 零间隔单次定时器，把一轮内的统计变化合并为一次信号
+    TraceBuffer m_trace;
+
+    int m_maxPassengers;
+    int m_randomPassengerCount;
+    int m_peakPassengerCount;
+    int m_doorTime;  // 开关门时间（毫秒），仅记录
+};
+
+#endif // ENGINECONTROLLER_H
@@ -0,0 +1,45 @@
+#ifndef SIMULATIONBACKEND_H
+#define SIMULATIONBACKEND_H
+
+#include <QObject>
+#include <QMap>
+#include <QString>
+#include "../common/types.h"
+
+// 主窗口驱动的模拟后端：主窗口每秒调用一次 update，界面只通过下面的信号刷新。
+// ElevatorController 是界面自带的实现，EngineController 把控制台版的 SimulationEngine 适配到同一接口
+class SimulationBackend : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SimulationBackend(QObject *parent = nullptr) : QObject(parent) {}
+    virtual ~SimulationBackend() = default;
+
+    // 添加乘客请求
+    virtual void addRequest(int currentFloor, int targetFloor, int passengerCount) = 0;
+    // 添加高峰时段请求
+    virtual void addRushHourRequests(bool isGroundFloor, const QString& type) = 0;
+    // 重置所有电梯状态
+    virtual void reset() = 0;
+    // 设置系统参数
+    virtual void setParameters(int maxPassengers, int floorTravelTime, int idleTime) = 0;
+    virtual void generateRandomPassengers() = 0;
+    virtual void setRandomPassengerCount(int count) = 0;
+    virtual void setPeakPassengerCount(int count) = 0;
+    virtual void setDoorTime(int milliseconds) = 0;
+
+    // 导出运行轨迹
+    virtual bool dumpTrace(const QString& fileName) const = 0;
+
+public slots:
+    virtual void update() = 0;  // 推进一秒模拟时间
+
+signals:
+    void statisticsUpdated(const QMap<int, int>& floorTotals);  // 同一轮事件循环内变化的楼层 -> 累计人数，合并后发出
+    void floorRequestCompleted(int fromFloor, int toFloor, int count);
+    void floorRequestAdded(int fromFloor, int toFloor, int count);
+    void elevatorUpdated(int elevatorId, int floor, Direction direction, int passengerCount);
+    void hallCallChanged(int floor, const HallCallState& state);  // 仅在楼层呼梯状态变化时发出
+};
+
+#endif // SIMULATIONBACKEND_H
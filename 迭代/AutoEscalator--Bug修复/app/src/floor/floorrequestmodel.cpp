@@ -0,0 +1,93 @@
+#include "floorrequestmodel.h"
+
+FloorRequestModel::FloorRequestModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_totalCount(0)
+{
+}
+
+int FloorRequestModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant FloorRequestModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const auto& row = m_rows[index.row()];
+    switch (role) {
+        case Qt::DisplayRole:
+            return QString("%1楼      %2人").arg(row.first, 2).arg(row.second, 2);
+        case Qt::TextAlignmentRole:
+            return int(Qt::AlignLeft | Qt::AlignVCenter);
+        default:
+            return QVariant();
+    }
+}
+
+int FloorRequestModel::lowerBound(int targetFloor) const {
+    int low = 0;
+    int high = m_rows.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (m_rows[mid].first < targetFloor) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void FloorRequestModel::adjust(int targetFloor, int countDelta) {
+    if (countDelta == 0) return;
+
+    bool wasEmpty = m_rows.isEmpty();
+    int row = lowerBound(targetFloor);
+    bool exists = row < m_rows.size() && m_rows[row].first == targetFloor;
+
+    if (exists) {
+        int oldCount = m_rows[row].second;
+        int newCount = oldCount + countDelta;
+        if (newCount <= 0) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_rows.remove(row);
+            m_totalCount -= oldCount;
+            endRemoveRows();
+        } else {
+            m_rows[row].second = newCount;
+            m_totalCount += countDelta;
+            QModelIndex changed = index(row);
+            emit dataChanged(changed, changed, {Qt::DisplayRole});
+        }
+    } else if (countDelta > 0) {
+        beginInsertRows(QModelIndex(), row, row);
+        m_rows.insert(row, qMakePair(targetFloor, countDelta));
+        m_totalCount += countDelta;
+        endInsertRows();
+    }
+
+    if (wasEmpty != m_rows.isEmpty()) {
+        emit emptyChanged(m_rows.isEmpty());
+    }
+}
+
+void FloorRequestModel::clear() {
+    if (m_rows.isEmpty()) return;
+
+    beginResetModel();
+    m_rows.clear();
+    m_totalCount = 0;
+    endResetModel();
+
+    emit emptyChanged(true);
+}
+
+int FloorRequestModel::count(int targetFloor) const {
+    int row = lowerBound(targetFloor);
+    if (row < m_rows.size() && m_rows[row].first == targetFloor) {
+        return m_rows[row].second;
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+#ifndef FLOORREQUESTMODEL_H
+#define FLOORREQUESTMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QPair>
+
+// 单个楼层的等待请求模型：每个目标楼层一行，按楼层升序排列。
+// 人数变化只发出对应行的 dataChanged，行的增删使用 insert/remove 通知，
+// 视图无需整体重建。
+class FloorRequestModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit FloorRequestModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // 调整某目标楼层的人数，人数降到0及以下时删除该行
+    void adjust(int targetFloor, int countDelta);
+    void clear();
+
+    int count(int targetFloor) const;
+    int totalCount() const { return m_totalCount; }
+    bool isEmpty() const { return m_rows.isEmpty(); }
+
+signals:
+    void emptyChanged(bool empty);  // 仅在有无请求发生切换时发出
+
+private:
+    int lowerBound(int targetFloor) const;
+
+    QVector<QPair<int, int>> m_rows;  // (targetFloor, count)，按 targetFloor 升序
+    int m_totalCount;
+};
+
+#endif // FLOORREQUESTMODEL_H
@@ -0,0 +1,130 @@
+#include "requestpanel.h"
+#include <QFormLayout>
+#include <QVBoxLayout>
+#include <QMessageBox>
+
+RequestPanel::RequestPanel(int floorCount, QWidget *parent)
+    : QWidget(parent)
+    , m_fromFloor(new QSpinBox(this))
+    , m_toFloor(new QSpinBox(this))
+    , m_count(new QSpinBox(this))
+    , m_submitButton(new QPushButton("添加请求", this))
+    , m_listHeader(new QLabel(this))
+    , m_requestList(new QListView(this))
+    , m_floorCount(floorCount)
+{
+    m_models.fill(nullptr, m_floorCount + 1);
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        m_models[floor] = new FloorRequestModel(this);
+    }
+
+    setupUI();
+
+    connect(m_submitButton, &QPushButton::clicked, this, &RequestPanel::onSubmitClicked);
+    connect(m_fromFloor, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &RequestPanel::onFromFloorChanged);
+    onFromFloorChanged(m_fromFloor->value());
+}
+
+void RequestPanel::setupUI() {
+    auto layout = new QVBoxLayout(this);
+    layout->setSpacing(5);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    m_fromFloor->setRange(1, m_floorCount);
+    m_fromFloor->setSuffix("层");
+    m_toFloor->setRange(1, m_floorCount);
+    m_toFloor->setSuffix("层");
+    m_toFloor->setValue(m_floorCount);
+    m_count->setRange(1, MAX_COUNT_PER_REQUEST);
+    m_count->setSuffix("人");
+
+    auto form = new QFormLayout();
+    form->setSpacing(4);
+    form->addRow("出发", m_fromFloor);
+    form->addRow("到达", m_toFloor);
+    form->addRow("人数", m_count);
+    layout->addLayout(form);
+
+    m_submitButton->setStyleSheet(R"(
+        QPushButton {
+            background-color: #2196F3;
+            color: white;
+            border: none;
+            padding: 5px;
+            border-radius: 3px;
+            min-height: 25px;
+        }
+        QPushButton:hover {
+            background-color: #1976D2;
+        }
+    )");
+    layout->addWidget(m_submitButton);
+
+    m_listHeader->setStyleSheet(R"(
+        QLabel {
+            background-color: #f5f5f5;
+            font-weight: bold;
+            padding: 3px 5px;
+            border: 1px solid #ccc;
+            border-bottom: none;
+        }
+    )");
+    layout->addWidget(m_listHeader);
+
+    // 列表视图直接绑定所选楼层的模型，行级增量刷新
+    m_requestList->setUniformItemSizes(true);
+    m_requestList->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_requestList->setStyleSheet(R"(
+        QListView {
+            border: 1px solid #ccc;
+            background-color: white;
+        }
+    )");
+    layout->addWidget(m_requestList, 1);
+}
+
+void RequestPanel::setCurrentFloor(int floor) {
+    m_fromFloor->setValue(floor);  // 超出范围时由 QSpinBox 截断
+}
+
+void RequestPanel::onFromFloorChanged(int floor) {
+    m_requestList->setModel(m_models[floor]);
+    m_listHeader->setText(QString("%1层等待  目标/人数").arg(floor));
+    emit currentFloorChanged(floor);
+}
+
+void RequestPanel::onSubmitClicked() {
+    int fromFloor = m_fromFloor->value();
+    int toFloor = m_toFloor->value();
+    if (toFloor == fromFloor) {
+        QMessageBox::warning(this, "输入错误", "目标楼层不能是出发楼层");
+        return;
+    }
+
+    // 列表由控制器的 floorRequestAdded 更新，被拒绝的请求不会出现在列表里
+    emit requestSubmitted(fromFloor, toFloor, m_count->value());
+}
+
+void RequestPanel::onRequestAdded(int fromFloor, int toFloor, int count) {
+    if (fromFloor < 1 || fromFloor > m_floorCount) return;
+    m_models[fromFloor]->adjust(toFloor, count);
+}
+
+void RequestPanel::onRequestCompleted(int fromFloor, int toFloor, int count) {
+    if (fromFloor < 1 || fromFloor > m_floorCount) return;
+
+    // 人数为0表示该层已无等待请求；控制器不带目标楼层的部分完成通知
+    // 无法对应到具体行，只在该层清空时同步
+    if (count == 0) {
+        m_models[fromFloor]->clear();
+    } else if (toFloor > 0) {
+        m_models[fromFloor]->adjust(toFloor, -count);
+    }
+}
+
+void RequestPanel::clear() {
+    for (int floor = 1; floor <= m_floorCount; ++floor) {
+        m_models[floor]->clear();
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef REQUESTPANEL_H
+#define REQUESTPANEL_H
+
+#include <QWidget>
+#include <QVector>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QListView>
+#include "floorrequestmodel.h"
+
+// 全楼共用的乘客请求输入面板：选择出发楼层、目标楼层和人数后提交一次请求，
+// 下方列表显示所选出发楼层的等待请求。各层只保留一个请求模型，不再为每层创建控件。
+class RequestPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit RequestPanel(int floorCount, QWidget *parent = nullptr);
+    ~RequestPanel() = default;
+
+    int currentFloor() const { return m_fromFloor->value(); }
+    void clear();
+
+signals:
+    void requestSubmitted(int currentFloor, int targetFloor, int count);
+    void currentFloorChanged(int floor);
+
+public slots:
+    void setCurrentFloor(int floor);
+    void onRequestAdded(int fromFloor, int toFloor, int count);
+    void onRequestCompleted(int fromFloor, int toFloor, int count);
+
+private slots:
+    void onSubmitClicked();
+    void onFromFloorChanged(int floor);
+
+private:
+    void setupUI();
+
+    QSpinBox* m_fromFloor;
+    QSpinBox* m_toFloor;
+    QSpinBox* m_count;
+    QPushButton* m_submitButton;
+    QLabel* m_listHeader;
+    QListView* m_requestList;
+
+    int m_floorCount;
+    QVector<FloorRequestModel*> m_models;  // 下标为楼层，0 不用
+
+    static const int MAX_COUNT_PER_REQUEST = 12;
+};
+
+#endif // REQUESTPANEL_H
@@ -3,13 +3,16 @@
 #include <QMessageBox>
 #include <QApplication>
 
-LoginWindow::LoginWindow(QWidget *parent) 
+LoginWindow::LoginWindow(int floorCount, int elevatorCount, bool legacyController, QWidget *parent)
     : QWidget(parent)
     , m_usernameEdit(new QLineEdit(this))
     , m_passwordEdit(new QLineEdit(this))
     , m_loginButton(new QPushButton("登录", this))
     , m_exitButton(new QPushButton("退出", this))
     , m_statusLabel(new QLabel(this))
+    , m_floorCount(floorCount)
+    , m_elevatorCount(elevatorCount)
+    , m_legacyController(legacyController)
 {
     setupUI();
     setupConnections();
@@ -111,7 +114,7 @@ void LoginWindow::onLoginClicked() {
 
     if (validateCredentials(username, password)) {
         // 登录成功，创建并显示主窗口
-        auto mainWindow = new MainWindow();
+        auto mainWindow = new MainWindow(m_floorCount, m_elevatorCount, m_legacyController);
         mainWindow->show();
         this->hide();
     } else {
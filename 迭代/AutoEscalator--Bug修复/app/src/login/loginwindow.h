@@ -12,7 +12,9 @@ class LoginWindow : public QWidget {
     Q_OBJECT
 
 public:
-    explicit LoginWindow(QWidget *parent = nullptr);
+    // 登录成功后按给定楼层数和电梯数打开主窗口
+    explicit LoginWindow(int floorCount, int elevatorCount, bool legacyController = false,
+                         QWidget *parent = nullptr);
     ~LoginWindow() = default;
 
 private slots:
@@ -29,6 +31,10 @@ private:
     QPushButton* m_loginButton;
     QPushButton* m_exitButton;
     QLabel* m_statusLabel;
+
+    int m_floorCount;
+    int m_elevatorCount;
+    bool m_legacyController;
 };
 
 #endif // LOGINWINDOW_H 
\ No newline at end of file
@@ -1,11 +1,54 @@
 #include <QtWidgets/QApplication>
+#include <QCommandLineParser>
+#include <cstdio>
 #include "login/loginwindow.h"
 
+namespace {
+    const int DEFAULT_FLOOR_COUNT = 14;
+    const int DEFAULT_ELEVATOR_COUNT = 4;
+    const int MAX_FLOOR_COUNT = 200;
+    const int MAX_ELEVATOR_COUNT = 32;
+
+    // 解析 [min, max] 范围内的整数选项，未给出时使用默认值
+    bool readCount(const QCommandLineParser& parser, const QCommandLineOption& option,
+                   int defaultValue, int min, int max, int& value) {
+        value = defaultValue;
+        if (!parser.isSet(option)) return true;
+
+        bool ok = false;
+        value = parser.value(option).toInt(&ok);
+        if (!ok || value < min || value > max) {
+            std::fprintf(stderr, "--%s 必须是 %d-%d 之间的整数\n",
+                         qPrintable(option.names().first()), min, max);
+            return false;
+        }
+        return true;
+    }
+}
+
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
-    
-    LoginWindow loginWindow;
+
+    // 用法: elevator_system [--floors N] [--elevators N] [--legacy-controller]
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption floorsOption("floors", "楼层数（默认14）", "N");
+    QCommandLineOption elevatorsOption("elevators", "电梯数（默认4）", "N");
+    QCommandLineOption legacyOption("legacy-controller", "使用界面自带的电梯控制器，而不是共享的模拟核心");
+    parser.addOption(floorsOption);
+    parser.addOption(elevatorsOption);
+    parser.addOption(legacyOption);
+    parser.process(app);
+
+    int floorCount = 0;
+    int elevatorCount = 0;
+    if (!readCount(parser, floorsOption, DEFAULT_FLOOR_COUNT, 2, MAX_FLOOR_COUNT, floorCount) ||
+        !readCount(parser, elevatorsOption, DEFAULT_ELEVATOR_COUNT, 1, MAX_ELEVATOR_COUNT, elevatorCount)) {
+        return 1;
+    }
+
+    LoginWindow loginWindow(floorCount, elevatorCount, parser.isSet(legacyOption));
     loginWindow.show();
-    
+
     return app.exec();
-}
\ No newline at end of file
+}
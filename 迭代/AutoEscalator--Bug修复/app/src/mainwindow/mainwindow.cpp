@@ -1,18 +1,21 @@
 #include "mainwindow.h"
 #include <QMessageBox>
+#include <QFileDialog>
 #include <QApplication>
 #include <QScreen>
 #include <QRandomGenerator>
 #include <QDebug>
 #include "../statistics/statisticsdialog.h"
+#include "../controller/elevatorcontroller.h"
+#include "../controller/enginecontroller.h"
 
-MainWindow::MainWindow(QWidget *parent)
+MainWindow::MainWindow(int floorCount, int elevatorCount, bool legacyController, QWidget *parent)
     : QMainWindow(parent)
     , m_centralWidget(new QWidget(this))
     , m_mainLayout(new QHBoxLayout(m_centralWidget))
     , m_controlLayout(new QVBoxLayout())
-    , m_floorDisplayArea(new QWidget(this))
-    , m_elevatorDisplayArea(new QWidget(this))
+    , m_requestPanel(nullptr)
+    , m_buildingCanvas(nullptr)
     , m_startButton(new QPushButton("开始", this))
     , m_resetButton(new QPushButton("重置", this))
     , m_rushHourLabel(new QLabel(this))
@@ -21,6 +24,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_isRunning(false)
     , m_simulationTime(0)
     , m_simulationTimer(new QTimer(this))
+    , m_floorCount(floorCount)
+    , m_elevatorCount(elevatorCount)
     , m_dayDuration(240)
     , m_floorTravelTime(5)
     , m_maxPassengers(12)
@@ -33,11 +38,16 @@ MainWindow::MainWindow(QWidget *parent)
     setupUI();
     setupMenuBar();
     setupControlPanel();
-    setupFloorDisplay();
-    setupElevatorDisplay();  // 先创建电梯
+    setupRequestPanel();
+    setupElevatorDisplay();
     
-    // 创建电梯控制器（在电梯创建之后）
-    m_elevatorController = new ElevatorController(m_elevatorWidgets, this);
+    // 创建模拟后端，状态通过信号推送给画布
+    if (legacyController) {
+        m_elevatorController = new ElevatorController(m_elevatorCount, m_floorCount, this);
+    } else {
+        m_elevatorController = new EngineController(m_elevatorCount, m_floorCount, this);
+    }
+    m_statisticsDialog = new StatisticsDialog(m_floorCount, this);
     
     setupConnections();
     
@@ -77,6 +87,10 @@ void MainWindow::setupMenuBar() {
     QMenu* userMenu = menuBar->addMenu("用户");
     QAction* logoutAction = userMenu->addAction("注销");
     connect(logoutAction, &QAction::triggered, this, &MainWindow::onLogoutTriggered);
+
+    QMenu* debugMenu = menuBar->addMenu("调试");
+    QAction* dumpTraceAction = debugMenu->addAction("导出运行轨迹...");
+    connect(dumpTraceAction, &QAction::triggered, this, &MainWindow::onDumpTraceTriggered);
 }
 
 void MainWindow::setupControlPanel() {
@@ -173,49 +187,36 @@ void MainWindow::setupConnections() {
     // 设置模拟计时器，只使用一个定时器
     connect(m_simulationTimer, &QTimer::timeout, this, &MainWindow::updateSimulation);
     connect(m_simulationTimer, &QTimer::timeout, this, &MainWindow::checkRushHour);
-    connect(m_simulationTimer, &QTimer::timeout, m_elevatorController, &ElevatorController::update);
+    connect(m_simulationTimer, &QTimer::timeout, m_elevatorController, &SimulationBackend::update);
     
     // 移除 m_passengerGenerator 相关的连接
     // connect(m_passengerGenerator, &QTimer::timeout, this, &MainWindow::checkRushHour);
     
+    // 电梯与呼梯状态绘制
+    connect(m_elevatorController, &SimulationBackend::elevatorUpdated,
+            m_buildingCanvas, &BuildingCanvas::onElevatorUpdated);
+    connect(m_elevatorController, &SimulationBackend::hallCallChanged,
+            m_buildingCanvas, &BuildingCanvas::onHallCallChanged);
+    
     // 统计信号连接
-    connect(m_elevatorController, &ElevatorController::statisticsUpdated,
-        [this](int floor, int count) {
-            if (m_statisticsDialog) {
-                QMap<int, int> stats;
-                stats[floor] = count;
-                m_statisticsDialog->updateStatistics(stats);
-            }
-        });
+    // 对话框常驻但隐藏时只累计数据，不刷新图表
+    connect(m_elevatorController, &SimulationBackend::statisticsUpdated,
+            m_statisticsDialog, &StatisticsDialog::updateStatistics);
     
-    // 添加楼层请求完成的信号连接
-    connect(m_elevatorController, &ElevatorController::floorRequestCompleted,
-        [this](int floor, int targetFloor, int count) {
-            // 更新起始楼层和目标楼层的状态
-            for (auto floorWidget : m_floorWidgets) {
-                if (floorWidget->getFloorNumber() == floor) {
-                    floorWidget->updatePassengerRequest(targetFloor, -count);
-                }
-            }
-        });
-
-    // 连接楼层请求信号
-    for (int i = 1; i <= 14; ++i) {
-        FloorWidget* floor = m_floorWidgets[i - 1];
-        
-        // 连接控制器的信号到楼层控件
-        connect(m_elevatorController, &ElevatorController::floorRequestAdded,
-                floor, &FloorWidget::onRequestAdded);
-        
-        connect(m_elevatorController, &ElevatorController::floorRequestCompleted,
-                floor, &FloorWidget::updatePassengerRequest);
-        
-        // 连接楼层的请求信号到控制器
-        connect(floor, &FloorWidget::requestAdded,
-                [this](int currentFloor, int targetFloor, int count) {
-                    m_elevatorController->addRequest(currentFloor, targetFloor, count);
-                });
-    }
+    // 请求输入：面板提交一次，列表随控制器的增删通知更新
+    connect(m_requestPanel, &RequestPanel::requestSubmitted,
+            m_elevatorController, &SimulationBackend::addRequest);
+    connect(m_elevatorController, &SimulationBackend::floorRequestAdded,
+            m_requestPanel, &RequestPanel::onRequestAdded);
+    connect(m_elevatorController, &SimulationBackend::floorRequestCompleted,
+            m_requestPanel, &RequestPanel::onRequestCompleted);
+
+    // 点击画布上的楼层即选为出发楼层，画布高亮面板当前楼层
+    connect(m_buildingCanvas, &BuildingCanvas::floorClicked,
+            m_requestPanel, &RequestPanel::setCurrentFloor);
+    connect(m_requestPanel, &RequestPanel::currentFloorChanged,
+            m_buildingCanvas, &BuildingCanvas::setSelectedFloor);
+    m_buildingCanvas->setSelectedFloor(m_requestPanel->currentFloor());
 }
 
 void MainWindow::onStartClicked() {
@@ -236,13 +237,12 @@ void MainWindow::onResetClicked() {
     // 停止计时器
     m_simulationTimer->stop();
     
-    // 重置电梯控制器
+    // 重置电梯控制器和画布
+    m_buildingCanvas->reset();
     m_elevatorController->reset();
     
-    // 重置所有楼层状态
-    for (auto floorWidget : m_floorWidgets) {
-        floorWidget->clearPassengerRequests();
-    }
+    // 清空请求列表
+    m_requestPanel->clear();
     
     // 重置时间和标签
     m_simulationTime = 0;
@@ -306,6 +306,16 @@ void MainWindow::onLogoutTriggered() {
     emit QApplication::instance()->quit();  // 重新启动应用
 }
 
+void MainWindow::onDumpTraceTriggered() {
+    QString fileName = QFileDialog::getSaveFileName(this, "导出运行轨迹",
+        "elevator_trace.bin", "运行轨迹 (*.bin)");
+    if (fileName.isEmpty()) return;
+
+    if (!m_elevatorController->dumpTrace(fileName)) {
+        QMessageBox::warning(this, "导出失败", QString("无法写入文件：%1").arg(fileName));
+    }
+}
+
 void MainWindow::updateSimulation() {
     if (!m_isRunning) return;
     
@@ -320,9 +330,6 @@ void MainWindow::updateSimulation() {
     // 检查是否到达一天结束
     if (m_simulationTime >= m_dayDuration) {
         // 显示统计图表
-        if (!m_statisticsDialog) {
-            m_statisticsDialog = new StatisticsDialog(this);
-        }
         m_statisticsDialog->exec();
         
         // 重置系统
@@ -380,82 +387,22 @@ void MainWindow::createRushHourPassengers(bool isGroundFloor, const QString& typ
     m_elevatorController->addRushHourRequests(isGroundFloor, type);
 }
 
-void MainWindow::setupFloorDisplay() {
-    // 创建楼层显示区域的布局
-    auto floorLayout = new QVBoxLayout(m_floorDisplayArea);
-    floorLayout->setSpacing(5);
-    floorLayout->setContentsMargins(10, 10, 10, 10);
-
-    // 从上到下创建14层楼的显示（14楼到1楼）
-    for (int i = 14; i >= 1; --i) {
-        auto floorWidget = new FloorWidget(i, this);
-        
-        // 连接乘客请求信号
-        connect(floorWidget, &FloorWidget::requestAdded, 
-            [this](int currentFloor, int targetFloor, int count) {
-                m_elevatorController->addRequest(currentFloor, targetFloor, count);
-            });
-        
-        m_floorWidgets.push_back(floorWidget);
-        floorLayout->addWidget(floorWidget);
-    }
-
-    // 设置楼层显示区域的样式
-    m_floorDisplayArea->setStyleSheet(R"(
-        QWidget {
-            background-color: white;
-            border: 1px solid #ccc;
-            border-radius: 5px;
-        }
-    )");
+void MainWindow::setupRequestPanel() {
+    // 所有楼层共用一个请求输入面板，等待队列由画布绘制
+    m_requestPanel = new RequestPanel(m_floorCount, this);
+    m_requestPanel->setFixedWidth(170);
 
-    // 设置固定宽度，但高度可以自适应
-    m_floorDisplayArea->setFixedWidth(200);  // 原来是300，调整为200
-    
     // 添加到主布局
-    m_mainLayout->addWidget(m_floorDisplayArea);
+    m_mainLayout->addWidget(m_requestPanel);
 }
 
 void MainWindow::setupElevatorDisplay() {
-    // 创建电梯显示区域的布局
-    auto elevatorLayout = new QHBoxLayout(m_elevatorDisplayArea);
-    elevatorLayout->setSpacing(10);
-    elevatorLayout->setContentsMargins(10, 10, 10, 10);
-
-    // 创建4部电梯
-    for (int i = 0; i < 4; ++i) {
-        auto elevatorWidget = new ElevatorWidget(i + 1, this);
-        m_elevatorWidgets.push_back(elevatorWidget);  // 先添加到数组中
-        elevatorLayout->addWidget(elevatorWidget);
-        
-        // 连接电梯状态变化信号
-        connect(elevatorWidget, &ElevatorWidget::floorChanged,
-            [this](int elevatorId, int floor) {
-                qDebug() << "Elevator" << elevatorId << "moved to floor" << floor;
-            });
-        
-        connect(elevatorWidget, &ElevatorWidget::directionChanged,
-            [this](int elevatorId, Direction direction) {
-                qDebug() << "Elevator" << elevatorId << "changed direction";
-            });
-        
-        connect(elevatorWidget, &ElevatorWidget::passengerCountChanged,
-            [this](int elevatorId, int count) {
-                qDebug() << "Elevator" << elevatorId << "passenger count:" << count;
-            });
-    }
-
-    // 设置电梯显示区域的样式
-    m_elevatorDisplayArea->setStyleSheet(R"(
-        QWidget {
-            background-color: white;
-            border: 1px solid #ccc;
-            border-radius: 5px;
-        }
-    )");
+    // 整栋楼由一个画布绘制，不再为每部电梯、每层楼创建子控件
+    m_buildingCanvas = new BuildingCanvas(m_floorCount, m_elevatorCount, this);
+    m_buildingCanvas->setFloorTransitionTime(1000);  // 与模拟计时器周期一致
 
     // 添加到主布局
-    m_mainLayout->addWidget(m_elevatorDisplayArea);
+    m_mainLayout->addWidget(m_buildingCanvas, 1);
 }
 
 QString MainWindow::formatSimulationTime(int seconds) const {
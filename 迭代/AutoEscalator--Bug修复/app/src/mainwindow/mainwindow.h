@@ -11,9 +11,9 @@
 #include <QMenuBar>
 #include <QVector>
 #include <QTimer>
-#include "../floor/floorwidget.h"  // 添加FloorWidget头文件
-#include "../elevator/elevatorwidget.h"  // 改为包含而不是前向声明
-#include "../controller/elevatorcontroller.h"  // 添加这行
+#include "../floor/requestpanel.h"
+#include "../canvas/buildingcanvas.h"
+#include "../controller/simulationbackend.h"
 #include "../settings/settingsdialog.h"  // 改为包含而不是前向声明
 #include "../statistics/statisticsdialog.h"
 
@@ -21,7 +21,9 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    explicit MainWindow(QWidget *parent = nullptr);
+    // legacyController 为 true 时使用界面自带的 ElevatorController，否则由 elevator_core 的 SimulationEngine 驱动
+    explicit MainWindow(int floorCount, int elevatorCount, bool legacyController = false,
+                        QWidget *parent = nullptr);
     ~MainWindow();
 
 private slots:
@@ -29,6 +31,7 @@ private slots:
     void onResetClicked();
     void onSettingsTriggered();
     void onLogoutTriggered();
+    void onDumpTraceTriggered();  // 导出控制器运行轨迹
     void updateSimulation();  // 更新模拟状态
     void checkRushHour();    // 检查高峰时段
 
@@ -36,7 +39,7 @@ private:
     void setupUI();
     void setupMenuBar();
     void setupControlPanel();
-    void setupFloorDisplay();
+    void setupRequestPanel();
     void setupElevatorDisplay();
     void setupConnections();
     void createRushHourPassengers(bool isGroundFloor, const QString& type);
@@ -45,17 +48,14 @@ private:
     QWidget* m_centralWidget;
     QHBoxLayout* m_mainLayout;
     QVBoxLayout* m_controlLayout;
-    QWidget* m_floorDisplayArea;
-    QWidget* m_elevatorDisplayArea;
+    RequestPanel* m_requestPanel;      // 全楼共用的请求输入面板
+    BuildingCanvas* m_buildingCanvas;  // 井道、轿厢与呼梯状态的绘制画布
     
     QPushButton* m_startButton;
     QPushButton* m_resetButton;
     QLabel* m_rushHourLabel;
     QLabel* m_timeLabel;  // 添加时间显示标签
     
-    QVector<FloorWidget*> m_floorWidgets;      // 14个楼层显示组件
-    QVector<ElevatorWidget*> m_elevatorWidgets; // 4个电梯显示组件
-    
     SettingsDialog* m_settingsDialog;
     StatisticsDialog* m_statisticsDialog;
     
@@ -66,6 +66,8 @@ private:
     QTimer* m_passengerGenerator;
     
     // 配置参数
+    int m_floorCount;         // 楼层数
+    int m_elevatorCount;      // 电梯数
     int m_dayDuration;        // 一天的持续时间（秒）
     int m_floorTravelTime;    // 电梯经过一层的时间（秒）
     int m_maxPassengers;      // 电梯最大载客数
@@ -74,8 +76,8 @@ private:
     int m_randomPassengerCount; // 随机乘客生成个数
     int m_peakPassengerCount;   // 高峰期乘客个数
     
-    // 添加电梯控制器
-    ElevatorController* m_elevatorController;
+    // 模拟后端
+    SimulationBackend* m_elevatorController;
     
     // 添加辅助函数
     QString formatSimulationTime(int seconds) const;
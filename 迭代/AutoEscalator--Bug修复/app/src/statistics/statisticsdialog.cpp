@@ -2,15 +2,23 @@
 #include <QApplication>
 #include <QScreen>
 
-StatisticsDialog::StatisticsDialog(QWidget *parent)
+StatisticsDialog::StatisticsDialog(int floorCount, QWidget *parent)
     : QDialog(parent)
     , m_chartView(new QChartView(this))
     , m_closeButton(new QPushButton("关闭", this))
     , m_chart(new QChart())
     , m_barSeries(new QBarSeries())
+    , m_barSet(nullptr)
     , m_axisX(new QBarCategoryAxis())
     , m_axisY(new QValueAxis())
+    , m_axisMax(100)
+    , m_floorCount(floorCount)
+    , m_refreshTimer(new QTimer(this))
 {
+    m_refreshTimer->setSingleShot(true);
+    connect(m_refreshTimer, &QTimer::timeout, this, &StatisticsDialog::updateChart);
+    m_lastRefresh.start();
+
     setupUI();
     setupChart();
     setWindowTitle("楼层使用统计");
@@ -44,7 +52,7 @@ void StatisticsDialog::setupChart() {
 
     // 设置X轴（楼层）
     QStringList categories;
-    for (int i = 1; i <= 14; ++i) {
+    for (int i = 1; i <= m_floorCount; ++i) {
         categories << QString::number(i) + "楼";
     }
     m_axisX->append(categories);
@@ -53,14 +61,15 @@ void StatisticsDialog::setupChart() {
     // 设置Y轴（使用次数）
     m_axisY->setTitleText("使用次数");
     m_axisY->setLabelFormat("%d");
+    m_axisY->setRange(0, m_axisMax);
     m_chart->addAxis(m_axisY, Qt::AlignLeft);
 
-    // 设置柱状图系列
-    QBarSet* initialSet = new QBarSet("乘客数量");
-    for (int i = 0; i < 14; ++i) {
-        initialSet->append(0);
+    // 设置柱状图系列，数据集创建一次后只做原地更新
+    m_barSet = new QBarSet("乘客数量");
+    for (int i = 0; i < m_floorCount; ++i) {
+        m_barSet->append(0);
     }
-    m_barSeries->append(initialSet);
+    m_barSeries->append(m_barSet);
     
     m_chart->addSeries(m_barSeries);
     m_barSeries->attachAxis(m_axisX);
@@ -78,38 +87,55 @@ void StatisticsDialog::setupChart() {
 }
 
 void StatisticsDialog::updateStatistics(const QMap<int, int>& stats) {
-    // 更新楼层使用统计数据
+    // 只记录数据变化，图表刷新交给限频定时器
     for (auto it = stats.begin(); it != stats.end(); ++it) {
         int floor = it.key();
-        int count = it.value();
-        m_floorStats[floor] = count;
+        if (floor < 1 || floor > m_floorCount) continue;
+        if (m_floorStats.value(floor, 0) != it.value()) {
+            m_floorStats[floor] = it.value();
+            m_dirtyFloors.insert(floor);
+        }
     }
     
-    // 更新图表
-    updateChart();
+    scheduleChartUpdate();
 }
 
-void StatisticsDialog::updateChart() {
-    // 清除现有数据
-    m_barSeries->clear();
+void StatisticsDialog::showEvent(QShowEvent* event) {
+    QDialog::showEvent(event);
     
-    // 创建数据集
-    QBarSet* barSet = new QBarSet("乘客数量");
-    
-    // 添加每层楼的数据
-    for (int floor = 1; floor <= 14; ++floor) {
-        barSet->append(m_floorStats.value(floor, 0));
+    // 隐藏期间累积的变化在显示时一次性刷新
+    if (!m_dirtyFloors.isEmpty()) {
+        m_refreshTimer->stop();
+        updateChart();
+    }
+}
+
+void StatisticsDialog::scheduleChartUpdate() {
+    // 对话框不可见时不刷新图表；已排队的刷新会一并带上新的变化
+    if (m_dirtyFloors.isEmpty() || !isVisible() || m_refreshTimer->isActive()) {
+        return;
     }
     
-    // 设置柱状图数据
-    m_barSeries->append(barSet);
-    
-    // 更新坐标轴范围
+    qint64 elapsed = m_lastRefresh.elapsed();
+    m_refreshTimer->start(elapsed >= MIN_REFRESH_INTERVAL ? 0 : int(MIN_REFRESH_INTERVAL - elapsed));
+}
+
+void StatisticsDialog::updateChart() {
+    // 原地更新发生变化的柱子，不重建数据集和坐标轴
     int maxValue = 0;
-    for (int value : m_floorStats) {
+    for (int floor : m_dirtyFloors) {
+        int value = m_floorStats.value(floor, 0);
+        m_barSet->replace(floor - 1, value);
         maxValue = qMax(maxValue, value);
     }
-    m_axisY->setRange(0, maxValue + 10);  // 留出一些余量
+    m_dirtyFloors.clear();
+    m_lastRefresh.restart();
+    
+    // 只在数据超出当前范围时扩大坐标轴，并预留余量减少轴重排
+    if (maxValue + 10 > m_axisMax) {
+        m_axisMax = maxValue + qMax(10, maxValue / 4);
+        m_axisY->setRange(0, m_axisMax);
+    }
     
     // 更新图表标题
     m_chart->setTitle(QString("楼层使用统计 (总乘客: %1人)").arg(calculateTotalPassengers()));
@@ -118,18 +144,16 @@ void StatisticsDialog::updateChart() {
 void StatisticsDialog::clearStatistics() {
     // 清空统计数据
     m_floorStats.clear();
+    m_dirtyFloors.clear();
+    m_refreshTimer->stop();
     
-    // 重置图表
-    m_barSeries->clear();
-    m_axisY->setRange(0, 100);  // 重置坐标轴范围
-    m_chart->setTitle("楼层使用统计");
-    
-    // 添加空数据以保持图表结构
-    QBarSet* emptySet = new QBarSet("乘客数量");
-    for (int i = 0; i < 14; ++i) {
-        emptySet->append(0);
+    // 重置图表数据（保持数据集结构）
+    for (int i = 0; i < m_floorCount; ++i) {
+        m_barSet->replace(i, 0);
     }
-    m_barSeries->append(emptySet);
+    m_axisMax = 100;
+    m_axisY->setRange(0, m_axisMax);  // 重置坐标轴范围
+    m_chart->setTitle("楼层使用统计");
 }
 
 int StatisticsDialog::calculateTotalPassengers() const {
@@ -4,6 +4,9 @@
 #include <QDialog>
 #include <QVBoxLayout>
 #include <QPushButton>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSet>
 #include <QtCharts>
 
 QT_CHARTS_USE_NAMESPACE
@@ -12,15 +15,19 @@ class StatisticsDialog : public QDialog {
     Q_OBJECT
 
 public:
-    explicit StatisticsDialog(QWidget *parent = nullptr);
+    explicit StatisticsDialog(int floorCount, QWidget *parent = nullptr);
     
-    // 更新统计数据
+    // 更新统计数据（只记录变化，图表按限频节奏刷新）
     void updateStatistics(const QMap<int, int>& stats);
     void clearStatistics();
 
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private:
     void setupUI();
     void setupChart();
+    void scheduleChartUpdate();
     void updateChart();
     int calculateTotalPassengers() const;  // 新增：计算总乘客数
 
@@ -32,11 +39,20 @@ private:
     // 图表组件
     QChart* m_chart;
     QBarSeries* m_barSeries;
+    QBarSet* m_barSet;           // 常驻数据集，按楼层原地更新
     QBarCategoryAxis* m_axisX;
     QValueAxis* m_axisY;
     
     // 数据存储
     QMap<int, int> m_floorStats;  // 楼层 -> 乘客数量
+    QSet<int> m_dirtyFloors;      // 尚未反映到图表的楼层
+    int m_axisMax;                // 当前Y轴上限，只在数据超出时扩大
+    int m_floorCount;             // 楼层数，决定柱子和X轴分类的个数
+
+    // 刷新限频
+    QTimer* m_refreshTimer;
+    QElapsedTimer m_lastRefresh;
+    static const int MIN_REFRESH_INTERVAL = 250;  // 图表两次刷新的最小间隔（毫秒）
 };
 
 #endif // STATISTICSDIALOG_H 
\ No newline at end of file
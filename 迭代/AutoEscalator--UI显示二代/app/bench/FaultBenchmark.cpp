@@ -0,0 +1,159 @@
+// 步进模式故障基准：电梯按平均故障间隔（MTBF）随机故障、按修复时间恢复，
+// 先检查单个行程在接客前和载客途中遇到故障时能否由其他电梯送达，
+// 再在高峰客流下运行，输出故障次数和行程完成情况（同样的参数和种子结果一致）
+//
+// 用法: elevator_fault_benchmark [--hours N] [--dt 秒] [--seed N] [--cars N] [--floors N]
+//                               [--mtbf 秒] [--repair 秒]
+#include "core/ElevatorDispatcher.h"
+#include "core/PassengerManager.h"
+#include <QObject>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    struct Options {
+        double hours = 4.0;
+        double deltaTime = 0.1;
+        quint32 seed = 42;
+        int cars = 4;
+        int floors = 20;
+        double mtbf = 3600.0;
+        double repair = 300.0;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--hours") == 0) options.hours = std::atof(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--cars") == 0) options.cars = std::atoi(value);
+            else if (std::strcmp(arg, "--floors") == 0) options.floors = std::atoi(value);
+            else if (std::strcmp(arg, "--mtbf") == 0) options.mtbf = std::atof(value);
+            else if (std::strcmp(arg, "--repair") == 0) options.repair = std::atof(value);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.hours > 0 && options.deltaTime > 0 && options.cars > 0 && options.floors > 1 &&
+               options.mtbf >= 0 && options.repair >= 0;
+    }
+
+    // 两台电梯、一个 5->15 的行程，承运的电梯在接客前或载客途中故障，
+    // 返回行程是否由另一台电梯送达
+    bool checkReassignment(bool boardFirst) {
+        ElevatorDispatcher dispatcher;
+        dispatcher.setStepMode(true);
+        Elevator first, second;
+        first.setConfig({1, 20});
+        second.setConfig({1, 20});
+        dispatcher.addElevator(&first);
+        dispatcher.addElevator(&second);
+
+        dispatcher.dispatchTrip(5, 15);
+        Elevator* car = first.getState() != Elevator::State::IDLE ? &first : &second;
+        Elevator* other = car == &first ? &second : &first;
+        if (boardFirst) {
+            // 走到5楼接客后，在去15楼的途中故障
+            for (int i = 0; i < 200 && car->getCurrentFloor() < 9; ++i) {
+                dispatcher.advance(0.1);
+            }
+        } else {
+            dispatcher.advance(1.0);
+        }
+        int faultFloor = car->getCurrentFloor();
+        car->simulateMalfunction();
+        for (int i = 0; i < 600; ++i) {
+            dispatcher.advance(0.1);
+        }
+
+        const auto trips = dispatcher.getTripMetrics();
+        bool delivered = trips.completed == 1 && other->getCurrentFloor() == 15 &&
+                         car->getCurrentFloor() == faultFloor;
+        std::cout << (boardFirst ? "载客途中故障" : "接客前故障  ") << ": 故障楼层 " << faultFloor
+                  << "  另一台电梯停在 " << other->getCurrentFloor() << "  送达 " << trips.completed
+                  << "/" << trips.started << "  改派送达: " << (delivered ? "是" : "否") << std::endl;
+        return delivered;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_fault_benchmark [--hours N] [--dt 秒] [--seed N] "
+                     "[--cars N] [--floors N] [--mtbf 秒] [--repair 秒]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "=== 步进模式故障基准 ===" << std::endl;
+    bool reassigned = checkReassignment(false);
+    reassigned = checkReassignment(true) && reassigned;
+
+    ElevatorDispatcher dispatcher;
+    dispatcher.setStepMode(true);
+    PassengerManager passengerManager(&dispatcher);
+    passengerManager.setStepMode(true);
+    passengerManager.setRandomSeed(options.seed);
+
+    std::vector<std::unique_ptr<Elevator>> elevators;
+    long long faults = 0, repairs = 0;
+    for (int i = 0; i < options.cars; ++i) {
+        auto elevator = std::make_unique<Elevator>();
+        Elevator::Config config{1, options.floors};
+        config.mtbf = options.mtbf;
+        config.repairTime = options.repair;
+        elevator->setConfig(config);
+        elevator->setFaultSeed(options.seed + 1 + i);
+        QObject::connect(elevator.get(), &Elevator::malfunctionOccurred, [&faults]() { ++faults; });
+        QObject::connect(elevator.get(), &Elevator::repaired, [&repairs]() { ++repairs; });
+        dispatcher.addElevator(elevator.get());
+        elevators.push_back(std::move(elevator));
+    }
+
+    // 与步进模式基准相同的早高峰客流
+    for (int floor = 1; floor <= options.floors; ++floor) {
+        int workers = (floor == 1) ? 3 : 0;
+        int elderly = (floor <= 3) ? 1 : 0;
+        passengerManager.setFloorPopulation(floor, workers, elderly);
+    }
+    passengerManager.startPeakHourSimulation();
+
+    double duration = options.hours * 3600.0;
+    double faultySeconds = 0.0;
+    for (double t = 0.0; t < duration; t += options.deltaTime) {
+        passengerManager.advance(options.deltaTime);
+        dispatcher.advance(options.deltaTime);
+        for (const auto& elevator : elevators) {
+            if (elevator->getState() == Elevator::State::MALFUNCTION) {
+                faultySeconds += options.deltaTime;
+            }
+        }
+    }
+
+    const auto trips = dispatcher.getTripMetrics();
+    const auto queue = dispatcher.getQueueMetrics();
+    std::cout << "电梯: " << options.cars << "  楼层: " << options.floors << "  模拟: " << options.hours
+              << " h  MTBF: " << options.mtbf << " s  修复: " << options.repair << " s  种子: "
+              << options.seed << std::endl;
+    std::cout << "故障/修复: " << faults << " / " << repairs << "  故障停运占比: "
+              << std::setprecision(2) << 100.0 * faultySeconds / (duration * options.cars) << "%"
+              << std::setprecision(1) << std::endl;
+    std::cout << "行程: 发出 " << trips.started << "  送达 " << trips.completed
+              << "  平均 " << trips.averageTripTime << " s  最长 " << trips.maxTripTime << " s" << std::endl;
+    std::cout << "排队中: " << queue.depth << "  最大队列: " << queue.maxDepth
+              << "  最老请求: " << queue.oldestAge << " s" << std::endl;
+    return reassigned ? 0 : 1;
+}
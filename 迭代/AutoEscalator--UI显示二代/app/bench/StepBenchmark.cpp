@@ -0,0 +1,117 @@
+// 步进模式基准：不创建 QApplication、不启动定时器，以固定步长推进调度核心，
+// 输出吞吐量和一次运行的校验值（同样的参数和种子校验值应当一致）
+//
+// 用法: elevator_step_benchmark [--hours N] [--dt 秒] [--seed N] [--cars N] [--floors N]
+#include "core/ElevatorDispatcher.h"
+#include "core/PassengerManager.h"
+#include <QObject>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    struct Options {
+        double hours = 1.0;
+        double deltaTime = 0.1;
+        quint32 seed = 42;
+        int cars = 4;
+        int floors = 20;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--hours") == 0) options.hours = std::atof(value);
+            else if (std::strcmp(arg, "--dt") == 0) options.deltaTime = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--cars") == 0) options.cars = std::atoi(value);
+            else if (std::strcmp(arg, "--floors") == 0) options.floors = std::atoi(value);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.hours > 0 && options.deltaTime > 0 && options.cars > 0 && options.floors > 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_step_benchmark [--hours N] [--dt 秒] [--seed N] "
+                     "[--cars N] [--floors N]" << std::endl;
+        return 1;
+    }
+
+    ElevatorDispatcher dispatcher;
+    dispatcher.setStepMode(true);
+    PassengerManager passengerManager(&dispatcher);
+    passengerManager.setStepMode(true);
+    passengerManager.setRandomSeed(options.seed);
+
+    std::vector<std::unique_ptr<Elevator>> elevators;
+    long long moves = 0, stops = 0;
+    for (int i = 0; i < options.cars; ++i) {
+        auto elevator = std::make_unique<Elevator>();
+        elevator->setConfig({1, options.floors});
+        QObject::connect(elevator.get(), &Elevator::floorChanged, [&moves](int) { ++moves; });
+        QObject::connect(elevator.get(), &Elevator::doorOpened, [&stops]() { ++stops; });
+        dispatcher.addElevator(elevator.get());
+        elevators.push_back(std::move(elevator));
+    }
+
+    // 上班族集中在1楼，低楼层住着部分老年人，其余楼层只作为目的地
+    for (int floor = 1; floor <= options.floors; ++floor) {
+        int workers = (floor == 1) ? 3 : 0;
+        int elderly = (floor <= 3) ? 1 : 0;
+        passengerManager.setFloorPopulation(floor, workers, elderly);
+    }
+    passengerManager.startPeakHourSimulation();
+
+    long long steps = 0;
+    unsigned long long checksum = 1469598103934665603ULL;  // FNV-1a
+    double duration = options.hours * 3600.0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (double t = 0.0; t < duration; t += options.deltaTime) {
+        passengerManager.advance(options.deltaTime);
+        dispatcher.advance(options.deltaTime);
+        for (const auto& elevator : elevators) {
+            checksum = (checksum ^ static_cast<unsigned>(elevator->getCurrentFloor())) * 1099511628211ULL;
+        }
+        ++steps;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== 步进模式基准 ===" << std::endl;
+    std::cout << "电梯: " << options.cars << "  楼层: " << options.floors
+              << "  模拟: " << options.hours << " h  步长: " << options.deltaTime
+              << "s  种子: " << options.seed << std::endl;
+    std::cout << "总步数: " << steps << std::endl;
+    std::cout << "耗时: " << seconds << " s" << std::endl;
+    std::cout << "每步耗时: " << (steps > 0 ? seconds * 1e6 / steps : 0.0) << " us" << std::endl;
+    std::cout << "加速比: " << std::setprecision(0) << (seconds > 0 ? duration / seconds : 0.0)
+              << "x" << std::setprecision(3) << std::endl;
+    std::cout << "运行层数/停靠次数: " << moves << " / " << stops << std::endl;
+    const auto queue = dispatcher.getQueueMetrics();
+    std::cout << "已分配请求: " << queue.dispatched << "  排队中: " << queue.depth
+              << "  最大队列: " << queue.maxDepth << "  重试: " << queue.retries << std::endl;
+    std::cout << "平均排队时间: " << queue.averageQueueTime
+              << " s  最老请求: " << queue.oldestAge << " s" << std::endl;
+    std::cout << "校验值: " << std::hex << checksum << std::dec << std::endl;
+    return 0;
+}
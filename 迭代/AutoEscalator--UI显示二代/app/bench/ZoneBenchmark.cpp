@@ -0,0 +1,161 @@
+// 分区基准：同一座60层大楼、同样的客流，比较不分区和分区（穿梭电梯 + 各区本地电梯）
+// 两种布局下的行程时间。以步进模式运行，不需要 QApplication。
+//
+// 用法: elevator_zone_benchmark [--minutes N] [--rate 人每分钟] [--seed N]
+//                               [--cars N] [--zones N] [--express N]
+#include "core/ElevatorDispatcher.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int FLOOR_COUNT = 60;
+    constexpr double STEP = 0.1;
+    constexpr double DRAIN_LIMIT = 3600.0;  // 停止产生客流后最多再运行的时间（秒）
+
+    struct Options {
+        double minutes = 60.0;
+        double ratePerMinute = 60.0;
+        unsigned int seed = 42;
+        int cars = 12;
+        int zones = 3;
+        int express = 3;
+    };
+
+    struct Result {
+        ElevatorDispatcher::TripMetrics trips;
+        HallCallScheduler::Metrics queue;
+        double simulated;
+        double seconds;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "缺少参数值: " << arg << std::endl;
+                return false;
+            }
+
+            if (std::strcmp(arg, "--minutes") == 0) options.minutes = std::atof(value);
+            else if (std::strcmp(arg, "--rate") == 0) options.ratePerMinute = std::atof(value);
+            else if (std::strcmp(arg, "--seed") == 0) options.seed = std::strtoul(value, nullptr, 10);
+            else if (std::strcmp(arg, "--cars") == 0) options.cars = std::atoi(value);
+            else if (std::strcmp(arg, "--zones") == 0) options.zones = std::atoi(value);
+            else if (std::strcmp(arg, "--express") == 0) options.express = std::atoi(value);
+            else {
+                std::cerr << "未知参数: " << arg << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        return options.minutes > 0 && options.ratePerMinute > 0 && options.zones > 1 &&
+               options.express > 0 && options.cars >= options.express + options.zones;
+    }
+
+    // 上行高峰为主的客流：70% 从1楼出发，15% 回到1楼，15% 层间
+    void nextTrip(std::mt19937& engine, int& fromFloor, int& toFloor) {
+        std::uniform_real_distribution<double> kind(0.0, 1.0);
+        std::uniform_int_distribution<int> upper(2, FLOOR_COUNT);
+        double k = kind(engine);
+        if (k < 0.70) {
+            fromFloor = 1;
+            toFloor = upper(engine);
+        } else if (k < 0.85) {
+            fromFloor = upper(engine);
+            toFloor = 1;
+        } else {
+            fromFloor = upper(engine);
+            do {
+                toFloor = upper(engine);
+            } while (toFloor == fromFloor);
+        }
+    }
+
+    Result run(const Options& options, bool zoned) {
+        ElevatorDispatcher dispatcher;
+        dispatcher.setStepMode(true);
+
+        std::vector<std::unique_ptr<Elevator>> elevators;
+        for (int i = 0; i < options.cars; ++i) {
+            auto elevator = std::make_unique<Elevator>();
+            elevator->setConfig({1, FLOOR_COUNT});
+            dispatcher.addElevator(elevator.get());
+            elevators.push_back(std::move(elevator));
+        }
+
+        if (zoned) {
+            // 本地电梯平均分给各分区，余数给高区
+            std::vector<int> carsPerZone(options.zones, (options.cars - options.express) / options.zones);
+            for (int i = 0; i < (options.cars - options.express) % options.zones; ++i) {
+                ++carsPerZone[options.zones - 1 - i];
+            }
+            dispatcher.configureZonedBank(ZoneLayout::evenZones(1, FLOOR_COUNT, options.zones),
+                                          options.express, carsPerZone);
+        }
+
+        // 两种布局使用同一个种子，客流完全相同
+        std::mt19937 engine(options.seed);
+        std::exponential_distribution<double> interval(options.ratePerMinute / 60.0);
+        double duration = options.minutes * 60.0;
+        double nextArrival = interval(engine);
+
+        auto begin = std::chrono::steady_clock::now();
+        double t = 0.0;
+        while (t < duration + DRAIN_LIMIT) {
+            while (nextArrival <= t && nextArrival < duration) {
+                int fromFloor, toFloor;
+                nextTrip(engine, fromFloor, toFloor);
+                dispatcher.dispatchTrip(fromFloor, toFloor);
+                nextArrival += interval(engine);
+            }
+            dispatcher.advance(STEP);
+            t += STEP;
+
+            auto trips = dispatcher.getTripMetrics();
+            if (t >= duration && trips.completed == trips.started) {
+                break;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        return {dispatcher.getTripMetrics(), dispatcher.getQueueMetrics(), t,
+                std::chrono::duration<double>(end - begin).count()};
+    }
+
+    void printResult(const char* name, const Result& result) {
+        std::cout << "--- " << name << " ---" << std::endl;
+        std::cout << "行程 发出/完成: " << result.trips.started << " / " << result.trips.completed
+                  << "  换乘: " << result.trips.transfers << std::endl;
+        std::cout << "平均行程时间: " << result.trips.averageTripTime
+                  << " s  最长行程时间: " << result.trips.maxTripTime << " s" << std::endl;
+        std::cout << "平均排队时间: " << result.queue.averageQueueTime
+                  << " s  最大队列: " << result.queue.maxDepth << std::endl;
+        std::cout << "模拟时长: " << result.simulated << " s  耗时: " << result.seconds << " s" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: elevator_zone_benchmark [--minutes N] [--rate 人每分钟] [--seed N] "
+                     "[--cars N] [--zones N] [--express N]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== 分区基准 ===" << std::endl;
+    std::cout << "楼层: " << FLOOR_COUNT << "  电梯: " << options.cars << "  分区: " << options.zones
+              << "  穿梭电梯: " << options.express << "  客流: " << options.ratePerMinute
+              << " 人/分钟 × " << options.minutes << " 分钟  种子: " << options.seed << std::endl;
+
+    printResult("不分区", run(options, false));
+    printResult("分区", run(options, true));
+    return 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <QObject>
 #include <QTimer>
+#include <QRandomGenerator>
 #include <queue>
 #include <vector>
 #include <memory>
@@ -24,6 +25,8 @@ public:
         double doorTime{0.5};    // 默认开关门时间0.5秒
         double floorTime{1.0};   // 默认每层楼运行时间1秒
         int capacity{15};        // 电梯容量
+        double mtbf{0.0};        // 步进模式下的平均故障间隔（秒），0 表示不随机发生故障
+        double repairTime{600.0};  // 故障后恢复运行所需时间（秒），0 表示不自动恢复
     };
 
     explicit Elevator(QObject* parent = nullptr);
@@ -31,9 +34,18 @@ public:
     // 基本操作
     void moveToFloor(int floor);
     void addDestination(int floor);
+    void clearDestinations();
     void openDoor();
     void closeDoor();
     
+    // 步进模式：不使用定时器，运行和开关门只随 advance 推进的模拟时间发生，
+    // 同样的调用序列总是得到同样的结果，也不需要事件循环
+    void setStepMode(bool enabled);
+    bool isStepMode() const { return stepMode; }
+    void advance(double seconds);
+    // 步进模式下按 config.mtbf 抽样故障所用的随机数种子，同样的种子得到同样的故障序列
+    void setFaultSeed(quint32 seed) { faultRng.seed(seed); }
+    
     // 状态查询
     State getState() const { return state; }
     int getCurrentFloor() const { return currentFloor; }
@@ -51,6 +63,7 @@ signals:
     void doorClosed();
     void overloaded();
     void malfunctionOccurred();
+    void repaired();
 
 public slots:
     void handleEmergency();
@@ -70,7 +83,27 @@ private:
     bool isValidFloor(int floor) const;
     void processNextDestination();
     
-    // 定时器用于模拟电梯运行时间
-    QTimer* moveTimer;
-    QTimer* doorTimer;
+    // 运行（每层一次）和开关门的计时，按模式分别交给定时器或模拟时间
+    void onMoveTick();
+    void onDoorTimeout();
+    void startMoveTimer();
+    void stopMoveTimer();
+    void startDoorTimer();
+    void stopDoorTimer();
+    void startRepairTimer();
+    void repair();
+    bool isMoveScheduled() const;
+    bool isDoorScheduled() const;
+    
+    // 实时模式下的定时器，首次使用时创建
+    QTimer* moveTimer{nullptr};
+    QTimer* doorTimer{nullptr};
+    QTimer* repairTimer{nullptr};
+    
+    // 步进模式下距离下次触发的剩余时间（秒），小于0表示未计时
+    bool stepMode{false};
+    double moveRemaining{-1.0};
+    double doorRemaining{-1.0};
+    double repairRemaining{-1.0};
+    QRandomGenerator faultRng{QRandomGenerator::global()->generate()};
 }; 
\ No newline at end of file
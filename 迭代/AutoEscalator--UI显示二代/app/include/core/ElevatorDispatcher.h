@@ -1,10 +1,14 @@
 #pragma once
 #include <vector>
 #include <unordered_map>
-#include <queue>
 #include <memory>
 #include "Elevator.h"
+#include "HallCallScheduler.h"
+#include "HotFloorTracker.h"
+#include "Passenger.h"
+#include "ZoneLayout.h"
 #include <QObject>
+#include <QTimer>
 
 class ElevatorDispatcher : public QObject {
     Q_OBJECT
@@ -14,48 +18,131 @@ public:
         int toFloor;
         bool isEmergency;
         long long timestamp;
-        
-        bool operator<(const Request& other) const {
-            if (isEmergency != other.isEmergency) {
-                return !isEmergency; // 紧急请求优先级更高
-            }
-            return timestamp > other.timestamp;
-        }
     };
 
     explicit ElevatorDispatcher(QObject* parent = nullptr);
     
     // 核心调度方法
     void dispatchRequest(int fromFloor, int toFloor, bool isEmergency = false);
+    void dispatchRequest(int fromFloor, int toFloor, HallCallScheduler::Priority priority);
+    static HallCallScheduler::Priority priorityFor(Passenger::Type type);
+    
+    // 完整行程：设置了分区布局时按布局拆成多段，每段送达后在换乘层自动续派下一段
+    void dispatchTrip(int fromFloor, int toFloor,
+                      HallCallScheduler::Priority priority = HallCallScheduler::Priority::NORMAL);
+    
+    struct TripMetrics {
+        long long started{0};
+        long long completed{0};
+        long long transfers{0};      // 已完成行程中的换乘次数
+        double averageTripTime{0.0}; // 从发出请求到抵达最终目的层（秒）
+        double maxTripTime{0.0};
+    };
+    TripMetrics getTripMetrics() const;
+    
+    // 选梯评分的权重（分数越低越优先），默认值为原先手工设定的数值
+    struct ScoreWeights {
+        int perFloor{1};          // 与请求起点每相距一层
+        int movingAway{50};       // 电梯正驶离请求楼层
+        int unavailable{100};     // 开门、维护等其他状态
+        int hotFloorBonus{20};    // 高峰期热点楼层的优先
+        int perPassenger{10};     // 轿厢内每位乘客
+    };
+    void setScoreWeights(const ScoreWeights& weights) { scoreWeights = weights; }
+    const ScoreWeights& getScoreWeights() const { return scoreWeights; }
     
     // 电梯管理
     void addElevator(Elevator* elevator);
     void setElevatorRange(int elevatorId, int minFloor, int maxFloor);
+    // 电梯只停靠给定楼层，空列表表示不限制
+    void setElevatorStops(int elevatorId, const std::vector<int>& floors);
+    
+    // 分区电梯组：前 expressCount 台电梯作为穿梭电梯，只停靠主门厅和各空中门厅；
+    // 之后的电梯按 carsPerZone 依次分给各分区作为本地电梯。电梯数量不足时返回 false
+    bool configureZonedBank(const ZoneLayout& layout, int expressCount,
+                            const std::vector<int>& carsPerZone);
+    void clearZoneLayout();
+    bool isZoned() const { return zoned; }
     
     // 模式控制
     void setEmergencyMode(bool enabled);
     void setPeakHourMode(bool enabled);
     
+    // 步进模式：已有和之后加入的电梯都切换为步进，请求时间戳和热点统计改用模拟时间。
+    // advance 推进所有电梯并重试队列中的请求
+    void setStepMode(bool enabled);
+    bool isStepMode() const { return stepMode; }
+    void advance(double seconds);
+    double getSimTime() const { return simTime; }
+    
     // 统计信息
     void updateFloorStatistics(int floor);
     std::vector<int> getHotFloors() const;
+    // 热点楼层只统计最近 seconds 秒内的访问（按指数衰减），0 表示统计全部历史；改变窗口会重新开始统计
+    void setHotFloorWindow(double seconds);
+    
+    // 排队请求的深度和等待时间
+    HallCallScheduler::Metrics getQueueMetrics() const;
+    // 暂时无法分配的请求的重试退避（秒）
+    void setRetryBackoff(double initial, double max);
     
     int getElevatorCount() const { return elevators.size(); }
     Elevator* getElevator(int index) const {
         return (index >= 0 && index < elevators.size()) ? elevators[index] : nullptr;
     }
 
+signals:
+    // 行程的乘客在出发楼层上梯（换乘段不算），乘客管理据此把他移出候梯队列
+    void passengerBoarded(int floor);
+
 private:
     // 调度算法辅助方法
     Elevator* findBestElevator(const Request& request);
     int calculateScore(Elevator* elevator, const Request& request);
     bool canServeRequest(Elevator* elevator, const Request& request);
+    double currentTime() const;
+    long long requestTimestamp() const;
+    
+    // 多段行程：记录每段由哪台电梯承运，开门时据此判断接到和送达
+    struct Trip {
+        std::vector<ZoneLayout::Leg> legs;
+        std::size_t nextLeg{0};
+        HallCallScheduler::Priority priority;
+        double startTime;
+    };
+    struct Ride {
+        int tripId;
+        int fromFloor;
+        int toFloor;
+        bool boarded{false};
+    };
+    void dispatchLeg(int tripId);
+    // 本段送达后续派下一段或结束行程，续派了下一段时返回 true
+    bool finishLeg(int tripId);
+    void onDoorOpened(Elevator* elevator);
+    // 电梯故障：它承运的各段交回队列改派
+    void onMalfunction(Elevator* elevator);
     
     std::vector<Elevator*> elevators;
-    std::priority_queue<Request> requestQueue;
-    std::unordered_map<int, int> floorStatistics;
+    HallCallScheduler requestQueue;
+    bool processingQueue{false};
+    QTimer* retryTimer{nullptr};  // 实时模式下按最早的退避到期时间重试
+    HotFloorTracker hotFloors{3};  // 前3个热点楼层，随 updateFloorStatistics 增量更新
+    
+    ZoneLayout zoneLayout;
+    bool zoned{false};
+    std::unordered_map<const Elevator*, std::vector<int>> allowedStops;  // 有序楼层列表
+    std::unordered_map<int, Trip> trips;
+    std::unordered_map<const Elevator*, std::vector<Ride>> rides;
+    int nextTripId{0};
+    TripMetrics tripMetrics;
+    double totalTripTime{0.0};
     
     bool emergencyMode{false};
     bool peakHourMode{false};
+    ScoreWeights scoreWeights;
+    bool stepMode{false};
+    double simTime{0.0};  // 步进模式下的模拟时间（秒）
     void processQueue();
+    void scheduleRetry();
 }; 
\ No newline at end of file
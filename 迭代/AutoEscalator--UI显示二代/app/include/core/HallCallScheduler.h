@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <functional>
+
+// 厅外召唤调度队列：按优先级分类排队，每个周期尝试所有到期的请求。
+// 暂时无法分配的请求留在原位并按指数退避延后重试，不会挡住后面的请求；
+// 同一优先级内保持先来先服务。
+class HallCallScheduler {
+public:
+    // 数值越小越优先
+    enum class Priority {
+        EMERGENCY,  // 紧急请求
+        VIP,        // 贵宾
+        ELDERLY,    // 老年人
+        NORMAL      // 普通乘客
+    };
+    static constexpr int PRIORITY_COUNT = 4;
+
+    struct Call {
+        int fromFloor;
+        int toFloor;
+        Priority priority;
+        double enqueueTime;   // 入队时间（秒）
+        double nextAttempt;   // 退避结束时间，之前不再尝试
+        int attempts{0};      // 已失败的分配次数
+        int tripId{-1};       // 调用方附带的行程编号，分配时原样带回
+    };
+
+    struct Metrics {
+        std::size_t depth{0};
+        std::array<std::size_t, PRIORITY_COUNT> depthByPriority{};
+        std::size_t maxDepth{0};      // 历史最大队列长度
+        std::size_t blocked{0};       // 当前处于退避中的请求数
+        double oldestAge{0.0};        // 队列中最老请求已等待的时间（秒）
+        double averageAge{0.0};
+        double averageQueueTime{0.0}; // 已分配请求从入队到分配的平均时间（秒）
+        long long dispatched{0};
+        long long retries{0};         // 累计失败重试次数
+    };
+
+    // 尝试分配一个请求，返回 false 表示暂时没有合适的电梯
+    using AssignFunction = std::function<bool(const Call&)>;
+
+    void enqueue(int fromFloor, int toFloor, Priority priority, double now, int tripId = -1);
+
+    // 按优先级依次尝试所有到期请求，返回本次成功分配的数量
+    int process(double now, const AssignFunction& tryAssign);
+
+    // 退避参数（秒）：第 n 次失败后等待 min(initial * 2^(n-1), max)
+    void setBackoff(double initial, double max);
+
+    // 最早的重试时间，队列为空时返回负数
+    double nextAttemptTime() const;
+
+    // 时间基准改变时（如切换步进模式）把所有请求的时间整体平移 delta 秒
+    void shiftTime(double delta);
+
+    Metrics getMetrics(double now) const;
+    std::size_t size() const { return depth; }
+    bool empty() const { return depth == 0; }
+    void clear();
+
+private:
+    double backoffDelay(int attempts) const;
+
+    std::array<std::deque<Call>, PRIORITY_COUNT> queues;
+    std::size_t depth{0};
+    std::size_t maxDepth{0};
+    long long dispatched{0};
+    long long retries{0};
+    double totalQueueTime{0.0};
+    double initialBackoff{0.5};
+    double maxBackoff{8.0};
+};
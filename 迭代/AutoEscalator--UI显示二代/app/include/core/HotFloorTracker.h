@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+
+// 热点楼层统计：增量维护访问量最高的前k个楼层。
+// 每次记录只调整被访问楼层在前k名中的位置，读取前k名和判断是否热点都是O(1)。
+//
+// 可选时间衰减：设置时间窗口后，每次访问的权重按 exp(-Δt/窗口) 随时间衰减，
+// 热点反映最近一段时间而不是全部历史。衰减对所有楼层等比例生效，不改变相对排序，
+// 因此用"前向衰减"实现：新访问按 exp(t/窗口) 放大计入，而不是每次衰减全部楼层。
+class HotFloorTracker {
+public:
+    explicit HotFloorTracker(int topCount = 3);
+
+    // 记录一次楼层访问，now 为单调递增的时间（秒）
+    void record(int floor, double now);
+
+    // 时间窗口（秒），0 表示不衰减，统计全部历史。窗口改变时清空已有统计
+    void setDecayWindow(double seconds);
+    double getDecayWindow() const { return decayWindow; }
+
+    const std::vector<int>& getHotFloors() const { return topFloors; }
+    bool isHot(int floor) const {
+        return floor >= 0 && floor < static_cast<int>(hotFlags.size()) && hotFlags[floor];
+    }
+
+    void clear();
+
+private:
+    void ensureFloor(int floor);
+    void promote(int floor);
+    void rebase(double now);
+
+    int topCount;
+    double decayWindow{0.0};
+    double baseTime{0.0};          // 前向衰减的参考时间
+    std::vector<double> weights;   // 下标为楼层，相对 baseTime 的放大权重
+    std::vector<int> topFloors;    // 按权重从高到低排列，最多 topCount 个
+    std::vector<char> hotFlags;    // 下标为楼层，是否在 topFloors 中
+};
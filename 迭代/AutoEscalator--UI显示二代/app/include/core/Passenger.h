@@ -6,7 +6,8 @@ public:
     enum class Type {
         NORMAL,     // 普通乘客
         ELDERLY,    // 老年人
-        WORKER      // 上班族
+        WORKER,     // 上班族
+        VIP         // 贵宾
     };
 
     Passenger(int from, int to, Type type = Type::NORMAL)
@@ -1,11 +1,11 @@
 #pragma once
 #include <QObject>
 #include <QTimer>
+#include <QRandomGenerator>
 #include <unordered_map>
-#include <queue>
 #include <vector>
-#include <memory>
 #include "Passenger.h"
+#include "PassengerPool.h"
 #include "ElevatorDispatcher.h"
 
 class PassengerManager : public QObject {
@@ -13,7 +13,7 @@ class PassengerManager : public QObject {
 public:
     explicit PassengerManager(ElevatorDispatcher* dispatcher, QObject* parent = nullptr);
 
-    // 乘客管理
+    // 乘客管理：候梯乘客放在对象池中，调度器报告上梯时移出队首并回收槽位
     void addPassenger(int fromFloor, int toFloor, Passenger::Type type = Passenger::Type::NORMAL);
     void removePassenger(int floor);
     
@@ -21,8 +21,18 @@ public:
     void startPeakHourSimulation();
     void stopPeakHourSimulation();
     
+    // 步进模式：高峰期乘客按 advance 推进的模拟时间每 PEAK_HOUR_INTERVAL 秒生成一批，
+    // 不启动定时器；配合 setRandomSeed 可完全复现一次运行
+    void setStepMode(bool enabled);
+    bool isStepMode() const { return stepMode; }
+    void advance(double seconds);
+    void setRandomSeed(quint32 seed) { rng.seed(seed); }
+    
+    static constexpr double PEAK_HOUR_INTERVAL = 5.0;  // 高峰期每批乘客间隔（秒）
+    
     // 楼层统计
     int getWaitingCount(int floor) const;
+    const PassengerPool& getPassengerPool() const { return passengerPool; }
     std::vector<int> getBusiestFloors() const;
     
     // 乘客分布设置
@@ -32,7 +42,7 @@ private:
     struct FloorInfo {
         int workerCount{0};
         int elderlyCount{0};
-        std::queue<std::shared_ptr<Passenger>> waitingQueue;
+        PassengerPool::List waitingQueue;
     };
 
     void simulatePeakHour();
@@ -41,8 +51,12 @@ private:
     
     ElevatorDispatcher* dispatcher;
     std::unordered_map<int, FloorInfo> floorInfo;
+    PassengerPool passengerPool;
     bool isPeakHour{false};
+    mutable QRandomGenerator rng{QRandomGenerator::global()->generate()};
     
-    // 定时器用于模拟高峰期
+    // 定时器用于模拟高峰期，步进模式下改用 peakHourElapsed 累计模拟时间
     QTimer* peakHourTimer;
+    bool stepMode{false};
+    double peakHourElapsed{0.0};
 }; 
\ No newline at end of file
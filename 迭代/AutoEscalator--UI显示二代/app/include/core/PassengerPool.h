@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Passenger.h"
+
+// 乘客对象池：乘客放在连续的槽位数组中，用32位句柄引用，每层的候梯队列是串在槽位上的
+// 侵入式链表。乘客上梯后槽位回到空闲链表供下一位到达的乘客复用，
+// 槽位数组只在同时候梯的人数超过历史最高时扩容，高峰期持续生成乘客也不再逐个分配
+class PassengerPool {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle NONE = UINT32_MAX;
+
+    // 链表头：首尾句柄和人数，链接保存在槽位中
+    struct List {
+        Handle head{NONE};
+        Handle tail{NONE};
+        int count{0};
+    };
+
+    Handle acquire(int fromFloor, int toFloor, Passenger::Type type);
+    void release(Handle handle);
+    const Passenger& get(Handle handle) const { return storage[handle].passenger; }
+
+    void pushBack(List& list, Handle handle);
+    Handle popFront(List& list);
+
+    int getLiveCount() const { return liveCount; }
+    std::size_t getCapacity() const { return storage.capacity(); }
+
+private:
+    struct Slot {
+        Passenger passenger;
+        Handle next;  // 所在链表的下一个；空闲时为空闲链表的下一个
+    };
+
+    std::vector<Slot> storage;
+    Handle freeHead{NONE};
+    int liveCount{0};
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+// 分区（空中门厅）布局：大楼自下而上分成若干连续分区，每个分区的最低层是它的门厅。
+// 第一个分区的门厅就是主门厅，其余分区的门厅是空中门厅。
+// 本地电梯只在各自分区内运行，穿梭电梯只停靠各个门厅；跨分区的行程拆成
+// "本区到门厅 → 穿梭到目标分区门厅 → 门厅到目的层" 最多三段。
+class ZoneLayout {
+public:
+    struct Zone {
+        int lobbyFloor;    // 分区门厅（分区最低层）
+        int highestFloor;
+    };
+
+    using Leg = std::pair<int, int>;  // (出发层, 到达层)
+
+    // 分区需按楼层从低到高依次添加，且首尾相接
+    bool addZone(int lobbyFloor, int highestFloor);
+
+    // 把 minFloor..maxFloor 平均分成 zoneCount 个分区
+    static ZoneLayout evenZones(int minFloor, int maxFloor, int zoneCount);
+
+    int getZoneCount() const { return static_cast<int>(zones.size()); }
+    const Zone& getZone(int index) const { return zones[index]; }
+    int getMainLobby() const { return zones.empty() ? 0 : zones.front().lobbyFloor; }
+    std::vector<int> getLobbies() const;
+
+    // 楼层所在分区，不在任何分区内返回 -1
+    int zoneOf(int floor) const;
+
+    // 规划行程的各段，无法规划（楼层不在布局内）时返回空
+    std::vector<Leg> planTrip(int fromFloor, int toFloor) const;
+
+private:
+    std::vector<Zone> zones;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <QDialog>
+#include <QLabel>
 #include <QTableWidget>
 #include <QTimer>
 #include "core/ElevatorDispatcher.h"
@@ -19,6 +20,7 @@ private:
     void setupUi();
     
     QTableWidget* statusTable;
+    QLabel* queueLabel;
     QTimer* updateTimer;
     ElevatorDispatcher* dispatcher;
     PassengerManager* passengerManager;
@@ -1,35 +1,40 @@
 #include "core/Elevator.h"
 #include <QTimer>
 #include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
 
 Elevator::Elevator(QObject* parent) : QObject(parent) {
-    moveTimer = new QTimer(this);
-    doorTimer = new QTimer(this);
+}
+
+void Elevator::onMoveTick() {
+    if (currentFloor < targetFloor) {
+        currentFloor++;
+    } else if (currentFloor > targetFloor) {
+        currentFloor--;
+    }
     
-    connect(moveTimer, &QTimer::timeout, this, [this]() {
-        if (currentFloor < targetFloor) {
-            currentFloor++;
-        } else if (currentFloor > targetFloor) {
-            currentFloor--;
-        }
-        
-        emit floorChanged(currentFloor);
-        
-        if (currentFloor == targetFloor) {
-            moveTimer->stop();
-            openDoor();
-        }
-    });
+    emit floorChanged(currentFloor);
     
-    connect(doorTimer, &QTimer::timeout, this, [this]() {
-        if (state == State::DOOR_OPENING) {
-            emit doorOpened();
+    if (currentFloor == targetFloor) {
+        stopMoveTimer();
+        openDoor();
+    }
+}
+
+void Elevator::onDoorTimeout() {
+    if (state == State::DOOR_OPENING) {
+        emit doorOpened();
+        // 还有待去的楼层就关门继续运行，否则停在本层待命
+        if (!destinations.empty()) {
+            closeDoor();
+        } else {
             updateState(State::IDLE);
-        } else if (state == State::DOOR_CLOSING) {
-            emit doorClosed();
-            processNextDestination();
         }
-    });
+    } else if (state == State::DOOR_CLOSING) {
+        emit doorClosed();
+        processNextDestination();
+    }
 }
 
 void Elevator::moveToFloor(int floor) {
@@ -44,7 +49,7 @@ void Elevator::moveToFloor(int floor) {
         updateState(State::MOVING_DOWN);
     }
     
-    moveTimer->start(config.floorTime * 1000); // 转换为毫秒
+    startMoveTimer();
 }
 
 void Elevator::addDestination(int floor) {
@@ -58,25 +63,172 @@ void Elevator::addDestination(int floor) {
 
 void Elevator::openDoor() {
     updateState(State::DOOR_OPENING);
-    doorTimer->start(config.doorTime * 1000);
+    startDoorTimer();
 }
 
 void Elevator::closeDoor() {
     updateState(State::DOOR_CLOSING);
+    startDoorTimer();
+}
+
+void Elevator::setStepMode(bool enabled) {
+    if (stepMode == enabled) {
+        return;
+    }
+    
+    // 正在进行的运行/开关门/修复在新模式下重新计时
+    bool moving = isMoveScheduled();
+    bool door = isDoorScheduled();
+    bool repairing = stepMode ? repairRemaining >= 0 : (repairTimer && repairTimer->isActive());
+    stopMoveTimer();
+    stopDoorTimer();
+    repairRemaining = -1.0;
+    if (repairTimer) repairTimer->stop();
+    stepMode = enabled;
+    if (moving) startMoveTimer();
+    if (door) startDoorTimer();
+    if (repairing) startRepairTimer();
+}
+
+void Elevator::advance(double seconds) {
+    if (!stepMode || seconds <= 0) {
+        return;
+    }
+    
+    constexpr double epsilon = 1e-9;
+    if (state == State::MALFUNCTION) {
+        // 故障期间不运行，只等待修复
+        if (repairRemaining >= 0) {
+            repairRemaining -= seconds;
+            if (repairRemaining <= epsilon) {
+                repair();
+            }
+        }
+        return;
+    }
+    
+    // 按到期先后依次触发，一步之内可以连续走过多层、完成多次开关门
+    double remaining = seconds;
+    while (true) {
+        double next = -1.0;
+        if (moveRemaining >= 0) next = moveRemaining;
+        if (doorRemaining >= 0 && (next < 0 || doorRemaining < next)) next = doorRemaining;
+        if (next < 0 || next > remaining + epsilon) {
+            break;
+        }
+        
+        remaining = std::max(0.0, remaining - next);
+        bool moveDue = moveRemaining >= 0 && moveRemaining - next <= epsilon;
+        bool doorDue = doorRemaining >= 0 && doorRemaining - next <= epsilon;
+        if (moveRemaining >= 0) moveRemaining = std::max(0.0, moveRemaining - next);
+        if (doorRemaining >= 0) doorRemaining = std::max(0.0, doorRemaining - next);
+        
+        if (moveDue) {
+            moveRemaining = config.floorTime;  // 与重复触发的 moveTimer 一致
+            onMoveTick();
+        } else if (doorDue) {
+            doorRemaining = -1.0;
+            onDoorTimeout();
+        }
+    }
+    
+    if (moveRemaining >= 0) moveRemaining -= remaining;
+    if (doorRemaining >= 0) doorRemaining -= remaining;
+    
+    // 故障按平均故障间隔随机发生，一步内发生的概率为 1 - exp(-步长/MTBF)
+    if (config.mtbf > 0 && faultRng.generateDouble() < -std::expm1(-seconds / config.mtbf)) {
+        simulateMalfunction();
+    }
+}
+
+void Elevator::startMoveTimer() {
+    if (stepMode) {
+        moveRemaining = config.floorTime;
+        return;
+    }
+    if (!moveTimer) {
+        moveTimer = new QTimer(this);
+        connect(moveTimer, &QTimer::timeout, this, &Elevator::onMoveTick);
+    }
+    moveTimer->start(config.floorTime * 1000); // 转换为毫秒
+}
+
+void Elevator::stopMoveTimer() {
+    moveRemaining = -1.0;
+    if (moveTimer) {
+        moveTimer->stop();
+    }
+}
+
+void Elevator::startDoorTimer() {
+    if (stepMode) {
+        doorRemaining = config.doorTime;
+        return;
+    }
+    if (!doorTimer) {
+        doorTimer = new QTimer(this);
+        doorTimer->setSingleShot(true);
+        connect(doorTimer, &QTimer::timeout, this, &Elevator::onDoorTimeout);
+    }
     doorTimer->start(config.doorTime * 1000);
 }
 
+void Elevator::stopDoorTimer() {
+    doorRemaining = -1.0;
+    if (doorTimer) {
+        doorTimer->stop();
+    }
+}
+
+bool Elevator::isMoveScheduled() const {
+    return stepMode ? moveRemaining >= 0 : (moveTimer && moveTimer->isActive());
+}
+
+bool Elevator::isDoorScheduled() const {
+    return stepMode ? doorRemaining >= 0 : (doorTimer && doorTimer->isActive());
+}
+
 void Elevator::simulateMalfunction() {
-    // 模拟1%的故障概率
-    if (QRandomGenerator::global()->bounded(100) == 0) {
-        updateState(State::MALFUNCTION);
-        emit malfunctionOccurred();
+    if (state == State::MALFUNCTION) {
+        return;
+    }
+    
+    // 故障的电梯停在当前楼层，未完成的目标作废，由调度改派给其他电梯
+    stopMoveTimer();
+    stopDoorTimer();
+    clearDestinations();
+    updateState(State::MALFUNCTION);
+    emit malfunctionOccurred();
+    if (config.repairTime > 0) {
+        startRepairTimer();
+    }
+}
+
+void Elevator::startRepairTimer() {
+    if (stepMode) {
+        repairRemaining = config.repairTime;
+        return;
+    }
+    if (!repairTimer) {
+        repairTimer = new QTimer(this);
+        repairTimer->setSingleShot(true);
+        connect(repairTimer, &QTimer::timeout, this, &Elevator::repair);
     }
+    repairTimer->start(config.repairTime * 1000);
+}
+
+void Elevator::repair() {
+    repairRemaining = -1.0;
+    if (state != State::MALFUNCTION) {
+        return;
+    }
+    updateState(State::IDLE);
+    emit repaired();
 }
 
 void Elevator::handleEmergency() {
-    moveTimer->stop();
-    doorTimer->stop();
+    stopMoveTimer();
+    stopDoorTimer();
     updateState(State::EMERGENCY);
     
     // 紧急情况下直接前往1楼
@@ -92,6 +244,11 @@ void Elevator::updateState(State newState) {
     }
 }
 
+void Elevator::clearDestinations() {
+    std::queue<int>().swap(destinations);
+    targetFloor = currentFloor;
+}
+
 bool Elevator::isValidFloor(int floor) const {
     return floor >= config.minFloor && floor <= config.maxFloor;
 }
@@ -1,6 +1,8 @@
 #include "core/ElevatorDispatcher.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 ElevatorDispatcher::ElevatorDispatcher(QObject* parent)
     : QObject(parent) {
@@ -8,27 +10,155 @@ ElevatorDispatcher::ElevatorDispatcher(QObject* parent)
 }
 
 void ElevatorDispatcher::dispatchRequest(int fromFloor, int toFloor, bool isEmergency) {
-    Request request{
-        fromFloor,
-        toFloor,
-        isEmergency,
-        std::chrono::system_clock::now().time_since_epoch().count()
-    };
-    
-    // 如果是紧急请求，直接处理
+    dispatchRequest(fromFloor, toFloor,
+                    isEmergency ? HallCallScheduler::Priority::EMERGENCY
+                                : HallCallScheduler::Priority::NORMAL);
+}
+
+void ElevatorDispatcher::dispatchRequest(int fromFloor, int toFloor, HallCallScheduler::Priority priority) {
+    bool isEmergency = priority == HallCallScheduler::Priority::EMERGENCY;
+    
+    // 如果是紧急请求，直接处理；暂时没有可用电梯时进入队列最前端等待重试
     if (isEmergency) {
+        Request request{fromFloor, toFloor, true, requestTimestamp()};
         if (Elevator* elevator = findBestElevator(request)) {
             elevator->addDestination(fromFloor);
             elevator->addDestination(toFloor);
+            return;
+        }
+    }
+    
+    // 其余请求按优先级排队
+    requestQueue.enqueue(fromFloor, toFloor, priority, currentTime());
+    processQueue();
+}
+
+HallCallScheduler::Priority ElevatorDispatcher::priorityFor(Passenger::Type type) {
+    switch (type) {
+        case Passenger::Type::VIP:
+            return HallCallScheduler::Priority::VIP;
+        case Passenger::Type::ELDERLY:
+            return HallCallScheduler::Priority::ELDERLY;
+        default:
+            return HallCallScheduler::Priority::NORMAL;
+    }
+}
+
+void ElevatorDispatcher::dispatchTrip(int fromFloor, int toFloor, HallCallScheduler::Priority priority) {
+    std::vector<ZoneLayout::Leg> legs;
+    if (zoned) {
+        legs = zoneLayout.planTrip(fromFloor, toFloor);
+    } else if (fromFloor != toFloor) {
+        legs.emplace_back(fromFloor, toFloor);
+    }
+    
+    // 无法规划的行程（同层或不在分区内）按普通请求处理
+    if (legs.empty()) {
+        dispatchRequest(fromFloor, toFloor, priority);
+        return;
+    }
+    
+    int tripId = nextTripId++;
+    trips[tripId] = Trip{std::move(legs), 0, priority, currentTime()};
+    ++tripMetrics.started;
+    dispatchLeg(tripId);
+    processQueue();
+}
+
+void ElevatorDispatcher::dispatchLeg(int tripId) {
+    const Trip& trip = trips[tripId];
+    const auto& leg = trip.legs[trip.nextLeg];
+    requestQueue.enqueue(leg.first, leg.second, trip.priority, currentTime(), tripId);
+}
+
+void ElevatorDispatcher::onDoorOpened(Elevator* elevator) {
+    auto it = rides.find(elevator);
+    if (it == rides.end()) {
+        return;
+    }
+    
+    int floor = elevator->getCurrentFloor();
+    bool legsDispatched = false;
+    auto& carRides = it->second;
+    for (auto ride = carRides.begin(); ride != carRides.end();) {
+        if (!ride->boarded) {
+            ride->boarded = ride->fromFloor == floor;
+            auto trip = trips.find(ride->tripId);
+            if (ride->boarded && trip != trips.end() && trip->second.nextLeg == 0) {
+                emit passengerBoarded(floor);
+            }
+            ++ride;
+            continue;
         }
+        if (ride->toFloor != floor) {
+            ++ride;
+            continue;
+        }
+        
+        int tripId = ride->tripId;
+        ride = carRides.erase(ride);
+        legsDispatched = finishLeg(tripId) || legsDispatched;
+    }
+    
+    if (legsDispatched) {
+        processQueue();
+    }
+}
+
+bool ElevatorDispatcher::finishLeg(int tripId) {
+    // 本段送达：还有后续段就在当前楼层换乘，否则行程结束
+    auto trip = trips.find(tripId);
+    if (trip == trips.end()) {
+        return false;
+    }
+    if (++trip->second.nextLeg < trip->second.legs.size()) {
+        dispatchLeg(tripId);
+        return true;
+    }
+    
+    double tripTime = currentTime() - trip->second.startTime;
+    ++tripMetrics.completed;
+    tripMetrics.transfers += static_cast<long long>(trip->second.legs.size()) - 1;
+    tripMetrics.maxTripTime = std::max(tripMetrics.maxTripTime, tripTime);
+    totalTripTime += tripTime;
+    trips.erase(trip);
+    return false;
+}
+
+void ElevatorDispatcher::onMalfunction(Elevator* elevator) {
+    auto it = rides.find(elevator);
+    if (it == rides.end()) {
         return;
     }
     
-    // 普通请求加入队列
-    requestQueue.push(request);
+    // 故障电梯承运的各段重新排队：未上梯的从原出发层重新呼梯，
+    // 已上梯的在故障楼层下梯后从该层继续本段，行程的开始时间不变
+    std::vector<Ride> stranded = std::move(it->second);
+    rides.erase(it);
+    int floor = elevator->getCurrentFloor();
+    for (const Ride& ride : stranded) {
+        auto trip = trips.find(ride.tripId);
+        if (trip == trips.end()) {
+            continue;
+        }
+        if (ride.boarded) {
+            if (floor == ride.toFloor) {
+                finishLeg(ride.tripId);
+                continue;
+            }
+            trip->second.legs[trip->second.nextLeg].first = floor;
+        }
+        dispatchLeg(ride.tripId);
+    }
     processQueue();
 }
 
+ElevatorDispatcher::TripMetrics ElevatorDispatcher::getTripMetrics() const {
+    TripMetrics metrics = tripMetrics;
+    metrics.averageTripTime = metrics.completed > 0 ? totalTripTime / metrics.completed : 0.0;
+    return metrics;
+}
+
 Elevator* ElevatorDispatcher::findBestElevator(const Request& request) {
     Elevator* bestElevator = nullptr;
     int bestScore = std::numeric_limits<int>::max();
@@ -52,7 +182,7 @@ int ElevatorDispatcher::calculateScore(Elevator* elevator, const Request& reques
     int score = 0;
     
     // 基础分：电梯当前位置到请求起点的距离
-    score += std::abs(elevator->getCurrentFloor() - request.fromFloor);
+    score += std::abs(elevator->getCurrentFloor() - request.fromFloor) * scoreWeights.perFloor;
     
     // 电梯状态加权
     switch (elevator->getState()) {
@@ -60,25 +190,22 @@ int ElevatorDispatcher::calculateScore(Elevator* elevator, const Request& reques
             score += 0;
             break;
         case Elevator::State::MOVING_UP:
-            score += (request.fromFloor < elevator->getCurrentFloor()) ? 50 : 0;
+            score += (request.fromFloor < elevator->getCurrentFloor()) ? scoreWeights.movingAway : 0;
             break;
         case Elevator::State::MOVING_DOWN:
-            score += (request.fromFloor > elevator->getCurrentFloor()) ? 50 : 0;
+            score += (request.fromFloor > elevator->getCurrentFloor()) ? scoreWeights.movingAway : 0;
             break;
         default:
-            score += 100;
+            score += scoreWeights.unavailable;
     }
     
     // 高峰期优化
-    if (peakHourMode) {
-        auto hotFloors = getHotFloors();
-        if (std::find(hotFloors.begin(), hotFloors.end(), request.fromFloor) != hotFloors.end()) {
-            score -= 20;  // 热点楼层优先级提高
-        }
+    if (peakHourMode && hotFloors.isHot(request.fromFloor)) {
+        score -= scoreWeights.hotFloorBonus;  // 热点楼层优先级提高
     }
     
     // 乘客数量影响
-    score += elevator->getPassengerCount() * 10;
+    score += elevator->getPassengerCount() * scoreWeights.perPassenger;
     
     return score;
 }
@@ -91,6 +218,14 @@ bool ElevatorDispatcher::canServeRequest(Elevator* elevator, const Request& requ
         return false;
     }
     
+    // 检查停靠限制（如只停门厅的穿梭电梯）
+    auto stops = allowedStops.find(elevator);
+    if (stops != allowedStops.end() &&
+        (!std::binary_search(stops->second.begin(), stops->second.end(), request.fromFloor) ||
+         !std::binary_search(stops->second.begin(), stops->second.end(), request.toFloor))) {
+        return false;
+    }
+    
     // 检查电梯状态
     if (elevator->getState() == Elevator::State::MALFUNCTION ||
         elevator->getState() == Elevator::State::EMERGENCY) {
@@ -106,41 +241,95 @@ bool ElevatorDispatcher::canServeRequest(Elevator* elevator, const Request& requ
 }
 
 void ElevatorDispatcher::updateFloorStatistics(int floor) {
-    floorStatistics[floor]++;
+    hotFloors.record(floor, currentTime());
 }
 
-std::vector<int> ElevatorDispatcher::getHotFloors() const {
-    std::vector<std::pair<int, int>> floors;
-    for (const auto& pair : floorStatistics) {
-        floors.emplace_back(pair);
+double ElevatorDispatcher::currentTime() const {
+    if (stepMode) {
+        return simTime;
     }
-    
-    // 按访问频率排序
-    std::sort(floors.begin(), floors.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-    
-    // 返回前3个热点楼层
-    std::vector<int> hotFloors;
-    for (size_t i = 0; i < std::min(size_t(3), floors.size()); ++i) {
-        hotFloors.push_back(floors[i].first);
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long long ElevatorDispatcher::requestTimestamp() const {
+    if (stepMode) {
+        return std::llround(simTime * 1e6);  // 微秒
     }
-    
-    return hotFloors;
+    return std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+std::vector<int> ElevatorDispatcher::getHotFloors() const {
+    // 按访问频率从高到低的前3个热点楼层
+    return hotFloors.getHotFloors();
+}
+
+void ElevatorDispatcher::setHotFloorWindow(double seconds) {
+    hotFloors.setDecayWindow(seconds);
+}
+
+HallCallScheduler::Metrics ElevatorDispatcher::getQueueMetrics() const {
+    return requestQueue.getMetrics(currentTime());
+}
+
+void ElevatorDispatcher::setRetryBackoff(double initial, double max) {
+    requestQueue.setBackoff(initial, max);
 }
 
 void ElevatorDispatcher::processQueue() {
-    while (!requestQueue.empty()) {
-        Request request = requestQueue.top();
+    // 分配过程中新到的请求只入队，由本轮或下一轮处理
+    if (processingQueue) {
+        return;
+    }
+    
+    processingQueue = true;
+    long long timestamp = requestTimestamp();
+    requestQueue.process(currentTime(), [this, timestamp](const HallCallScheduler::Call& call) {
+        Request request{
+            call.fromFloor,
+            call.toFloor,
+            call.priority == HallCallScheduler::Priority::EMERGENCY,
+            timestamp
+        };
         
-        if (Elevator* elevator = findBestElevator(request)) {
-            elevator->addDestination(request.fromFloor);
-            elevator->addDestination(request.toFloor);
-            requestQueue.pop();
-        } else {
-            // 如果没有合适的电梯，保留请求在队列中
-            break;
+        // 没有合适的电梯时请求留在队列中退避，不影响后面的请求
+        Elevator* elevator = findBestElevator(request);
+        if (!elevator) {
+            return false;
+        }
+        elevator->addDestination(request.fromFloor);
+        elevator->addDestination(request.toFloor);
+        if (call.tripId >= 0) {
+            rides[elevator].push_back({call.tripId, call.fromFloor, call.toFloor});
+        }
+        return true;
+    });
+    processingQueue = false;
+    
+    scheduleRetry();
+}
+
+void ElevatorDispatcher::scheduleRetry() {
+    // 步进模式由 advance 驱动重试
+    if (stepMode) {
+        return;
+    }
+    
+    double next = requestQueue.nextAttemptTime();
+    if (next < 0) {
+        if (retryTimer) {
+            retryTimer->stop();
         }
+        return;
+    }
+    
+    if (!retryTimer) {
+        retryTimer = new QTimer(this);
+        retryTimer->setSingleShot(true);
+        connect(retryTimer, &QTimer::timeout, this, &ElevatorDispatcher::processQueue);
     }
+    double delay = std::max(0.0, next - currentTime());
+    retryTimer->start(static_cast<int>(std::ceil(delay * 1000)));
 }
 
 void ElevatorDispatcher::setElevatorRange(int elevatorId, int minFloor, int maxFloor) {
@@ -154,6 +343,64 @@ void ElevatorDispatcher::setElevatorRange(int elevatorId, int minFloor, int maxF
     }
 }
 
+void ElevatorDispatcher::setElevatorStops(int elevatorId, const std::vector<int>& floors) {
+    if (elevatorId < 0 || elevatorId >= static_cast<int>(elevators.size())) {
+        return;
+    }
+    
+    const Elevator* elevator = elevators[elevatorId];
+    if (floors.empty()) {
+        allowedStops.erase(elevator);
+        return;
+    }
+    auto& stops = allowedStops[elevator];
+    stops = floors;
+    std::sort(stops.begin(), stops.end());
+    stops.erase(std::unique(stops.begin(), stops.end()), stops.end());
+}
+
+bool ElevatorDispatcher::configureZonedBank(const ZoneLayout& layout, int expressCount,
+                                            const std::vector<int>& carsPerZone) {
+    if (layout.getZoneCount() == 0 || expressCount < 0 ||
+        static_cast<int>(carsPerZone.size()) != layout.getZoneCount()) {
+        return false;
+    }
+    int required = expressCount;
+    for (int count : carsPerZone) {
+        required += count;
+    }
+    if (required > static_cast<int>(elevators.size())) {
+        return false;
+    }
+    
+    // 穿梭电梯：主门厅到最高的空中门厅，只停各门厅
+    auto lobbies = layout.getLobbies();
+    int id = 0;
+    for (; id < expressCount; ++id) {
+        setElevatorRange(id, lobbies.front(), lobbies.back());
+        setElevatorStops(id, lobbies);
+    }
+    
+    // 本地电梯：限制在各自分区内
+    for (int zone = 0; zone < layout.getZoneCount(); ++zone) {
+        const auto& range = layout.getZone(zone);
+        for (int i = 0; i < carsPerZone[zone]; ++i, ++id) {
+            setElevatorRange(id, range.lobbyFloor, range.highestFloor);
+            setElevatorStops(id, {});
+        }
+    }
+    
+    zoneLayout = layout;
+    zoned = true;
+    return true;
+}
+
+void ElevatorDispatcher::clearZoneLayout() {
+    zoneLayout = ZoneLayout();
+    zoned = false;
+    allowedStops.clear();
+}
+
 void ElevatorDispatcher::setEmergencyMode(bool enabled) {
     emergencyMode = enabled;
     for (auto elevator : elevators) {
@@ -169,8 +416,54 @@ void ElevatorDispatcher::setPeakHourMode(bool enabled) {
     peakHourMode = enabled;
 }
 
+void ElevatorDispatcher::setStepMode(bool enabled) {
+    if (stepMode == enabled) {
+        return;
+    }
+    
+    double before = currentTime();
+    stepMode = enabled;
+    requestQueue.shiftTime(currentTime() - before);
+    if (stepMode && retryTimer) {
+        retryTimer->stop();
+    }
+    // 热点统计的时间基准随模式改变，旧记录不再可比
+    hotFloors.clear();
+    for (auto elevator : elevators) {
+        if (elevator) {
+            elevator->setStepMode(enabled);
+        }
+    }
+    scheduleRetry();
+}
+
+void ElevatorDispatcher::advance(double seconds) {
+    if (!stepMode || seconds <= 0) {
+        return;
+    }
+    
+    simTime += seconds;
+    for (auto elevator : elevators) {
+        if (elevator) {
+            elevator->advance(seconds);
+        }
+    }
+    
+    // 电梯状态变化后，之前无法分配的请求可能已经可以处理
+    processQueue();
+}
+
 void ElevatorDispatcher::addElevator(Elevator* elevator) {
     if (elevator) {
+        elevator->setStepMode(stepMode);
         elevators.push_back(elevator);
+        connect(elevator, &Elevator::doorOpened, this, [this, elevator]() {
+            onDoorOpened(elevator);
+        });
+        connect(elevator, &Elevator::malfunctionOccurred, this, [this, elevator]() {
+            onMalfunction(elevator);
+        });
+        // 修复后的电梯可以接排队中的请求
+        connect(elevator, &Elevator::repaired, this, &ElevatorDispatcher::processQueue);
     }
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "core/HallCallScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+void HallCallScheduler::enqueue(int fromFloor, int toFloor, Priority priority, double now, int tripId) {
+    queues[static_cast<int>(priority)].push_back({fromFloor, toFloor, priority, now, now, 0, tripId});
+    ++depth;
+    maxDepth = std::max(maxDepth, depth);
+}
+
+int HallCallScheduler::process(double now, const AssignFunction& tryAssign) {
+    int assigned = 0;
+    for (auto& queue : queues) {
+        // 原地压缩：分配成功的请求移除，其余保持原有顺序
+        auto keep = queue.begin();
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (it->nextAttempt <= now) {
+                if (tryAssign(*it)) {
+                    totalQueueTime += now - it->enqueueTime;
+                    ++dispatched;
+                    ++assigned;
+                    continue;
+                }
+                ++it->attempts;
+                ++retries;
+                it->nextAttempt = now + backoffDelay(it->attempts);
+            }
+            if (keep != it) {
+                *keep = std::move(*it);
+            }
+            ++keep;
+        }
+        queue.erase(keep, queue.end());
+    }
+    depth -= assigned;
+    return assigned;
+}
+
+void HallCallScheduler::setBackoff(double initial, double max) {
+    initialBackoff = std::max(0.0, initial);
+    maxBackoff = std::max(initialBackoff, max);
+}
+
+double HallCallScheduler::nextAttemptTime() const {
+    double next = -1.0;
+    for (const auto& queue : queues) {
+        for (const auto& call : queue) {
+            if (next < 0 || call.nextAttempt < next) {
+                next = call.nextAttempt;
+            }
+        }
+    }
+    return next;
+}
+
+void HallCallScheduler::shiftTime(double delta) {
+    for (auto& queue : queues) {
+        for (auto& call : queue) {
+            call.enqueueTime += delta;
+            call.nextAttempt += delta;
+        }
+    }
+}
+
+HallCallScheduler::Metrics HallCallScheduler::getMetrics(double now) const {
+    Metrics metrics;
+    metrics.depth = depth;
+    metrics.maxDepth = maxDepth;
+    metrics.dispatched = dispatched;
+    metrics.retries = retries;
+    metrics.averageQueueTime = dispatched > 0 ? totalQueueTime / dispatched : 0.0;
+
+    double totalAge = 0.0;
+    for (int i = 0; i < PRIORITY_COUNT; ++i) {
+        metrics.depthByPriority[i] = queues[i].size();
+        for (const auto& call : queues[i]) {
+            double age = now - call.enqueueTime;
+            totalAge += age;
+            metrics.oldestAge = std::max(metrics.oldestAge, age);
+            if (call.nextAttempt > now) {
+                ++metrics.blocked;
+            }
+        }
+    }
+    metrics.averageAge = depth > 0 ? totalAge / depth : 0.0;
+    return metrics;
+}
+
+void HallCallScheduler::clear() {
+    for (auto& queue : queues) {
+        queue.clear();
+    }
+    depth = 0;
+}
+
+double HallCallScheduler::backoffDelay(int attempts) const {
+    double delay = initialBackoff * std::pow(2.0, std::min(attempts - 1, 30));
+    return std::min(delay, maxBackoff);
+}
@@ -0,0 +1,85 @@
+#include "core/HotFloorTracker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 放大倍数超过 e^MAX_EXPONENT 时整体折算一次，避免溢出
+    constexpr double MAX_EXPONENT = 50.0;
+}
+
+HotFloorTracker::HotFloorTracker(int topCount)
+    : topCount(std::max(1, topCount)) {
+    topFloors.reserve(this->topCount + 1);
+}
+
+void HotFloorTracker::record(int floor, double now) {
+    if (floor < 0) return;
+    ensureFloor(floor);
+
+    double increment = 1.0;
+    if (decayWindow > 0.0) {
+        double exponent = (now - baseTime) / decayWindow;
+        if (exponent > MAX_EXPONENT) {
+            rebase(now);
+            exponent = 0.0;
+        }
+        increment = std::exp(exponent);
+    }
+
+    weights[floor] += increment;
+    promote(floor);
+}
+
+// 已有权重是按旧窗口放大的，各次访问的时间又没有保存，无法换算到新窗口，
+// 混在一起会让新旧访问的比重失真，所以窗口改变时重新开始统计
+void HotFloorTracker::setDecayWindow(double seconds) {
+    seconds = std::max(0.0, seconds);
+    if (seconds == decayWindow) return;
+    decayWindow = seconds;
+    clear();
+}
+
+void HotFloorTracker::clear() {
+    std::fill(weights.begin(), weights.end(), 0.0);
+    std::fill(hotFlags.begin(), hotFlags.end(), 0);
+    topFloors.clear();
+    baseTime = 0.0;
+}
+
+void HotFloorTracker::ensureFloor(int floor) {
+    if (floor >= static_cast<int>(weights.size())) {
+        weights.resize(floor + 1, 0.0);
+        hotFlags.resize(floor + 1, 0);
+    }
+}
+
+// 权重只会增加，所以该楼层要么在前k名内上移，要么替换掉第k名
+void HotFloorTracker::promote(int floor) {
+    auto it = std::find(topFloors.begin(), topFloors.end(), floor);
+    if (it == topFloors.end()) {
+        if (static_cast<int>(topFloors.size()) < topCount) {
+            topFloors.push_back(floor);
+        } else if (weights[floor] > weights[topFloors.back()]) {
+            hotFlags[topFloors.back()] = 0;
+            topFloors.back() = floor;
+        } else {
+            return;
+        }
+        hotFlags[floor] = 1;
+        it = topFloors.end() - 1;
+    }
+
+    while (it != topFloors.begin() && weights[*(it - 1)] < weights[*it]) {
+        std::iter_swap(it - 1, it);
+        --it;
+    }
+}
+
+// 把所有权重折算到新的参考时间，相对大小不变
+void HotFloorTracker::rebase(double now) {
+    double scale = std::exp(-(now - baseTime) / decayWindow);
+    for (double& weight : weights) {
+        weight *= scale;
+    }
+    baseTime = now;
+}
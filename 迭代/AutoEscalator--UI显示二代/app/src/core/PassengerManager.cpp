@@ -2,35 +2,44 @@
 #include <QTimer>
 #include <QRandomGenerator>
 #include <algorithm>
+#include <iterator>
 
 PassengerManager::PassengerManager(ElevatorDispatcher* dispatcher, QObject* parent)
     : QObject(parent), dispatcher(dispatcher) {
     peakHourTimer = new QTimer(this);
     connect(peakHourTimer, &QTimer::timeout, this, &PassengerManager::simulatePeakHour);
+    connect(dispatcher, &ElevatorDispatcher::passengerBoarded, this,
+            [this](int floor) { removePassenger(floor); });
 }
 
 void PassengerManager::addPassenger(int fromFloor, int toFloor, Passenger::Type type) {
-    auto passenger = std::make_shared<Passenger>(fromFloor, toFloor, type);
-    floorInfo[fromFloor].waitingQueue.push(passenger);
+    // 出发层就是目的层的乘客不会上梯，不进候梯队列，否则占着的槽位永远不会回收
+    auto& info = floorInfo[fromFloor];
+    if (fromFloor != toFloor) {
+        passengerPool.pushBack(info.waitingQueue, passengerPool.acquire(fromFloor, toFloor, type));
+    }
     
     // 通知调度系统
-    dispatcher->dispatchRequest(fromFloor, toFloor);
+    dispatcher->dispatchTrip(fromFloor, toFloor, ElevatorDispatcher::priorityFor(type));
     
     // 更新统计信息
     dispatcher->updateFloorStatistics(fromFloor);
 }
 
 void PassengerManager::removePassenger(int floor) {
-    auto& queue = floorInfo[floor].waitingQueue;
-    if (!queue.empty()) {
-        queue.pop();
+    auto it = floorInfo.find(floor);
+    if (it != floorInfo.end() && it->second.waitingQueue.count > 0) {
+        passengerPool.release(passengerPool.popFront(it->second.waitingQueue));
     }
 }
 
 void PassengerManager::startPeakHourSimulation() {
     isPeakHour = true;
     dispatcher->setPeakHourMode(true);
-    peakHourTimer->start(5000); // 每5秒生成一批乘客
+    peakHourElapsed = 0.0;
+    if (!stepMode) {
+        peakHourTimer->start(PEAK_HOUR_INTERVAL * 1000); // 每5秒生成一批乘客
+    }
 }
 
 void PassengerManager::stopPeakHourSimulation() {
@@ -39,6 +48,32 @@ void PassengerManager::stopPeakHourSimulation() {
     peakHourTimer->stop();
 }
 
+void PassengerManager::setStepMode(bool enabled) {
+    if (stepMode == enabled) {
+        return;
+    }
+    
+    stepMode = enabled;
+    peakHourElapsed = 0.0;
+    if (stepMode) {
+        peakHourTimer->stop();
+    } else if (isPeakHour) {
+        peakHourTimer->start(PEAK_HOUR_INTERVAL * 1000);
+    }
+}
+
+void PassengerManager::advance(double seconds) {
+    if (!stepMode || !isPeakHour || seconds <= 0) {
+        return;
+    }
+    
+    peakHourElapsed += seconds;
+    while (peakHourElapsed >= PEAK_HOUR_INTERVAL) {
+        peakHourElapsed -= PEAK_HOUR_INTERVAL;
+        simulatePeakHour();
+    }
+}
+
 void PassengerManager::simulatePeakHour() {
     generateRandomPassengers();
 }
@@ -47,7 +82,7 @@ void PassengerManager::generateRandomPassengers() {
     for (const auto& [floor, info] : floorInfo) {
         // 生成上班族
         if (info.workerCount > 0) {
-            int count = QRandomGenerator::global()->bounded(1, info.workerCount + 1);
+            int count = rng.bounded(1, info.workerCount + 1);
             for (int i = 0; i < count; ++i) {
                 int toFloor = getRandomFloor();
                 addPassenger(floor, toFloor, Passenger::Type::WORKER);
@@ -55,8 +90,8 @@ void PassengerManager::generateRandomPassengers() {
         }
         
         // 生成老年人（较少频率）
-        if (info.elderlyCount > 0 && QRandomGenerator::global()->bounded(100) < 20) {
-            int count = QRandomGenerator::global()->bounded(1, info.elderlyCount + 1);
+        if (info.elderlyCount > 0 && rng.bounded(100) < 20) {
+            int count = rng.bounded(1, info.elderlyCount + 1);
             for (int i = 0; i < count; ++i) {
                 int toFloor = getRandomFloor();
                 addPassenger(floor, toFloor, Passenger::Type::ELDERLY);
@@ -66,19 +101,15 @@ void PassengerManager::generateRandomPassengers() {
 }
 
 int PassengerManager::getRandomFloor() const {
-    std::vector<int> floors;
-    for (const auto& [floor, _] : floorInfo) {
-        floors.push_back(floor);
-    }
-    
-    int index = QRandomGenerator::global()->bounded(static_cast<int>(floors.size()));
-    return floors[index];
+    // 按遍历顺序取第 index 个楼层，不为每位乘客复制一份楼层列表
+    int index = rng.bounded(static_cast<int>(floorInfo.size()));
+    return std::next(floorInfo.begin(), index)->first;
 }
 
 int PassengerManager::getWaitingCount(int floor) const {
     auto it = floorInfo.find(floor);
     if (it != floorInfo.end()) {
-        return static_cast<int>(it->second.waitingQueue.size());
+        return it->second.waitingQueue.count;
     }
     return 0;
 }
@@ -0,0 +1,43 @@
+#include "core/PassengerPool.h"
+
+PassengerPool::Handle PassengerPool::acquire(int fromFloor, int toFloor, Passenger::Type type) {
+    ++liveCount;
+    if (freeHead != NONE) {
+        Handle handle = freeHead;
+        freeHead = storage[handle].next;
+        storage[handle] = Slot{Passenger(fromFloor, toFloor, type), NONE};
+        return handle;
+    }
+    storage.push_back(Slot{Passenger(fromFloor, toFloor, type), NONE});
+    return static_cast<Handle>(storage.size() - 1);
+}
+
+void PassengerPool::release(Handle handle) {
+    storage[handle].next = freeHead;
+    freeHead = handle;
+    --liveCount;
+}
+
+void PassengerPool::pushBack(List& list, Handle handle) {
+    storage[handle].next = NONE;
+    if (list.tail == NONE) {
+        list.head = handle;
+    } else {
+        storage[list.tail].next = handle;
+    }
+    list.tail = handle;
+    ++list.count;
+}
+
+PassengerPool::Handle PassengerPool::popFront(List& list) {
+    Handle handle = list.head;
+    if (handle == NONE) {
+        return NONE;
+    }
+    list.head = storage[handle].next;
+    if (list.head == NONE) {
+        list.tail = NONE;
+    }
+    --list.count;
+    return handle;
+}
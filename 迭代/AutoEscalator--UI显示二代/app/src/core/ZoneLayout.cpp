@@ -0,0 +1,74 @@
+#include "core/ZoneLayout.h"
+#include <algorithm>
+
+bool ZoneLayout::addZone(int lobbyFloor, int highestFloor) {
+    if (highestFloor < lobbyFloor) {
+        return false;
+    }
+    if (!zones.empty() && lobbyFloor != zones.back().highestFloor + 1) {
+        return false;
+    }
+    zones.push_back({lobbyFloor, highestFloor});
+    return true;
+}
+
+ZoneLayout ZoneLayout::evenZones(int minFloor, int maxFloor, int zoneCount) {
+    ZoneLayout layout;
+    int floorCount = maxFloor - minFloor + 1;
+    zoneCount = std::max(1, std::min(zoneCount, floorCount));
+
+    int lobby = minFloor;
+    for (int i = 0; i < zoneCount; ++i) {
+        // 余下的楼层平均分给剩余分区，多出的楼层放在靠上的分区
+        int remaining = maxFloor - lobby + 1;
+        int size = remaining / (zoneCount - i);
+        layout.addZone(lobby, lobby + size - 1);
+        lobby += size;
+    }
+    return layout;
+}
+
+std::vector<int> ZoneLayout::getLobbies() const {
+    std::vector<int> lobbies;
+    lobbies.reserve(zones.size());
+    for (const auto& zone : zones) {
+        lobbies.push_back(zone.lobbyFloor);
+    }
+    return lobbies;
+}
+
+int ZoneLayout::zoneOf(int floor) const {
+    // 分区按楼层有序，二分查找最后一个门厅不高于 floor 的分区
+    auto it = std::upper_bound(zones.begin(), zones.end(), floor,
+                               [](int value, const Zone& zone) { return value < zone.lobbyFloor; });
+    if (it == zones.begin()) {
+        return -1;
+    }
+    --it;
+    return floor <= it->highestFloor ? static_cast<int>(it - zones.begin()) : -1;
+}
+
+std::vector<ZoneLayout::Leg> ZoneLayout::planTrip(int fromFloor, int toFloor) const {
+    std::vector<Leg> legs;
+    int fromZone = zoneOf(fromFloor);
+    int toZone = zoneOf(toFloor);
+    if (fromZone < 0 || toZone < 0 || fromFloor == toFloor) {
+        return legs;
+    }
+
+    if (fromZone == toZone) {
+        legs.emplace_back(fromFloor, toFloor);
+        return legs;
+    }
+
+    int fromLobby = zones[fromZone].lobbyFloor;
+    int toLobby = zones[toZone].lobbyFloor;
+    if (fromFloor != fromLobby) {
+        legs.emplace_back(fromFloor, fromLobby);
+    }
+    legs.emplace_back(fromLobby, toLobby);
+    if (toFloor != toLobby) {
+        legs.emplace_back(toLobby, toFloor);
+    }
+    return legs;
+}
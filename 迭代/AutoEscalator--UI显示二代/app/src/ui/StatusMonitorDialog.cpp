@@ -27,9 +27,26 @@ void StatusMonitorDialog::setupUi() {
     statusTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     layout->addWidget(statusTable);
     
+    queueLabel = new QLabel(this);
+    layout->addWidget(queueLabel);
+    
     resize(600, 400);
 }
 
 void StatusMonitorDialog::updateStatus() {
     // 实现状态更新逻辑
+    
+    // 排队请求：总数、各优先级数量和等待时间
+    const auto metrics = dispatcher->getQueueMetrics();
+    using Priority = HallCallScheduler::Priority;
+    queueLabel->setText(QString("排队请求: %1（紧急 %2 / 贵宾 %3 / 老人 %4 / 普通 %5，退避中 %6）  "
+                                "最长等待: %7s  平均等待: %8s")
+        .arg(metrics.depth)
+        .arg(metrics.depthByPriority[static_cast<int>(Priority::EMERGENCY)])
+        .arg(metrics.depthByPriority[static_cast<int>(Priority::VIP)])
+        .arg(metrics.depthByPriority[static_cast<int>(Priority::ELDERLY)])
+        .arg(metrics.depthByPriority[static_cast<int>(Priority::NORMAL)])
+        .arg(metrics.blocked)
+        .arg(metrics.oldestAge, 0, 'f', 1)
+        .arg(metrics.averageAge, 0, 'f', 1));
 } 
\ No newline at end of file